@@ -0,0 +1,97 @@
+// Copyright (c) 2024 Simons Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "./bench_common.hpp"
+#include <nda/blas.hpp>
+
+using value_t = double;
+
+const long Nmin = 64;
+const long Nmax = 1 << 22;
+
+// y += a * x as a lazy expression (dispatched to BLAS above nda::blas::level1_dispatch_min_size)
+template <long Stride>
+static void axpy_expr(benchmark::State &state) {
+  long N = state.range(0);
+  auto X = nda::vector<value_t>{nda::rand<value_t>(N * Stride)};
+  auto Y = nda::vector<value_t>{nda::rand<value_t>(N * Stride)};
+  auto x = X(range(0, N * Stride, Stride));
+  auto y = Y(range(0, N * Stride, Stride));
+  for (auto s : state) {
+    y += 0.5 * x;
+    benchmark::DoNotOptimize(Y.data());
+  }
+  state.SetBytesProcessed(state.iterations() * 3 * N * long(sizeof(value_t)));
+}
+
+// y += a * x as an inline loop, i.e. what the lazy expression generates without dispatch
+template <long Stride>
+static void axpy_loop(benchmark::State &state) {
+  long N = state.range(0);
+  auto X = nda::vector<value_t>{nda::rand<value_t>(N * Stride)};
+  auto Y = nda::vector<value_t>{nda::rand<value_t>(N * Stride)};
+  for (auto s : state) {
+    auto const *__restrict px = X.data();
+    auto *__restrict py       = Y.data();
+    for (long i = 0; i < N * Stride; i += Stride) py[i] += 0.5 * px[i];
+    benchmark::DoNotOptimize(Y.data());
+  }
+  state.SetBytesProcessed(state.iterations() * 3 * N * long(sizeof(value_t)));
+}
+
+// y += a * x with a direct call to BLAS
+template <long Stride>
+static void axpy_blas(benchmark::State &state) {
+  long N = state.range(0);
+  auto X = nda::vector<value_t>{nda::rand<value_t>(N * Stride)};
+  auto Y = nda::vector<value_t>{nda::rand<value_t>(N * Stride)};
+  auto x = X(range(0, N * Stride, Stride));
+  auto y = Y(range(0, N * Stride, Stride));
+  for (auto s : state) {
+    nda::blas::axpy(0.5, x, y);
+    benchmark::DoNotOptimize(Y.data());
+  }
+  state.SetBytesProcessed(state.iterations() * 3 * N * long(sizeof(value_t)));
+}
+
+// y *= a as a lazy expression (dispatched to BLAS above nda::blas::level1_dispatch_min_size)
+static void scal_expr(benchmark::State &state) {
+  long N = state.range(0);
+  auto Y = nda::vector<value_t>{nda::rand<value_t>(N)};
+  for (auto s : state) {
+    Y *= -1.0;
+    benchmark::DoNotOptimize(Y.data());
+  }
+  state.SetBytesProcessed(state.iterations() * 2 * N * long(sizeof(value_t)));
+}
+
+// y *= a with a direct call to BLAS
+static void scal_blas(benchmark::State &state) {
+  long N = state.range(0);
+  auto Y = nda::vector<value_t>{nda::rand<value_t>(N)};
+  for (auto s : state) {
+    nda::blas::scal(-1.0, Y);
+    benchmark::DoNotOptimize(Y.data());
+  }
+  state.SetBytesProcessed(state.iterations() * 2 * N * long(sizeof(value_t)));
+}
+
+BENCHMARK_TEMPLATE(axpy_expr, 1)->RangeMultiplier(4)->Range(Nmin, Nmax);  // NOLINT
+BENCHMARK_TEMPLATE(axpy_loop, 1)->RangeMultiplier(4)->Range(Nmin, Nmax);  // NOLINT
+BENCHMARK_TEMPLATE(axpy_blas, 1)->RangeMultiplier(4)->Range(Nmin, Nmax);  // NOLINT
+BENCHMARK_TEMPLATE(axpy_expr, 4)->RangeMultiplier(4)->Range(Nmin, Nmax);  // NOLINT
+BENCHMARK_TEMPLATE(axpy_loop, 4)->RangeMultiplier(4)->Range(Nmin, Nmax);  // NOLINT
+BENCHMARK_TEMPLATE(axpy_blas, 4)->RangeMultiplier(4)->Range(Nmin, Nmax);  // NOLINT
+BENCHMARK(scal_expr)->RangeMultiplier(4)->Range(Nmin, Nmax);              // NOLINT
+BENCHMARK(scal_blas)->RangeMultiplier(4)->Range(Nmin, Nmax);              // NOLINT
@@ -0,0 +1,71 @@
+// Copyright (c) 2024 Simons Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "./bench_common.hpp"
+#include <nda/linalg.hpp>
+
+using value_t  = double;
+using matrix_t = nda::matrix<value_t, nda::F_layout>;
+
+const long Nmin = 32;
+const long Nmax = 1 << 10;
+
+// Well conditioned N-by-N matrix.
+static matrix_t make_matrix(long N) { return nda::rand<value_t>(N, N) + N * nda::eye<value_t>(N); }
+
+// Replace one column and recompute the inverse and the determinant from scratch.
+static void RECOMPUTE(benchmark::State &state) {
+  long N = state.range(0);
+  auto A = make_matrix(N);
+  auto v = nda::vector<value_t>{nda::rand<value_t>(N)};
+  long j = 0;
+  for (auto s : state) {
+    j                     = (j + 1) % N;
+    v(j)                  = N;
+    A(nda::range::all, j) = v;
+    auto f                = nda::linalg::lu{A};
+    auto Ainv             = f.inverse();
+    benchmark::DoNotOptimize(f.det());
+    benchmark::DoNotOptimize(Ainv.data());
+    v(j) = 0.5;
+  }
+}
+BENCHMARK(RECOMPUTE)->RangeMultiplier(2)->Range(Nmin, Nmax)->Unit(benchmark::kMicrosecond); // NOLINT
+
+// Replace one column with a rank-1 update of the inverse and the determinant (without periodic recomputation).
+static void DET_MANIP(benchmark::State &state) {
+  long N  = state.range(0);
+  auto dm = nda::linalg::det_manip{make_matrix(N)};
+  auto v  = nda::vector<value_t>{nda::rand<value_t>(N)};
+  long j  = 0;
+  dm.set_recompute_period(0);
+  for (auto s : state) {
+    j    = (j + 1) % N;
+    v(j) = N;
+    benchmark::DoNotOptimize(dm.try_change_col(j, v));
+    dm.complete_operation();
+    v(j) = 0.5;
+  }
+}
+BENCHMARK(DET_MANIP)->RangeMultiplier(2)->Range(Nmin, Nmax)->Unit(benchmark::kMicrosecond); // NOLINT
+
+// Recompute the inverse and the determinant from the current matrix (done periodically by nda::linalg::det_manip).
+static void DET_MANIP_REGENERATE(benchmark::State &state) {
+  long N  = state.range(0);
+  auto dm = nda::linalg::det_manip{make_matrix(N)};
+  for (auto s : state) {
+    dm.regenerate();
+    benchmark::DoNotOptimize(dm.determinant());
+  }
+}
+BENCHMARK(DET_MANIP_REGENERATE)->RangeMultiplier(2)->Range(Nmin, Nmax)->Unit(benchmark::kMicrosecond); // NOLINT
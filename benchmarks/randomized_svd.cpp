@@ -0,0 +1,69 @@
+// Copyright (c) 2024 Simons Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "./bench_common.hpp"
+#include <nda/linalg.hpp>
+
+#include <cmath>
+
+using value_t  = double;
+using matrix_t = nda::matrix<value_t, nda::F_layout>;
+
+const long Nmin = 256;
+const long Nmax = 1 << 11;
+const long Rank = 20;
+
+// N-by-N matrix with exponentially decaying singular values and numerical rank ~Rank.
+static matrix_t make_low_rank(long N) {
+  auto Q1 = matrix_t(N, N), Q2 = matrix_t(N, N);
+  for (auto *Q : {&Q1, &Q2}) {
+    auto jpvt = nda::zeros<int>(N);
+    auto tau  = nda::vector<value_t>(N);
+    *Q        = nda::rand<value_t>(N, N);
+    nda::lapack::geqp3(*Q, jpvt, tau);
+    nda::lapack::orgqr(*Q, tau);
+  }
+  auto S = nda::vector<value_t>(N);
+  for (long i = 0; i < N; ++i) S(i) = std::exp(-static_cast<double>(i) / 2.0);
+  return Q1 * nda::diag(S) * Q2;
+}
+
+static void GESVD(benchmark::State &state) {
+  long N  = state.range(0);
+  auto A  = make_low_rank(N);
+  auto S  = nda::vector<double>(N);
+  auto U  = matrix_t(N, N);
+  auto VT = matrix_t(N, N);
+  auto ws = nda::lapack::workspace<value_t>{};
+  for (auto s : state) {
+    auto Acopy = A;
+    nda::lapack::gesvd(Acopy, S, U, VT, ws);
+  }
+}
+BENCHMARK(GESVD)->RangeMultiplier(2)->Range(Nmin, Nmax)->Unit(benchmark::kMillisecond); // NOLINT
+
+static void RANDOMIZED_SVD(benchmark::State &state) {
+  long N = state.range(0);
+  auto A = make_low_rank(N);
+  for (auto s : state) {
+    auto [U, S, VH] = nda::linalg::randomized_svd(A, Rank);
+    benchmark::DoNotOptimize(S.data());
+  }
+
+  // relative error of the largest and the smallest computed singular value
+  auto [U, S, VH]             = nda::linalg::randomized_svd(A, Rank);
+  state.counters["err_first"] = std::abs(S(0) - 1.0);
+  state.counters["err_last"]  = std::abs(S(Rank - 1) / std::exp(-static_cast<double>(Rank - 1) / 2.0) - 1.0);
+}
+BENCHMARK(RANDOMIZED_SVD)->RangeMultiplier(2)->Range(Nmin, Nmax)->Unit(benchmark::kMillisecond); // NOLINT
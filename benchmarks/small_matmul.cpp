@@ -0,0 +1,73 @@
+// Copyright (c) 2024 Simons Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "./bench_common.hpp"
+#include <nda/blas.hpp>
+
+using value_t = double;
+
+// small matrices with compile-time extents
+template <int N>
+static void stack_matmul(benchmark::State &state) {
+  auto A = nda::stack_matrix<value_t, N, N>{nda::rand<value_t>(N, N)};
+  auto B = nda::stack_matrix<value_t, N, N>{nda::rand<value_t>(N, N)};
+  auto C = nda::stack_matrix<value_t, N, N>{};
+  for (auto s : state) { benchmark::DoNotOptimize(C = A * B); }
+}
+
+// small matrices with runtime extents using the inline kernel
+template <int N>
+static void gemm_small(benchmark::State &state) {
+  auto A = nda::matrix<value_t>{nda::rand<value_t>(N, N)};
+  auto B = nda::matrix<value_t>{nda::rand<value_t>(N, N)};
+  auto C = nda::matrix<value_t>(N, N);
+  for (auto s : state) {
+    nda::blas::gemm_small(1.0, A, B, 0.0, C);
+    benchmark::DoNotOptimize(C.data());
+  }
+}
+
+// small matrices with runtime extents using BLAS
+template <int N>
+static void gemm_blas(benchmark::State &state) {
+  auto A = nda::matrix<value_t>{nda::rand<value_t>(N, N)};
+  auto B = nda::matrix<value_t>{nda::rand<value_t>(N, N)};
+  auto C = nda::matrix<value_t>(N, N);
+  for (auto s : state) {
+    nda::blas::gemm(1.0, A, B, 0.0, C);
+    benchmark::DoNotOptimize(C.data());
+  }
+}
+
+BENCHMARK_TEMPLATE(stack_matmul, 2);
+BENCHMARK_TEMPLATE(stack_matmul, 3);
+BENCHMARK_TEMPLATE(stack_matmul, 4);
+BENCHMARK_TEMPLATE(stack_matmul, 6);
+BENCHMARK_TEMPLATE(stack_matmul, 8);
+
+BENCHMARK_TEMPLATE(gemm_small, 2);
+BENCHMARK_TEMPLATE(gemm_small, 3);
+BENCHMARK_TEMPLATE(gemm_small, 4);
+BENCHMARK_TEMPLATE(gemm_small, 6);
+BENCHMARK_TEMPLATE(gemm_small, 8);
+BENCHMARK_TEMPLATE(gemm_small, 12);
+BENCHMARK_TEMPLATE(gemm_small, 16);
+
+BENCHMARK_TEMPLATE(gemm_blas, 2);
+BENCHMARK_TEMPLATE(gemm_blas, 3);
+BENCHMARK_TEMPLATE(gemm_blas, 4);
+BENCHMARK_TEMPLATE(gemm_blas, 6);
+BENCHMARK_TEMPLATE(gemm_blas, 8);
+BENCHMARK_TEMPLATE(gemm_blas, 12);
+BENCHMARK_TEMPLATE(gemm_blas, 16);
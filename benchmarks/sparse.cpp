@@ -0,0 +1,62 @@
+// Copyright (c) 2024 Simons Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "./bench_common.hpp"
+#include <nda/linalg.hpp>
+#include <nda/sparse.hpp>
+
+using value_t = std::complex<double>;
+
+const long Nmin = 256;
+const long Nmax = 1 << 14;
+
+// N-by-N matrix with about 8 nonzero elements per row (tight-binding-like hopping plus random long range terms).
+static nda::sparse::coo_matrix<value_t> make_sparse(long N) {
+  auto coo = nda::sparse::coo_matrix<value_t>(N, N, 8 * N);
+  for (long i = 0; i < N; ++i) {
+    coo.insert(i, i, 1.0);
+    for (long d : {1l, 2l, 17l}) {
+      coo.insert(i, (i + d) % N, value_t{-1.0, 0.1});
+      coo.insert((i + d) % N, i, value_t{-1.0, -0.1});
+    }
+    coo.insert(i, (31 * i + 7) % N, 0.5);
+  }
+  return coo;
+}
+
+static void GEMV(benchmark::State &state) {
+  long N = state.range(0);
+  auto A = make_sparse(N).to_dense();
+  auto x = nda::vector<value_t>::rand(N);
+  auto y = nda::vector<value_t>(N);
+  for (auto s : state) nda::blas::gemv(1.0, A, x, 0.0, y);
+}
+BENCHMARK(GEMV)->RangeMultiplier(4)->Range(Nmin, Nmax / 4)->Unit(benchmark::kMicrosecond); // NOLINT
+
+static void SPMV(benchmark::State &state) {
+  long N = state.range(0);
+  auto A = nda::sparse::csr_matrix{make_sparse(N)};
+  auto x = nda::vector<value_t>::rand(N);
+  auto y = nda::vector<value_t>(N);
+  for (auto s : state) nda::sparse::spmv(1.0, A, x, 0.0, y);
+}
+BENCHMARK(SPMV)->RangeMultiplier(4)->Range(Nmin, Nmax)->Unit(benchmark::kMicrosecond); // NOLINT
+
+static void SPMM(benchmark::State &state) {
+  long N = state.range(0);
+  auto A = nda::sparse::csr_matrix{make_sparse(N)};
+  auto B = nda::matrix<value_t>::rand(N, 16);
+  auto C = nda::matrix<value_t>(N, 16);
+  for (auto s : state) nda::sparse::spmm(1.0, A, B, 0.0, C);
+}
+BENCHMARK(SPMM)->RangeMultiplier(4)->Range(Nmin, Nmax)->Unit(benchmark::kMicrosecond); // NOLINT
@@ -452,6 +452,11 @@ void assign_from_ndarray(RHS const &rhs) { // FIXME noexcept {
   // compile-time check if assignment is possible
   static_assert(std::is_assignable_v<value_type &, get_value_t<RHS>>, "Error in assign_from_ndarray: Incompatible value types");
 
+  // dispatch simple patterns like y = x, y += a * x or y *= a to BLAS level-1 routines if possible
+  if constexpr (blas::detail::has_level1_pattern<self_t, RHS>) {
+    if (blas::detail::assign_level1(*this, rhs)) return;
+  }
+
   // are both operands nda::MemoryArray types?
   static constexpr bool both_in_memory = MemoryArray<self_t> and MemoryArray<RHS>;
 
@@ -22,6 +22,7 @@
 #pragma once
 
 #include "./basic_functions.hpp"
+#include "./blas/axpy.hpp"
 #include "./clef.hpp"
 #include "./concepts.hpp"
 #include "./declarations.hpp"
@@ -21,11 +21,23 @@
 
 #pragma once
 
+#include "./blas/axpy.hpp"
 #include "./blas/interface/cxx_interface.hpp"
 #include "./blas/dot.hpp"
+#include "./blas/gbmv.hpp"
 #include "./blas/gemm.hpp"
 #include "./blas/gemm_batch.hpp"
+#include "./blas/gemm_small.hpp"
 #include "./blas/gemv.hpp"
+#include "./blas/gemv_batch.hpp"
 #include "./blas/ger.hpp"
 #include "./blas/scal.hpp"
+#include "./blas/spmv.hpp"
+#include "./blas/spr.hpp"
+#include "./blas/symm.hpp"
+#include "./blas/syr2k.hpp"
+#include "./blas/syrk.hpp"
+#include "./blas/threads.hpp"
 #include "./blas/tools.hpp"
+#include "./blas/trmm.hpp"
+#include "./blas/trsm.hpp"
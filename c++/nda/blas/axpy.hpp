@@ -0,0 +1,395 @@
+// Copyright (c) 2024 Simons Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file
+ * @brief Provides generic interfaces to the BLAS `axpy`, `axpby` and `copy` routines and the dispatch of simple
+ * assignment patterns to BLAS level-1 routines.
+ */
+
+#pragma once
+
+#include "./interface/cxx_interface.hpp"
+#include "./tools.hpp"
+#include "../concepts.hpp"
+#include "../declarations.hpp"
+#include "../macros.hpp"
+#include "../mem/address_space.hpp"
+#include "../traits.hpp"
+
+#ifndef NDA_HAVE_DEVICE
+#include "../device.hpp"
+#endif
+
+#include <climits>
+#include <type_traits>
+
+namespace nda::blas {
+
+  /**
+   * @addtogroup linalg_blas
+   * @{
+   */
+
+  /**
+   * @brief Interface to the BLAS `axpy` routine.
+   *
+   * @details This function calculates
+   * \f[
+   *   \mathbf{y} \leftarrow \alpha \mathbf{x} + \mathbf{y} \;,
+   * \f]
+   * where \f$ \alpha \f$ is a scalar and \f$ \mathbf{x} \f$, \f$ \mathbf{y} \f$ are vectors.
+   *
+   * @tparam X nda::MemoryVector type.
+   * @tparam Y nda::MemoryVector type.
+   * @param alpha Input scalar.
+   * @param x Input vector.
+   * @param y Input/Output vector.
+   */
+  template <MemoryVector X, MemoryVector Y>
+    requires(have_same_value_type_v<X, Y> and is_blas_lapack_v<get_value_t<X>>)
+  void axpy(get_value_t<X> alpha, X const &x, Y &&y) { // NOLINT (temporary views are allowed here)
+    static_assert(mem::have_compatible_addr_space<X, Y>, "Error in nda::blas::axpy: Incompatible memory address spaces");
+    EXPECTS(x.shape() == y.shape());
+
+    if constexpr (mem::have_device_compatible_addr_space<X, Y>) {
+#if defined(NDA_HAVE_DEVICE)
+      device::axpy(x.size(), alpha, x.data(), x.indexmap().strides()[0], y.data(), y.indexmap().strides()[0]);
+#else
+      compile_error_no_gpu();
+#endif
+    } else {
+      f77::axpy(x.size(), alpha, x.data(), x.indexmap().strides()[0], y.data(), y.indexmap().strides()[0]);
+    }
+  }
+
+  /**
+   * @brief Interface to the BLAS `axpby` routine.
+   *
+   * @details This function calculates
+   * \f[
+   *   \mathbf{y} \leftarrow \alpha \mathbf{x} + \beta \mathbf{y} \;,
+   * \f]
+   * where \f$ \alpha \f$, \f$ \beta \f$ are scalars and \f$ \mathbf{x} \f$, \f$ \mathbf{y} \f$ are vectors.
+   *
+   * `axpby` is a BLAS extension provided by MKL. For other BLAS implementations, it is emulated by a call to `scal`
+   * followed by a call to `axpy`.
+   *
+   * @tparam X nda::MemoryVector type.
+   * @tparam Y nda::MemoryVector type.
+   * @param alpha Input scalar.
+   * @param x Input vector.
+   * @param beta Input scalar.
+   * @param y Input/Output vector.
+   */
+  template <MemoryVector X, MemoryVector Y>
+    requires(have_same_value_type_v<X, Y> and is_blas_lapack_v<get_value_t<X>>)
+  void axpby(get_value_t<X> alpha, X const &x, get_value_t<X> beta, Y &&y) { // NOLINT (temporary views are allowed here)
+    static_assert(mem::have_compatible_addr_space<X, Y>, "Error in nda::blas::axpby: Incompatible memory address spaces");
+    EXPECTS(x.shape() == y.shape());
+
+    if constexpr (mem::have_device_compatible_addr_space<X, Y>) {
+#if defined(NDA_HAVE_DEVICE)
+      device::axpby(x.size(), alpha, x.data(), x.indexmap().strides()[0], beta, y.data(), y.indexmap().strides()[0]);
+#else
+      compile_error_no_gpu();
+#endif
+    } else {
+      f77::axpby(x.size(), alpha, x.data(), x.indexmap().strides()[0], beta, y.data(), y.indexmap().strides()[0]);
+    }
+  }
+
+  /**
+   * @brief Interface to the BLAS `copy` routine.
+   *
+   * @details This function copies the vector \f$ \mathbf{x} \f$ into the vector \f$ \mathbf{y} \f$.
+   *
+   * @tparam X nda::MemoryVector type.
+   * @tparam Y nda::MemoryVector type.
+   * @param x Input vector.
+   * @param y Output vector.
+   */
+  template <MemoryVector X, MemoryVector Y>
+    requires(have_same_value_type_v<X, Y> and is_blas_lapack_v<get_value_t<X>>)
+  void copy(X const &x, Y &&y) { // NOLINT (temporary views are allowed here)
+    static_assert(mem::have_compatible_addr_space<X, Y>, "Error in nda::blas::copy: Incompatible memory address spaces");
+    EXPECTS(x.shape() == y.shape());
+
+    if constexpr (mem::have_device_compatible_addr_space<X, Y>) {
+#if defined(NDA_HAVE_DEVICE)
+      device::copy(x.size(), x.data(), x.indexmap().strides()[0], y.data(), y.indexmap().strides()[0]);
+#else
+      compile_error_no_gpu();
+#endif
+    } else {
+      f77::copy(x.size(), x.data(), x.indexmap().strides()[0], y.data(), y.indexmap().strides()[0]);
+    }
+  }
+
+  /**
+   * @brief Smallest number of elements for which an assignment of the form `y = x`, `y = a * x + b * y`,
+   * `y += a * x` or `y *= a` on the host is dispatched to the BLAS level-1 routines `copy`, `axpby`, `axpy` or `scal`.
+   *
+   * @details Below this size, the inline loop generated for the lazy expression is roughly as fast as the Fortran BLAS
+   * call on a single core (see benchmarks/axpy.cpp). Above it, multithreaded BLAS implementations split the work
+   * among several cores, which pays off for these memory bound operations.
+   */
+  inline constexpr long level1_dispatch_min_size = 1 << 15;
+
+  /** @} */
+
+  namespace detail {
+
+    // Is the type an array which can be an operand of a level-1 routine together with the left hand side Y, i.e. it has
+    // the same rank, value type and (for rank > 1) the same strided 1d layout?
+    template <typename Y, typename X_ref>
+    static constexpr bool is_level1_operand = []() {
+      using X = std::remove_cvref_t<X_ref>;
+      if constexpr (MemoryArray<X>) {
+        if constexpr (get_rank<X> != get_rank<Y> or not have_same_value_type_v<X, Y> or not mem::have_compatible_addr_space<X, Y>)
+          return false;
+        else
+          return get_rank<X> == 1 or (has_layout_strided_1d<X> and get_layout_info<X>.stride_order == get_layout_info<Y>.stride_order);
+      } else {
+        return false;
+      }
+    }();
+
+    // Type traits to check if a type is a scalar times an array, i.e. `a * x` or `x * a`.
+    template <typename T>
+    inline constexpr bool is_scaled_expr = false;
+
+    template <typename L, typename R>
+    inline constexpr bool is_scaled_expr<expr<'*', L, R>> = (nda::is_scalar_v<L> != nda::is_scalar_v<R>);
+
+    // Type traits to check if a type is a sum or a difference of two arrays.
+    template <typename T>
+    inline constexpr bool is_sum_expr = false;
+
+    template <char OP, typename L, typename R>
+    inline constexpr bool is_sum_expr<expr<OP, L, R>> = ((OP == '+' or OP == '-') and not nda::is_scalar_v<L> and not nda::is_scalar_v<R>);
+
+    // Type traits to check if a type is a difference of two arrays or scalars.
+    template <typename T>
+    inline constexpr bool is_diff_expr = false;
+
+    template <typename L, typename R>
+    inline constexpr bool is_diff_expr<expr<'-', L, R>> = true;
+
+    // Type traits to check if a type is a negated array.
+    template <typename T>
+    inline constexpr bool is_neg_expr = false;
+
+    template <typename A>
+    inline constexpr bool is_neg_expr<expr_unary<'-', A>> = true;
+
+    // Is the type a term of a level-1 pattern, i.e. `x`, `-x`, `a * x` or `x * a`?
+    template <typename Y, typename T>
+    static constexpr bool is_level1_term = []() {
+      using T_t = std::remove_cvref_t<T>;
+      if constexpr (is_level1_operand<Y, T_t>) {
+        return true;
+      } else if constexpr (is_neg_expr<T_t>) {
+        return is_level1_operand<Y, decltype(T_t::a)>;
+      } else if constexpr (is_scaled_expr<T_t>) {
+        using S = std::conditional_t<nda::is_scalar_v<typename T_t::L_t>, typename T_t::L_t, typename T_t::R_t>;
+        using A = std::conditional_t<nda::is_scalar_v<typename T_t::L_t>, decltype(T_t::r), decltype(T_t::l)>;
+        return std::is_constructible_v<get_value_t<Y>, S> and is_level1_operand<Y, A>;
+      } else {
+        return false;
+      }
+    }();
+
+    // Get the array and the scalar prefactor of a level-1 term.
+    template <typename T>
+    auto const &level1_term_array(T const &t) {
+      if constexpr (MemoryArray<T>)
+        return t;
+      else if constexpr (is_scaled_expr<T>) {
+        if constexpr (T::l_is_scalar)
+          return t.r;
+        else
+          return t.l;
+      } else
+        return t.a;
+    }
+
+    template <typename V, typename T>
+    V level1_term_scalar(T const &t) {
+      if constexpr (MemoryArray<T>)
+        return V{1};
+      else if constexpr (is_scaled_expr<T>) {
+        if constexpr (T::l_is_scalar)
+          return static_cast<V>(t.l);
+        else
+          return static_cast<V>(t.r);
+      } else
+        return V{-1};
+    }
+
+    /**
+     * @brief Check at compile-time if an assignment `y = rhs` has one of the forms that can be dispatched to a BLAS
+     * level-1 routine.
+     *
+     * @details The left hand side has to be a non-const nda::MemoryArray with a BLAS compatible value type which is
+     * either 1-dimensional or strided in 1d. The right hand side can be
+     * - an array with a non-unit increment on either side (`copy`),
+     * - a single term `-x`, `a * x` or `x * a` (`scal` if `x` is the left hand side) or
+     * - the sum or difference of two such terms (`axpy` or `axpby` if one of them is the left hand side).
+     */
+    template <typename Y, typename RHS>
+    static constexpr bool has_level1_pattern = []() {
+      if constexpr (not MemoryArray<Y> or not is_blas_lapack_v<get_value_t<Y>>) {
+        return false;
+      } else if constexpr (std::is_const_v<typename std::remove_cvref_t<Y>::value_type>) {
+        return false;
+      } else if constexpr (get_rank<Y> != 1 and not has_layout_strided_1d<Y>) {
+        return false;
+      } else if constexpr (is_sum_expr<RHS>) {
+        return is_level1_term<Y, decltype(RHS::l)> and is_level1_term<Y, decltype(RHS::r)>;
+      } else {
+        return is_level1_term<Y, RHS>;
+      }
+    }();
+
+    // Increment of a 1-dimensional or strided 1d array.
+    template <typename A>
+    long level1_inc(A const &a) {
+      if constexpr (get_rank<A> == 1)
+        return a.indexmap().strides()[0];
+      else
+        return a.indexmap().min_stride();
+    }
+
+    /**
+     * @brief Try to perform the assignment `y = rhs` by calling a BLAS level-1 routine.
+     *
+     * @details It is a no-op and returns false if
+     * - the assignment takes place on the host and the size is smaller than nda::blas::level1_dispatch_min_size,
+     * - the size does not fit into an `int` or one of the arrays has a non-positive increment,
+     * - none of the arrays on the right hand side is the left hand side itself (except for `y = x`) or
+     * - an array on the right hand side overlaps in memory with the left hand side without being identical to it.
+     *
+     * In those cases, the caller has to fallback to the elementwise assignment.
+     *
+     * @tparam Y nda::MemoryArray type.
+     * @tparam RHS Type of the right hand side (see nda::blas::detail::has_level1_pattern).
+     * @param y Left hand side array.
+     * @param rhs Right hand side.
+     * @return True if the assignment has been performed.
+     */
+    template <typename Y, typename RHS>
+      requires(has_level1_pattern<Y, RHS>)
+    bool assign_level1(Y &y, RHS const &rhs) {
+      using value_t                   = get_value_t<Y>;
+      static constexpr bool on_device = mem::on_device<Y>;
+
+      // runtime checks on the left hand side
+      long const size = y.size();
+      if ((not on_device and size < level1_dispatch_min_size) or size > INT_MAX) return false;
+      long const inc_y = level1_inc(y);
+      if (inc_y <= 0) return false;
+
+      // 0: x is y, 1: x and y do not overlap, -1: x partially overlaps with y or has an unsupported layout
+      auto relation_to_y = [&](auto const &x) {
+        long const inc_x = level1_inc(x);
+        if (x.shape() != y.shape() or inc_x <= 0) return -1;
+        auto const *x_beg = x.data();
+        auto const *y_beg = y.data();
+        if (x_beg == y_beg and inc_x == inc_y) return 0;
+        auto const *x_end = x_beg + (size - 1) * inc_x + 1;
+        auto const *y_end = y_beg + (size - 1) * inc_y + 1;
+        return (x_end <= y_beg or y_end <= x_beg) ? 1 : -1;
+      };
+
+      // call the BLAS routines (the arrays are either all on the host or all on the device)
+      auto call_copy = [&](auto const &x) {
+        if constexpr (on_device) {
+#if defined(NDA_HAVE_DEVICE)
+          device::copy(size, x.data(), level1_inc(x), y.data(), inc_y);
+#else
+          compile_error_no_gpu();
+#endif
+        } else {
+          f77::copy(size, x.data(), level1_inc(x), y.data(), inc_y);
+        }
+      };
+      auto call_scal = [&](value_t alpha) {
+        if constexpr (on_device) {
+#if defined(NDA_HAVE_DEVICE)
+          device::scal(size, alpha, y.data(), inc_y);
+#else
+          compile_error_no_gpu();
+#endif
+        } else {
+          f77::scal(size, alpha, y.data(), inc_y);
+        }
+      };
+      auto call_axpby = [&](value_t alpha, auto const &x, value_t beta) {
+        if constexpr (on_device) {
+#if defined(NDA_HAVE_DEVICE)
+          if (beta == value_t{1})
+            device::axpy(size, alpha, x.data(), level1_inc(x), y.data(), inc_y);
+          else
+            device::axpby(size, alpha, x.data(), level1_inc(x), beta, y.data(), inc_y);
+#else
+          compile_error_no_gpu();
+#endif
+        } else {
+          if (beta == value_t{1})
+            f77::axpy(size, alpha, x.data(), level1_inc(x), y.data(), inc_y);
+          else
+            f77::axpby(size, alpha, x.data(), level1_inc(x), beta, y.data(), inc_y);
+        }
+      };
+
+      if constexpr (is_sum_expr<RHS>) {
+        // y = b * y + a * x or y = a * x + b * y (a subtraction flips the sign of the right term)
+        auto const &x_l = level1_term_array(rhs.l);
+        auto const &x_r = level1_term_array(rhs.r);
+        auto const a_l  = level1_term_scalar<value_t>(rhs.l);
+        auto const a_r  = (is_diff_expr<RHS> ? value_t{-1} : value_t{1}) * level1_term_scalar<value_t>(rhs.r);
+        int const rel_l = relation_to_y(x_l);
+        int const rel_r = relation_to_y(x_r);
+        if (rel_l == 0 and rel_r == 1) {
+          call_axpby(a_r, x_r, a_l);
+          return true;
+        }
+        if (rel_l == 1 and rel_r == 0) {
+          call_axpby(a_l, x_l, a_r);
+          return true;
+        }
+        return false;
+      } else {
+        auto const &x = level1_term_array(rhs);
+        int const rel = relation_to_y(x);
+        if (rel == 0) {
+          // y = a * y (y = y is a no-op)
+          if constexpr (not MemoryArray<RHS>) call_scal(level1_term_scalar<value_t>(rhs));
+          return true;
+        }
+        if constexpr (MemoryArray<RHS>) {
+          // y = x (contiguous copies are left to the vectorized loop)
+          if (rel == 1 and (inc_y != 1 or level1_inc(x) != 1)) {
+            call_copy(x);
+            return true;
+          }
+        }
+        return false;
+      }
+    }
+
+  } // namespace detail
+
+} // namespace nda::blas
@@ -16,12 +16,13 @@
 
 /**
  * @file
- * @brief Provides a generic interface to the BLAS `dot` routine.
+ * @brief Provides a generic interface to the BLAS `dot` routine and a strided batched version of it.
  */
 
 #pragma once
 
 #include "./interface/cxx_interface.hpp"
+#include "./tools.hpp"
 #include "../concepts.hpp"
 #include "../macros.hpp"
 #include "../mapped_functions.hpp"
@@ -127,6 +128,70 @@ namespace nda::blas {
     }
   }
 
+  /**
+   * @brief Implements a strided batched version of nda::blas::dot and nda::blas::dotc taking 2-dimensional arrays as
+   * arguments.
+   *
+   * @details It calculates `res(i) = dot(x(i, _), y(i, _))` for all i. If \f$ \mathbf{x} \f$ is a conjugate lazy
+   * expression, the conjugated dot product nda::blas::dotc is calculated instead. The vectors can have arbitrary
+   * strides.
+   *
+   * With MKL (>= 2021.1), the dot products are calculated with a single call to `?gemv_batch_strided`. Otherwise, they
+   * are distributed over the OpenMP threads while the BLAS backend runs single-threaded (see
+   * nda::blas::scoped_num_threads).
+   *
+   * @tparam X nda::ArrayOfRank<2> type.
+   * @tparam Y nda::MemoryArrayOfRank<2> type.
+   * @tparam R nda::MemoryVector type.
+   * @param x 2-dimensional input array (or its conjugate).
+   * @param y 2-dimensional input array.
+   * @param res Output vector containing the dot products.
+   */
+  template <ArrayOfRank<2> X, MemoryArrayOfRank<2> Y, MemoryVector R>
+    requires((MemoryArrayOfRank<X, 2> or is_conj_array_expr<X>) and have_same_value_type_v<X, Y, R> and is_blas_lapack_v<get_value_t<X>>)
+  void dot_batch_strided(X const &x, Y const &y, R &&res) { // NOLINT (temporary views are allowed here)
+    // get underlying array in case it is given as a lazy expression
+    auto to_arr = []<typename Z>(Z const &z) -> auto & {
+      if constexpr (is_conj_array_expr<Z>)
+        return std::get<0>(z.a);
+      else
+        return z;
+    };
+    auto &arr_x = to_arr(x);
+
+    // compile-time check
+    using arr_x_type = decltype(arr_x);
+    static_assert(mem::have_compatible_addr_space<arr_x_type, Y, R>, "Error in nda::blas::dot_batch_strided: Incompatible memory address spaces");
+
+    // runtime checks
+    EXPECTS(arr_x.shape() == y.shape());
+    EXPECTS(arr_x.extent(0) == res.extent(0));
+    if (res.empty()) return;
+
+    // gather parameters for the call
+    static constexpr bool conj_x = is_conj_array_expr<X> and is_complex_v<get_value_t<X>>;
+    auto [stride_x, incx]        = arr_x.indexmap().strides();
+    auto [stride_y, incy]        = y.indexmap().strides();
+    auto [batch_count, n]        = y.shape();
+    auto incres                  = res.indexmap().strides()[0];
+
+    if constexpr (mem::have_device_compatible_addr_space<arr_x_type, Y, R>) {
+#if defined(NDA_HAVE_DEVICE)
+      if constexpr (conj_x)
+        device::dotc_batch_strided(n, arr_x.data(), incx, stride_x, y.data(), incy, stride_y, res.data(), incres, batch_count);
+      else
+        device::dot_batch_strided(n, arr_x.data(), incx, stride_x, y.data(), incy, stride_y, res.data(), incres, batch_count);
+#else
+      compile_error_no_gpu();
+#endif
+    } else {
+      if constexpr (conj_x)
+        f77::dotc_batch_strided(n, arr_x.data(), incx, stride_x, y.data(), incy, stride_y, res.data(), incres, batch_count);
+      else
+        f77::dot_batch_strided(n, arr_x.data(), incx, stride_x, y.data(), incy, stride_y, res.data(), incres, batch_count);
+    }
+  }
+
   namespace detail {
 
     // Implementation of the nda::dot_generic and nda::dotc_generic functions.
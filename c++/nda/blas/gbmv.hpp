@@ -0,0 +1,77 @@
+// Copyright (c) 2024 Simons Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file
+ * @brief Provides a generic interface to the BLAS `gbmv` routine.
+ */
+
+#pragma once
+
+#include "./interface/cxx_interface.hpp"
+#include "./tools.hpp"
+#include "../concepts.hpp"
+#include "../macros.hpp"
+#include "../mem/address_space.hpp"
+#include "../traits.hpp"
+
+namespace nda::blas {
+
+  /**
+   * @ingroup linalg_blas
+   * @brief Interface to the BLAS `gbmv` routine.
+   *
+   * @details This function performs one of the matrix-vector operations
+   * - \f$ \mathbf{y} \leftarrow \alpha \mathbf{A} \mathbf{x} + \beta \mathbf{y} \f$ (`op == 'N'`),
+   * - \f$ \mathbf{y} \leftarrow \alpha \mathbf{A}^T \mathbf{x} + \beta \mathbf{y} \f$ (`op == 'T'`) or
+   * - \f$ \mathbf{y} \leftarrow \alpha \mathbf{A}^H \mathbf{x} + \beta \mathbf{y} \f$ (`op == 'C'`),
+   *
+   * where \f$ \mathbf{A} \f$ is an m-by-n band matrix with `kl` sub-diagonals and `ku` super-diagonals.
+   *
+   * The band matrix is given in the LAPACK band storage, i.e. the element \f$ A_{ij} \f$ with
+   * \f$ \max(0, j - k_u) \leq i \leq \min(m - 1, j + k_l) \f$ is stored in `ab(ku + i - j, j)`. The number of rows m of
+   * \f$ \mathbf{A} \f$ is deduced from the size of `y` (`op == 'N'`) or `x` (otherwise).
+   *
+   * @tparam AB nda::MemoryMatrix type.
+   * @tparam X nda::MemoryVector type.
+   * @tparam Y nda::MemoryVector type.
+   * @param alpha Input scalar.
+   * @param ab Input matrix of size at least (kl + ku + 1)-by-n containing the band matrix \f$ \mathbf{A} \f$.
+   * @param kl Number of sub-diagonals.
+   * @param ku Number of super-diagonals.
+   * @param x Input vector.
+   * @param beta Input scalar.
+   * @param y Input/Output vector.
+   * @param op Operation applied to \f$ \mathbf{A} \f$ ('N', 'T' or 'C').
+   */
+  template <MemoryMatrix AB, MemoryVector X, MemoryVector Y>
+    requires(have_same_value_type_v<AB, X, Y> and mem::on_host<AB, X, Y> and is_blas_lapack_v<get_value_t<AB>>)
+  void gbmv(get_value_t<AB> alpha, AB const &ab, int kl, int ku, X const &x, get_value_t<AB> beta, Y &&y, // NOLINT (temporary views are allowed here)
+            char op = 'N') {
+    static_assert(has_F_layout<AB>, "Error in nda::blas::gbmv: C order not supported");
+
+    // runtime checks
+    EXPECTS(op == 'N' or op == 'T' or op == 'C');
+    EXPECTS(kl >= 0 and ku >= 0);
+    EXPECTS(ab.extent(0) >= kl + ku + 1);
+    EXPECTS(ab.indexmap().min_stride() == 1);
+    EXPECTS((op == 'N' ? x.size() : y.size()) == ab.extent(1));
+
+    int m = (op == 'N' ? y.size() : x.size());
+    int n = ab.extent(1);
+    if (m == 0 or n == 0) return;
+    f77::gbmv(op, m, n, kl, ku, alpha, ab.data(), get_ld(ab), x.data(), x.indexmap().strides()[0], beta, y.data(), y.indexmap().strides()[0]);
+  }
+
+} // namespace nda::blas
@@ -0,0 +1,213 @@
+// Copyright (c) 2024 Simons Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file
+ * @brief Provides inline matrix-matrix and matrix-vector kernels for small matrices.
+ */
+
+#pragma once
+
+#include "../concepts.hpp"
+#include "../macros.hpp"
+#include "../mem/address_space.hpp"
+#include "../traits.hpp"
+
+#include <array>
+#include <type_traits>
+#include <utility>
+
+namespace nda::blas {
+
+  /**
+   * @addtogroup linalg_blas
+   * @{
+   */
+
+  /**
+   * @brief Largest extent for which nda::matmul and nda::matvecmul use the inline kernels nda::blas::gemm_small and
+   * nda::blas::gemv_small instead of calling BLAS.
+   *
+   * @details For matrices with runtime extents, the overhead of the Fortran BLAS call dominates the actual work as long
+   * as all extents are smaller or equal to this value (see benchmarks/small_matmul.cpp).
+   */
+  inline constexpr long small_gemm_max_extent = 8;
+
+  /// Constexpr variable that is true if the type is an nda::MemoryArray with all extents known at compile-time.
+  template <typename A>
+  static constexpr bool has_static_extents = []() {
+    if constexpr (MemoryArray<A>)
+      return std::remove_cvref_t<A>::layout_t::ce_size() > 0;
+    else
+      return false;
+  }();
+
+  /// Constexpr variable that specifies the I-th static extent of an nda::MemoryArray type (0 if it is dynamic).
+  template <typename A, int I>
+    requires(MemoryArray<A>)
+  static constexpr long static_extent = std::remove_cvref_t<A>::layout_t::static_extents[I];
+
+  namespace detail {
+
+    // Call f(std::integral_constant<long, I>{}) for I = 0, ..., N - 1, i.e. a loop which is unrolled at compile-time.
+    template <long N, typename F>
+    FORCEINLINE void static_for(F &&f) {
+      [&f]<long... Is>(std::integer_sequence<long, Is...>) { (f(std::integral_constant<long, Is>{}), ...); }(std::make_integer_sequence<long, N>{});
+    }
+
+  } // namespace detail
+
+  /**
+   * @brief Inline kernel for the matrix-matrix product of small matrices.
+   *
+   * @details It computes \f$ \mathbf{C} \leftarrow \alpha \mathbf{A} \mathbf{B} + \beta \mathbf{C} \f$ without
+   * calling BLAS.
+   *
+   * If the extents of both \f$ \mathbf{A} \f$ and \f$ \mathbf{B} \f$ are known at compile-time (e.g. for
+   * nda::stack_matrix), all loops are fully unrolled and the product is accumulated in a local tile, which allows the
+   * compiler to keep it in (SIMD) registers. Otherwise, the loops are ordered such that the innermost loop runs over
+   * the columns of \f$ \mathbf{B} \f$ and \f$ \mathbf{C} \f$.
+   *
+   * As for BLAS `gemm`, \f$ \mathbf{C} \f$ is not read if \f$ \beta = 0 \f$. In case of runtime extents,
+   * \f$ \mathbf{C} \f$ must not alias \f$ \mathbf{A} \f$ or \f$ \mathbf{B} \f$.
+   *
+   * @tparam A nda::Matrix type.
+   * @tparam B nda::Matrix type.
+   * @tparam C nda::MemoryMatrix type.
+   * @param alpha Input scalar.
+   * @param a Input matrix of size m-by-k.
+   * @param b Input matrix of size k-by-n.
+   * @param beta Input scalar.
+   * @param c Input/Output matrix of size m-by-n.
+   */
+  template <Matrix A, Matrix B, MemoryMatrix C>
+    requires(mem::on_host<A, B, C>)
+  void gemm_small(get_value_t<C> alpha, A const &a, B const &b, get_value_t<C> beta, C &&c) { // NOLINT (temporary views are allowed here)
+    using value_t = get_value_t<C>;
+    EXPECTS(a.shape()[1] == b.shape()[0]);
+    EXPECTS(a.shape()[0] == c.extent(0));
+    EXPECTS(b.shape()[1] == c.extent(1));
+
+    if constexpr (has_static_extents<A> and has_static_extents<B>) {
+      constexpr long M = static_extent<A, 0>;
+      constexpr long K = static_extent<A, 1>;
+      constexpr long N = static_extent<B, 1>;
+      static_assert(K == static_extent<B, 0>, "Error in nda::blas::gemm_small: Dimension mismatch");
+
+      // accumulate the product in a local tile
+      std::array<value_t, M * N> tile{};
+      detail::static_for<M>([&](auto i) {
+        detail::static_for<K>([&](auto k) {
+          auto const aik = a(i(), k());
+          detail::static_for<N>([&](auto j) { tile[i() * N + j()] += aik * b(k(), j()); });
+        });
+      });
+
+      // write the result
+      detail::static_for<M>([&](auto i) {
+        detail::static_for<N>([&](auto j) {
+          if (beta == value_t{0})
+            c(i(), j()) = alpha * tile[i() * N + j()];
+          else
+            c(i(), j()) = alpha * tile[i() * N + j()] + beta * c(i(), j());
+        });
+      });
+    } else if constexpr (MemoryMatrix<A> and MemoryMatrix<B>) {
+      // work directly on the raw data to avoid the overhead of the call operator
+      auto const [m, k]     = a.shape();
+      auto const n          = b.shape()[1];
+      auto const [as0, as1] = a.indexmap().strides();
+      auto const [bs0, bs1] = b.indexmap().strides();
+      auto const [cs0, cs1] = c.indexmap().strides();
+      auto const *a_ptr     = a.data();
+      auto const *b_ptr     = b.data();
+      auto *c_ptr           = c.data();
+      auto kernel = [&](long c_inc, long b_inc) {
+        for (long i = 0; i < m; ++i) {
+          auto *c_row = c_ptr + i * cs0;
+          if (beta == value_t{0})
+            for (long j = 0; j < n; ++j) c_row[j * c_inc] = value_t{0};
+          else
+            for (long j = 0; j < n; ++j) c_row[j * c_inc] *= beta;
+          for (long l = 0; l < k; ++l) {
+            auto const aik    = alpha * a_ptr[i * as0 + l * as1];
+            auto const *b_row = b_ptr + l * bs0;
+            for (long j = 0; j < n; ++j) c_row[j * c_inc] += aik * b_row[j * b_inc];
+          }
+        }
+      };
+
+      // let the compiler vectorize the innermost loop for unit strides (i.e. C layout)
+      if (cs1 == 1 and bs1 == 1)
+        kernel(1, 1);
+      else
+        kernel(cs1, bs1);
+    } else {
+      auto const [m, k] = a.shape();
+      auto const n      = b.shape()[1];
+      for (long i = 0; i < m; ++i) {
+        for (long j = 0; j < n; ++j) c(i, j) = (beta == value_t{0} ? value_t{0} : beta * c(i, j));
+        for (long l = 0; l < k; ++l) {
+          auto const aik = alpha * a(i, l);
+          for (long j = 0; j < n; ++j) c(i, j) += aik * b(l, j);
+        }
+      }
+    }
+  }
+
+  /**
+   * @brief Inline kernel for the matrix-vector product of small matrices.
+   *
+   * @details It computes \f$ \mathbf{y} \leftarrow \alpha \mathbf{A} \mathbf{x} + \beta \mathbf{y} \f$ without
+   * calling BLAS. The loops are fully unrolled if the extents of \f$ \mathbf{A} \f$ are known at compile-time.
+   *
+   * As for BLAS `gemv`, \f$ \mathbf{y} \f$ is not read if \f$ \beta = 0 \f$.
+   *
+   * @tparam A nda::Matrix type.
+   * @tparam X nda::Vector type.
+   * @tparam Y nda::MemoryVector type.
+   * @param alpha Input scalar.
+   * @param a Input matrix of size m-by-n.
+   * @param x Input vector of size n.
+   * @param beta Input scalar.
+   * @param y Input/Output vector of size m.
+   */
+  template <Matrix A, Vector X, MemoryVector Y>
+    requires(mem::on_host<A, X, Y>)
+  void gemv_small(get_value_t<Y> alpha, A const &a, X const &x, get_value_t<Y> beta, Y &&y) { // NOLINT (temporary views are allowed here)
+    using value_t = get_value_t<Y>;
+    EXPECTS(a.shape()[1] == x.shape()[0]);
+    EXPECTS(a.shape()[0] == y.extent(0));
+
+    // compute a single row times x
+    auto row_dot = [&](long i, auto n) {
+      auto res = value_t{0};
+      if constexpr (std::is_integral_v<decltype(n)>) {
+        for (long j = 0; j < n; ++j) res += a(i, j) * x(j);
+      } else {
+        detail::static_for<decltype(n)::value>([&](auto j) { res += a(i, j()) * x(j()); });
+      }
+      return (beta == value_t{0} ? alpha * res : alpha * res + beta * y(i));
+    };
+
+    if constexpr (has_static_extents<A>) {
+      detail::static_for<static_extent<A, 0>>([&](auto i) { y(i()) = row_dot(i(), std::integral_constant<long, static_extent<A, 1>>{}); });
+    } else {
+      for (long i = 0; i < a.shape()[0]; ++i) y(i) = row_dot(i, a.shape()[1]);
+    }
+  }
+
+  /** @} */
+
+} // namespace nda::blas
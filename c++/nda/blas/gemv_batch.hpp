@@ -0,0 +1,206 @@
+// Copyright (c) 2024 Simons Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file
+ * @brief Provides a generic interface to batched versions of the BLAS `gemv` routine.
+ */
+
+#pragma once
+
+#include "./interface/cxx_interface.hpp"
+#include "./tools.hpp"
+#include "../concepts.hpp"
+#include "../declarations.hpp"
+#include "../layout/range.hpp"
+#include "../macros.hpp"
+#include "../mem/address_space.hpp"
+#include "../mem/policies.hpp"
+#include "../traits.hpp"
+
+#ifndef NDA_HAVE_DEVICE
+#include "../device.hpp"
+#endif
+
+#include <algorithm>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace nda::blas {
+
+  /**
+   * @addtogroup linalg_blas
+   * @{
+   */
+
+  /**
+   * @brief Implements a batched version of nda::blas::gemv taking vectors of matrices and vectors as arguments.
+   *
+   * @details This routine is a batched version of nda::blas::gemv, performing multiple `gemv` operations in a single
+   * call. All matrices are required to have the same shape and all vectors in `vx` and `vy` the same increment.
+   *
+   * With MKL (>= 2021.1), it calls `?gemv_batch`. Otherwise, the `gemv` operations are distributed over the OpenMP
+   * threads while the BLAS backend runs single-threaded (see nda::blas::scoped_num_threads).
+   *
+   * @tparam A nda::Matrix type.
+   * @tparam X nda::MemoryVector type.
+   * @tparam Y nda::MemoryVector type.
+   * @param alpha Input scalar.
+   * @param va std::vector of input matrices.
+   * @param vx std::vector of input vectors.
+   * @param beta Input scalar.
+   * @param vy std::vector of input/output vectors.
+   */
+  template <Matrix A, MemoryVector X, MemoryVector Y>
+    requires((MemoryMatrix<A> or is_conj_array_expr<A>) and have_same_value_type_v<A, X, Y> and is_blas_lapack_v<get_value_t<A>>)
+  void gemv_batch(get_value_t<A> alpha, std::vector<A> const &va, std::vector<X> const &vx, get_value_t<A> beta, std::vector<Y> &vy) {
+    // check sizes
+    EXPECTS(va.size() == vx.size() and va.size() == vy.size());
+    if (va.empty()) return;
+    int batch_count = va.size();
+
+    // get underlying matrix in case it is given as a lazy expression
+    auto to_mat = []<typename Z>(Z &z) -> auto & {
+      if constexpr (is_conj_array_expr<Z>)
+        return std::get<0>(z.a);
+      else
+        return z;
+    };
+    auto &a0 = to_mat(va[0]);
+
+    // compile-time checks
+    using mat_type = decltype(a0);
+    static_assert(mem::have_compatible_addr_space<mat_type, X, Y>, "Error in nda::blas::gemv_batch: Incompatible memory address spaces");
+
+    // runtime checks
+    EXPECTS(a0.extent(1) == vx[0].extent(0));
+    EXPECTS(a0.extent(0) == vy[0].extent(0));
+    EXPECTS(std::all_of(va.begin(), va.end(), [&](auto &z) { return z.shape() == va[0].shape() and to_mat(z).indexmap().min_stride() == 1; }));
+    EXPECTS(std::all_of(vx.begin(), vx.end(), [&](auto &z) { return z.shape() == vx[0].shape() and z.strides() == vx[0].strides(); }));
+    EXPECTS(std::all_of(vy.begin(), vy.end(), [&](auto &z) { return z.shape() == vy[0].shape() and z.strides() == vy[0].strides(); }));
+
+    // for operations on the device, use unified memory for vector of ptrs
+    auto constexpr vec_adr_spc = []() { return mem::on_host<Y> ? mem::Host : mem::Unified; }();
+
+    // convert the vector of matrices/vectors into the associated vector of pointers
+    auto get_ptrs = [&to_mat]<typename V>(V &v) {
+      using value_t = get_value_t<typename V::value_type>;
+      using ptr_t   = std::conditional_t<std::is_const_v<V>, value_t const *, value_t *>;
+      auto v_ptrs   = nda::vector<ptr_t, heap<vec_adr_spc>>(v.size());
+      std::transform(v.begin(), v.end(), v_ptrs.begin(), [&to_mat](auto &z) { return to_mat(z).data(); });
+      return v_ptrs;
+    };
+    auto a_ptrs = get_ptrs(va);
+    auto x_ptrs = get_ptrs(vx);
+    auto y_ptrs = get_ptrs(vy);
+
+    // gather parameters for gemv call
+    static constexpr bool conj_A = is_conj_array_expr<A>;
+    char op_a                    = get_op<conj_A, /* transpose = */ !has_F_layout<mat_type>>;
+    auto [m, n]                  = a0.shape();
+    if constexpr (has_C_layout<mat_type>) std::swap(m, n);
+    int incx = vx[0].indexmap().strides()[0];
+    int incy = vy[0].indexmap().strides()[0];
+
+    if constexpr (mem::have_device_compatible_addr_space<mat_type, X, Y>) {
+#if defined(NDA_HAVE_DEVICE)
+      device::gemv_batch(op_a, m, n, alpha, a_ptrs.data(), get_ld(a0), x_ptrs.data(), incx, beta, y_ptrs.data(), incy, batch_count);
+#else
+      compile_error_no_gpu();
+#endif
+    } else {
+      f77::gemv_batch(op_a, m, n, alpha, a_ptrs.data(), get_ld(a0), x_ptrs.data(), incx, beta, y_ptrs.data(), incy, batch_count);
+    }
+  }
+
+  /**
+   * @brief Implements a strided batched version of nda::blas::gemv taking 3-dimensional and 2-dimensional arrays as
+   * arguments.
+   *
+   * @details This function is similar to nda::blas::gemv_batch except that it takes a 3-dimensional array of matrices
+   * and 2-dimensional arrays of vectors as arguments. It calculates
+   * \f[
+   *   \mathbf{y}_i \leftarrow \alpha \mathbf{A}_i \mathbf{x}_i + \beta \mathbf{y}_i \;,
+   * \f]
+   * where \f$ \mathbf{A}_i \f$ = `a(i, _, _)`, \f$ \mathbf{x}_i \f$ = `x(i, _)` and \f$ \mathbf{y}_i \f$ = `y(i, _)`.
+   *
+   * The matrices `a(i, _, _)` are required to have unit stride in one of their dimensions, while the vectors can have
+   * arbitrary strides.
+   *
+   * With MKL (>= 2021.1), it calls `?gemv_batch_strided`. Otherwise, the `gemv` operations are distributed over the
+   * OpenMP threads while the BLAS backend runs single-threaded (see nda::blas::scoped_num_threads).
+   *
+   * @tparam A nda::ArrayOfRank<3> type.
+   * @tparam X nda::MemoryArrayOfRank<2> type.
+   * @tparam Y nda::MemoryArrayOfRank<2> type.
+   * @param alpha Input scalar.
+   * @param a 3-dimensional input array.
+   * @param x 2-dimensional input array.
+   * @param beta Input scalar.
+   * @param y 2-dimensional input/output array.
+   */
+  template <ArrayOfRank<3> A, MemoryArrayOfRank<2> X, MemoryArrayOfRank<2> Y>
+    requires((MemoryArrayOfRank<A, 3> or (is_conj_array_expr<A>)) and have_same_value_type_v<A, X, Y> and is_blas_lapack_v<get_value_t<A>>)
+  void gemv_batch_strided(get_value_t<A> alpha, A const &a, X const &x, get_value_t<A> beta, Y &&y) { // NOLINT (temporary views are allowed here)
+    // check number of matrices
+    EXPECTS(a.shape()[0] == x.extent(0) and a.shape()[0] == y.extent(0));
+    if (a.shape()[0] == 0) return;
+
+    // get underlying array in case it is given as a lazy expression
+    auto to_arr = []<typename Z>(Z &z) -> auto & {
+      if constexpr (is_conj_array_expr<Z>)
+        return std::get<0>(z.a);
+      else
+        return z;
+    };
+    auto &arr_a = to_arr(a);
+
+    // compile-time check
+    using arr_a_type = decltype(arr_a);
+    static_assert(mem::have_compatible_addr_space<arr_a_type, X, Y>, "Error in nda::blas::gemv_batch_strided: Incompatible memory address spaces");
+
+    // runtime checks
+    auto _  = nda::range::all;
+    auto a0 = arr_a(0, _, _);
+    EXPECTS(a0.extent(1) == x.extent(1));
+    EXPECTS(a0.extent(0) == y.extent(1));
+    EXPECTS(a0.indexmap().min_stride() == 1);
+
+    // gather parameters for gemv call
+    using mat_type               = decltype(a0);
+    static constexpr bool conj_A = is_conj_array_expr<A>;
+    char op_a                    = get_op<conj_A, /* transpose = */ !has_F_layout<mat_type>>;
+    auto [m, n]                  = a0.shape();
+    if constexpr (has_C_layout<mat_type>) std::swap(m, n);
+    auto [stride_x, incx] = x.indexmap().strides();
+    auto [stride_y, incy] = y.indexmap().strides();
+
+    if constexpr (mem::have_device_compatible_addr_space<arr_a_type, X, Y>) {
+#if defined(NDA_HAVE_DEVICE)
+      device::gemv_batch_strided(op_a, m, n, alpha, arr_a.data(), get_ld(a0), arr_a.strides()[0], x.data(), incx, stride_x, beta, y.data(), incy,
+                                 stride_y, arr_a.extent(0));
+#else
+      compile_error_no_gpu();
+#endif
+    } else {
+      f77::gemv_batch_strided(op_a, m, n, alpha, arr_a.data(), get_ld(a0), arr_a.strides()[0], x.data(), incx, stride_x, beta, y.data(), incy,
+                              stride_y, arr_a.extent(0));
+    }
+  }
+
+  /** @} */
+
+} // namespace nda::blas
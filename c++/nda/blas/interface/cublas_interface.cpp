@@ -28,6 +28,8 @@
 #include "magma_v2.h"
 #endif
 
+#include <algorithm>
+
 namespace nda::blas::device {
 
   // Local function to get unique CuBlas handle.
@@ -152,6 +154,16 @@ namespace nda::blas::device {
     CUBLAS_CHECK(cublasZaxpy, N, cucplx(&alpha), cucplx(x), incx, cucplx(Y), incy);
   }
 
+  // cuBLAS does not provide axpby
+  void axpby(int N, double alpha, const double *x, int incx, double beta, double *Y, int incy) {
+    scal(N, beta, Y, incy);
+    axpy(N, alpha, x, incx, Y, incy);
+  }
+  void axpby(int N, dcomplex alpha, const dcomplex *x, int incx, dcomplex beta, dcomplex *Y, int incy) {
+    scal(N, beta, Y, incy);
+    axpy(N, alpha, x, incx, Y, incy);
+  }
+
   void copy(int N, const double *x, int incx, double *Y, int incy) { cublasDcopy(get_handle(), N, x, incx, Y, incy); }
   void copy(int N, const dcomplex *x, int incx, dcomplex *Y, int incy) { CUBLAS_CHECK(cublasZcopy, N, cucplx(x), incx, cucplx(Y), incy); }
 
@@ -171,6 +183,22 @@ namespace nda::blas::device {
     return {res.x, res.y};
   }
 
+  // batched dot products are gemv calls with a 1-by-M matrix (stored with leading dimension incx)
+  void dot_batch_strided(int M, const double *x, int incx, int stridex, const double *Y, int incy, int stridey, double *res, int incres,
+                         int batch_count) {
+    gemv_batch_strided('N', 1, M, 1.0, x, incx, stridex, Y, incy, stridey, 0.0, res, 1, incres, batch_count);
+  }
+  void dot_batch_strided(int M, const dcomplex *x, int incx, int stridex, const dcomplex *Y, int incy, int stridey, dcomplex *res, int incres,
+                         int batch_count) {
+    gemv_batch_strided('N', 1, M, 1.0, x, incx, stridex, Y, incy, stridey, 0.0, res, 1, incres, batch_count);
+  }
+  void dotc_batch_strided(int M, const dcomplex *x, int incx, int stridex, const dcomplex *Y, int incy, int stridey, dcomplex *res, int incres,
+                          int batch_count) {
+    // conjugation requires the transpose, i.e. an M-by-1 matrix
+    if (incx != 1) NDA_RUNTIME_ERROR << "Error in nda::blas::device::dotc_batch_strided: Only unit increments are supported for x";
+    gemv_batch_strided('C', M, 1, 1.0, x, std::max(M, 1), stridex, Y, incy, stridey, 0.0, res, 1, incres, batch_count);
+  }
+
   void gemv(char op, int M, int N, double alpha, const double *A, int LDA, const double *x, int incx, double beta, double *Y, int incy) {
     CUBLAS_CHECK(cublasDgemv, get_cublas_op(op), M, N, &alpha, A, LDA, x, incx, &beta, Y, incy);
   }
@@ -178,6 +206,27 @@ namespace nda::blas::device {
     CUBLAS_CHECK(cublasZgemv, get_cublas_op(op), M, N, cucplx(&alpha), cucplx(A), LDA, cucplx(x), incx, cucplx(&beta), cucplx(Y), incy);
   }
 
+  void gemv_batch(char op, int M, int N, double alpha, const double **A, int LDA, const double **x, int incx, double beta, double **Y, int incy,
+                  int batch_count) {
+    CUBLAS_CHECK(cublasDgemvBatched, get_cublas_op(op), M, N, &alpha, A, LDA, x, incx, &beta, Y, incy, batch_count);
+  }
+  void gemv_batch(char op, int M, int N, dcomplex alpha, const dcomplex **A, int LDA, const dcomplex **x, int incx, dcomplex beta, dcomplex **Y,
+                  int incy, int batch_count) {
+    CUBLAS_CHECK(cublasZgemvBatched, get_cublas_op(op), M, N, cucplx(&alpha), cucplx(A), LDA, cucplx(x), incx, cucplx(&beta), cucplx(Y), incy,
+                 batch_count);
+  }
+
+  void gemv_batch_strided(char op, int M, int N, double alpha, const double *A, int LDA, int strideA, const double *x, int incx, int stridex,
+                          double beta, double *Y, int incy, int stridey, int batch_count) {
+    CUBLAS_CHECK(cublasDgemvStridedBatched, get_cublas_op(op), M, N, &alpha, A, LDA, strideA, x, incx, stridex, &beta, Y, incy, stridey,
+                 batch_count);
+  }
+  void gemv_batch_strided(char op, int M, int N, dcomplex alpha, const dcomplex *A, int LDA, int strideA, const dcomplex *x, int incx, int stridex,
+                          dcomplex beta, dcomplex *Y, int incy, int stridey, int batch_count) {
+    CUBLAS_CHECK(cublasZgemvStridedBatched, get_cublas_op(op), M, N, cucplx(&alpha), cucplx(A), LDA, strideA, cucplx(x), incx, stridex,
+                 cucplx(&beta), cucplx(Y), incy, stridey, batch_count);
+  }
+
   void ger(int M, int N, double alpha, const double *x, int incx, const double *Y, int incy, double *A, int LDA) {
     CUBLAS_CHECK(cublasDger, M, N, &alpha, x, incx, Y, incy, A, LDA);
   }
@@ -185,6 +234,21 @@ namespace nda::blas::device {
     CUBLAS_CHECK(cublasZgeru, M, N, cucplx(&alpha), cucplx(x), incx, cucplx(Y), incy, cucplx(A), LDA);
   }
 
+  void hemm(char side, char uplo, int M, int N, dcomplex alpha, const dcomplex *A, int LDA, const dcomplex *B, int LDB, dcomplex beta, dcomplex *C,
+            int LDC) {
+    CUBLAS_CHECK(cublasZhemm, get_cublas_side(side), get_cublas_fill(uplo), M, N, cucplx(&alpha), cucplx(A), LDA, cucplx(B), LDB, cucplx(&beta),
+                 cucplx(C), LDC);
+  }
+
+  void her2k(char uplo, char op, int N, int K, dcomplex alpha, const dcomplex *A, int LDA, const dcomplex *B, int LDB, double beta, dcomplex *C,
+             int LDC) {
+    CUBLAS_CHECK(cublasZher2k, get_cublas_fill(uplo), get_cublas_op(op), N, K, cucplx(&alpha), cucplx(A), LDA, cucplx(B), LDB, &beta, cucplx(C), LDC);
+  }
+
+  void herk(char uplo, char op, int N, int K, double alpha, const dcomplex *A, int LDA, double beta, dcomplex *C, int LDC) {
+    CUBLAS_CHECK(cublasZherk, get_cublas_fill(uplo), get_cublas_op(op), N, K, &alpha, cucplx(A), LDA, &beta, cucplx(C), LDC);
+  }
+
   void scal(int M, double alpha, double *x, int incx) { CUBLAS_CHECK(cublasDscal, M, &alpha, x, incx); }
   void scal(int M, dcomplex alpha, dcomplex *x, int incx) { CUBLAS_CHECK(cublasZscal, M, cucplx(&alpha), cucplx(x), incx); }
 
@@ -193,4 +257,47 @@ namespace nda::blas::device {
     CUBLAS_CHECK(cublasZswap, N, cucplx(x), incx, cucplx(Y), incy);
   }
 
+  void symm(char side, char uplo, int M, int N, double alpha, const double *A, int LDA, const double *B, int LDB, double beta, double *C, int LDC) {
+    CUBLAS_CHECK(cublasDsymm, get_cublas_side(side), get_cublas_fill(uplo), M, N, &alpha, A, LDA, B, LDB, &beta, C, LDC);
+  }
+  void symm(char side, char uplo, int M, int N, dcomplex alpha, const dcomplex *A, int LDA, const dcomplex *B, int LDB, dcomplex beta, dcomplex *C,
+            int LDC) {
+    CUBLAS_CHECK(cublasZsymm, get_cublas_side(side), get_cublas_fill(uplo), M, N, cucplx(&alpha), cucplx(A), LDA, cucplx(B), LDB, cucplx(&beta),
+                 cucplx(C), LDC);
+  }
+
+  void syr2k(char uplo, char op, int N, int K, double alpha, const double *A, int LDA, const double *B, int LDB, double beta, double *C, int LDC) {
+    CUBLAS_CHECK(cublasDsyr2k, get_cublas_fill(uplo), get_cublas_op(op), N, K, &alpha, A, LDA, B, LDB, &beta, C, LDC);
+  }
+  void syr2k(char uplo, char op, int N, int K, dcomplex alpha, const dcomplex *A, int LDA, const dcomplex *B, int LDB, dcomplex beta, dcomplex *C,
+             int LDC) {
+    CUBLAS_CHECK(cublasZsyr2k, get_cublas_fill(uplo), get_cublas_op(op), N, K, cucplx(&alpha), cucplx(A), LDA, cucplx(B), LDB, cucplx(&beta),
+                 cucplx(C), LDC);
+  }
+
+  void syrk(char uplo, char op, int N, int K, double alpha, const double *A, int LDA, double beta, double *C, int LDC) {
+    CUBLAS_CHECK(cublasDsyrk, get_cublas_fill(uplo), get_cublas_op(op), N, K, &alpha, A, LDA, &beta, C, LDC);
+  }
+  void syrk(char uplo, char op, int N, int K, dcomplex alpha, const dcomplex *A, int LDA, dcomplex beta, dcomplex *C, int LDC) {
+    CUBLAS_CHECK(cublasZsyrk, get_cublas_fill(uplo), get_cublas_op(op), N, K, cucplx(&alpha), cucplx(A), LDA, cucplx(&beta), cucplx(C), LDC);
+  }
+
+  // cuBLAS trmm is out-of-place, passing B as output makes it in-place
+  void trmm(char side, char uplo, char op, char diag, int M, int N, double alpha, const double *A, int LDA, double *B, int LDB) {
+    CUBLAS_CHECK(cublasDtrmm, get_cublas_side(side), get_cublas_fill(uplo), get_cublas_op(op), get_cublas_diag(diag), M, N, &alpha, A, LDA, B, LDB,
+                 B, LDB);
+  }
+  void trmm(char side, char uplo, char op, char diag, int M, int N, dcomplex alpha, const dcomplex *A, int LDA, dcomplex *B, int LDB) {
+    CUBLAS_CHECK(cublasZtrmm, get_cublas_side(side), get_cublas_fill(uplo), get_cublas_op(op), get_cublas_diag(diag), M, N, cucplx(&alpha),
+                 cucplx(A), LDA, cucplx(B), LDB, cucplx(B), LDB);
+  }
+
+  void trsm(char side, char uplo, char op, char diag, int M, int N, double alpha, const double *A, int LDA, double *B, int LDB) {
+    CUBLAS_CHECK(cublasDtrsm, get_cublas_side(side), get_cublas_fill(uplo), get_cublas_op(op), get_cublas_diag(diag), M, N, &alpha, A, LDA, B, LDB);
+  }
+  void trsm(char side, char uplo, char op, char diag, int M, int N, dcomplex alpha, const dcomplex *A, int LDA, dcomplex *B, int LDB) {
+    CUBLAS_CHECK(cublasZtrsm, get_cublas_side(side), get_cublas_fill(uplo), get_cublas_op(op), get_cublas_diag(diag), M, N, cucplx(&alpha),
+                 cucplx(A), LDA, cucplx(B), LDB);
+  }
+
 } // namespace nda::blas::device
@@ -32,6 +32,9 @@ namespace nda::blas::device {
   void axpy(int N, double alpha, const double *x, int incx, double *Y, int incy);
   void axpy(int N, dcomplex alpha, const dcomplex *x, int incx, dcomplex *Y, int incy);
 
+  void axpby(int N, double alpha, const double *x, int incx, double beta, double *Y, int incy);
+  void axpby(int N, dcomplex alpha, const dcomplex *x, int incx, dcomplex beta, dcomplex *Y, int incy);
+
   void copy(int N, const double *x, int incx, double *Y, int incy);
   void copy(int N, const dcomplex *x, int incx, dcomplex *Y, int incy);
 
@@ -39,6 +42,13 @@ namespace nda::blas::device {
   dcomplex dot(int M, const dcomplex *x, int incx, const dcomplex *Y, int incy);
   dcomplex dotc(int M, const dcomplex *x, int incx, const dcomplex *Y, int incy);
 
+  void dot_batch_strided(int M, const double *x, int incx, int stridex, const double *Y, int incy, int stridey, double *res, int incres,
+                         int batch_count);
+  void dot_batch_strided(int M, const dcomplex *x, int incx, int stridex, const dcomplex *Y, int incy, int stridey, dcomplex *res, int incres,
+                         int batch_count);
+  void dotc_batch_strided(int M, const dcomplex *x, int incx, int stridex, const dcomplex *Y, int incy, int stridey, dcomplex *res, int incres,
+                          int batch_count);
+
   void gemm(char op_a, char op_b, int M, int N, int K, double alpha, const double *A, int LDA, const double *B, int LDB, double beta, double *C,
             int LDC);
   void gemm(char op_a, char op_b, int M, int N, int K, dcomplex alpha, const dcomplex *A, int LDA, const dcomplex *B, int LDB, dcomplex beta,
@@ -72,13 +82,48 @@ namespace nda::blas::device {
   void gemv(char op, int M, int N, double alpha, const double *A, int LDA, const double *x, int incx, double beta, double *Y, int incy);
   void gemv(char op, int M, int N, dcomplex alpha, const dcomplex *A, int LDA, const dcomplex *x, int incx, dcomplex beta, dcomplex *Y, int incy);
 
+  void gemv_batch(char op, int M, int N, double alpha, const double **A, int LDA, const double **x, int incx, double beta, double **Y, int incy,
+                  int batch_count);
+  void gemv_batch(char op, int M, int N, dcomplex alpha, const dcomplex **A, int LDA, const dcomplex **x, int incx, dcomplex beta, dcomplex **Y,
+                  int incy, int batch_count);
+
+  void gemv_batch_strided(char op, int M, int N, double alpha, const double *A, int LDA, int strideA, const double *x, int incx, int stridex,
+                          double beta, double *Y, int incy, int stridey, int batch_count);
+  void gemv_batch_strided(char op, int M, int N, dcomplex alpha, const dcomplex *A, int LDA, int strideA, const dcomplex *x, int incx, int stridex,
+                          dcomplex beta, dcomplex *Y, int incy, int stridey, int batch_count);
+
   void ger(int M, int N, double alpha, const double *x, int incx, const double *Y, int incy, double *A, int LDA);
   void ger(int M, int N, dcomplex alpha, const dcomplex *x, int incx, const dcomplex *Y, int incy, dcomplex *A, int LDA);
 
+  void hemm(char side, char uplo, int M, int N, dcomplex alpha, const dcomplex *A, int LDA, const dcomplex *B, int LDB, dcomplex beta, dcomplex *C,
+            int LDC);
+
+  void her2k(char uplo, char op, int N, int K, dcomplex alpha, const dcomplex *A, int LDA, const dcomplex *B, int LDB, double beta, dcomplex *C,
+             int LDC);
+
+  void herk(char uplo, char op, int N, int K, double alpha, const dcomplex *A, int LDA, double beta, dcomplex *C, int LDC);
+
   void scal(int M, double alpha, double *x, int incx);
   void scal(int M, dcomplex alpha, dcomplex *x, int incx);
 
   void swap(int N, double *x, int incx, double *Y, int incy);     // NOLINT (this is a BLAS swap)
   void swap(int N, dcomplex *x, int incx, dcomplex *Y, int incy); // NOLINT (this is a BLAS swap)
 
+  void symm(char side, char uplo, int M, int N, double alpha, const double *A, int LDA, const double *B, int LDB, double beta, double *C, int LDC);
+  void symm(char side, char uplo, int M, int N, dcomplex alpha, const dcomplex *A, int LDA, const dcomplex *B, int LDB, dcomplex beta, dcomplex *C,
+            int LDC);
+
+  void syr2k(char uplo, char op, int N, int K, double alpha, const double *A, int LDA, const double *B, int LDB, double beta, double *C, int LDC);
+  void syr2k(char uplo, char op, int N, int K, dcomplex alpha, const dcomplex *A, int LDA, const dcomplex *B, int LDB, dcomplex beta, dcomplex *C,
+             int LDC);
+
+  void syrk(char uplo, char op, int N, int K, double alpha, const double *A, int LDA, double beta, double *C, int LDC);
+  void syrk(char uplo, char op, int N, int K, dcomplex alpha, const dcomplex *A, int LDA, dcomplex beta, dcomplex *C, int LDC);
+
+  void trmm(char side, char uplo, char op, char diag, int M, int N, double alpha, const double *A, int LDA, double *B, int LDB);
+  void trmm(char side, char uplo, char op, char diag, int M, int N, dcomplex alpha, const dcomplex *A, int LDA, dcomplex *B, int LDB);
+
+  void trsm(char side, char uplo, char op, char diag, int M, int N, double alpha, const double *A, int LDA, double *B, int LDB);
+  void trsm(char side, char uplo, char op, char diag, int M, int N, dcomplex alpha, const dcomplex *A, int LDA, dcomplex *B, int LDB);
+
 } // namespace nda::blas::device
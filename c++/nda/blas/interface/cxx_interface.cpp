@@ -22,9 +22,13 @@
 // Extracted from Reference Lapack (https://github.com/Reference-LAPACK):
 #include "./cblas_f77.h"
 #include "./cxx_interface.hpp"
+#include "../threads.hpp"
 #include "../tools.hpp"
+#include "../../macros.hpp"
 
+#include <algorithm>
 #include <cstddef>
+#include <cstdint>
 
 #ifdef NDA_USE_MKL
 #include "../../basic_array.hpp"
@@ -53,8 +57,51 @@ namespace {
     double imag;
   };
 
+  // run f(0), ..., f(batch_count - 1) in an OpenMP parallel loop with single-threaded BLAS calls
+  template <typename F> void parallel_batch(int batch_count, F f) {
+    nda::blas::detail::parallel_batch(batch_count, [] { return 0; }, [&f](int, long i) { f(static_cast<int>(i)); });
+  }
+
 } // namespace
 
+#if !defined(NDA_USE_MKL) && defined(__GNUC__) && defined(__ELF__)
+// OpenBLAS and BLIS thread control routines (weak symbols are null if the backend is not linked)
+extern "C" {
+int openblas_get_num_threads() __attribute__((weak));
+void openblas_set_num_threads(int) __attribute__((weak));
+std::int64_t bli_thread_get_num_threads() __attribute__((weak));
+void bli_thread_set_num_threads(std::int64_t) __attribute__((weak));
+}
+#endif
+
+namespace nda::blas {
+
+  int get_num_threads() {
+#ifdef NDA_USE_MKL
+    return mkl_get_max_threads();
+#elif defined(__GNUC__) && defined(__ELF__)
+    if (openblas_get_num_threads != nullptr) return openblas_get_num_threads();
+    if (bli_thread_get_num_threads != nullptr) return static_cast<int>(bli_thread_get_num_threads());
+    return 1;
+#else
+    return 1;
+#endif
+  }
+
+  void set_num_threads(int n) {
+    EXPECTS(n > 0);
+#ifdef NDA_USE_MKL
+    mkl_set_num_threads(n);
+#elif defined(__GNUC__) && defined(__ELF__)
+    if (openblas_set_num_threads != nullptr)
+      openblas_set_num_threads(n);
+    else if (bli_thread_set_num_threads != nullptr)
+      bli_thread_set_num_threads(n);
+#endif
+  }
+
+} // namespace nda::blas
+
 // manually define dot routines since cblas_f77.h uses "_sub" to wrap the Fortran routines
 #define F77_ddot F77_GLOBAL(ddot, DDOT)
 #define F77_zdotu F77_GLOBAL(zdotu, DDOT)
@@ -77,6 +124,23 @@ namespace nda::blas::f77 {
     F77_zaxpy(&N, blacplx(&alpha), blacplx(x), &incx, blacplx(Y), &incy);
   }
 
+  void axpby(int N, double alpha, const double *x, int incx, double beta, double *Y, int incy) {
+#ifdef NDA_USE_MKL
+    daxpby(&N, &alpha, x, &incx, &beta, Y, &incy);
+#else // Fallback to scal + axpy
+    scal(N, beta, Y, incy);
+    axpy(N, alpha, x, incx, Y, incy);
+#endif
+  }
+  void axpby(int N, dcomplex alpha, const dcomplex *x, int incx, dcomplex beta, dcomplex *Y, int incy) {
+#ifdef NDA_USE_MKL
+    zaxpby(&N, mklcplx(&alpha), mklcplx(x), &incx, mklcplx(&beta), mklcplx(Y), &incy);
+#else
+    scal(N, beta, Y, incy);
+    axpy(N, alpha, x, incx, Y, incy);
+#endif
+  }
+
   // No Const In Wrapping!
   void copy(int N, const double *x, int incx, double *Y, int incy) { F77_dcopy(&N, x, &incx, Y, &incy); }
   void copy(int N, const dcomplex *x, int incx, dcomplex *Y, int incy) { F77_zcopy(&N, blacplx(x), &incx, blacplx(Y), &incy); }
@@ -101,6 +165,50 @@ namespace nda::blas::f77 {
     return dcomplex{result.real, result.imag};
   }
 
+  // with MKL, batched dot products are gemv calls with a 1-by-M matrix (stored with leading dimension incx)
+  void dot_batch_strided(int M, const double *x, int incx, int stridex, const double *Y, int incy, int stridey, double *res, int incres,
+                         int batch_count) {
+#if defined(NDA_USE_MKL) && INTEL_MKL_VERSION >= 20210000
+    gemv_batch_strided('N', 1, M, 1.0, x, incx, stridex, Y, incy, stridey, 0.0, res, 1, incres, batch_count);
+#else // Fallback to parallel loop
+    parallel_batch(batch_count, [&](int i) {
+      res[static_cast<ptrdiff_t>(i) * incres] = dot(M, x + static_cast<ptrdiff_t>(i) * stridex, incx, Y + static_cast<ptrdiff_t>(i) * stridey, incy);
+    });
+#endif
+  }
+  void dot_batch_strided(int M, const dcomplex *x, int incx, int stridex, const dcomplex *Y, int incy, int stridey, dcomplex *res, int incres,
+                         int batch_count) {
+#if defined(NDA_USE_MKL) && INTEL_MKL_VERSION >= 20210000
+    gemv_batch_strided('N', 1, M, 1.0, x, incx, stridex, Y, incy, stridey, 0.0, res, 1, incres, batch_count);
+#else
+    parallel_batch(batch_count, [&](int i) {
+      res[static_cast<ptrdiff_t>(i) * incres] = dot(M, x + static_cast<ptrdiff_t>(i) * stridex, incx, Y + static_cast<ptrdiff_t>(i) * stridey, incy);
+    });
+#endif
+  }
+  void dotc_batch_strided(int M, const dcomplex *x, int incx, int stridex, const dcomplex *Y, int incy, int stridey, dcomplex *res, int incres,
+                          int batch_count) {
+#if defined(NDA_USE_MKL) && INTEL_MKL_VERSION >= 20210000
+    // conjugation requires the transpose, i.e. an M-by-1 matrix
+    if (incx == 1) {
+      gemv_batch_strided('C', M, 1, 1.0, x, std::max(M, 1), stridex, Y, incy, stridey, 0.0, res, 1, incres, batch_count);
+      return;
+    }
+#endif
+    parallel_batch(batch_count, [&](int i) {
+      res[static_cast<ptrdiff_t>(i) * incres] = dotc(M, x + static_cast<ptrdiff_t>(i) * stridex, incx, Y + static_cast<ptrdiff_t>(i) * stridey, incy);
+    });
+  }
+
+  void gbmv(char op, int M, int N, int KL, int KU, double alpha, const double *A, int LDA, const double *x, int incx, double beta, double *Y,
+            int incy) {
+    F77_dgbmv(&op, &M, &N, &KL, &KU, &alpha, A, &LDA, x, &incx, &beta, Y, &incy);
+  }
+  void gbmv(char op, int M, int N, int KL, int KU, dcomplex alpha, const dcomplex *A, int LDA, const dcomplex *x, int incx, dcomplex beta,
+            dcomplex *Y, int incy) {
+    F77_zgbmv(&op, &M, &N, &KL, &KU, blacplx(&alpha), blacplx(A), &LDA, blacplx(x), &incx, blacplx(&beta), blacplx(Y), &incy);
+  }
+
   void gemm(char op_a, char op_b, int M, int N, int K, double alpha, const double *A, int LDA, const double *B, int LDB, double beta, double *C,
             int LDC) {
     F77_dgemm(&op_a, &op_b, &M, &N, &K, &alpha, A, &LDA, B, &LDB, &beta, C, &LDC);
@@ -183,6 +291,49 @@ namespace nda::blas::f77 {
     F77_zgemv(&op, &M, &N, blacplx(&alpha), blacplx(A), &LDA, blacplx(x), &incx, blacplx(&beta), blacplx(Y), &incy);
   }
 
+  void gemv_batch(char op, int M, int N, double alpha, const double **A, int LDA, const double **x, int incx, double beta, double **Y, int incy,
+                  int batch_count) {
+#if defined(NDA_USE_MKL) && INTEL_MKL_VERSION >= 20210000
+    const int group_count = 1;
+    dgemv_batch(&op, &M, &N, &alpha, A, &LDA, x, &incx, &beta, Y, &incy, &group_count, &batch_count);
+#else // Fallback to parallel loop
+    parallel_batch(batch_count, [&](int i) { gemv(op, M, N, alpha, A[i], LDA, x[i], incx, beta, Y[i], incy); });
+#endif
+  }
+  void gemv_batch(char op, int M, int N, dcomplex alpha, const dcomplex **A, int LDA, const dcomplex **x, int incx, dcomplex beta, dcomplex **Y,
+                  int incy, int batch_count) {
+#if defined(NDA_USE_MKL) && INTEL_MKL_VERSION >= 20210000
+    const int group_count = 1;
+    zgemv_batch(&op, &M, &N, mklcplx(&alpha), mklcplx(A), &LDA, mklcplx(x), &incx, mklcplx(&beta), mklcplx(Y), &incy, &group_count, &batch_count);
+#else
+    parallel_batch(batch_count, [&](int i) { gemv(op, M, N, alpha, A[i], LDA, x[i], incx, beta, Y[i], incy); });
+#endif
+  }
+
+  void gemv_batch_strided(char op, int M, int N, double alpha, const double *A, int LDA, int strideA, const double *x, int incx, int stridex,
+                          double beta, double *Y, int incy, int stridey, int batch_count) {
+#if defined(NDA_USE_MKL) && INTEL_MKL_VERSION >= 20210000
+    dgemv_batch_strided(&op, &M, &N, &alpha, A, &LDA, &strideA, x, &incx, &stridex, &beta, Y, &incy, &stridey, &batch_count);
+#else // Fallback to parallel loop
+    parallel_batch(batch_count, [&](int i) {
+      gemv(op, M, N, alpha, A + static_cast<ptrdiff_t>(i) * strideA, LDA, x + static_cast<ptrdiff_t>(i) * stridex, incx, beta,
+           Y + static_cast<ptrdiff_t>(i) * stridey, incy);
+    });
+#endif
+  }
+  void gemv_batch_strided(char op, int M, int N, dcomplex alpha, const dcomplex *A, int LDA, int strideA, const dcomplex *x, int incx, int stridex,
+                          dcomplex beta, dcomplex *Y, int incy, int stridey, int batch_count) {
+#if defined(NDA_USE_MKL) && INTEL_MKL_VERSION >= 20210000
+    zgemv_batch_strided(&op, &M, &N, mklcplx(&alpha), mklcplx(A), &LDA, &strideA, mklcplx(x), &incx, &stridex, mklcplx(&beta), mklcplx(Y), &incy,
+                        &stridey, &batch_count);
+#else
+    parallel_batch(batch_count, [&](int i) {
+      gemv(op, M, N, alpha, A + static_cast<ptrdiff_t>(i) * strideA, LDA, x + static_cast<ptrdiff_t>(i) * stridex, incx, beta,
+           Y + static_cast<ptrdiff_t>(i) * stridey, incy);
+    });
+#endif
+  }
+
   void ger(int M, int N, double alpha, const double *x, int incx, const double *Y, int incy, double *A, int LDA) {
     F77_dger(&M, &N, &alpha, x, &incx, Y, &incy, A, &LDA);
   }
@@ -190,12 +341,75 @@ namespace nda::blas::f77 {
     F77_zgeru(&M, &N, blacplx(&alpha), blacplx(x), &incx, blacplx(Y), &incy, blacplx(A), &LDA);
   }
 
+  void hemm(char side, char uplo, int M, int N, dcomplex alpha, const dcomplex *A, int LDA, const dcomplex *B, int LDB, dcomplex beta, dcomplex *C,
+            int LDC) {
+    F77_zhemm(&side, &uplo, &M, &N, blacplx(&alpha), blacplx(A), &LDA, blacplx(B), &LDB, blacplx(&beta), blacplx(C), &LDC);
+  }
+
+  void her2k(char uplo, char op, int N, int K, dcomplex alpha, const dcomplex *A, int LDA, const dcomplex *B, int LDB, double beta, dcomplex *C,
+             int LDC) {
+    F77_zher2k(&uplo, &op, &N, &K, blacplx(&alpha), blacplx(A), &LDA, blacplx(B), &LDB, &beta, blacplx(C), &LDC);
+  }
+
+  void herk(char uplo, char op, int N, int K, double alpha, const dcomplex *A, int LDA, double beta, dcomplex *C, int LDC) {
+    F77_zherk(&uplo, &op, &N, &K, &alpha, blacplx(A), &LDA, &beta, blacplx(C), &LDC);
+  }
+
+  void hpmv(char uplo, int N, dcomplex alpha, const dcomplex *AP, const dcomplex *x, int incx, dcomplex beta, dcomplex *Y, int incy) {
+    F77_zhpmv(&uplo, &N, blacplx(&alpha), blacplx(AP), blacplx(x), &incx, blacplx(&beta), blacplx(Y), &incy);
+  }
+
+  void hpr(char uplo, int N, double alpha, const dcomplex *x, int incx, dcomplex *AP) { F77_zhpr(&uplo, &N, &alpha, blacplx(x), &incx, blacplx(AP)); }
+
   void scal(int M, double alpha, double *x, int incx) { F77_dscal(&M, &alpha, x, &incx); }
   void scal(int M, dcomplex alpha, dcomplex *x, int incx) { F77_zscal(&M, blacplx(&alpha), blacplx(x), &incx); }
 
+  void spmv(char uplo, int N, double alpha, const double *AP, const double *x, int incx, double beta, double *Y, int incy) {
+    F77_dspmv(&uplo, &N, &alpha, AP, x, &incx, &beta, Y, &incy);
+  }
+
+  void spr(char uplo, int N, double alpha, const double *x, int incx, double *AP) { F77_dspr(&uplo, &N, &alpha, x, &incx, AP); }
+
   void swap(int N, double *x, int incx, double *Y, int incy) { F77_dswap(&N, x, &incx, Y, &incy); } // NOLINT (this is a BLAS swap)
   void swap(int N, dcomplex *x, int incx, dcomplex *Y, int incy) {                                  // NOLINT (this is a BLAS swap)
     F77_zswap(&N, blacplx(x), &incx, blacplx(Y), &incy);
   }
 
+  void symm(char side, char uplo, int M, int N, double alpha, const double *A, int LDA, const double *B, int LDB, double beta, double *C, int LDC) {
+    F77_dsymm(&side, &uplo, &M, &N, &alpha, A, &LDA, B, &LDB, &beta, C, &LDC);
+  }
+  void symm(char side, char uplo, int M, int N, dcomplex alpha, const dcomplex *A, int LDA, const dcomplex *B, int LDB, dcomplex beta, dcomplex *C,
+            int LDC) {
+    F77_zsymm(&side, &uplo, &M, &N, blacplx(&alpha), blacplx(A), &LDA, blacplx(B), &LDB, blacplx(&beta), blacplx(C), &LDC);
+  }
+
+  void syr2k(char uplo, char op, int N, int K, double alpha, const double *A, int LDA, const double *B, int LDB, double beta, double *C, int LDC) {
+    F77_dsyr2k(&uplo, &op, &N, &K, &alpha, A, &LDA, B, &LDB, &beta, C, &LDC);
+  }
+  void syr2k(char uplo, char op, int N, int K, dcomplex alpha, const dcomplex *A, int LDA, const dcomplex *B, int LDB, dcomplex beta, dcomplex *C,
+             int LDC) {
+    F77_zsyr2k(&uplo, &op, &N, &K, blacplx(&alpha), blacplx(A), &LDA, blacplx(B), &LDB, blacplx(&beta), blacplx(C), &LDC);
+  }
+
+  void syrk(char uplo, char op, int N, int K, double alpha, const double *A, int LDA, double beta, double *C, int LDC) {
+    F77_dsyrk(&uplo, &op, &N, &K, &alpha, A, &LDA, &beta, C, &LDC);
+  }
+  void syrk(char uplo, char op, int N, int K, dcomplex alpha, const dcomplex *A, int LDA, dcomplex beta, dcomplex *C, int LDC) {
+    F77_zsyrk(&uplo, &op, &N, &K, blacplx(&alpha), blacplx(A), &LDA, blacplx(&beta), blacplx(C), &LDC);
+  }
+
+  void trmm(char side, char uplo, char op, char diag, int M, int N, double alpha, const double *A, int LDA, double *B, int LDB) {
+    F77_dtrmm(&side, &uplo, &op, &diag, &M, &N, &alpha, A, &LDA, B, &LDB);
+  }
+  void trmm(char side, char uplo, char op, char diag, int M, int N, dcomplex alpha, const dcomplex *A, int LDA, dcomplex *B, int LDB) {
+    F77_ztrmm(&side, &uplo, &op, &diag, &M, &N, blacplx(&alpha), blacplx(A), &LDA, blacplx(B), &LDB);
+  }
+
+  void trsm(char side, char uplo, char op, char diag, int M, int N, double alpha, const double *A, int LDA, double *B, int LDB) {
+    F77_dtrsm(&side, &uplo, &op, &diag, &M, &N, &alpha, A, &LDA, B, &LDB);
+  }
+  void trsm(char side, char uplo, char op, char diag, int M, int N, dcomplex alpha, const dcomplex *A, int LDA, dcomplex *B, int LDB) {
+    F77_ztrsm(&side, &uplo, &op, &diag, &M, &N, blacplx(&alpha), blacplx(A), &LDA, blacplx(B), &LDB);
+  }
+
 } // namespace nda::blas::f77
@@ -0,0 +1,94 @@
+// Copyright (c) 2024 Simons Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file
+ * @brief Provides generic interfaces to the BLAS `spmv` and `hpmv` routines.
+ */
+
+#pragma once
+
+#include "./interface/cxx_interface.hpp"
+#include "./tools.hpp"
+#include "../concepts.hpp"
+#include "../macros.hpp"
+#include "../mem/address_space.hpp"
+#include "../traits.hpp"
+
+#include <utility>
+
+namespace nda::blas {
+
+  /**
+   * @addtogroup linalg_blas
+   * @{
+   */
+
+  /**
+   * @brief Interface to the BLAS `spmv` and `hpmv` routines.
+   *
+   * @details This function performs the matrix-vector operation
+   * \f[
+   *   \mathbf{y} \leftarrow \alpha \mathbf{A} \mathbf{x} + \beta \mathbf{y} \;,
+   * \f]
+   * where \f$ \mathbf{A} \f$ is a real symmetric or complex hermitian n-by-n matrix in packed storage, i.e. the upper
+   * (`uplo == 'U'`) or lower (`uplo == 'L'`) triangle of \f$ \mathbf{A} \f$ is stored column by column in a vector of
+   * size \f$ n(n+1)/2 \f$. For real value types, it calls `spmv`, for complex value types `hpmv`.
+   *
+   * @tparam AP nda::MemoryVector type.
+   * @tparam X nda::MemoryVector type.
+   * @tparam Y nda::MemoryVector type.
+   * @param alpha Input scalar.
+   * @param ap Input vector containing the packed matrix \f$ \mathbf{A} \f$ (unit stride).
+   * @param x Input vector of size n.
+   * @param beta Input scalar.
+   * @param y Input/Output vector of size n.
+   * @param uplo Triangular part of \f$ \mathbf{A} \f$ that is stored in `ap`.
+   */
+  template <MemoryVector AP, MemoryVector X, MemoryVector Y>
+    requires(have_same_value_type_v<AP, X, Y> and mem::on_host<AP, X, Y> and is_blas_lapack_v<get_value_t<AP>>)
+  void spmv(get_value_t<AP> alpha, AP const &ap, X const &x, get_value_t<AP> beta, Y &&y, // NOLINT (temporary views are allowed here)
+            char uplo = 'U') {
+    // runtime checks
+    EXPECTS(uplo == 'U' or uplo == 'L');
+    EXPECTS(x.size() == y.size());
+    EXPECTS(ap.size() == x.size() * (x.size() + 1) / 2);
+    EXPECTS(ap.indexmap().min_stride() == 1);
+
+    if (x.empty()) return;
+    if constexpr (is_complex_v<get_value_t<AP>>) {
+      f77::hpmv(uplo, x.size(), alpha, ap.data(), x.data(), x.indexmap().strides()[0], beta, y.data(), y.indexmap().strides()[0]);
+    } else {
+      f77::spmv(uplo, x.size(), alpha, ap.data(), x.data(), x.indexmap().strides()[0], beta, y.data(), y.indexmap().strides()[0]);
+    }
+  }
+
+  /**
+   * @brief Interface to the BLAS `hpmv` routine.
+   *
+   * @details Alias of nda::blas::spmv, which calls `hpmv` for complex value types.
+   *
+   * @tparam Args Types of the arguments.
+   * @param args Arguments forwarded to nda::blas::spmv.
+   */
+  template <typename... Args>
+  void hpmv(Args &&...args)
+    requires(requires { spmv(std::forward<Args>(args)...); })
+  {
+    spmv(std::forward<Args>(args)...);
+  }
+
+  /** @} */
+
+} // namespace nda::blas
@@ -0,0 +1,88 @@
+// Copyright (c) 2024 Simons Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file
+ * @brief Provides generic interfaces to the BLAS `spr` and `hpr` routines.
+ */
+
+#pragma once
+
+#include "./interface/cxx_interface.hpp"
+#include "./tools.hpp"
+#include "../concepts.hpp"
+#include "../macros.hpp"
+#include "../mem/address_space.hpp"
+#include "../traits.hpp"
+
+#include <utility>
+
+namespace nda::blas {
+
+  /**
+   * @addtogroup linalg_blas
+   * @{
+   */
+
+  /**
+   * @brief Interface to the BLAS `spr` and `hpr` routines.
+   *
+   * @details This function performs the rank 1 operation
+   * \f[
+   *   \mathbf{A} \leftarrow \alpha \mathbf{x} \mathbf{x}^H + \mathbf{A} \;,
+   * \f]
+   * where \f$ \alpha \f$ is a real scalar and \f$ \mathbf{A} \f$ is a real symmetric or complex hermitian n-by-n matrix
+   * in packed storage (see nda::blas::spmv). For real value types, it calls `spr`, for complex value types `hpr`.
+   *
+   * @tparam X nda::MemoryVector type.
+   * @tparam AP nda::MemoryVector type.
+   * @param alpha Input real scalar.
+   * @param x Input vector of size n.
+   * @param ap Input/Output vector containing the packed matrix \f$ \mathbf{A} \f$ (unit stride).
+   * @param uplo Triangular part of \f$ \mathbf{A} \f$ that is stored in `ap`.
+   */
+  template <MemoryVector X, MemoryVector AP>
+    requires(have_same_value_type_v<X, AP> and mem::on_host<X, AP> and is_blas_lapack_v<get_value_t<X>>)
+  void spr(double alpha, X const &x, AP &&ap, char uplo = 'U') { // NOLINT (temporary views are allowed here)
+    // runtime checks
+    EXPECTS(uplo == 'U' or uplo == 'L');
+    EXPECTS(ap.size() == x.size() * (x.size() + 1) / 2);
+    EXPECTS(ap.indexmap().min_stride() == 1);
+
+    if (x.empty()) return;
+    if constexpr (is_complex_v<get_value_t<X>>) {
+      f77::hpr(uplo, x.size(), alpha, x.data(), x.indexmap().strides()[0], ap.data());
+    } else {
+      f77::spr(uplo, x.size(), alpha, x.data(), x.indexmap().strides()[0], ap.data());
+    }
+  }
+
+  /**
+   * @brief Interface to the BLAS `hpr` routine.
+   *
+   * @details Alias of nda::blas::spr, which calls `hpr` for complex value types.
+   *
+   * @tparam Args Types of the arguments.
+   * @param args Arguments forwarded to nda::blas::spr.
+   */
+  template <typename... Args>
+  void hpr(Args &&...args)
+    requires(requires { spr(std::forward<Args>(args)...); })
+  {
+    spr(std::forward<Args>(args)...);
+  }
+
+  /** @} */
+
+} // namespace nda::blas
@@ -0,0 +1,172 @@
+// Copyright (c) 2024 Simons Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file
+ * @brief Provides generic interfaces to the BLAS `symm` and `hemm` routines.
+ */
+
+#pragma once
+
+#include "./interface/cxx_interface.hpp"
+#include "./tools.hpp"
+#include "../concepts.hpp"
+#include "../layout_transforms.hpp"
+#include "../macros.hpp"
+#include "../mem/address_space.hpp"
+#include "../traits.hpp"
+
+#ifndef NDA_HAVE_DEVICE
+#include "../device.hpp"
+#endif
+
+#include <utility>
+
+namespace nda::blas {
+
+  /**
+   * @addtogroup linalg_blas
+   * @{
+   */
+
+  /**
+   * @brief Interface to the BLAS `symm` routine.
+   *
+   * @details This function performs one of the matrix-matrix operations
+   * \f[
+   *   \mathbf{C} \leftarrow \alpha \mathbf{A} \mathbf{B} + \beta \mathbf{C} \quad \mathrm{or} \quad
+   *   \mathbf{C} \leftarrow \alpha \mathbf{B} \mathbf{A} + \beta \mathbf{C} \;,
+   * \f]
+   * depending on whether `side == 'L'` or `side == 'R'`. Here, \f$ \alpha \f$ and \f$ \beta \f$ are scalars,
+   * \f$ \mathbf{A} \f$ is a symmetric matrix and \f$ \mathbf{B} \f$, \f$ \mathbf{C} \f$ are m-by-n matrices.
+   *
+   * Only the upper (`uplo == 'U'`) or lower (`uplo == 'L'`) triangular part of \f$ \mathbf{A} \f$ is referenced.
+   * \f$ \mathbf{B} \f$ and \f$ \mathbf{C} \f$ are required to have the same memory layout.
+   *
+   * @tparam A nda::MemoryMatrix type.
+   * @tparam B nda::MemoryMatrix type.
+   * @tparam C nda::MemoryMatrix type.
+   * @param alpha Input scalar.
+   * @param a Input symmetric matrix of size m-by-m (`side == 'L'`) or n-by-n (`side == 'R'`).
+   * @param b Input matrix of size m-by-n.
+   * @param beta Input scalar.
+   * @param c Input/Output matrix of size m-by-n.
+   * @param side Side from which \f$ \mathbf{A} \f$ is multiplied.
+   * @param uplo Triangular part of \f$ \mathbf{A} \f$ that is referenced.
+   */
+  template <MemoryMatrix A, MemoryMatrix B, MemoryMatrix C>
+    requires(have_same_value_type_v<A, B, C> and is_blas_lapack_v<get_value_t<A>>)
+  void symm(get_value_t<A> alpha, A const &a, B const &b, get_value_t<A> beta, C &&c, char side = 'L',
+            char uplo = 'U') { // NOLINT (temporary views are allowed here)
+    static_assert(mem::have_compatible_addr_space<A, B, C>, "Error in nda::blas::symm: Incompatible memory address spaces");
+    static_assert(has_C_layout<B> == has_C_layout<C>, "Error in nda::blas::symm: B and C must have the same layout");
+
+    // runtime checks
+    EXPECTS(side == 'L' or side == 'R');
+    EXPECTS(uplo == 'U' or uplo == 'L');
+    EXPECTS(a.extent(0) == a.extent(1));
+    EXPECTS(a.extent(0) == c.extent(side == 'L' ? 0 : 1));
+    EXPECTS(b.shape() == c.shape());
+    EXPECTS(a.indexmap().min_stride() == 1);
+    EXPECTS(b.indexmap().min_stride() == 1);
+    EXPECTS(c.indexmap().min_stride() == 1);
+
+    // c is in C order: compute the transpose of the product in Fortran order
+    if constexpr (has_C_layout<C>) {
+      symm(alpha, transpose(a), transpose(b), beta, transpose(std::forward<C>(c)), flip_side(side), flip_uplo(uplo));
+    } else { // c is in Fortran order
+      // a symmetric matrix is its own transpose, only the referenced triangle changes
+      char uplo_a = (has_C_layout<A> ? flip_uplo(uplo) : uplo);
+      auto [m, n] = c.shape();
+
+      if constexpr (mem::have_device_compatible_addr_space<A, B, C>) {
+#if defined(NDA_HAVE_DEVICE)
+        device::symm(side, uplo_a, m, n, alpha, a.data(), get_ld(a), b.data(), get_ld(b), beta, c.data(), get_ld(c));
+#else
+        compile_error_no_gpu();
+#endif
+      } else {
+        f77::symm(side, uplo_a, m, n, alpha, a.data(), get_ld(a), b.data(), get_ld(b), beta, c.data(), get_ld(c));
+      }
+    }
+  }
+
+  /**
+   * @brief Interface to the BLAS `hemm` routine.
+   *
+   * @details This function performs one of the matrix-matrix operations
+   * \f[
+   *   \mathbf{C} \leftarrow \alpha \mathbf{A} \mathbf{B} + \beta \mathbf{C} \quad \mathrm{or} \quad
+   *   \mathbf{C} \leftarrow \alpha \mathbf{B} \mathbf{A} + \beta \mathbf{C} \;,
+   * \f]
+   * depending on whether `side == 'L'` or `side == 'R'`. Here, \f$ \alpha \f$ and \f$ \beta \f$ are scalars,
+   * \f$ \mathbf{A} \f$ is a hermitian matrix and \f$ \mathbf{B} \f$, \f$ \mathbf{C} \f$ are m-by-n matrices.
+   *
+   * Only the upper (`uplo == 'U'`) or lower (`uplo == 'L'`) triangular part of \f$ \mathbf{A} \f$ is referenced.
+   * All three matrices are required to have the same memory layout. For real value types, it calls nda::blas::symm.
+   *
+   * @tparam A nda::MemoryMatrix type.
+   * @tparam B nda::MemoryMatrix type.
+   * @tparam C nda::MemoryMatrix type.
+   * @param alpha Input scalar.
+   * @param a Input hermitian matrix of size m-by-m (`side == 'L'`) or n-by-n (`side == 'R'`).
+   * @param b Input matrix of size m-by-n.
+   * @param beta Input scalar.
+   * @param c Input/Output matrix of size m-by-n.
+   * @param side Side from which \f$ \mathbf{A} \f$ is multiplied.
+   * @param uplo Triangular part of \f$ \mathbf{A} \f$ that is referenced.
+   */
+  template <MemoryMatrix A, MemoryMatrix B, MemoryMatrix C>
+    requires(have_same_value_type_v<A, B, C> and is_blas_lapack_v<get_value_t<A>>)
+  void hemm(get_value_t<A> alpha, A const &a, B const &b, get_value_t<A> beta, C &&c, char side = 'L',
+            char uplo = 'U') { // NOLINT (temporary views are allowed here)
+    if constexpr (not is_complex_v<get_value_t<A>>) {
+      symm(alpha, a, b, beta, std::forward<C>(c), side, uplo);
+    } else {
+      static_assert(mem::have_compatible_addr_space<A, B, C>, "Error in nda::blas::hemm: Incompatible memory address spaces");
+      static_assert(has_C_layout<A> == has_C_layout<C> and has_C_layout<B> == has_C_layout<C>,
+                    "Error in nda::blas::hemm: A, B and C must have the same layout");
+
+      // runtime checks
+      EXPECTS(side == 'L' or side == 'R');
+      EXPECTS(uplo == 'U' or uplo == 'L');
+      EXPECTS(a.extent(0) == a.extent(1));
+      EXPECTS(a.extent(0) == c.extent(side == 'L' ? 0 : 1));
+      EXPECTS(b.shape() == c.shape());
+      EXPECTS(a.indexmap().min_stride() == 1);
+      EXPECTS(b.indexmap().min_stride() == 1);
+      EXPECTS(c.indexmap().min_stride() == 1);
+
+      // c is in C order: compute the transpose of the product in Fortran order
+      if constexpr (has_C_layout<C>) {
+        hemm(alpha, transpose(a), transpose(b), beta, transpose(std::forward<C>(c)), flip_side(side), flip_uplo(uplo));
+      } else { // c is in Fortran order
+        auto [m, n] = c.shape();
+
+        if constexpr (mem::have_device_compatible_addr_space<A, B, C>) {
+#if defined(NDA_HAVE_DEVICE)
+          device::hemm(side, uplo, m, n, alpha, a.data(), get_ld(a), b.data(), get_ld(b), beta, c.data(), get_ld(c));
+#else
+          compile_error_no_gpu();
+#endif
+        } else {
+          f77::hemm(side, uplo, m, n, alpha, a.data(), get_ld(a), b.data(), get_ld(b), beta, c.data(), get_ld(c));
+        }
+      }
+    }
+  }
+
+  /** @} */
+
+} // namespace nda::blas
@@ -0,0 +1,191 @@
+// Copyright (c) 2024 Simons Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file
+ * @brief Provides generic interfaces to the BLAS `syr2k` and `her2k` routines.
+ */
+
+#pragma once
+
+#include "./interface/cxx_interface.hpp"
+#include "./tools.hpp"
+#include "../concepts.hpp"
+#include "../layout_transforms.hpp"
+#include "../macros.hpp"
+#include "../mapped_functions.hpp"
+#include "../mem/address_space.hpp"
+#include "../traits.hpp"
+
+#ifndef NDA_HAVE_DEVICE
+#include "../device.hpp"
+#endif
+
+#include <tuple>
+#include <utility>
+
+namespace nda::blas {
+
+  /**
+   * @addtogroup linalg_blas
+   * @{
+   */
+
+  /**
+   * @brief Interface to the BLAS `syr2k` routine.
+   *
+   * @details This function performs the symmetric rank-2k update
+   * \f[
+   *   \mathbf{C} \leftarrow \alpha \mathbf{A} \mathbf{B}^T + \alpha \mathbf{B} \mathbf{A}^T + \beta \mathbf{C} \;,
+   * \f]
+   * where \f$ \alpha \f$ and \f$ \beta \f$ are scalars, \f$ \mathbf{A} \f$ and \f$ \mathbf{B} \f$ are n-by-k matrices
+   * and \f$ \mathbf{C} \f$ is an n-by-n symmetric matrix.
+   *
+   * Only the upper (`uplo == 'U'`) or lower (`uplo == 'L'`) triangular part of \f$ \mathbf{C} \f$ is referenced and
+   * updated. \f$ \mathbf{A} \f$ and \f$ \mathbf{B} \f$ are required to have the same memory layout.
+   *
+   * @tparam A nda::MemoryMatrix type.
+   * @tparam B nda::MemoryMatrix type.
+   * @tparam C nda::MemoryMatrix type.
+   * @param alpha Input scalar.
+   * @param a Input matrix of size n-by-k.
+   * @param b Input matrix of size n-by-k.
+   * @param beta Input scalar.
+   * @param c Input/Output matrix of size n-by-n.
+   * @param uplo Triangular part of \f$ \mathbf{C} \f$ that is updated.
+   */
+  template <MemoryMatrix A, MemoryMatrix B, MemoryMatrix C>
+    requires(have_same_value_type_v<A, B, C> and is_blas_lapack_v<get_value_t<A>>)
+  void syr2k(get_value_t<A> alpha, A const &a, B const &b, get_value_t<A> beta, C &&c, char uplo = 'U') { // NOLINT (temporary views are allowed here)
+    static_assert(mem::have_compatible_addr_space<A, B, C>, "Error in nda::blas::syr2k: Incompatible memory address spaces");
+    static_assert(has_C_layout<A> == has_C_layout<B>, "Error in nda::blas::syr2k: A and B must have the same layout");
+
+    // runtime checks
+    EXPECTS(uplo == 'U' or uplo == 'L');
+    EXPECTS(a.shape() == b.shape());
+    EXPECTS(a.extent(0) == c.extent(0));
+    EXPECTS(c.extent(0) == c.extent(1));
+    EXPECTS(a.indexmap().min_stride() == 1);
+    EXPECTS(b.indexmap().min_stride() == 1);
+    EXPECTS(c.indexmap().min_stride() == 1);
+
+    // c is in C order: it is symmetric, so we only need to update the opposite triangle in Fortran order
+    if constexpr (has_C_layout<C>) {
+      syr2k(alpha, a, b, beta, transpose(std::forward<C>(c)), flip_uplo(uplo));
+    } else { // c is in Fortran order
+      char op     = get_op<false, /* transpose = */ has_C_layout<A>>;
+      auto [n, k] = a.shape();
+
+      if constexpr (mem::have_device_compatible_addr_space<A, B, C>) {
+#if defined(NDA_HAVE_DEVICE)
+        device::syr2k(uplo, op, n, k, alpha, a.data(), get_ld(a), b.data(), get_ld(b), beta, c.data(), get_ld(c));
+#else
+        compile_error_no_gpu();
+#endif
+      } else {
+        f77::syr2k(uplo, op, n, k, alpha, a.data(), get_ld(a), b.data(), get_ld(b), beta, c.data(), get_ld(c));
+      }
+    }
+  }
+
+  /**
+   * @brief Interface to the BLAS `her2k` routine.
+   *
+   * @details This function performs the hermitian rank-2k update
+   * \f[
+   *   \mathbf{C} \leftarrow \alpha \mathbf{A} \mathbf{B}^H + \bar{\alpha} \mathbf{B} \mathbf{A}^H + \beta \mathbf{C}
+   *   \;,
+   * \f]
+   * where \f$ \alpha \f$ is a scalar, \f$ \beta \f$ is a real scalar, \f$ \mathbf{A} \f$ and \f$ \mathbf{B} \f$ are
+   * n-by-k matrices and \f$ \mathbf{C} \f$ is an n-by-n hermitian matrix.
+   *
+   * Only the upper (`uplo == 'U'`) or lower (`uplo == 'L'`) triangular part of \f$ \mathbf{C} \f$ is referenced and
+   * updated. For real value types, it calls nda::blas::syr2k.
+   *
+   * \f$ \mathbf{A} \f$ and \f$ \mathbf{B} \f$ must either both be conjugate lazy expressions or both be
+   * nda::MemoryMatrix types. As for nda::blas::herk, they are required to have the same memory layout as
+   * \f$ \mathbf{C} \f$ if they are not conjugated and the opposite one if they are.
+   *
+   * @tparam A nda::Matrix type.
+   * @tparam B nda::Matrix type.
+   * @tparam C nda::MemoryMatrix type.
+   * @param alpha Input scalar.
+   * @param a Input matrix of size n-by-k.
+   * @param b Input matrix of size n-by-k.
+   * @param beta Input scalar.
+   * @param c Input/Output matrix of size n-by-n.
+   * @param uplo Triangular part of \f$ \mathbf{C} \f$ that is updated.
+   */
+  template <Matrix A, Matrix B, MemoryMatrix C>
+    requires((MemoryMatrix<A> or is_conj_array_expr<A>) and (MemoryMatrix<B> or is_conj_array_expr<B>) and have_same_value_type_v<A, B, C>
+             and is_blas_lapack_v<get_value_t<A>>)
+  void her2k(get_value_t<A> alpha, A const &a, B const &b, double beta, C &&c, char uplo = 'U') { // NOLINT (temporary views are allowed here)
+    if constexpr (not is_complex_v<get_value_t<A>>) {
+      syr2k(alpha, a, b, beta, std::forward<C>(c), uplo);
+    } else {
+      // get underlying matrix in case it is given as a lazy expression
+      auto to_mat = []<typename Z>(Z const &z) -> auto & {
+        if constexpr (is_conj_array_expr<Z>)
+          return std::get<0>(z.a);
+        else
+          return z;
+      };
+      auto &mat_a = to_mat(a);
+      auto &mat_b = to_mat(b);
+
+      // compile-time checks
+      using mat_a_type = decltype(mat_a);
+      using mat_b_type = decltype(mat_b);
+      static_assert(mem::have_compatible_addr_space<mat_a_type, mat_b_type, C>, "Error in nda::blas::her2k: Incompatible memory address spaces");
+      static_assert(is_conj_array_expr<A> == is_conj_array_expr<B>, "Error in nda::blas::her2k: Either both or none of A and B can be conjugated");
+      static_assert(has_C_layout<mat_a_type> == has_C_layout<mat_b_type>, "Error in nda::blas::her2k: A and B must have the same layout");
+
+      // runtime checks
+      EXPECTS(uplo == 'U' or uplo == 'L');
+      EXPECTS(a.shape() == b.shape());
+      EXPECTS(a.shape()[0] == c.extent(0));
+      EXPECTS(c.extent(0) == c.extent(1));
+      EXPECTS(mat_a.indexmap().min_stride() == 1);
+      EXPECTS(mat_b.indexmap().min_stride() == 1);
+      EXPECTS(c.indexmap().min_stride() == 1);
+
+      static constexpr bool conj_A = is_conj_array_expr<A>;
+      if constexpr (has_C_layout<C>) {
+        // c is in C order: compute the transpose, i.e. the complex conjugate, of the update in Fortran order
+        if constexpr (conj_A)
+          her2k(std::conj(alpha), mat_a, mat_b, beta, transpose(std::forward<C>(c)), flip_uplo(uplo));
+        else
+          her2k(std::conj(alpha), conj(a), conj(b), beta, transpose(std::forward<C>(c)), flip_uplo(uplo));
+      } else { // c is in Fortran order
+        static_assert(conj_A == has_C_layout<mat_a_type>,
+                      "Error in nda::blas::her2k: A and B must have the same layout as C (or the opposite one if they are conjugated)");
+        char op     = get_op<conj_A, /* transpose = */ has_C_layout<mat_a_type>>;
+        auto [n, k] = a.shape();
+
+        if constexpr (mem::have_device_compatible_addr_space<mat_a_type, mat_b_type, C>) {
+#if defined(NDA_HAVE_DEVICE)
+          device::her2k(uplo, op, n, k, alpha, mat_a.data(), get_ld(mat_a), mat_b.data(), get_ld(mat_b), beta, c.data(), get_ld(c));
+#else
+          compile_error_no_gpu();
+#endif
+        } else {
+          f77::her2k(uplo, op, n, k, alpha, mat_a.data(), get_ld(mat_a), mat_b.data(), get_ld(mat_b), beta, c.data(), get_ld(c));
+        }
+      }
+    }
+  }
+
+  /** @} */
+
+} // namespace nda::blas
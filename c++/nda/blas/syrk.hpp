@@ -0,0 +1,178 @@
+// Copyright (c) 2024 Simons Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file
+ * @brief Provides generic interfaces to the BLAS `syrk` and `herk` routines.
+ */
+
+#pragma once
+
+#include "./interface/cxx_interface.hpp"
+#include "./tools.hpp"
+#include "../concepts.hpp"
+#include "../layout_transforms.hpp"
+#include "../macros.hpp"
+#include "../mapped_functions.hpp"
+#include "../mem/address_space.hpp"
+#include "../traits.hpp"
+
+#ifndef NDA_HAVE_DEVICE
+#include "../device.hpp"
+#endif
+
+#include <tuple>
+#include <utility>
+
+namespace nda::blas {
+
+  /**
+   * @addtogroup linalg_blas
+   * @{
+   */
+
+  /**
+   * @brief Interface to the BLAS `syrk` routine.
+   *
+   * @details This function performs the symmetric rank-k update
+   * \f[
+   *   \mathbf{C} \leftarrow \alpha \mathbf{A} \mathbf{A}^T + \beta \mathbf{C} \;,
+   * \f]
+   * where \f$ \alpha \f$ and \f$ \beta \f$ are scalars, \f$ \mathbf{A} \f$ is an n-by-k matrix and \f$ \mathbf{C} \f$
+   * is an n-by-n symmetric matrix.
+   *
+   * Only the upper (`uplo == 'U'`) or lower (`uplo == 'L'`) triangular part of \f$ \mathbf{C} \f$ is referenced and
+   * updated. It requires roughly half the operations of the corresponding nda::blas::gemm call. To compute
+   * \f$ \mathbf{A}^T \mathbf{A} \f$ simply pass `transpose(a)`.
+   *
+   * @tparam A nda::MemoryMatrix type.
+   * @tparam C nda::MemoryMatrix type.
+   * @param alpha Input scalar.
+   * @param a Input matrix of size n-by-k.
+   * @param beta Input scalar.
+   * @param c Input/Output matrix of size n-by-n.
+   * @param uplo Triangular part of \f$ \mathbf{C} \f$ that is updated.
+   */
+  template <MemoryMatrix A, MemoryMatrix C>
+    requires(have_same_value_type_v<A, C> and is_blas_lapack_v<get_value_t<A>>)
+  void syrk(get_value_t<A> alpha, A const &a, get_value_t<A> beta, C &&c, char uplo = 'U') { // NOLINT (temporary views are allowed here)
+    static_assert(mem::have_compatible_addr_space<A, C>, "Error in nda::blas::syrk: Incompatible memory address spaces");
+
+    // runtime checks
+    EXPECTS(uplo == 'U' or uplo == 'L');
+    EXPECTS(a.extent(0) == c.extent(0));
+    EXPECTS(c.extent(0) == c.extent(1));
+    EXPECTS(a.indexmap().min_stride() == 1);
+    EXPECTS(c.indexmap().min_stride() == 1);
+
+    // c is in C order: it is symmetric, so we only need to update the opposite triangle in Fortran order
+    if constexpr (has_C_layout<C>) {
+      syrk(alpha, a, beta, transpose(std::forward<C>(c)), flip_uplo(uplo));
+    } else { // c is in Fortran order
+      char op     = get_op<false, /* transpose = */ has_C_layout<A>>;
+      auto [n, k] = a.shape();
+
+      if constexpr (mem::have_device_compatible_addr_space<A, C>) {
+#if defined(NDA_HAVE_DEVICE)
+        device::syrk(uplo, op, n, k, alpha, a.data(), get_ld(a), beta, c.data(), get_ld(c));
+#else
+        compile_error_no_gpu();
+#endif
+      } else {
+        f77::syrk(uplo, op, n, k, alpha, a.data(), get_ld(a), beta, c.data(), get_ld(c));
+      }
+    }
+  }
+
+  /**
+   * @brief Interface to the BLAS `herk` routine.
+   *
+   * @details This function performs the hermitian rank-k update
+   * \f[
+   *   \mathbf{C} \leftarrow \alpha \mathbf{A} \mathbf{A}^H + \beta \mathbf{C} \;,
+   * \f]
+   * where \f$ \alpha \f$ and \f$ \beta \f$ are real scalars, \f$ \mathbf{A} \f$ is an n-by-k matrix and
+   * \f$ \mathbf{C} \f$ is an n-by-n hermitian matrix.
+   *
+   * Only the upper (`uplo == 'U'`) or lower (`uplo == 'L'`) triangular part of \f$ \mathbf{C} \f$ is referenced and
+   * updated. To compute \f$ \mathbf{A}^H \mathbf{A} \f$ simply pass `dagger(a)`. For real value types, it calls
+   * nda::blas::syrk.
+   *
+   * As for nda::blas::gemm, \f$ \mathbf{A} \f$ can be a conjugate lazy expression. Since BLAS does not provide a
+   * conjugation without transposition, \f$ \mathbf{A} \f$ is required to have the same memory layout as
+   * \f$ \mathbf{C} \f$ if it is not conjugated and the opposite one if it is.
+   *
+   * @tparam A nda::Matrix type.
+   * @tparam C nda::MemoryMatrix type.
+   * @param alpha Input scalar.
+   * @param a Input matrix of size n-by-k.
+   * @param beta Input scalar.
+   * @param c Input/Output matrix of size n-by-n.
+   * @param uplo Triangular part of \f$ \mathbf{C} \f$ that is updated.
+   */
+  template <Matrix A, MemoryMatrix C>
+    requires((MemoryMatrix<A> or is_conj_array_expr<A>) and have_same_value_type_v<A, C> and is_blas_lapack_v<get_value_t<A>>)
+  void herk(double alpha, A const &a, double beta, C &&c, char uplo = 'U') { // NOLINT (temporary views are allowed here)
+    if constexpr (not is_complex_v<get_value_t<A>>) {
+      syrk(alpha, a, beta, std::forward<C>(c), uplo);
+    } else {
+      // get underlying matrix in case it is given as a lazy expression
+      auto to_mat = []<typename Z>(Z const &z) -> auto & {
+        if constexpr (is_conj_array_expr<Z>)
+          return std::get<0>(z.a);
+        else
+          return z;
+      };
+      auto &mat_a = to_mat(a);
+
+      // compile-time checks
+      using mat_a_type = decltype(mat_a);
+      static_assert(mem::have_compatible_addr_space<mat_a_type, C>, "Error in nda::blas::herk: Incompatible memory address spaces");
+
+      // runtime checks
+      EXPECTS(uplo == 'U' or uplo == 'L');
+      EXPECTS(a.shape()[0] == c.extent(0));
+      EXPECTS(c.extent(0) == c.extent(1));
+      EXPECTS(mat_a.indexmap().min_stride() == 1);
+      EXPECTS(c.indexmap().min_stride() == 1);
+
+      static constexpr bool conj_A = is_conj_array_expr<A>;
+      if constexpr (has_C_layout<C>) {
+        // c is in C order: compute the transpose, i.e. the complex conjugate, of the product in Fortran order
+        if constexpr (conj_A)
+          herk(alpha, mat_a, beta, transpose(std::forward<C>(c)), flip_uplo(uplo));
+        else
+          herk(alpha, conj(a), beta, transpose(std::forward<C>(c)), flip_uplo(uplo));
+      } else { // c is in Fortran order
+        static_assert(conj_A == has_C_layout<mat_a_type>,
+                      "Error in nda::blas::herk: A must have the same layout as C (or the opposite one if it is conjugated)");
+        char op     = get_op<conj_A, /* transpose = */ has_C_layout<mat_a_type>>;
+        auto [n, k] = a.shape();
+
+        if constexpr (mem::have_device_compatible_addr_space<mat_a_type, C>) {
+#if defined(NDA_HAVE_DEVICE)
+          device::herk(uplo, op, n, k, alpha, mat_a.data(), get_ld(mat_a), beta, c.data(), get_ld(c));
+#else
+          compile_error_no_gpu();
+#endif
+        } else {
+          f77::herk(uplo, op, n, k, alpha, mat_a.data(), get_ld(mat_a), beta, c.data(), get_ld(c));
+        }
+      }
+    }
+  }
+
+  /** @} */
+
+} // namespace nda::blas
@@ -0,0 +1,143 @@
+// Copyright (c) 2024 Simons Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file
+ * @brief Provides a portable interface to control the number of threads used by the BLAS/LAPACK backend.
+ */
+
+#pragma once
+
+#include <exception>
+#include <optional>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace nda::blas {
+
+  /**
+   * @addtogroup linalg_blas
+   * @{
+   */
+
+  /**
+   * @brief Get the number of threads used by the BLAS/LAPACK backend.
+   *
+   * @details The backend is detected as follows:
+   * - MKL (`NDA_USE_MKL` is defined at build time): `mkl_get_max_threads`,
+   * - OpenBLAS (found at link time): `openblas_get_num_threads`,
+   * - BLIS (found at link time): `bli_thread_get_num_threads`.
+   *
+   * For any other backend, the number of threads cannot be queried and 1 is returned.
+   *
+   * @return Number of threads used by the backend.
+   */
+  int get_num_threads();
+
+  /**
+   * @brief Set the number of threads used by the BLAS/LAPACK backend.
+   *
+   * @details See nda::blas::get_num_threads for the supported backends. For any other backend, this function does
+   * nothing.
+   *
+   * @param n Number of threads (must be positive).
+   */
+  void set_num_threads(int n);
+
+  /**
+   * @brief RAII guard which sets the number of BLAS/LAPACK threads for the lifetime of the object and restores the
+   * previous value afterwards.
+   *
+   * @details Its main purpose is to avoid oversubscription when BLAS/LAPACK routines are called from within an OpenMP
+   * parallel region, e.g.
+   *
+   * @code{.cpp}
+   * {
+   *   auto guard = nda::blas::scoped_num_threads{1};
+   * #pragma omp parallel for
+   *   for (int i = 0; i < n; ++i) nda::blas::gemm(1.0, a[i], b[i], 0.0, c[i]);
+   * }
+   * @endcode
+   *
+   * Since the backends store the number of threads globally, the guard should be created outside of any parallel
+   * region.
+   */
+  class scoped_num_threads {
+    // Number of threads before the guard was created.
+    int saved_;
+
+    public:
+    /**
+     * @brief Construct a guard and set the number of BLAS/LAPACK threads.
+     * @param n Number of threads (must be positive).
+     */
+    explicit scoped_num_threads(int n) : saved_(get_num_threads()) {
+      if (n != saved_) set_num_threads(n);
+    }
+
+    /// Deleted copy constructor.
+    scoped_num_threads(scoped_num_threads const &) = delete;
+
+    /// Deleted copy assignment operator.
+    scoped_num_threads &operator=(scoped_num_threads const &) = delete;
+
+    /// Destructor restores the previous number of BLAS/LAPACK threads.
+    ~scoped_num_threads() {
+      if (get_num_threads() != saved_) set_num_threads(saved_);
+    }
+  };
+
+  /** @} */
+
+  namespace detail {
+
+    // Check if a batch of independent BLAS/LAPACK calls should be distributed over the OpenMP threads.
+    inline bool parallelize_batch(long batch_count) {
+#ifdef _OPENMP
+      return batch_count > 1 and omp_get_max_threads() > 1 and not omp_in_parallel();
+#else
+      return false;
+#endif
+    }
+
+    // Call f(state, i) for i = 0, ..., batch_count - 1 in an OpenMP parallel loop with single-threaded BLAS/LAPACK
+    // calls, where each thread owns its own state created by make_state(). The first exception thrown by any of the
+    // calls is rethrown after the loop.
+    template <typename MakeState, typename F>
+    void parallel_batch(long batch_count, MakeState make_state, F f) {
+      bool const par = parallelize_batch(batch_count);
+      auto guard     = std::optional<scoped_num_threads>{};
+      if (par) guard.emplace(1);
+      std::exception_ptr eptr;
+#pragma omp parallel if (par)
+      {
+        auto state = make_state();
+#pragma omp for
+        for (long i = 0; i < batch_count; ++i) {
+          try {
+            f(state, i);
+          } catch (...) {
+#pragma omp critical(nda_blas_parallel_batch)
+            if (not eptr) eptr = std::current_exception();
+          }
+        }
+      }
+      if (eptr) std::rethrow_exception(eptr);
+    }
+
+  } // namespace detail
+
+} // namespace nda::blas
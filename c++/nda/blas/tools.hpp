@@ -22,9 +22,11 @@
 #pragma once
 
 #include "../concepts.hpp"
+#include "../macros.hpp"
 #include "../map.hpp"
 #include "../mapped_functions.hpp"
 
+#include <cmath>
 #include <complex>
 #include <tuple>
 #include <type_traits>
@@ -98,6 +100,22 @@ namespace nda::blas {
       return 'N';
   }();
 
+  /**
+   * @brief Get the BLAS `uplo` character ('U' or 'L') that refers to the same elements of the transposed matrix.
+   *
+   * @param uplo Character specifying the upper ('U') or lower ('L') triangular part of a matrix.
+   * @return 'L' if `uplo == 'U'`, 'U' otherwise.
+   */
+  constexpr char flip_uplo(char uplo) { return (uplo == 'U' ? 'L' : 'U'); }
+
+  /**
+   * @brief Get the BLAS `side` character ('L' or 'R') for the transposed matrix product.
+   *
+   * @param side Character specifying if a matrix is multiplied from the left ('L') or from the right ('R').
+   * @return 'R' if `side == 'L'`, 'L' otherwise.
+   */
+  constexpr char flip_side(char side) { return (side == 'L' ? 'R' : 'L'); }
+
   /**
    * @brief Get the leading dimension in LAPACK jargon of an nda::MemoryMatrix.
    *
@@ -110,6 +128,21 @@ namespace nda::blas {
     return a.indexmap().strides()[has_F_layout<A> ? 1 : 0];
   }
 
+  /**
+   * @brief Get the size n of an n-by-n matrix in packed storage from the number of stored elements.
+   *
+   * @details In packed storage, only the upper or lower triangle of a symmetric/hermitian matrix is stored column by
+   * column in a 1-dimensional array of size \f$ n(n+1)/2 \f$.
+   *
+   * @param size Number of elements in the packed array.
+   * @return Number of rows/columns of the matrix.
+   */
+  inline int get_packed_dim(long size) {
+    auto n = static_cast<long>((std::sqrt(8.0 * static_cast<double>(size) + 1.0) - 1.0) / 2.0 + 0.5);
+    EXPECTS(n * (n + 1) / 2 == size);
+    return static_cast<int>(n);
+  }
+
   /**
    * @brief Get the number of columns in LAPACK jargon of an nda::MemoryMatrix.
    *
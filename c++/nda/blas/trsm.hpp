@@ -0,0 +1,120 @@
+// Copyright (c) 2024 Simons Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file
+ * @brief Provides a generic interface to the BLAS `trsm` routine.
+ */
+
+#pragma once
+
+#include "./interface/cxx_interface.hpp"
+#include "./tools.hpp"
+#include "../concepts.hpp"
+#include "../layout_transforms.hpp"
+#include "../macros.hpp"
+#include "../mem/address_space.hpp"
+#include "../traits.hpp"
+
+#ifndef NDA_HAVE_DEVICE
+#include "../device.hpp"
+#endif
+
+#include <tuple>
+#include <utility>
+
+namespace nda::blas {
+
+  /**
+   * @addtogroup linalg_blas
+   * @{
+   */
+
+  /**
+   * @brief Interface to the BLAS `trsm` routine.
+   *
+   * @details This function solves one of the matrix equations
+   * \f[
+   *   \mathrm{op}(\mathbf{A}) \mathbf{X} = \alpha \mathbf{B} \quad \mathrm{or} \quad
+   *   \mathbf{X} \mathrm{op}(\mathbf{A}) = \alpha \mathbf{B} \;,
+   * \f]
+   * depending on whether `side == 'L'` or `side == 'R'`. Here, \f$ \alpha \f$ is a scalar, \f$ \mathbf{A} \f$ is an
+   * upper (`uplo == 'U'`) or lower (`uplo == 'L'`) triangular matrix and \f$ \mathbf{X} \f$, \f$ \mathbf{B} \f$ are
+   * m-by-n matrices. The solution \f$ \mathbf{X} \f$ overwrites \f$ \mathbf{B} \f$. If `diag == 'U'`, the diagonal
+   * elements of \f$ \mathbf{A} \f$ are assumed to be one and are not referenced.
+   *
+   * No check for singularity is performed. It is typically used for the triangular solves after a factorization, e.g.
+   * nda::lapack::getrf.
+   *
+   * As for nda::blas::gemm, \f$ \mathrm{op}(\mathbf{A}) \f$ is determined by the memory layout of \f$ \mathbf{A} \f$
+   * and whether it is a conjugate lazy expression. `uplo` always refers to the matrix \f$ \mathbf{A} \f$ as it is
+   * passed to this function, e.g. `transpose(a)` of an upper triangular matrix `a` is lower triangular.
+   *
+   * @tparam A nda::Matrix type.
+   * @tparam B nda::MemoryMatrix type.
+   * @param alpha Input scalar.
+   * @param a Input triangular matrix of size m-by-m (`side == 'L'`) or n-by-n (`side == 'R'`).
+   * @param b Input/Output matrix of size m-by-n. On exit, it contains the solution \f$ \mathbf{X} \f$.
+   * @param side Side from which \f$ \mathbf{A} \f$ is multiplied with \f$ \mathbf{X} \f$.
+   * @param uplo Triangular part of \f$ \mathbf{A} \f$ that is referenced.
+   * @param diag Specifies whether \f$ \mathbf{A} \f$ is unit triangular ('U') or not ('N').
+   */
+  template <Matrix A, MemoryMatrix B>
+    requires((MemoryMatrix<A> or is_conj_array_expr<A>) and have_same_value_type_v<A, B> and is_blas_lapack_v<get_value_t<A>>)
+  void trsm(get_value_t<A> alpha, A const &a, B &&b, char side = 'L', char uplo = 'U', char diag = 'N') { // NOLINT (temporary views are allowed here)
+    // get underlying matrix in case it is given as a lazy expression
+    auto to_mat = []<typename Z>(Z const &z) -> auto & {
+      if constexpr (is_conj_array_expr<Z>)
+        return std::get<0>(z.a);
+      else
+        return z;
+    };
+    auto &mat_a = to_mat(a);
+
+    // compile-time checks
+    using mat_a_type = decltype(mat_a);
+    static_assert(mem::have_compatible_addr_space<mat_a_type, B>, "Error in nda::blas::trsm: Incompatible memory address spaces");
+
+    // runtime checks
+    EXPECTS(side == 'L' or side == 'R');
+    EXPECTS(uplo == 'U' or uplo == 'L');
+    EXPECTS(diag == 'N' or diag == 'U');
+    EXPECTS(mat_a.extent(0) == mat_a.extent(1));
+    EXPECTS(mat_a.extent(0) == b.extent(side == 'L' ? 0 : 1));
+    EXPECTS(mat_a.indexmap().min_stride() == 1);
+    EXPECTS(b.indexmap().min_stride() == 1);
+
+    // b is in C order: solve the transposed equation in Fortran order
+    if constexpr (has_C_layout<B>) {
+      trsm(alpha, transpose(a), transpose(std::forward<B>(b)), flip_side(side), flip_uplo(uplo), diag);
+    } else { // b is in Fortran order
+      char op     = get_op<is_conj_array_expr<A>, /* transpose = */ has_C_layout<mat_a_type>>;
+      char uplo_a = (has_C_layout<mat_a_type> ? flip_uplo(uplo) : uplo);
+      auto [m, n] = b.shape();
+
+      if constexpr (mem::have_device_compatible_addr_space<mat_a_type, B>) {
+#if defined(NDA_HAVE_DEVICE)
+        device::trsm(side, uplo_a, op, diag, m, n, alpha, mat_a.data(), get_ld(mat_a), b.data(), get_ld(b));
+#else
+        compile_error_no_gpu();
+#endif
+      } else {
+        f77::trsm(side, uplo_a, op, diag, m, n, alpha, mat_a.data(), get_ld(mat_a), b.data(), get_ld(b));
+      }
+    }
+  }
+
+  /** @} */
+
+} // namespace nda::blas
@@ -92,6 +92,63 @@ namespace nda {
     }
   }
 
+  /**
+   * @brief Map between a single char and the corresponding `cublasSideMode_t`.
+   *
+   * @details The mapping is as follows:
+   * - 'L' -> `CUBLAS_SIDE_LEFT`
+   * - 'R' -> `CUBLAS_SIDE_RIGHT`
+   * - everything else -> call `std::terminate()`.
+   *
+   * @param side Character to be mapped to a `cublasSideMode_t`.
+   * @return The corresponding `cublasSideMode_t`.
+   */
+  inline cublasSideMode_t get_cublas_side(char side) {
+    switch (side) {
+      case 'L': return CUBLAS_SIDE_LEFT;
+      case 'R': return CUBLAS_SIDE_RIGHT;
+      default: std::terminate(); return {};
+    }
+  }
+
+  /**
+   * @brief Map between a single char and the corresponding `cublasFillMode_t`.
+   *
+   * @details The mapping is as follows:
+   * - 'U' -> `CUBLAS_FILL_MODE_UPPER`
+   * - 'L' -> `CUBLAS_FILL_MODE_LOWER`
+   * - everything else -> call `std::terminate()`.
+   *
+   * @param uplo Character to be mapped to a `cublasFillMode_t`.
+   * @return The corresponding `cublasFillMode_t`.
+   */
+  inline cublasFillMode_t get_cublas_fill(char uplo) {
+    switch (uplo) {
+      case 'U': return CUBLAS_FILL_MODE_UPPER;
+      case 'L': return CUBLAS_FILL_MODE_LOWER;
+      default: std::terminate(); return {};
+    }
+  }
+
+  /**
+   * @brief Map between a single char and the corresponding `cublasDiagType_t`.
+   *
+   * @details The mapping is as follows:
+   * - 'N' -> `CUBLAS_DIAG_NON_UNIT`
+   * - 'U' -> `CUBLAS_DIAG_UNIT`
+   * - everything else -> call `std::terminate()`.
+   *
+   * @param diag Character to be mapped to a `cublasDiagType_t`.
+   * @return The corresponding `cublasDiagType_t`.
+   */
+  inline cublasDiagType_t get_cublas_diag(char diag) {
+    switch (diag) {
+      case 'N': return CUBLAS_DIAG_NON_UNIT;
+      case 'U': return CUBLAS_DIAG_UNIT;
+      default: std::terminate(); return {};
+    }
+  }
+
   /**
    * @brief Cast a `std::complex<double>` to a `cuDoubleComplex`.
    *
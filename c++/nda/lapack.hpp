@@ -22,12 +22,30 @@
 #pragma once
 
 #include "./lapack/interface/cxx_interface.hpp"
+#include "./lapack/gbsv.hpp"
+#include "./lapack/gbtrf.hpp"
+#include "./lapack/gbtrs.hpp"
+#include "./lapack/geev.hpp"
 #include "./lapack/gelss.hpp"
 #include "./lapack/geqp3.hpp"
+#include "./lapack/gesdd.hpp"
 #include "./lapack/gesvd.hpp"
 #include "./lapack/getrf.hpp"
 #include "./lapack/getri.hpp"
 #include "./lapack/getrs.hpp"
+#include "./lapack/ggev.hpp"
 #include "./lapack/gtsv.hpp"
 #include "./lapack/orgqr.hpp"
+#include "./lapack/potrf.hpp"
+#include "./lapack/potri.hpp"
+#include "./lapack/potrs.hpp"
+#include "./lapack/pptrf.hpp"
+#include "./lapack/pptrs.hpp"
+#include "./lapack/spev.hpp"
+#include "./lapack/syevd.hpp"
+#include "./lapack/syevr.hpp"
+#include "./lapack/sygvd.hpp"
+#include "./lapack/sytrf.hpp"
+#include "./lapack/sytrs.hpp"
 #include "./lapack/ungqr.hpp"
+#include "./lapack/workspace.hpp"
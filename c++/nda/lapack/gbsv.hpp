@@ -0,0 +1,89 @@
+// Copyright (c) 2024 Simons Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file
+ * @brief Provides a generic interface to the LAPACK `gbsv` routine.
+ */
+
+#pragma once
+
+#include "./interface/cxx_interface.hpp"
+#include "../concepts.hpp"
+#include "../macros.hpp"
+#include "../mem/address_space.hpp"
+#include "../traits.hpp"
+
+#include <algorithm>
+#include <type_traits>
+
+namespace nda::lapack {
+
+  /**
+   * @ingroup linalg_lapack
+   * @brief Interface to the LAPACK `gbsv` routine.
+   *
+   * @details Solves the equation
+   * \f[
+   *   \mathbf{A} \mathbf{X} = \mathbf{B},
+   * \f]
+   * where \f$ \mathbf{A} \f$ is an n-by-n band matrix with `kl` sub-diagonals and `ku` super-diagonals, by an LU
+   * factorization with partial pivoting (see nda::lapack::gbtrf) followed by a forward and backward substitution (see
+   * nda::lapack::gbtrs).
+   *
+   * The band matrix is given in the LAPACK band storage with `kl` additional rows for the fill-in of the factorization,
+   * i.e. the element \f$ A_{ij} \f$ is stored in `ab(kl + ku + i - j, j)`. The right hand side has to be a vector or a
+   * matrix in Fortran order.
+   *
+   * @tparam AB nda::MemoryMatrix type.
+   * @tparam IPIV nda::MemoryVector type.
+   * @tparam B nda::MemoryArray type.
+   * @param ab Input/output matrix of size at least (2 kl + ku + 1)-by-n. On entry, the band matrix
+   * \f$ \mathbf{A} \f$. On exit, the factors \f$ \mathbf{L} \f$ and \f$ \mathbf{U} \f$ as computed by `gbtrf`.
+   * @param kl Number of sub-diagonals.
+   * @param ku Number of super-diagonals.
+   * @param ipiv Output vector of size n. The pivot indices as computed by `gbtrf`.
+   * @param b Input/output array. On entry, the right hand side vector/matrix \f$ \mathbf{B} \f$. On exit, if
+   * `info == 0`, the solution vector/matrix \f$ \mathbf{X} \f$.
+   * @return Integer return code from the LAPACK call.
+   */
+  template <MemoryMatrix AB, MemoryVector IPIV, MemoryArray B>
+    requires(have_same_value_type_v<AB, B> and mem::on_host<AB, IPIV, B> and is_blas_lapack_v<get_value_t<AB>>)
+  int gbsv(AB &&ab, int kl, int ku, IPIV &&ipiv, B &&b) { // NOLINT (temporary views are allowed here)
+    static_assert(MemoryVector<B> or MemoryMatrix<B>, "Error in nda::lapack::gbsv: B must be a vector or a matrix");
+    static_assert(has_F_layout<AB> and has_F_layout<B>, "Error in nda::lapack::gbsv: C order not supported");
+    static_assert(std::is_same_v<get_value_t<IPIV>, int>, "Error in nda::lapack::gbsv: Pivoting array must have elements of type int");
+
+    // runtime checks
+    EXPECTS(kl >= 0 and ku >= 0);
+    EXPECTS(ab.extent(0) >= 2 * kl + ku + 1);
+    EXPECTS(b.extent(0) == ab.extent(1));
+    EXPECTS(ipiv.size() >= ab.extent(1));
+    EXPECTS(ab.indexmap().min_stride() == 1);
+    EXPECTS(b.indexmap().min_stride() == 1);
+    EXPECTS(ipiv.indexmap().min_stride() == 1);
+
+    int nrhs = 1, ldb = std::max(1, static_cast<int>(b.extent(0))); // defaults for B MemoryVector
+    if constexpr (MemoryMatrix<B>) {
+      nrhs = b.extent(1);
+      ldb  = get_ld(b);
+    }
+
+    int info = 0;
+    if (b.extent(0) == 0) return info;
+    f77::gbsv(b.extent(0), kl, ku, nrhs, ab.data(), get_ld(ab), ipiv.data(), b.data(), ldb, info);
+    return info;
+  }
+
+} // namespace nda::lapack
@@ -0,0 +1,74 @@
+// Copyright (c) 2024 Simons Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file
+ * @brief Provides a generic interface to the LAPACK `gbtrf` routine.
+ */
+
+#pragma once
+
+#include "./interface/cxx_interface.hpp"
+#include "../concepts.hpp"
+#include "../macros.hpp"
+#include "../mem/address_space.hpp"
+#include "../traits.hpp"
+
+#include <type_traits>
+
+namespace nda::lapack {
+
+  /**
+   * @ingroup linalg_lapack
+   * @brief Interface to the LAPACK `gbtrf` routine.
+   *
+   * @details Computes an LU factorization \f$ \mathbf{A} = \mathbf{P L U} \f$ of an n-by-n band matrix
+   * \f$ \mathbf{A} \f$ with `kl` sub-diagonals and `ku` super-diagonals using partial pivoting with row interchanges.
+   *
+   * The band matrix is given in the LAPACK band storage with `kl` additional rows for the fill-in of the factorization,
+   * i.e. the element \f$ A_{ij} \f$ is stored in `ab(kl + ku + i - j, j)` and the first `kl` rows of `ab` need not be
+   * set on entry. On exit, \f$ \mathbf{U} \f$ is stored as an upper band matrix with `kl + ku` super-diagonals in the
+   * rows 0 to `kl + ku` and the multipliers of \f$ \mathbf{L} \f$ are stored in the rows `kl + ku + 1` to `2 kl + ku`.
+   *
+   * @tparam AB nda::MemoryMatrix type.
+   * @tparam IPIV nda::MemoryVector type.
+   * @param ab Input/output matrix of size at least (2 kl + ku + 1)-by-n. On entry, the band matrix
+   * \f$ \mathbf{A} \f$. On exit, the factors \f$ \mathbf{L} \f$ and \f$ \mathbf{U} \f$ as described above.
+   * @param kl Number of sub-diagonals.
+   * @param ku Number of super-diagonals.
+   * @param ipiv Output vector of size n. The pivot indices, i.e. for `1 <= i <= N`, row i of the matrix was
+   * interchanged with row `ipiv(i)`.
+   * @return Integer return code from the LAPACK call.
+   */
+  template <MemoryMatrix AB, MemoryVector IPIV>
+    requires(mem::on_host<AB, IPIV> and is_blas_lapack_v<get_value_t<AB>>)
+  int gbtrf(AB &&ab, int kl, int ku, IPIV &&ipiv) { // NOLINT (temporary views are allowed here)
+    static_assert(has_F_layout<AB>, "Error in nda::lapack::gbtrf: C order not supported");
+    static_assert(std::is_same_v<get_value_t<IPIV>, int>, "Error in nda::lapack::gbtrf: Pivoting array must have elements of type int");
+
+    // runtime checks
+    EXPECTS(kl >= 0 and ku >= 0);
+    EXPECTS(ab.extent(0) >= 2 * kl + ku + 1);
+    EXPECTS(ipiv.size() >= ab.extent(1));
+    EXPECTS(ab.indexmap().min_stride() == 1);
+    EXPECTS(ipiv.indexmap().min_stride() == 1);
+
+    int n    = ab.extent(1);
+    int info = 0;
+    if (n == 0) return info;
+    f77::gbtrf(n, n, kl, ku, ab.data(), get_ld(ab), ipiv.data(), info);
+    return info;
+  }
+
+} // namespace nda::lapack
@@ -0,0 +1,88 @@
+// Copyright (c) 2024 Simons Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file
+ * @brief Provides a generic interface to the LAPACK `gbtrs` routine.
+ */
+
+#pragma once
+
+#include "./interface/cxx_interface.hpp"
+#include "../concepts.hpp"
+#include "../macros.hpp"
+#include "../mem/address_space.hpp"
+#include "../traits.hpp"
+
+#include <algorithm>
+#include <type_traits>
+
+namespace nda::lapack {
+
+  /**
+   * @ingroup linalg_lapack
+   * @brief Interface to the LAPACK `gbtrs` routine.
+   *
+   * @details Solves a system of linear equations
+   *
+   * - \f$ \mathbf{A X} = \mathbf{B} \f$ (`op == 'N'`),
+   * - \f$ \mathbf{A}^T \mathbf{X} = \mathbf{B} \f$ (`op == 'T'`) or
+   * - \f$ \mathbf{A}^H \mathbf{X} = \mathbf{B} \f$ (`op == 'C'`)
+   *
+   * with an n-by-n band matrix \f$ \mathbf{A} \f$ using the LU factorization computed by nda::lapack::gbtrf.
+   *
+   * The right hand side has to be a vector or a matrix in Fortran order.
+   *
+   * @tparam AB nda::MemoryMatrix type.
+   * @tparam IPIV nda::MemoryVector type.
+   * @tparam B nda::MemoryArray type.
+   * @param ab Input matrix. The factors \f$ \mathbf{L} \f$ and \f$ \mathbf{U} \f$ as computed by `gbtrf`.
+   * @param kl Number of sub-diagonals.
+   * @param ku Number of super-diagonals.
+   * @param ipiv Input vector. The pivot indices from `gbtrf`.
+   * @param b Input/output array. On entry, the right hand side vector/matrix \f$ \mathbf{B} \f$. On exit, the solution
+   * vector/matrix \f$ \mathbf{X} \f$.
+   * @param op Operation applied to \f$ \mathbf{A} \f$ ('N', 'T' or 'C').
+   * @return Integer return code from the LAPACK call.
+   */
+  template <MemoryMatrix AB, MemoryVector IPIV, MemoryArray B>
+    requires(have_same_value_type_v<AB, B> and mem::on_host<AB, IPIV, B> and is_blas_lapack_v<get_value_t<AB>>)
+  int gbtrs(AB const &ab, int kl, int ku, IPIV const &ipiv, B &&b, char op = 'N') { // NOLINT (temporary views are allowed here)
+    static_assert(MemoryVector<B> or MemoryMatrix<B>, "Error in nda::lapack::gbtrs: B must be a vector or a matrix");
+    static_assert(has_F_layout<AB> and has_F_layout<B>, "Error in nda::lapack::gbtrs: C order not supported");
+    static_assert(std::is_same_v<get_value_t<IPIV>, int>, "Error in nda::lapack::gbtrs: Pivoting array must have elements of type int");
+
+    // runtime checks
+    EXPECTS(op == 'N' or op == 'T' or op == 'C');
+    EXPECTS(kl >= 0 and ku >= 0);
+    EXPECTS(ab.extent(0) >= 2 * kl + ku + 1);
+    EXPECTS(b.extent(0) == ab.extent(1));
+    EXPECTS(ipiv.size() >= ab.extent(1));
+    EXPECTS(ab.indexmap().min_stride() == 1);
+    EXPECTS(b.indexmap().min_stride() == 1);
+    EXPECTS(ipiv.indexmap().min_stride() == 1);
+
+    int nrhs = 1, ldb = std::max(1, static_cast<int>(b.extent(0))); // defaults for B MemoryVector
+    if constexpr (MemoryMatrix<B>) {
+      nrhs = b.extent(1);
+      ldb  = get_ld(b);
+    }
+
+    int info = 0;
+    if (b.extent(0) == 0 or nrhs == 0) return info;
+    f77::gbtrs(op, b.extent(0), kl, ku, nrhs, ab.data(), get_ld(ab), ipiv.data(), b.data(), ldb, info);
+    return info;
+  }
+
+} // namespace nda::lapack
@@ -0,0 +1,160 @@
+// Copyright (c) 2024 Simons Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file
+ * @brief Provides a generic interface to the LAPACK `geev` routine.
+ */
+
+#pragma once
+
+#include "./interface/cxx_interface.hpp"
+#include "./workspace.hpp"
+#include "../concepts.hpp"
+#include "../exceptions.hpp"
+#include "../macros.hpp"
+#include "../mem/address_space.hpp"
+#include "../traits.hpp"
+
+#include <complex>
+#include <type_traits>
+#include <utility>
+
+namespace nda::lapack {
+
+  /**
+   * @addtogroup linalg_lapack
+   * @{
+   */
+
+  /**
+   * @brief Interface to the LAPACK `geev` routine.
+   *
+   * @details Computes the eigenvalues and, optionally, the left and/or right eigenvectors of a general real or complex
+   * n-by-n matrix \f$ \mathbf{A} \f$. The right eigenvectors \f$ \mathbf{v}_j \f$ and left eigenvectors
+   * \f$ \mathbf{u}_j \f$ satisfy
+   * \f[
+   *   \mathbf{A} \mathbf{v}_j = \lambda_j \mathbf{v}_j \quad \text{and} \quad \mathbf{u}_j^H \mathbf{A} = \lambda_j
+   *   \mathbf{u}_j^H \; .
+   * \f]
+   * They are normalized to have Euclidean norm 1 and largest component real.
+   *
+   * For real matrices, the eigenvectors are stored in the compact format of LAPACK: If \f$ \lambda_j \f$ is real, the
+   * j-th column of `vr` is \f$ \mathbf{v}_j \f$. If \f$ \lambda_j \f$ and \f$ \lambda_{j+1} \f$ form a complex
+   * conjugate pair (with positive imaginary part first), then \f$ \mathbf{v}_j = \f$ `vr(_, j) + i * vr(_, j+1)` and
+   * \f$ \mathbf{v}_{j+1} = \f$ `vr(_, j) - i * vr(_, j+1)` (the same holds for `vl`).
+   *
+   * The optimal size of the `work` buffer is obtained from a workspace query. All buffers are taken from the given
+   * nda::lapack::workspace, so that repeated calls with the same workspace and problem size do not allocate.
+   *
+   * @tparam A nda::MemoryMatrix type.
+   * @tparam W nda::MemoryVector type.
+   * @tparam VL nda::MemoryMatrix type.
+   * @tparam VR nda::MemoryMatrix type.
+   * @param a Input/output matrix. On entry, the n-by-n matrix \f$ \mathbf{A} \f$. On exit, its content is destroyed.
+   * @param w Output vector of size n. The (complex) eigenvalues of \f$ \mathbf{A} \f$.
+   * @param vl Output matrix. If `jobvl == 'V'`, the n-by-n matrix of left eigenvectors. Otherwise, it is not referenced.
+   * @param vr Output matrix. If `jobvr == 'V'`, the n-by-n matrix of right eigenvectors. Otherwise, it is not
+   * referenced.
+   * @param ws nda::lapack::workspace used for the `work` and `rwork` buffers.
+   * @param jobvl Compute the left eigenvectors (`jobvl == 'V'`) or not (`jobvl == 'N'`).
+   * @param jobvr Compute the right eigenvectors (`jobvr == 'V'`) or not (`jobvr == 'N'`).
+   * @return Integer return code from the LAPACK call.
+   */
+  template <MemoryMatrix A, MemoryVector W, MemoryMatrix VL, MemoryMatrix VR>
+    requires(mem::on_host<A, W, VL, VR> and have_same_value_type_v<A, VL, VR> and is_blas_lapack_v<get_value_t<A>>
+             and std::is_same_v<get_value_t<W>, std::complex<double>>)
+  int geev(A &&a, W &&w, VL &&vl, VR &&vr, workspace<get_value_t<A>> &ws, char jobvl = 'N', // NOLINT (temporary views are allowed here)
+           char jobvr = 'V') {
+    static_assert(has_F_layout<A> and has_F_layout<VL> and has_F_layout<VR>, "Error in nda::lapack::geev: C order not supported");
+
+    // runtime checks
+    EXPECTS(jobvl == 'N' or jobvl == 'V');
+    EXPECTS(jobvr == 'N' or jobvr == 'V');
+    EXPECTS(a.extent(0) == a.extent(1));
+    EXPECTS(w.size() >= a.extent(0));
+    EXPECTS(a.indexmap().min_stride() == 1);
+
+    int n = a.extent(0);
+    if (n == 0) return 0;
+
+    int ldvl = 1, ldvr = 1;
+    if (jobvl == 'V') {
+      EXPECTS(vl.extent(0) == n and vl.extent(1) == n);
+      EXPECTS(vl.indexmap().min_stride() == 1);
+      ldvl = get_ld(vl);
+    }
+    if (jobvr == 'V') {
+      EXPECTS(vr.extent(0) == n and vr.extent(1) == n);
+      EXPECTS(vr.indexmap().min_stride() == 1);
+      ldvr = get_ld(vr);
+    }
+
+    // call the correct LAPACK routine (the real and imaginary parts of the eigenvalues of real matrices are stored in
+    // the rwork buffer)
+    using value_type = get_value_t<A>;
+    int info         = 0;
+    double *rwork    = ws.rwork(2 * n);
+    auto call        = [&](value_type *work, int lwork) {
+      if constexpr (is_complex_v<value_type>) {
+        EXPECTS(w.indexmap().min_stride() == 1);
+        f77::geev(jobvl, jobvr, n, a.data(), get_ld(a), w.data(), vl.data(), ldvl, vr.data(), ldvr, work, lwork, rwork, info);
+      } else {
+        f77::geev(jobvl, jobvr, n, a.data(), get_ld(a), rwork, rwork + n, vl.data(), ldvl, vr.data(), ldvr, work, lwork, info);
+      }
+    };
+
+    // first call to get the optimal buffersize
+    value_type bufferSize_T{};
+    call(&bufferSize_T, -1);
+    int bufferSize = lwork_from_query(bufferSize_T);
+
+    // get the work buffer and perform actual library call
+    call(ws.work(bufferSize), bufferSize);
+    if constexpr (not is_complex_v<value_type>) {
+      for (int i = 0; i < n; ++i) w(i) = std::complex<double>{rwork[i], rwork[n + i]};
+    }
+
+    if (info) NDA_RUNTIME_ERROR << "Error in nda::lapack::geev: info = " << info;
+    return info;
+  }
+
+  /**
+   * @brief Interface to the LAPACK `geev` routine with a temporary workspace.
+   *
+   * @details See nda::lapack::geev(A &&, W &&, VL &&, VR &&, workspace<get_value_t<A>> &, char, char).
+   *
+   * @tparam A nda::MemoryMatrix type.
+   * @tparam W nda::MemoryVector type.
+   * @tparam VL nda::MemoryMatrix type.
+   * @tparam VR nda::MemoryMatrix type.
+   * @param a Input/output matrix.
+   * @param w Output vector of eigenvalues.
+   * @param vl Output matrix of left eigenvectors.
+   * @param vr Output matrix of right eigenvectors.
+   * @param jobvl Compute the left eigenvectors (`jobvl == 'V'`) or not (`jobvl == 'N'`).
+   * @param jobvr Compute the right eigenvectors (`jobvr == 'V'`) or not (`jobvr == 'N'`).
+   * @return Integer return code from the LAPACK call.
+   */
+  template <MemoryMatrix A, MemoryVector W, MemoryMatrix VL, MemoryMatrix VR>
+    requires(mem::on_host<A, W, VL, VR> and have_same_value_type_v<A, VL, VR> and is_blas_lapack_v<get_value_t<A>>
+             and std::is_same_v<get_value_t<W>, std::complex<double>>)
+  int geev(A &&a, W &&w, VL &&vl, VR &&vr, char jobvl = 'N', char jobvr = 'V') { // NOLINT (temporary views are allowed here)
+    auto ws = workspace<get_value_t<A>>{};
+    return geev(std::forward<A>(a), std::forward<W>(w), std::forward<VL>(vl), std::forward<VR>(vr), ws, jobvl, jobvr);
+  }
+
+  /** @} */
+
+} // namespace nda::lapack
@@ -22,6 +22,7 @@
 #pragma once
 
 #include "./interface/cxx_interface.hpp"
+#include "./workspace.hpp"
 #include "../basic_array.hpp"
 #include "../concepts.hpp"
 #include "../declarations.hpp"
@@ -31,8 +32,7 @@
 #include "../traits.hpp"
 
 #include <algorithm>
-#include <cmath>
-#include <complex>
+#include <utility>
 
 namespace nda::lapack {
 
@@ -54,6 +54,9 @@ namespace nda::lapack {
    * The effective rank of \f$ \mathbf{A} \f$ is determined by treating as zero those singular values which are less
    * than `rcond` times the largest singular value.
    *
+   * The optimal size of the `work` buffer is obtained from a workspace query. The buffers are taken from the given
+   * nda::lapack::workspace, so that repeated calls with the same workspace and problem size do not allocate.
+   *
    * @tparam A nda::MemoryMatrix type.
    * @tparam B nda::MemoryArray type.
    * @tparam S nda::MemoryVector type.
@@ -69,11 +72,12 @@ namespace nda::lapack {
    * s(1)` are treated as zero. If `rcond < 0`, machine precision is used instead.
    * @param rank Output variable of the effective rank of \f$ \mathbf{A} \f$, i.e., the number of singular values which
    * are greater than `rcond * s(1)`.
+   * @param ws nda::lapack::workspace used for the `work` and `rwork` buffers.
    * @return Integer return code.
    */
   template <MemoryMatrix A, MemoryArray B, MemoryVector S>
     requires(have_same_value_type_v<A, B> and mem::on_host<A, B, S> and is_blas_lapack_v<get_value_t<A>>)
-  int gelss(A &&a, B &&b, S &&s, double rcond, int &rank) { // NOLINT (temporary views are allowed here)
+  int gelss(A &&a, B &&b, S &&s, double rcond, int &rank, workspace<get_value_t<A>> &ws) { // NOLINT (temporary views are allowed here)
     static_assert(has_F_layout<A> and has_F_layout<B>, "Error in nda::lapack::gelss: C order not supported");
     static_assert(MemoryVector<B> or MemoryMatrix<B>, "Error in nda::lapack::gelss: B must be a vector or a matrix");
 
@@ -88,23 +92,45 @@ namespace nda::lapack {
     // first call to get the optimal bufferSize
     using value_type = get_value_t<A>;
     value_type bufferSize_T{};
-    auto rwork = array<double, 1>(5 * dm);
-    int info   = 0;
+    auto *rwork = ws.rwork(5 * dm);
+    int info    = 0;
     int nrhs = 1, ldb = b.size(); // defaults for B MemoryVector
     if constexpr (MemoryMatrix<B>) {
       nrhs = b.extent(1);
       ldb  = get_ld(b);
     }
-    f77::gelss(a.extent(0), a.extent(1), nrhs, a.data(), get_ld(a), b.data(), ldb, s.data(), rcond, rank, &bufferSize_T, -1, rwork.data(), info);
-    int bufferSize = static_cast<int>(std::ceil(std::real(bufferSize_T)));
+    f77::gelss(a.extent(0), a.extent(1), nrhs, a.data(), get_ld(a), b.data(), ldb, s.data(), rcond, rank, &bufferSize_T, -1, rwork, info);
+    int bufferSize = lwork_from_query(bufferSize_T);
 
-    // allocate work buffer and perform actual library call
-    array<value_type, 1> work(bufferSize);
-    f77::gelss(a.extent(0), a.extent(1), nrhs, a.data(), get_ld(a), b.data(), ldb, s.data(), rcond, rank, work.data(), bufferSize, rwork.data(),
+    // get the work buffer and perform actual library call
+    f77::gelss(a.extent(0), a.extent(1), nrhs, a.data(), get_ld(a), b.data(), ldb, s.data(), rcond, rank, ws.work(bufferSize), bufferSize, rwork,
                info);
 
     if (info) NDA_RUNTIME_ERROR << "Error in nda::lapack::gelss: info = " << info;
     return info;
   }
 
+  /**
+   * @ingroup linalg_lapack
+   * @brief Interface to the LAPACK `gelss` routine with a temporary workspace.
+   *
+   * @details See nda::lapack::gelss(A &&, B &&, S &&, double, int &, workspace<get_value_t<A>> &).
+   *
+   * @tparam A nda::MemoryMatrix type.
+   * @tparam B nda::MemoryArray type.
+   * @tparam S nda::MemoryVector type.
+   * @param a Input/output matrix.
+   * @param b Input/output right hand side(s).
+   * @param s Output vector of singular values.
+   * @param rcond Threshold for the effective rank of \f$ \mathbf{A} \f$.
+   * @param rank Output variable of the effective rank of \f$ \mathbf{A} \f$.
+   * @return Integer return code.
+   */
+  template <MemoryMatrix A, MemoryArray B, MemoryVector S>
+    requires(have_same_value_type_v<A, B> and mem::on_host<A, B, S> and is_blas_lapack_v<get_value_t<A>>)
+  int gelss(A &&a, B &&b, S &&s, double rcond, int &rank) { // NOLINT (temporary views are allowed here)
+    auto ws = workspace<get_value_t<A>>{};
+    return gelss(std::forward<A>(a), std::forward<B>(b), std::forward<S>(s), rcond, rank, ws);
+  }
+
 } // namespace nda::lapack
@@ -21,6 +21,8 @@
 #pragma once
 
 #include "./gesvd.hpp"
+#include "../blas/gemm.hpp"
+#include "../blas/threads.hpp"
 #include "../algorithms.hpp"
 #include "../basic_array.hpp"
 #include "../declarations.hpp"
@@ -38,6 +40,7 @@
 #include <cmath>
 #include <complex>
 #include <optional>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -73,15 +76,55 @@ namespace nda::lapack {
     // Matrix to be decomposed by SVD.
     matrix<T> A;
 
-    // (Pseudo) Inverse of A, i.e. V * Diag(S_vec)^{-1} * UH, for the least square problem.
-    matrix<T> V_x_InvS_x_UH;
+    // Left singular vectors of A (thin SVD), i.e. A = U * Diag(S_vec) * VH.
+    matrix<T, F_layout> U;
 
-    // Part of UH fixing the error of the least square problem.
-    matrix<T> UH_NULL;
+    // Right singular vectors scaled by the inverse singular values, i.e. V * Diag(S_vec)^{-1}.
+    matrix<T, F_layout> V_x_InvS;
 
     // Array containing the singular values.
     array<double, 1> s_vec;
 
+    // Buffers for the intermediate results UH * B and B - U * UH * B of a solve.
+    struct scratch_t {
+      matrix<T, F_layout> uh_b, res;
+    };
+
+    // Solve the least square problem for the right hand side B, write the solution into X and the error of each column
+    // into err (if not empty) and return the maximum error.
+    template <typename XM, typename E>
+    double solve(matrix_const_view<T> B, XM &X, E &err, scratch_t &s) const {
+      long nrhs = B.extent(1);
+      EXPECTS(B.extent(0) == M);
+      EXPECTS(X.extent(0) == N and X.extent(1) == nrhs);
+      EXPECTS(err.size() == 0 or err.size() == nrhs);
+      if (nrhs == 0) return 0.0;
+
+      // X = V * Diag(S_vec)^{-1} * UH * B
+      s.res.resize(M, nrhs);
+      s.uh_b.resize(N, nrhs);
+      s.res = B;
+      blas::gemm(T{1}, dagger(U), s.res, T{0}, s.uh_b);
+      blas::gemm(T{1}, V_x_InvS, s.uh_b, T{0}, X);
+
+      // the residual B - U * UH * B defines the error of the least square procedure
+      if (M == N) {
+        if (err.size() > 0) err = 0.0;
+        return 0.0;
+      }
+      blas::gemm(T{-1}, U, s.uh_b, T{1}, s.res);
+      double err_max = 0.0;
+      for (long j = 0; j < nrhs; ++j) {
+        double sum = 0.0;
+        auto *col  = s.res.data() + j * M;
+        for (long i = 0; i < M; ++i) sum += std::norm(col[i]);
+        double e = std::sqrt(sum / static_cast<double>(M));
+        if (err.size() > 0) err(j) = e;
+        err_max = std::max(err_max, e);
+      }
+      return err_max;
+    }
+
     public:
     /**
      * @brief Get the number of variables of the given problem.
@@ -99,47 +142,64 @@ namespace nda::lapack {
      * @brief Construct a new worker object for a given matrix \f$ \mathbf{A} \f$ .
      *
      * @details It performs the SVD decomposition of the given matrix \f$ \mathbf{A} \f$  and calculates the (pseudo)
-     * inverse of \f$ \mathbf{A} \f$. Furthermore, it sets the null space term which determines the error of the least
-     * square problem.
+     * inverse of \f$ \mathbf{A} \f$. Furthermore, it stores the left singular vectors which determine the error of the
+     * least square problem.
+     *
+     * Only the economy size SVD is computed, i.e. the memory required by the worker scales as O(MN) instead of O(M^2).
      *
      * @param A_ Matrix to be decomposed by SVD.
      */
-    gelss_worker(matrix<T> A_) : M(A_.extent(0)), N(A_.extent(1)), A(std::move(A_)), s_vec(std::min(M, N)) {
+    gelss_worker(matrix<T> A_) : M(A_.extent(0)), N(A_.extent(1)), A(std::move(A_)), U(M, N), V_x_InvS(N, N), s_vec(std::min(M, N)) {
       if (N > M) NDA_RUNTIME_ERROR << "Error in nda::lapack::gelss_worker: Matrix A cannot have more columns than rows";
 
-      // initialize matrices
+      // calculate the thin SVD: A = U * Diag(S_vec) * VH
       matrix<T, F_layout> A_FL{A};
-      matrix<T, F_layout> U(M, M);
       matrix<T, F_layout> VH(N, N);
+      gesvd(A_FL, s_vec, U, VH, 'S');
 
-      // calculate the SVD: A = U * Diag(S_vec) * VH
-      gesvd(A_FL, s_vec, U, VH);
-
-      // calculate the matrix V * Diag(S_vec)^{-1} * UH for the least square procedure
-      matrix<double, F_layout> S_inv(N, M);
-      S_inv = 0.;
-      for (long i : range(std::min(M, N))) S_inv(i, i) = 1.0 / s_vec(i);
-      V_x_InvS_x_UH = dagger(VH) * S_inv * dagger(U);
-
-      // read off UH_Null for defining the error of the least square procedure
-      if (N < M) UH_NULL = dagger(U)(range(N, M), range(M));
+      // calculate the matrix V * Diag(S_vec)^{-1} for the least square procedure
+      for (long j : range(N))
+        for (long i : range(N)) V_x_InvS(i, j) = nda::conj(VH(j, i)) / s_vec(j);
     }
 
     /**
      * @brief Solve the least-square problem for a given right hand side matrix \f$ \mathbf{B} \f$.
      *
+     * @details The solution and the residual of all columns are computed with three calls to nda::blas::gemm. The error
+     * is the maximum over the columns \f$ \mathbf{b}_j \f$ of \f$ |\mathbf{b}_j - \mathbf{U U}^H \mathbf{b}_j|_2 /
+     * \sqrt{M} \f$.
+     *
      * @param B Right hand side matrix.
      * @return A std::pair containing the solution matrix \f$ \mathbf{X} \f$ and the error of the least square problem.
      */
     std::pair<matrix<T>, double> operator()(matrix_const_view<T> B, std::optional<long> /* inner_matrix_dim */ = {}) const {
-      using std::sqrt;
-      double err = 0.0;
-      if (M != N) {
-        std::vector<double> err_vec;
-        for (long i : range(B.shape()[1])) err_vec.push_back(frobenius_norm(UH_NULL * B(range::all, range(i, i + 1))) / sqrt(B.shape()[0]));
-        err = *std::max_element(err_vec.begin(), err_vec.end());
-      }
-      return std::make_pair(V_x_InvS_x_UH * B, err);
+      auto X   = matrix<T>(N, B.extent(1));
+      auto err = array<double, 1>{};
+      auto s   = scratch_t{};
+      double e = solve(B, X, err, s);
+      return std::make_pair(std::move(X), e);
+    }
+
+    /**
+     * @brief Solve the least-square problem for a given right hand side matrix \f$ \mathbf{B} \f$ and write the result
+     * into caller-provided buffers.
+     *
+     * @details Apart from two intermediate matrices of size N-by-K and M-by-K, where K is the number of right hand sides,
+     * no memory is allocated.
+     *
+     * @tparam XM nda::MemoryMatrix type.
+     * @tparam E nda::MemoryVector type.
+     * @param B Right hand side matrix.
+     * @param X Output matrix. The N-by-K solution matrix \f$ \mathbf{X} \f$ (it needs to have unit stride in one of its
+     * dimensions).
+     * @param err Output vector. The error of the least square problem for each of the K columns of \f$ \mathbf{B} \f$.
+     * @return Maximum error over all columns.
+     */
+    template <MemoryMatrix XM, MemoryVector E>
+      requires(std::is_same_v<get_value_t<XM>, T> and std::is_same_v<get_value_t<E>, double>)
+    double operator()(matrix_const_view<T> B, XM &&X, E &&err) const { // NOLINT (temporary views are allowed here)
+      auto s = scratch_t{};
+      return solve(B, X, err, s);
     }
 
     /**
@@ -150,9 +210,31 @@ namespace nda::lapack {
      */
     std::pair<vector<T>, double> operator()(vector_const_view<T> b, std::optional<long> /*inner_matrix_dim*/ = {}) const {
       using std::sqrt;
+      auto uh_b  = vector<T>{dagger(U) * b};
       double err = 0.0;
-      if (M != N) { err = norm(UH_NULL * b) / sqrt(b.size()); }
-      return std::make_pair(V_x_InvS_x_UH * b, err);
+      if (M != N) { err = norm(b - U * uh_b) / sqrt(b.size()); }
+      return std::make_pair(vector<T>{V_x_InvS * uh_b}, err);
+    }
+
+    /**
+     * @brief Solve the least-square problem for many right hand side matrices.
+     *
+     * @details The problems are distributed over the OpenMP threads (see nda::blas::scoped_num_threads), where each
+     * thread reuses its intermediate buffers for all its right hand sides.
+     *
+     * @param Bs std::vector of right hand side matrices.
+     * @return std::vector containing a std::pair of the solution matrix and the error for each right hand side.
+     */
+    std::vector<std::pair<matrix<T>, double>> solve_batch(std::vector<matrix<T>> const &Bs) const {
+      auto res = std::vector<std::pair<matrix<T>, double>>(Bs.size());
+      blas::detail::parallel_batch(
+         static_cast<long>(Bs.size()), [] { return std::make_pair(scratch_t{}, array<double, 1>{}); },
+         [&](auto &state, long i) {
+           auto &[X, e] = res[i];
+           X.resize(N, Bs[i].extent(1));
+           e = solve(Bs[i], X, state.second, state.first);
+         });
+      return res;
     }
   };
 
@@ -0,0 +1,140 @@
+// Copyright (c) 2024 Simons Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file
+ * @brief Provides a generic interface to the LAPACK `gesdd` routine.
+ */
+
+#pragma once
+
+#include "./interface/cxx_interface.hpp"
+#include "./workspace.hpp"
+#include "../concepts.hpp"
+#include "../exceptions.hpp"
+#include "../macros.hpp"
+#include "../mem/address_space.hpp"
+#include "../traits.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace nda::lapack {
+
+  /**
+   * @addtogroup linalg_lapack
+   * @{
+   */
+
+  /**
+   * @brief Interface to the LAPACK `gesdd` routine.
+   *
+   * @details Computes the singular value decomposition (SVD) \f$ \mathbf{A} = \mathbf{U} \mathbf{S} \mathbf{V}^H \f$
+   * of a real or complex m-by-n matrix \f$ \mathbf{A} \f$ using a divide and conquer algorithm. If the singular vectors
+   * are requested, it is usually considerably faster than nda::lapack::gesvd for large matrices at the cost of a larger
+   * workspace.
+   *
+   * The parameter `jobz` determines which parts of \f$ \mathbf{U} \f$ and \f$ \mathbf{V}^H \f$ are computed (see
+   * nda::lapack::gesvd):
+   * - `jobz == 'A'`: all m columns of \f$ \mathbf{U} \f$ and all n rows of \f$ \mathbf{V}^H \f$,
+   * - `jobz == 'S'` (economy size): the first `min(m,n)` columns of \f$ \mathbf{U} \f$ and the first `min(m,n)` rows
+   * of \f$ \mathbf{V}^H \f$,
+   * - `jobz == 'N'`: only the singular values, `u` and `vt` are not referenced and can be empty.
+   *
+   * The optimal size of the `work` buffer is obtained from a workspace query. All buffers are taken from the given
+   * nda::lapack::workspace, so that repeated calls with the same workspace and problem size do not allocate.
+   *
+   * @tparam A nda::MemoryMatrix type.
+   * @tparam S nda::MemoryVector type.
+   * @tparam U nda::MemoryMatrix type.
+   * @tparam VT nda::MemoryMatrix type.
+   * @param a Input/output matrix. On entry, the m-by-n matrix \f$ \mathbf{A} \f$. On exit, the contents of
+   * \f$ \mathbf{A} \f$ are destroyed.
+   * @param s Output vector. The singular values of \f$ \mathbf{A} \f$, sorted so that `s(i) >= s(i+1)`.
+   * @param u Output matrix. It contains \f$ \mathbf{U} \f$ or its first `min(m,n)` columns.
+   * @param vt Output matrix. It contains \f$ \mathbf{V}^H \f$ or its first `min(m,n)` rows.
+   * @param ws nda::lapack::workspace used for the `work`, `rwork` and `iwork` buffers.
+   * @param jobz Computation mode for the singular vectors (see above).
+   * @return Integer return code from the LAPACK call.
+   */
+  template <MemoryMatrix A, MemoryVector S, MemoryMatrix U, MemoryMatrix VT>
+    requires(have_same_value_type_v<A, U, VT> and mem::on_host<A, S, U, VT> and is_blas_lapack_v<get_value_t<A>>)
+  int gesdd(A &&a, S &&s, U &&u, VT &&vt, workspace<get_value_t<A>> &ws, char jobz = 'A') { // NOLINT (temporary views are allowed here)
+    static_assert(has_F_layout<A> and has_F_layout<U> and has_F_layout<VT>, "Error in nda::lapack::gesdd: C order not supported");
+
+    int m = a.extent(0), n = a.extent(1);
+    int mn = std::min(m, n), mx = std::max(m, n);
+    if (s.size() < mn) s.resize(mn);
+
+    // runtime checks
+    EXPECTS(jobz == 'A' or jobz == 'S' or jobz == 'N');
+    if (jobz != 'N') {
+      EXPECTS(u.extent(0) == m and u.extent(1) == (jobz == 'A' ? m : mn));
+      EXPECTS(vt.extent(0) == (jobz == 'A' ? n : mn) and vt.extent(1) == n);
+      EXPECTS(u.indexmap().min_stride() == 1);
+      EXPECTS(vt.indexmap().min_stride() == 1);
+    }
+    EXPECTS(a.indexmap().min_stride() == 1);
+    EXPECTS(s.indexmap().min_stride() == 1);
+    int ldu  = (jobz == 'N' ? 1 : std::max(1, get_ld(u)));
+    int ldvt = (jobz == 'N' ? 1 : std::max(1, get_ld(vt)));
+
+    // rwork (only used by zgesdd) and iwork have fixed sizes
+    double *rwork = nullptr;
+    if constexpr (is_complex_v<get_value_t<A>>) {
+      long lrwork = (jobz == 'N' ? 7l * mn : std::max(5l * mn * mn + 5l * mn, 2l * mx * mn + 2l * mn * mn + mn));
+      rwork       = ws.rwork(std::max(1l, lrwork));
+    }
+    int *iwork = ws.iwork(std::max(1, 8 * mn));
+
+    // first call to get the optimal buffersize
+    using value_type = get_value_t<A>;
+    value_type bufferSize_T{};
+    int info = 0;
+    f77::gesdd(jobz, m, n, a.data(), get_ld(a), s.data(), u.data(), ldu, vt.data(), ldvt, &bufferSize_T, -1, rwork, iwork, info);
+    int bufferSize = lwork_from_query(bufferSize_T);
+
+    // get the work buffer and perform actual library call
+    f77::gesdd(jobz, m, n, a.data(), get_ld(a), s.data(), u.data(), ldu, vt.data(), ldvt, ws.work(bufferSize), bufferSize, rwork, iwork, info);
+
+    if (info) NDA_RUNTIME_ERROR << "Error in nda::lapack::gesdd: info = " << info;
+    return info;
+  }
+
+  /**
+   * @brief Interface to the LAPACK `gesdd` routine with a temporary workspace.
+   *
+   * @details See nda::lapack::gesdd(A &&, S &&, U &&, VT &&, workspace<get_value_t<A>> &, char).
+   *
+   * @tparam A nda::MemoryMatrix type.
+   * @tparam S nda::MemoryVector type.
+   * @tparam U nda::MemoryMatrix type.
+   * @tparam VT nda::MemoryMatrix type.
+   * @param a Input/output matrix.
+   * @param s Output vector of singular values.
+   * @param u Output matrix of left singular vectors.
+   * @param vt Output matrix of right singular vectors.
+   * @param jobz Computation mode for the singular vectors: all (`'A'`), economy size (`'S'`) or none (`'N'`).
+   * @return Integer return code from the LAPACK call.
+   */
+  template <MemoryMatrix A, MemoryVector S, MemoryMatrix U, MemoryMatrix VT>
+    requires(have_same_value_type_v<A, U, VT> and mem::on_host<A, S, U, VT> and is_blas_lapack_v<get_value_t<A>>)
+  int gesdd(A &&a, S &&s, U &&u, VT &&vt, char jobz = 'A') { // NOLINT (temporary views are allowed here)
+    auto ws = workspace<get_value_t<A>>{};
+    return gesdd(std::forward<A>(a), std::forward<S>(s), std::forward<U>(u), std::forward<VT>(vt), ws, jobz);
+  }
+
+  /** @} */
+
+} // namespace nda::lapack
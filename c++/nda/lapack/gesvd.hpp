@@ -22,6 +22,7 @@
 #pragma once
 
 #include "./interface/cxx_interface.hpp"
+#include "./workspace.hpp"
 #include "../concepts.hpp"
 #include "../declarations.hpp"
 #include "../exceptions.hpp"
@@ -36,8 +37,6 @@
 #endif // NDA_HAVE_DEVICE
 
 #include <algorithm>
-#include <cmath>
-#include <complex>
 #include <utility>
 
 namespace nda::lapack {
@@ -59,6 +58,17 @@ namespace nda::lapack {
    *
    * Note that the routine returns \f$ \mathbf{V}^H \f$, not \f$ \mathbf{V} \f$.
    *
+   * The parameter `job` determines which parts of \f$ \mathbf{U} \f$ and \f$ \mathbf{V}^H \f$ are computed:
+   * - `job == 'A'`: all m columns of \f$ \mathbf{U} \f$ and all n rows of \f$ \mathbf{V}^H \f$,
+   * - `job == 'S'` (economy size): the first `min(m,n)` columns of \f$ \mathbf{U} \f$ and the first `min(m,n)` rows
+   * of \f$ \mathbf{V}^H \f$, i.e. only the singular vectors,
+   * - `job == 'N'`: only the singular values, `u` and `vt` are not referenced and can be empty.
+   *
+   * For a tall m-by-n matrix with m >> n, the economy size SVD requires O(mn) instead of O(m^2) memory.
+   *
+   * The optimal size of the `work` buffer is obtained from a workspace query. The buffers are taken from the given
+   * nda::lapack::workspace, so that repeated calls with the same workspace and problem size do not allocate.
+   *
    * @tparam A nda::MemoryMatrix type.
    * @tparam S nda::MemoryVector type.
    * @tparam U nda::MemoryMatrix type.
@@ -66,23 +76,38 @@ namespace nda::lapack {
    * @param a Input/output matrix. On entry, the m-by-n matrix \f$ \mathbf{A} \f$. On exit, the contents of
    * \f$ \mathbf{A} \f$ are destroyed.
    * @param s Output vector. The singular values of \f$ \mathbf{A} \f$, sorted so that `s(i) >= s(i+1)`.
-   * @param u Output matrix. It contains the m-by-m unitary matrix \f$ \mathbf{U} \f$.
-   * @param vt Output matrix. It contains contains the n-by-n unitary matrix \f$ \mathbf{V}^H \f$.
+   * @param u Output matrix. It contains the m-by-m unitary matrix \f$ \mathbf{U} \f$ (`job == 'A'`) or its first
+   * `min(m,n)` columns (`job == 'S'`).
+   * @param vt Output matrix. It contains contains the n-by-n unitary matrix \f$ \mathbf{V}^H \f$ (`job == 'A'`) or its
+   * first `min(m,n)` rows (`job == 'S'`).
+   * @param ws nda::lapack::workspace used for the `work` and `rwork` buffers.
+   * @param job Computation mode for the singular vectors (see above).
    * @return Integer return code from the LAPACK call.
    */
   template <MemoryMatrix A, MemoryVector S, MemoryMatrix U, MemoryMatrix VT>
     requires(have_same_value_type_v<A, U, VT> and mem::have_compatible_addr_space<A, S, U, VT> and is_blas_lapack_v<get_value_t<A>>)
-  int gesvd(A &&a, S &&s, U &&u, VT &&vt) { // NOLINT (temporary views are allowed here)
+  int gesvd(A &&a, S &&s, U &&u, VT &&vt, workspace<get_value_t<A>, mem::get_addr_space<A>> &ws, // NOLINT (temporary views are allowed here)
+            char job = 'A') {
     static_assert(has_F_layout<A> and has_F_layout<U> and has_F_layout<VT>, "Error in nda::lapack::gesvd: C order not supported");
 
-    auto dm = std::min(a.extent(0), a.extent(1));
+    auto [m, n] = a.shape();
+    auto dm     = std::min(m, n);
     if (s.size() < dm) s.resize(dm);
 
+    // runtime checks
+    EXPECTS(job == 'A' or job == 'S' or job == 'N');
+    if (job != 'N') {
+      EXPECTS(u.extent(0) == m and u.extent(1) == (job == 'A' ? m : dm));
+      EXPECTS(vt.extent(0) == (job == 'A' ? n : dm) and vt.extent(1) == n);
+      EXPECTS(u.indexmap().min_stride() == 1);
+      EXPECTS(vt.indexmap().min_stride() == 1);
+    }
+
     // must be lapack compatible
     EXPECTS(a.indexmap().min_stride() == 1);
     EXPECTS(s.indexmap().min_stride() == 1);
-    EXPECTS(u.indexmap().min_stride() == 1);
-    EXPECTS(vt.indexmap().min_stride() == 1);
+    int ldu  = (job == 'N' ? 1 : std::max(1, get_ld(u)));
+    int ldvt = (job == 'N' ? 1 : std::max(1, get_ld(vt)));
 
     // call host/device implementation depending on input type
     auto gesvd_call = []<typename... Ts>(Ts &&...args) {
@@ -100,19 +125,40 @@ namespace nda::lapack {
     // first call to get the optimal buffersize
     using value_type = get_value_t<A>;
     value_type bufferSize_T{};
-    auto rwork = array<double, 1, C_layout, heap<mem::get_addr_space<A>>>(5 * dm);
-    int info   = 0;
-    gesvd_call('A', 'A', a.extent(0), a.extent(1), a.data(), get_ld(a), s.data(), u.data(), get_ld(u), vt.data(), get_ld(vt), &bufferSize_T, -1,
-               rwork.data(), info);
-    int bufferSize = static_cast<int>(std::ceil(std::real(bufferSize_T)));
+    auto *rwork = ws.rwork(5 * dm);
+    int info    = 0;
+    gesvd_call(job, job, m, n, a.data(), get_ld(a), s.data(), u.data(), ldu, vt.data(), ldvt, &bufferSize_T, -1, rwork, info);
+    int bufferSize = lwork_from_query(bufferSize_T);
 
-    // allocate work buffer and perform actual library call
-    nda::array<value_type, 1, C_layout, heap<mem::get_addr_space<A>>> work(bufferSize);
-    gesvd_call('A', 'A', a.extent(0), a.extent(1), a.data(), get_ld(a), s.data(), u.data(), get_ld(u), vt.data(), get_ld(vt), work.data(), bufferSize,
-               rwork.data(), info);
+    // get the work buffer and perform actual library call
+    gesvd_call(job, job, m, n, a.data(), get_ld(a), s.data(), u.data(), ldu, vt.data(), ldvt, ws.work(bufferSize), bufferSize, rwork, info);
 
     if (info) NDA_RUNTIME_ERROR << "Error in nda::lapack::gesvd: info = " << info;
     return info;
   }
 
+  /**
+   * @ingroup linalg_lapack
+   * @brief Interface to the LAPACK `gesvd` routine with a temporary workspace.
+   *
+   * @details See nda::lapack::gesvd(A &&, S &&, U &&, VT &&, workspace<get_value_t<A>, mem::get_addr_space<A>> &, char).
+   *
+   * @tparam A nda::MemoryMatrix type.
+   * @tparam S nda::MemoryVector type.
+   * @tparam U nda::MemoryMatrix type.
+   * @tparam VT nda::MemoryMatrix type.
+   * @param a Input/output matrix.
+   * @param s Output vector of singular values.
+   * @param u Output matrix of left singular vectors.
+   * @param vt Output matrix of right singular vectors.
+   * @param job Computation mode for the singular vectors: all (`'A'`), economy size (`'S'`) or none (`'N'`).
+   * @return Integer return code from the LAPACK call.
+   */
+  template <MemoryMatrix A, MemoryVector S, MemoryMatrix U, MemoryMatrix VT>
+    requires(have_same_value_type_v<A, U, VT> and mem::have_compatible_addr_space<A, S, U, VT> and is_blas_lapack_v<get_value_t<A>>)
+  int gesvd(A &&a, S &&s, U &&u, VT &&vt, char job = 'A') { // NOLINT (temporary views are allowed here)
+    auto ws = workspace<get_value_t<A>, mem::get_addr_space<A>>{};
+    return gesvd(std::forward<A>(a), std::forward<S>(s), std::forward<U>(u), std::forward<VT>(vt), ws, job);
+  }
+
 } // namespace nda::lapack
@@ -22,6 +22,7 @@
 #pragma once
 
 #include "./interface/cxx_interface.hpp"
+#include "./workspace.hpp"
 #include "../concepts.hpp"
 #include "../declarations.hpp"
 #include "../exceptions.hpp"
@@ -30,9 +31,8 @@
 #include "../traits.hpp"
 
 #include <algorithm>
-#include <cmath>
-#include <complex>
 #include <type_traits>
+#include <utility>
 
 namespace nda::lapack {
 
@@ -45,6 +45,9 @@ namespace nda::lapack {
    * This method inverts \f$ \mathbf{U} \f$ and then computes \f$ \mathrm{inv}(\mathbf{A}) \f$ by solving the system
    * \f$ \mathrm{inv}(\mathbf{A}) L = \mathrm{inv}(\mathbf{U}) \f$ for \f$ \mathrm{inv}(\mathbf{A}) \f$.
    *
+   * On the host, the optimal size of the `work` buffer is obtained from a workspace query and the buffer is taken from
+   * the given nda::lapack::workspace.
+   *
    * @tparam A nda::MemoryMatrix type.
    * @tparam IPIV nda::MemoryVector type.
    * @param a Input/output matrix. On entry, the factors \f$ \mathbf{L} \f$ and \f$ \mathbf{U} \f$ from the
@@ -52,11 +55,12 @@ namespace nda::lapack {
    * the original matrix \f$ \mathbf{A} \f$.
    * @param ipiv Input vector. The pivot indices from `getrf`, i.e. for `1 <= i <= N`, row i of the matrix was
    * interchanged with row `ipiv(i)`.
+   * @param ws nda::lapack::workspace used for the `work` buffer (only on the host).
    * @return Integer return code from the LAPACK call.
    */
   template <MemoryMatrix A, MemoryVector IPIV>
     requires(mem::have_compatible_addr_space<A, IPIV> and is_blas_lapack_v<get_value_t<A>>)
-  int getri(A &&a, IPIV const &ipiv) { // NOLINT (temporary views are allowed here)
+  int getri(A &&a, IPIV const &ipiv, workspace<get_value_t<A>> &ws) { // NOLINT (temporary views are allowed here)
     static_assert(std::is_same_v<get_value_t<IPIV>, int>, "Error in nda::lapack::getri: Pivoting array must have elements of type int");
     auto dm = std::min(a.extent(0), a.extent(1));
 
@@ -79,18 +83,37 @@ namespace nda::lapack {
       using value_type = get_value_t<A>;
       value_type bufferSize_T{};
       f77::getri(a.extent(0), a.data(), get_ld(a), ipiv.data(), &bufferSize_T, -1, info);
-      int bufferSize = static_cast<int>(std::ceil(std::real(bufferSize_T)));
+      int bufferSize = lwork_from_query(bufferSize_T);
 
-      // allocate work buffer and perform actual library call
-      array<value_type, 1> work(bufferSize);
+      // get the work buffer and perform actual library call
+      auto *work = ws.work(bufferSize);
 #if defined(__has_feature)
 #if __has_feature(memory_sanitizer)
-      work = 0;
+      std::fill(work, work + bufferSize, value_type{});
 #endif
 #endif
-      f77::getri(a.extent(0), a.data(), get_ld(a), ipiv.data(), work.data(), bufferSize, info);
+      f77::getri(a.extent(0), a.data(), get_ld(a), ipiv.data(), work, bufferSize, info);
     }
     return info;
   }
 
+  /**
+   * @ingroup linalg_lapack
+   * @brief Interface to the LAPACK `getri` routine with a temporary workspace.
+   *
+   * @details See nda::lapack::getri(A &&, IPIV const &, workspace<get_value_t<A>> &).
+   *
+   * @tparam A nda::MemoryMatrix type.
+   * @tparam IPIV nda::MemoryVector type.
+   * @param a Input/output matrix.
+   * @param ipiv Input vector of pivot indices from `getrf`.
+   * @return Integer return code from the LAPACK call.
+   */
+  template <MemoryMatrix A, MemoryVector IPIV>
+    requires(mem::have_compatible_addr_space<A, IPIV> and is_blas_lapack_v<get_value_t<A>>)
+  int getri(A &&a, IPIV const &ipiv) { // NOLINT (temporary views are allowed here)
+    auto ws = workspace<get_value_t<A>>{};
+    return getri(std::forward<A>(a), ipiv, ws);
+  }
+
 } // namespace nda::lapack
@@ -0,0 +1,178 @@
+// Copyright (c) 2024 Simons Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file
+ * @brief Provides a generic interface to the LAPACK `ggev` routine.
+ */
+
+#pragma once
+
+#include "./interface/cxx_interface.hpp"
+#include "./workspace.hpp"
+#include "../concepts.hpp"
+#include "../exceptions.hpp"
+#include "../macros.hpp"
+#include "../mem/address_space.hpp"
+#include "../traits.hpp"
+
+#include <complex>
+#include <type_traits>
+#include <utility>
+
+namespace nda::lapack {
+
+  /**
+   * @addtogroup linalg_lapack
+   * @{
+   */
+
+  /**
+   * @brief Interface to the LAPACK `ggev` routine.
+   *
+   * @details Computes the generalized eigenvalues and, optionally, the left and/or right generalized eigenvectors of a
+   * pair of general real or complex n-by-n matrices \f$ (\mathbf{A}, \mathbf{B}) \f$. The right eigenvectors
+   * \f$ \mathbf{v}_j \f$ and left eigenvectors \f$ \mathbf{u}_j \f$ satisfy
+   * \f[
+   *   \mathbf{A} \mathbf{v}_j = \lambda_j \mathbf{B} \mathbf{v}_j \quad \text{and} \quad \mathbf{u}_j^H \mathbf{A} =
+   *   \lambda_j \mathbf{u}_j^H \mathbf{B} \; ,
+   * \f]
+   * where the eigenvalues are returned as ratios \f$ \lambda_j = \alpha_j / \beta_j \f$. If \f$ \beta_j = 0 \f$, the
+   * eigenvalue is infinite (which happens e.g. for singular \f$ \mathbf{B} \f$). The eigenvectors of real matrices are
+   * stored in the same compact format as in nda::lapack::geev.
+   *
+   * For hermitian \f$ \mathbf{A} \f$ and hermitian positive definite \f$ \mathbf{B} \f$, nda::lapack::hegvd should be
+   * used instead.
+   *
+   * The optimal size of the `work` buffer is obtained from a workspace query. All buffers are taken from the given
+   * nda::lapack::workspace, so that repeated calls with the same workspace and problem size do not allocate.
+   *
+   * @tparam A nda::MemoryMatrix type.
+   * @tparam B nda::MemoryMatrix type.
+   * @tparam ALPHA nda::MemoryVector type.
+   * @tparam BETA nda::MemoryVector type.
+   * @tparam VL nda::MemoryMatrix type.
+   * @tparam VR nda::MemoryMatrix type.
+   * @param a Input/output matrix. On entry, the n-by-n matrix \f$ \mathbf{A} \f$. On exit, its content is destroyed.
+   * @param b Input/output matrix. On entry, the n-by-n matrix \f$ \mathbf{B} \f$. On exit, its content is destroyed.
+   * @param alpha Output vector of size n. The (complex) numerators \f$ \alpha_j \f$ of the eigenvalues.
+   * @param beta Output vector of size n. The denominators \f$ \beta_j \f$ of the eigenvalues.
+   * @param vl Output matrix. If `jobvl == 'V'`, the n-by-n matrix of left eigenvectors. Otherwise, it is not referenced.
+   * @param vr Output matrix. If `jobvr == 'V'`, the n-by-n matrix of right eigenvectors. Otherwise, it is not
+   * referenced.
+   * @param ws nda::lapack::workspace used for the `work` and `rwork` buffers.
+   * @param jobvl Compute the left eigenvectors (`jobvl == 'V'`) or not (`jobvl == 'N'`).
+   * @param jobvr Compute the right eigenvectors (`jobvr == 'V'`) or not (`jobvr == 'N'`).
+   * @return Integer return code from the LAPACK call.
+   */
+  template <MemoryMatrix A, MemoryMatrix B, MemoryVector ALPHA, MemoryVector BETA, MemoryMatrix VL, MemoryMatrix VR>
+    requires(mem::on_host<A, B, ALPHA, BETA, VL, VR> and have_same_value_type_v<A, B, BETA, VL, VR> and is_blas_lapack_v<get_value_t<A>>
+             and std::is_same_v<get_value_t<ALPHA>, std::complex<double>>)
+  int ggev(A &&a, B &&b, ALPHA &&alpha, BETA &&beta, VL &&vl, VR &&vr, workspace<get_value_t<A>> &ws, // NOLINT (temporary views are allowed here)
+           char jobvl = 'N', char jobvr = 'V') {
+    static_assert(has_F_layout<A> and has_F_layout<B> and has_F_layout<VL> and has_F_layout<VR>,
+                  "Error in nda::lapack::ggev: C order not supported");
+
+    // runtime checks
+    EXPECTS(jobvl == 'N' or jobvl == 'V');
+    EXPECTS(jobvr == 'N' or jobvr == 'V');
+    EXPECTS(a.extent(0) == a.extent(1));
+    EXPECTS(b.shape() == a.shape());
+    EXPECTS(alpha.size() >= a.extent(0));
+    EXPECTS(beta.size() >= a.extent(0));
+    EXPECTS(a.indexmap().min_stride() == 1);
+    EXPECTS(b.indexmap().min_stride() == 1);
+    EXPECTS(beta.indexmap().min_stride() == 1);
+
+    int n = a.extent(0);
+    if (n == 0) return 0;
+
+    int ldvl = 1, ldvr = 1;
+    if (jobvl == 'V') {
+      EXPECTS(vl.extent(0) == n and vl.extent(1) == n);
+      EXPECTS(vl.indexmap().min_stride() == 1);
+      ldvl = get_ld(vl);
+    }
+    if (jobvr == 'V') {
+      EXPECTS(vr.extent(0) == n and vr.extent(1) == n);
+      EXPECTS(vr.indexmap().min_stride() == 1);
+      ldvr = get_ld(vr);
+    }
+
+    // call the correct LAPACK routine (the real and imaginary parts of alpha for real matrices are stored in the rwork
+    // buffer)
+    using value_type = get_value_t<A>;
+    int info         = 0;
+    double *rwork    = ws.rwork(8 * n);
+    auto call        = [&](value_type *work, int lwork) {
+      if constexpr (is_complex_v<value_type>) {
+        EXPECTS(alpha.indexmap().min_stride() == 1);
+        f77::ggev(jobvl, jobvr, n, a.data(), get_ld(a), b.data(), get_ld(b), alpha.data(), beta.data(), vl.data(), ldvl, vr.data(), ldvr, work,
+                  lwork, rwork, info);
+      } else {
+        f77::ggev(jobvl, jobvr, n, a.data(), get_ld(a), b.data(), get_ld(b), rwork, rwork + n, beta.data(), vl.data(), ldvl, vr.data(), ldvr, work,
+                  lwork, info);
+      }
+    };
+
+    // first call to get the optimal buffersize
+    value_type bufferSize_T{};
+    call(&bufferSize_T, -1);
+    int bufferSize = lwork_from_query(bufferSize_T);
+
+    // get the work buffer and perform actual library call
+    call(ws.work(bufferSize), bufferSize);
+    if constexpr (not is_complex_v<value_type>) {
+      for (int i = 0; i < n; ++i) alpha(i) = std::complex<double>{rwork[i], rwork[n + i]};
+    }
+
+    if (info) NDA_RUNTIME_ERROR << "Error in nda::lapack::ggev: info = " << info;
+    return info;
+  }
+
+  /**
+   * @brief Interface to the LAPACK `ggev` routine with a temporary workspace.
+   *
+   * @details See nda::lapack::ggev(A &&, B &&, ALPHA &&, BETA &&, VL &&, VR &&, workspace<get_value_t<A>> &, char,
+   * char).
+   *
+   * @tparam A nda::MemoryMatrix type.
+   * @tparam B nda::MemoryMatrix type.
+   * @tparam ALPHA nda::MemoryVector type.
+   * @tparam BETA nda::MemoryVector type.
+   * @tparam VL nda::MemoryMatrix type.
+   * @tparam VR nda::MemoryMatrix type.
+   * @param a Input/output matrix \f$ \mathbf{A} \f$.
+   * @param b Input/output matrix \f$ \mathbf{B} \f$.
+   * @param alpha Output vector of eigenvalue numerators.
+   * @param beta Output vector of eigenvalue denominators.
+   * @param vl Output matrix of left eigenvectors.
+   * @param vr Output matrix of right eigenvectors.
+   * @param jobvl Compute the left eigenvectors (`jobvl == 'V'`) or not (`jobvl == 'N'`).
+   * @param jobvr Compute the right eigenvectors (`jobvr == 'V'`) or not (`jobvr == 'N'`).
+   * @return Integer return code from the LAPACK call.
+   */
+  template <MemoryMatrix A, MemoryMatrix B, MemoryVector ALPHA, MemoryVector BETA, MemoryMatrix VL, MemoryMatrix VR>
+    requires(mem::on_host<A, B, ALPHA, BETA, VL, VR> and have_same_value_type_v<A, B, BETA, VL, VR> and is_blas_lapack_v<get_value_t<A>>
+             and std::is_same_v<get_value_t<ALPHA>, std::complex<double>>)
+  int ggev(A &&a, B &&b, ALPHA &&alpha, BETA &&beta, VL &&vl, VR &&vr, char jobvl = 'N', // NOLINT (temporary views are allowed here)
+           char jobvr = 'V') {
+    auto ws = workspace<get_value_t<A>>{};
+    return ggev(std::forward<A>(a), std::forward<B>(b), std::forward<ALPHA>(alpha), std::forward<BETA>(beta), std::forward<VL>(vl),
+                std::forward<VR>(vr), ws, jobvl, jobvr);
+  }
+
+  /** @} */
+
+} // namespace nda::lapack
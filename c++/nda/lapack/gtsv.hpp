@@ -16,17 +16,23 @@
 
 /**
  * @file
- * @brief Provides a generic interface to the LAPACK `gtsv` routine.
+ * @brief Provides a generic interface to the LAPACK `gtsv` routine and a batched version of it.
  */
 
 #pragma once
 
 #include "./interface/cxx_interface.hpp"
+#include "../basic_array.hpp"
+#include "../blas/threads.hpp"
 #include "../concepts.hpp"
+#include "../declarations.hpp"
+#include "../exceptions.hpp"
 #include "../macros.hpp"
 #include "../mem/address_space.hpp"
 #include "../traits.hpp"
 
+#include <algorithm>
+
 namespace nda::lapack {
 
   /**
@@ -75,4 +81,56 @@ namespace nda::lapack {
     return info;
   }
 
+  /**
+   * @ingroup linalg_lapack
+   * @brief Solve a stack of independent tridiagonal systems with the LAPACK `gtsv` routine.
+   *
+   * @details For each `i`, it solves the equation
+   * \f[
+   *   \mathbf{A}_i \mathbf{x}_i = \mathbf{b}_i,
+   * \f]
+   * where \f$ \mathbf{A}_i \f$ is the n-by-n tridiagonal matrix with the sub-diagonal `dl(i, _)`, the diagonal `d(i, _)`
+   * and the super-diagonal `du(i, _)`, and \f$ \mathbf{b}_i \f$ is the right hand side `b(i, _)`. All arrays are
+   * overwritten in the same way as in nda::lapack::gtsv.
+   *
+   * The systems are distributed over the OpenMP threads, while the BLAS/LAPACK backend runs single-threaded (see
+   * nda::blas::scoped_num_threads). The rows of all arrays must be contiguous in memory, e.g. arrays in C order.
+   *
+   * @tparam DL nda::MemoryMatrix type.
+   * @tparam D nda::MemoryMatrix type.
+   * @tparam DU nda::MemoryMatrix type.
+   * @tparam B nda::MemoryMatrix type.
+   * @param dl Input/Output array of shape `(batch, n - 1)` containing the sub-diagonals.
+   * @param d Input/Output array of shape `(batch, n)` containing the diagonals.
+   * @param du Input/Output array of shape `(batch, n - 1)` containing the super-diagonals.
+   * @param b Input/Output array of shape `(batch, n)`. On entry, the right hand sides. On exit, the solutions of all
+   * systems with a zero return code.
+   * @return nda::array of rank 1 containing the integer return codes from the LAPACK calls.
+   */
+  template <MemoryMatrix DL, MemoryMatrix D, MemoryMatrix DU, MemoryMatrix B>
+    requires(have_same_value_type_v<DL, D, DU, B> and mem::on_host<DL, D, DU, B> and is_blas_lapack_v<get_value_t<DL>>)
+  array<int, 1> gtsv_batch(DL &&dl, D &&d, DU &&du, B &&b) { // NOLINT (temporary views are allowed here)
+    long const batch = d.extent(0);
+    long const n     = d.extent(1);
+    auto row_major   = [](auto const &x) { return x.extent(1) <= 1 or x.indexmap().strides()[1] == 1; };
+
+    // runtime checks
+    EXPECTS(dl.extent(0) == batch and du.extent(0) == batch and b.extent(0) == batch);
+    EXPECTS(dl.extent(1) == n - 1 and du.extent(1) == n - 1 and b.extent(1) == n);
+    if (not(row_major(dl) and row_major(d) and row_major(du) and row_major(b)))
+      NDA_RUNTIME_ERROR << "Error in nda::lapack::gtsv_batch: Rows of the arrays are not contiguous in memory";
+
+    // solve the systems in parallel
+    auto info = array<int, 1>(batch);
+    auto row  = [](auto &x, long i) { return x.data() + i * x.indexmap().strides()[0]; };
+    blas::detail::parallel_batch(
+       batch, [] { return 0; },
+       [&](int, long i) {
+         int info_i = 0;
+         f77::gtsv(n, 1, row(dl, i), row(d, i), row(du, i), row(b, i), std::max(1l, n), info_i);
+         info(i) = info_i;
+       });
+    return info;
+  }
+
 } // namespace nda::lapack
@@ -22,8 +22,54 @@
 // Extracted from Reference Lapack (https://github.com/Reference-LAPACK):
 #include "./lapack.h"
 #include "./cxx_interface.hpp"
+#include "../workspace.hpp"
+#include "../../blas/threads.hpp"
 
 #include <complex>
+#include <vector>
+
+#ifdef NDA_USE_MKL
+#include <mkl_version.h>
+#endif
+
+#if defined(NDA_USE_MKL) && INTEL_MKL_VERSION >= 20210000
+// batched LAPACK routines provided by MKL (>= 2021.1)
+extern "C" {
+void dgetrf_batch_strided(int const *m, int const *n, double *a, int const *lda, int const *stride_a, int *ipiv, int const *stride_ipiv,
+                          int const *batch_size, int *info);
+void zgetrf_batch_strided(int const *m, int const *n, std::complex<double> *a, int const *lda, int const *stride_a, int *ipiv,
+                          int const *stride_ipiv, int const *batch_size, int *info);
+void dgetri_oop_batch_strided(int const *n, double const *a, int const *lda, int const *stride_a, int const *ipiv, int const *stride_ipiv,
+                              double *ainv, int const *ldainv, int const *stride_ainv, int const *batch_size, int *info);
+void zgetri_oop_batch_strided(int const *n, std::complex<double> const *a, int const *lda, int const *stride_a, int const *ipiv,
+                              int const *stride_ipiv, std::complex<double> *ainv, int const *ldainv, int const *stride_ainv, int const *batch_size,
+                              int *info);
+}
+#endif
+
+namespace {
+
+  // getrf for each matrix in a strided batch distributed over the OpenMP threads
+  template <typename T>
+  void getrf_batch_strided_impl(int M, int N, T *A, int LDA, int strideA, int *ipiv, int stride_ipiv, int batch_count, int *info) {
+    nda::blas::detail::parallel_batch(
+       batch_count, [] { return 0; },
+       [&](int, long i) { nda::lapack::f77::getrf(M, N, A + i * strideA, LDA, ipiv + i * stride_ipiv, info[i]); });
+  }
+
+  // getri for each matrix in a strided batch distributed over the OpenMP threads (each thread owns a work buffer)
+  template <typename T>
+  void getri_batch_strided_impl(int N, T *A, int LDA, int strideA, int const *ipiv, int stride_ipiv, int batch_count, int *info) {
+    T bufferSize_T{};
+    int info_query = 0;
+    nda::lapack::f77::getri(N, A, LDA, ipiv, &bufferSize_T, -1, info_query);
+    int lwork = nda::lapack::lwork_from_query(bufferSize_T);
+    nda::blas::detail::parallel_batch(
+       batch_count, [lwork] { return std::vector<T>(lwork); },
+       [&](std::vector<T> &work, long i) { nda::lapack::f77::getri(N, A + i * strideA, LDA, ipiv + i * stride_ipiv, work.data(), lwork, info[i]); });
+  }
+
+} // namespace
 
 namespace nda::lapack::f77 {
 
@@ -45,6 +91,15 @@ namespace nda::lapack::f77 {
     LAPACK_zgesvd(&JOBU, &JOBVT, &M, &N, A, &LDA, S, U, &LDU, VT, &LDVT, WORK, &LWORK, RWORK, &INFO);
   }
 
+  void gesdd(char JOBZ, int M, int N, double *A, int LDA, double *S, double *U, int LDU, double *VT, int LDVT, double *WORK, int LWORK,
+             [[maybe_unused]] double *RWORK, int *IWORK, int &INFO) {
+    LAPACK_dgesdd(&JOBZ, &M, &N, A, &LDA, S, U, &LDU, VT, &LDVT, WORK, &LWORK, IWORK, &INFO);
+  }
+  void gesdd(char JOBZ, int M, int N, std::complex<double> *A, int LDA, double *S, std::complex<double> *U, int LDU, std::complex<double> *VT,
+             int LDVT, std::complex<double> *WORK, int LWORK, double *RWORK, int *IWORK, int &INFO) {
+    LAPACK_zgesdd(&JOBZ, &M, &N, A, &LDA, S, U, &LDU, VT, &LDVT, WORK, &LWORK, RWORK, IWORK, &INFO);
+  }
+
   void geqp3(int M, int N, double *A, int LDA, int *JPVT, double *TAU, double *WORK, int LWORK, [[maybe_unused]] double *RWORK, int &INFO) {
     LAPACK_dgeqp3(&M, &N, A, &LDA, JPVT, TAU, WORK, &LWORK, &INFO);
   }
@@ -71,6 +126,60 @@ namespace nda::lapack::f77 {
     LAPACK_zgetri(&N, A, &LDA, ipiv, work, &lwork, &info);
   }
 
+  void getrf_batch_strided(int M, int N, double *A, int LDA, int strideA, int *ipiv, int stride_ipiv, int batch_count, int *info) {
+#if defined(NDA_USE_MKL) && INTEL_MKL_VERSION >= 20210000
+    dgetrf_batch_strided(&M, &N, A, &LDA, &strideA, ipiv, &stride_ipiv, &batch_count, info);
+#else
+    getrf_batch_strided_impl(M, N, A, LDA, strideA, ipiv, stride_ipiv, batch_count, info);
+#endif
+  }
+  void getrf_batch_strided(int M, int N, std::complex<double> *A, int LDA, int strideA, int *ipiv, int stride_ipiv, int batch_count, int *info) {
+#if defined(NDA_USE_MKL) && INTEL_MKL_VERSION >= 20210000
+    zgetrf_batch_strided(&M, &N, A, &LDA, &strideA, ipiv, &stride_ipiv, &batch_count, info);
+#else
+    getrf_batch_strided_impl(M, N, A, LDA, strideA, ipiv, stride_ipiv, batch_count, info);
+#endif
+  }
+
+  void getri_batch_strided(int N, double *A, int LDA, int strideA, int const *ipiv, int stride_ipiv, int batch_count, int *info) {
+#if defined(NDA_USE_MKL) && INTEL_MKL_VERSION >= 20210000
+    // MKL only provides an out-of-place version
+    auto A_copy = std::vector<double>(A, A + static_cast<long>(batch_count - 1) * strideA + static_cast<long>(LDA) * N);
+    dgetri_oop_batch_strided(&N, A_copy.data(), &LDA, &strideA, ipiv, &stride_ipiv, A, &LDA, &strideA, &batch_count, info);
+#else
+    getri_batch_strided_impl(N, A, LDA, strideA, ipiv, stride_ipiv, batch_count, info);
+#endif
+  }
+  void getri_batch_strided(int N, std::complex<double> *A, int LDA, int strideA, int const *ipiv, int stride_ipiv, int batch_count, int *info) {
+#if defined(NDA_USE_MKL) && INTEL_MKL_VERSION >= 20210000
+    // MKL only provides an out-of-place version
+    auto A_copy = std::vector<std::complex<double>>(A, A + static_cast<long>(batch_count - 1) * strideA + static_cast<long>(LDA) * N);
+    zgetri_oop_batch_strided(&N, A_copy.data(), &LDA, &strideA, ipiv, &stride_ipiv, A, &LDA, &strideA, &batch_count, info);
+#else
+    getri_batch_strided_impl(N, A, LDA, strideA, ipiv, stride_ipiv, batch_count, info);
+#endif
+  }
+
+  void gbsv(int N, int KL, int KU, int NRHS, double *AB, int LDAB, int *ipiv, double *B, int LDB, int &info) {
+    LAPACK_dgbsv(&N, &KL, &KU, &NRHS, AB, &LDAB, ipiv, B, &LDB, &info);
+  }
+  void gbsv(int N, int KL, int KU, int NRHS, std::complex<double> *AB, int LDAB, int *ipiv, std::complex<double> *B, int LDB, int &info) {
+    LAPACK_zgbsv(&N, &KL, &KU, &NRHS, AB, &LDAB, ipiv, B, &LDB, &info);
+  }
+
+  void gbtrf(int M, int N, int KL, int KU, double *AB, int LDAB, int *ipiv, int &info) { LAPACK_dgbtrf(&M, &N, &KL, &KU, AB, &LDAB, ipiv, &info); }
+  void gbtrf(int M, int N, int KL, int KU, std::complex<double> *AB, int LDAB, int *ipiv, int &info) {
+    LAPACK_zgbtrf(&M, &N, &KL, &KU, AB, &LDAB, ipiv, &info);
+  }
+
+  void gbtrs(char op, int N, int KL, int KU, int NRHS, double const *AB, int LDAB, int const *ipiv, double *B, int LDB, int &info) {
+    LAPACK_dgbtrs(&op, &N, &KL, &KU, &NRHS, AB, &LDAB, ipiv, B, &LDB, &info);
+  }
+  void gbtrs(char op, int N, int KL, int KU, int NRHS, std::complex<double> const *AB, int LDAB, int const *ipiv, std::complex<double> *B, int LDB,
+             int &info) {
+    LAPACK_zgbtrs(&op, &N, &KL, &KU, &NRHS, AB, &LDAB, ipiv, B, &LDB, &info);
+  }
+
   void gtsv(int N, int NRHS, double *DL, double *D, double *DU, double *B, int LDB, int &info) { LAPACK_dgtsv(&N, &NRHS, DL, D, DU, B, &LDB, &info); }
   void gtsv(int N, int NRHS, std::complex<double> *DL, std::complex<double> *D, std::complex<double> *DU, std::complex<double> *B, int LDB,
             int &info) {
@@ -88,6 +197,65 @@ namespace nda::lapack::f77 {
     LAPACK_zheev(&JOBZ, &UPLO, &N, A, &LDA, W, work, &lwork, work2, &info);
   }
 
+  void spev(char JOBZ, char UPLO, int N, double *AP, double *W, double *Z, int LDZ, double *work, int &info) {
+    LAPACK_dspev(&JOBZ, &UPLO, &N, AP, W, Z, &LDZ, work, &info);
+  }
+
+  void hpev(char JOBZ, char UPLO, int N, std::complex<double> *AP, double *W, std::complex<double> *Z, int LDZ, std::complex<double> *work,
+            double *rwork, int &info) {
+    LAPACK_zhpev(&JOBZ, &UPLO, &N, AP, W, Z, &LDZ, work, rwork, &info);
+  }
+
+  void geev(char JOBVL, char JOBVR, int N, double *A, int LDA, double *WR, double *WI, double *VL, int LDVL, double *VR, int LDVR, double *WORK,
+            int LWORK, int &INFO) {
+    LAPACK_dgeev(&JOBVL, &JOBVR, &N, A, &LDA, WR, WI, VL, &LDVL, VR, &LDVR, WORK, &LWORK, &INFO);
+  }
+  void geev(char JOBVL, char JOBVR, int N, std::complex<double> *A, int LDA, std::complex<double> *W, std::complex<double> *VL, int LDVL,
+            std::complex<double> *VR, int LDVR, std::complex<double> *WORK, int LWORK, double *RWORK, int &INFO) {
+    LAPACK_zgeev(&JOBVL, &JOBVR, &N, A, &LDA, W, VL, &LDVL, VR, &LDVR, WORK, &LWORK, RWORK, &INFO);
+  }
+
+  void ggev(char JOBVL, char JOBVR, int N, double *A, int LDA, double *B, int LDB, double *ALPHAR, double *ALPHAI, double *BETA, double *VL,
+            int LDVL, double *VR, int LDVR, double *WORK, int LWORK, int &INFO) {
+    LAPACK_dggev(&JOBVL, &JOBVR, &N, A, &LDA, B, &LDB, ALPHAR, ALPHAI, BETA, VL, &LDVL, VR, &LDVR, WORK, &LWORK, &INFO);
+  }
+  void ggev(char JOBVL, char JOBVR, int N, std::complex<double> *A, int LDA, std::complex<double> *B, int LDB, std::complex<double> *ALPHA,
+            std::complex<double> *BETA, std::complex<double> *VL, int LDVL, std::complex<double> *VR, int LDVR, std::complex<double> *WORK, int LWORK,
+            double *RWORK, int &INFO) {
+    LAPACK_zggev(&JOBVL, &JOBVR, &N, A, &LDA, B, &LDB, ALPHA, BETA, VL, &LDVL, VR, &LDVR, WORK, &LWORK, RWORK, &INFO);
+  }
+
+  void sygvd(int ITYPE, char JOBZ, char UPLO, int N, double *A, int LDA, double *B, int LDB, double *W, double *WORK, int LWORK, int *IWORK,
+             int LIWORK, int &INFO) {
+    LAPACK_dsygvd(&ITYPE, &JOBZ, &UPLO, &N, A, &LDA, B, &LDB, W, WORK, &LWORK, IWORK, &LIWORK, &INFO);
+  }
+
+  void hegvd(int ITYPE, char JOBZ, char UPLO, int N, std::complex<double> *A, int LDA, std::complex<double> *B, int LDB, double *W,
+             std::complex<double> *WORK, int LWORK, double *RWORK, int LRWORK, int *IWORK, int LIWORK, int &INFO) {
+    LAPACK_zhegvd(&ITYPE, &JOBZ, &UPLO, &N, A, &LDA, B, &LDB, W, WORK, &LWORK, RWORK, &LRWORK, IWORK, &LIWORK, &INFO);
+  }
+
+  void syevd(char JOBZ, char UPLO, int N, double *A, int LDA, double *W, double *WORK, int LWORK, int *IWORK, int LIWORK, int &INFO) {
+    LAPACK_dsyevd(&JOBZ, &UPLO, &N, A, &LDA, W, WORK, &LWORK, IWORK, &LIWORK, &INFO);
+  }
+
+  void heevd(char JOBZ, char UPLO, int N, std::complex<double> *A, int LDA, double *W, std::complex<double> *WORK, int LWORK, double *RWORK,
+             int LRWORK, int *IWORK, int LIWORK, int &INFO) {
+    LAPACK_zheevd(&JOBZ, &UPLO, &N, A, &LDA, W, WORK, &LWORK, RWORK, &LRWORK, IWORK, &LIWORK, &INFO);
+  }
+
+  void syevr(char JOBZ, char RANGE, char UPLO, int N, double *A, int LDA, double VL, double VU, int IL, int IU, double ABSTOL, int &M, double *W,
+             double *Z, int LDZ, int *ISUPPZ, double *WORK, int LWORK, int *IWORK, int LIWORK, int &INFO) {
+    LAPACK_dsyevr(&JOBZ, &RANGE, &UPLO, &N, A, &LDA, &VL, &VU, &IL, &IU, &ABSTOL, &M, W, Z, &LDZ, ISUPPZ, WORK, &LWORK, IWORK, &LIWORK, &INFO);
+  }
+
+  void heevr(char JOBZ, char RANGE, char UPLO, int N, std::complex<double> *A, int LDA, double VL, double VU, int IL, int IU, double ABSTOL, int &M,
+             double *W, std::complex<double> *Z, int LDZ, int *ISUPPZ, std::complex<double> *WORK, int LWORK, double *RWORK, int LRWORK, int *IWORK,
+             int LIWORK, int &INFO) {
+    LAPACK_zheevr(&JOBZ, &RANGE, &UPLO, &N, A, &LDA, &VL, &VU, &IL, &IU, &ABSTOL, &M, W, Z, &LDZ, ISUPPZ, WORK, &LWORK, RWORK, &LRWORK, IWORK,
+                  &LIWORK, &INFO);
+  }
+
   void getrs(char op, int N, int NRHS, double const *A, int LDA, int const *ipiv, double *B, int LDB, int &info) {
     LAPACK_dgetrs(&op, &N, &NRHS, A, &LDA, ipiv, B, &LDB, &info);
   }
@@ -95,4 +263,47 @@ namespace nda::lapack::f77 {
     LAPACK_zgetrs(&op, &N, &NRHS, A, &LDA, ipiv, B, &LDB, &info);
   }
 
+  void potrf(char uplo, int N, double *A, int LDA, int &info) { LAPACK_dpotrf(&uplo, &N, A, &LDA, &info); }
+  void potrf(char uplo, int N, std::complex<double> *A, int LDA, int &info) { LAPACK_zpotrf(&uplo, &N, A, &LDA, &info); }
+
+  void potrs(char uplo, int N, int NRHS, double const *A, int LDA, double *B, int LDB, int &info) {
+    LAPACK_dpotrs(&uplo, &N, &NRHS, A, &LDA, B, &LDB, &info);
+  }
+  void potrs(char uplo, int N, int NRHS, std::complex<double> const *A, int LDA, std::complex<double> *B, int LDB, int &info) {
+    LAPACK_zpotrs(&uplo, &N, &NRHS, A, &LDA, B, &LDB, &info);
+  }
+
+  void potri(char uplo, int N, double *A, int LDA, int &info) { LAPACK_dpotri(&uplo, &N, A, &LDA, &info); }
+  void potri(char uplo, int N, std::complex<double> *A, int LDA, int &info) { LAPACK_zpotri(&uplo, &N, A, &LDA, &info); }
+
+  void pptrf(char uplo, int N, double *AP, int &info) { LAPACK_dpptrf(&uplo, &N, AP, &info); }
+  void pptrf(char uplo, int N, std::complex<double> *AP, int &info) { LAPACK_zpptrf(&uplo, &N, AP, &info); }
+
+  void pptrs(char uplo, int N, int NRHS, double const *AP, double *B, int LDB, int &info) { LAPACK_dpptrs(&uplo, &N, &NRHS, AP, B, &LDB, &info); }
+  void pptrs(char uplo, int N, int NRHS, std::complex<double> const *AP, std::complex<double> *B, int LDB, int &info) {
+    LAPACK_zpptrs(&uplo, &N, &NRHS, AP, B, &LDB, &info);
+  }
+
+  void sytrf(char uplo, int N, double *A, int LDA, int *ipiv, double *work, int lwork, int &info) {
+    LAPACK_dsytrf(&uplo, &N, A, &LDA, ipiv, work, &lwork, &info);
+  }
+  void sytrf(char uplo, int N, std::complex<double> *A, int LDA, int *ipiv, std::complex<double> *work, int lwork, int &info) {
+    LAPACK_zsytrf(&uplo, &N, A, &LDA, ipiv, work, &lwork, &info);
+  }
+
+  void sytrs(char uplo, int N, int NRHS, double const *A, int LDA, int const *ipiv, double *B, int LDB, int &info) {
+    LAPACK_dsytrs(&uplo, &N, &NRHS, A, &LDA, ipiv, B, &LDB, &info);
+  }
+  void sytrs(char uplo, int N, int NRHS, std::complex<double> const *A, int LDA, int const *ipiv, std::complex<double> *B, int LDB, int &info) {
+    LAPACK_zsytrs(&uplo, &N, &NRHS, A, &LDA, ipiv, B, &LDB, &info);
+  }
+
+  void hetrf(char uplo, int N, std::complex<double> *A, int LDA, int *ipiv, std::complex<double> *work, int lwork, int &info) {
+    LAPACK_zhetrf(&uplo, &N, A, &LDA, ipiv, work, &lwork, &info);
+  }
+
+  void hetrs(char uplo, int N, int NRHS, std::complex<double> const *A, int LDA, int const *ipiv, std::complex<double> *B, int LDB, int &info) {
+    LAPACK_zhetrs(&uplo, &N, &NRHS, A, &LDA, ipiv, B, &LDB, &info);
+  }
+
 } // namespace nda::lapack::f77
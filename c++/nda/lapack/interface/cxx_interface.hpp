@@ -41,6 +41,11 @@ namespace nda::lapack::f77 {
   void gesvd(char JOBU, char JOBVT, int M, int N, std::complex<double> *A, int LDA, double *S, std::complex<double> *U, int LDU,
              std::complex<double> *VT, int LDVT, std::complex<double> *WORK, int LWORK, double *RWORK, int &INFO);
 
+  void gesdd(char JOBZ, int M, int N, double *A, int LDA, double *S, double *U, int LDU, double *VT, int LDVT, double *WORK, int LWORK, double *RWORK,
+             int *IWORK, int &INFO);
+  void gesdd(char JOBZ, int M, int N, std::complex<double> *A, int LDA, double *S, std::complex<double> *U, int LDU, std::complex<double> *VT,
+             int LDVT, std::complex<double> *WORK, int LWORK, double *RWORK, int *IWORK, int &INFO);
+
   void geqp3(int M, int N, double *A, int LDA, int *JPVT, double *TAU, double *WORK, int LWORK, double *RWORK, int &INFO);
   void geqp3(int M, int N, std::complex<double> *A, int LDA, int *JPVT, std::complex<double> *TAU, std::complex<double> *WORK, int LWORK,
              double *RWORK, int &INFO);
@@ -55,6 +60,22 @@ namespace nda::lapack::f77 {
   void getri(int N, double *A, int LDA, int const *ipiv, double *work, int lwork, int &info);
   void getri(int N, std::complex<double> *A, int LDA, int const *ipiv, std::complex<double> *work, int lwork, int &info);
 
+  void getrf_batch_strided(int M, int N, double *A, int LDA, int strideA, int *ipiv, int stride_ipiv, int batch_count, int *info);
+  void getrf_batch_strided(int M, int N, std::complex<double> *A, int LDA, int strideA, int *ipiv, int stride_ipiv, int batch_count, int *info);
+
+  void getri_batch_strided(int N, double *A, int LDA, int strideA, int const *ipiv, int stride_ipiv, int batch_count, int *info);
+  void getri_batch_strided(int N, std::complex<double> *A, int LDA, int strideA, int const *ipiv, int stride_ipiv, int batch_count, int *info);
+
+  void gbsv(int N, int KL, int KU, int NRHS, double *AB, int LDAB, int *ipiv, double *B, int LDB, int &info);
+  void gbsv(int N, int KL, int KU, int NRHS, std::complex<double> *AB, int LDAB, int *ipiv, std::complex<double> *B, int LDB, int &info);
+
+  void gbtrf(int M, int N, int KL, int KU, double *AB, int LDAB, int *ipiv, int &info);
+  void gbtrf(int M, int N, int KL, int KU, std::complex<double> *AB, int LDAB, int *ipiv, int &info);
+
+  void gbtrs(char op, int N, int KL, int KU, int NRHS, double const *AB, int LDAB, int const *ipiv, double *B, int LDB, int &info);
+  void gbtrs(char op, int N, int KL, int KU, int NRHS, std::complex<double> const *AB, int LDAB, int const *ipiv, std::complex<double> *B, int LDB,
+             int &info);
+
   void gtsv(int N, int NRHS, double *DL, double *D, double *DU, double *B, int LDB, int &info);
   void gtsv(int N, int NRHS, std::complex<double> *DL, std::complex<double> *D, std::complex<double> *DU, std::complex<double> *B, int LDB,
             int &info);
@@ -66,20 +87,85 @@ namespace nda::lapack::f77 {
   void heev(char JOBZ, char UPLO, int N, std::complex<double> *A, int LDA, double *W, std::complex<double> *work, int &lwork, double *work2,
             int &info);
 
+  void spev(char JOBZ, char UPLO, int N, double *AP, double *W, double *Z, int LDZ, double *work, int &info);
+
+  void hpev(char JOBZ, char UPLO, int N, std::complex<double> *AP, double *W, std::complex<double> *Z, int LDZ, std::complex<double> *work,
+            double *rwork, int &info);
+
+  void geev(char JOBVL, char JOBVR, int N, double *A, int LDA, double *WR, double *WI, double *VL, int LDVL, double *VR, int LDVR, double *WORK,
+            int LWORK, int &INFO);
+  void geev(char JOBVL, char JOBVR, int N, std::complex<double> *A, int LDA, std::complex<double> *W, std::complex<double> *VL, int LDVL,
+            std::complex<double> *VR, int LDVR, std::complex<double> *WORK, int LWORK, double *RWORK, int &INFO);
+
+  void ggev(char JOBVL, char JOBVR, int N, double *A, int LDA, double *B, int LDB, double *ALPHAR, double *ALPHAI, double *BETA, double *VL,
+            int LDVL, double *VR, int LDVR, double *WORK, int LWORK, int &INFO);
+  void ggev(char JOBVL, char JOBVR, int N, std::complex<double> *A, int LDA, std::complex<double> *B, int LDB, std::complex<double> *ALPHA,
+            std::complex<double> *BETA, std::complex<double> *VL, int LDVL, std::complex<double> *VR, int LDVR, std::complex<double> *WORK, int LWORK,
+            double *RWORK, int &INFO);
+
+  void sygvd(int ITYPE, char JOBZ, char UPLO, int N, double *A, int LDA, double *B, int LDB, double *W, double *WORK, int LWORK, int *IWORK,
+             int LIWORK, int &INFO);
+
+  void hegvd(int ITYPE, char JOBZ, char UPLO, int N, std::complex<double> *A, int LDA, std::complex<double> *B, int LDB, double *W,
+             std::complex<double> *WORK, int LWORK, double *RWORK, int LRWORK, int *IWORK, int LIWORK, int &INFO);
+
+  void syevd(char JOBZ, char UPLO, int N, double *A, int LDA, double *W, double *WORK, int LWORK, int *IWORK, int LIWORK, int &INFO);
+
+  void heevd(char JOBZ, char UPLO, int N, std::complex<double> *A, int LDA, double *W, std::complex<double> *WORK, int LWORK, double *RWORK,
+             int LRWORK, int *IWORK, int LIWORK, int &INFO);
+
+  void syevr(char JOBZ, char RANGE, char UPLO, int N, double *A, int LDA, double VL, double VU, int IL, int IU, double ABSTOL, int &M, double *W,
+             double *Z, int LDZ, int *ISUPPZ, double *WORK, int LWORK, int *IWORK, int LIWORK, int &INFO);
+
+  void heevr(char JOBZ, char RANGE, char UPLO, int N, std::complex<double> *A, int LDA, double VL, double VU, int IL, int IU, double ABSTOL, int &M,
+             double *W, std::complex<double> *Z, int LDZ, int *ISUPPZ, std::complex<double> *WORK, int LWORK, double *RWORK, int LRWORK, int *IWORK,
+             int LIWORK, int &INFO);
+
   void getrs(char op, int N, int NRHS, double const *A, int LDA, int const *ipiv, double *B, int LDB, int &info);
   void getrs(char op, int N, int NRHS, std::complex<double> const *A, int LDA, int const *ipiv, std::complex<double> *B, int LDB, int &info);
 
+  void potrf(char uplo, int N, double *A, int LDA, int &info);
+  void potrf(char uplo, int N, std::complex<double> *A, int LDA, int &info);
+
+  void potrs(char uplo, int N, int NRHS, double const *A, int LDA, double *B, int LDB, int &info);
+  void potrs(char uplo, int N, int NRHS, std::complex<double> const *A, int LDA, std::complex<double> *B, int LDB, int &info);
+
+  void potri(char uplo, int N, double *A, int LDA, int &info);
+  void potri(char uplo, int N, std::complex<double> *A, int LDA, int &info);
+
+  void pptrf(char uplo, int N, double *AP, int &info);
+  void pptrf(char uplo, int N, std::complex<double> *AP, int &info);
+
+  void pptrs(char uplo, int N, int NRHS, double const *AP, double *B, int LDB, int &info);
+  void pptrs(char uplo, int N, int NRHS, std::complex<double> const *AP, std::complex<double> *B, int LDB, int &info);
+
+  void sytrf(char uplo, int N, double *A, int LDA, int *ipiv, double *work, int lwork, int &info);
+  void sytrf(char uplo, int N, std::complex<double> *A, int LDA, int *ipiv, std::complex<double> *work, int lwork, int &info);
+
+  void sytrs(char uplo, int N, int NRHS, double const *A, int LDA, int const *ipiv, double *B, int LDB, int &info);
+  void sytrs(char uplo, int N, int NRHS, std::complex<double> const *A, int LDA, int const *ipiv, std::complex<double> *B, int LDB, int &info);
+
+  void hetrf(char uplo, int N, std::complex<double> *A, int LDA, int *ipiv, std::complex<double> *work, int lwork, int &info);
+
+  void hetrs(char uplo, int N, int NRHS, std::complex<double> const *A, int LDA, int const *ipiv, std::complex<double> *B, int LDB, int &info);
+
 } // namespace nda::lapack::f77
 
 // Useful routines from the BLAS interface
 namespace nda::lapack {
 
+  // See nda::blas::flip_uplo.
+  using blas::flip_uplo;
+
   // See nda::blas::get_ld.
   using blas::get_ld;
 
   // See nda::blas::get_ncols.
   using blas::get_ncols;
 
+  // See nda::blas::get_packed_dim.
+  using blas::get_packed_dim;
+
   // See nda::blas::get_op.
   using blas::get_op;
 
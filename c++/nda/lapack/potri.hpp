@@ -0,0 +1,63 @@
+// Copyright (c) 2024 Simons Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file
+ * @brief Provides a generic interface to the LAPACK `potri` routine.
+ */
+
+#pragma once
+
+#include "./interface/cxx_interface.hpp"
+#include "../concepts.hpp"
+#include "../macros.hpp"
+#include "../mem/address_space.hpp"
+#include "../traits.hpp"
+
+namespace nda::lapack {
+
+  /**
+   * @ingroup linalg_lapack
+   * @brief Interface to the LAPACK `potri` routine.
+   *
+   * @details Computes the inverse of a real symmetric or complex hermitian positive definite matrix
+   * \f$ \mathbf{A} \f$ using the Cholesky factorization computed by nda::lapack::potrf.
+   *
+   * The matrix can be in C or Fortran order, but it has to be in the same order as in the call to `potrf`.
+   *
+   * @tparam A nda::MemoryMatrix type.
+   * @param a Input/output matrix. On entry, the factor \f$ \mathbf{U} \f$ or \f$ \mathbf{L} \f$ from `potrf`. On exit,
+   * the triangle specified by `uplo` contains the corresponding triangle of \f$ \mathbf{A}^{-1} \f$. The other triangle
+   * is not modified.
+   * @param uplo Triangular part of \f$ \mathbf{A} \f$ that contains the factor (as in the call to `potrf`).
+   * @return Integer return code from the LAPACK call. If `INFO > 0`, the element `(INFO, INFO)` of the factor is zero
+   * and the inverse could not be computed.
+   */
+  template <MemoryMatrix A>
+    requires(mem::on_host<A> and is_blas_lapack_v<get_value_t<A>>)
+  int potri(A &&a, char uplo = 'U') { // NOLINT (temporary views are allowed here)
+    // runtime checks
+    EXPECTS(uplo == 'U' or uplo == 'L');
+    EXPECTS(a.extent(0) == a.extent(1));
+    EXPECTS(a.indexmap().min_stride() == 1);
+
+    // for a matrix in C order, the other triangle is referenced in Fortran order
+    char uplo_f = (has_C_layout<A> ? flip_uplo(uplo) : uplo);
+
+    int info = 0;
+    f77::potri(uplo_f, a.extent(0), a.data(), get_ld(a), info);
+    return info;
+  }
+
+} // namespace nda::lapack
@@ -0,0 +1,83 @@
+// Copyright (c) 2024 Simons Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file
+ * @brief Provides a generic interface to the LAPACK `potrs` routine.
+ */
+
+#pragma once
+
+#include "./interface/cxx_interface.hpp"
+#include "../concepts.hpp"
+#include "../macros.hpp"
+#include "../mapped_functions.hpp"
+#include "../mem/address_space.hpp"
+#include "../traits.hpp"
+
+#include <algorithm>
+
+namespace nda::lapack {
+
+  /**
+   * @ingroup linalg_lapack
+   * @brief Interface to the LAPACK `potrs` routine.
+   *
+   * @details Solves a system of linear equations \f$ \mathbf{A X} = \mathbf{B} \f$ with a real symmetric or complex
+   * hermitian positive definite n-by-n matrix \f$ \mathbf{A} \f$ using the Cholesky factorization computed by
+   * nda::lapack::potrf.
+   *
+   * The factored matrix can be in C or Fortran order, but it has to be in the same order as in the call to `potrf`.
+   * The right hand side has to be a vector or a matrix in Fortran order.
+   *
+   * @tparam A nda::MemoryMatrix type.
+   * @tparam B nda::MemoryArray type.
+   * @param a Input matrix. The factor \f$ \mathbf{U} \f$ or \f$ \mathbf{L} \f$ from `potrf`.
+   * @param b Input/output array. On entry, the right hand side vector/matrix \f$ \mathbf{B} \f$. On exit, the solution
+   * vector/matrix \f$ \mathbf{X} \f$.
+   * @param uplo Triangular part of \f$ \mathbf{A} \f$ that contains the factor (as in the call to `potrf`).
+   * @return Integer return code from the LAPACK call.
+   */
+  template <MemoryMatrix A, MemoryArray B>
+    requires(have_same_value_type_v<A, B> and mem::on_host<A, B> and is_blas_lapack_v<get_value_t<A>>)
+  int potrs(A const &a, B &&b, char uplo = 'U') { // NOLINT (temporary views are allowed here)
+    static_assert(MemoryVector<B> or MemoryMatrix<B>, "Error in nda::lapack::potrs: B must be a vector or a matrix");
+    static_assert(has_F_layout<B>, "Error in nda::lapack::potrs: C order not supported for B");
+
+    // runtime checks
+    EXPECTS(uplo == 'U' or uplo == 'L');
+    EXPECTS(a.extent(0) == a.extent(1));
+    EXPECTS(a.extent(0) == b.extent(0));
+    EXPECTS(a.indexmap().min_stride() == 1);
+    EXPECTS(b.indexmap().min_stride() == 1);
+
+    int nrhs = 1, ldb = std::max(1, static_cast<int>(b.extent(0))); // defaults for B MemoryVector
+    if constexpr (MemoryMatrix<B>) {
+      nrhs = b.extent(1);
+      ldb  = get_ld(b);
+    }
+
+    // for a matrix in C order, LAPACK sees the transpose, i.e. the complex conjugate, of the hermitian matrix
+    static constexpr bool conj_b = has_C_layout<A> and is_complex_v<get_value_t<A>>;
+    char uplo_f                  = (has_C_layout<A> ? flip_uplo(uplo) : uplo);
+    if constexpr (conj_b) b = conj(b);
+
+    int info = 0;
+    f77::potrs(uplo_f, a.extent(0), nrhs, a.data(), get_ld(a), b.data(), ldb, info);
+
+    if constexpr (conj_b) b = conj(b);
+    return info;
+  }
+
+} // namespace nda::lapack
@@ -0,0 +1,60 @@
+// Copyright (c) 2024 Simons Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file
+ * @brief Provides a generic interface to the LAPACK `pptrf` routine.
+ */
+
+#pragma once
+
+#include "./interface/cxx_interface.hpp"
+#include "../concepts.hpp"
+#include "../macros.hpp"
+#include "../mem/address_space.hpp"
+#include "../traits.hpp"
+
+namespace nda::lapack {
+
+  /**
+   * @ingroup linalg_lapack
+   * @brief Interface to the LAPACK `pptrf` routine.
+   *
+   * @details Computes the Cholesky factorization of a real symmetric or complex hermitian positive definite n-by-n
+   * matrix \f$ \mathbf{A} \f$ in packed storage (see nda::blas::spmv).
+   *
+   * The factorization has the form \f$ \mathbf{A} = \mathbf{U}^H \mathbf{U} \f$ or
+   * \f$ \mathbf{A} = \mathbf{L} \mathbf{L}^H \f$, if `uplo == 'U'` or `uplo == 'L'`, respectively (see
+   * nda::lapack::potrf).
+   *
+   * @tparam AP nda::MemoryVector type.
+   * @param ap Input/output vector. On entry, the packed matrix \f$ \mathbf{A} \f$. On exit, if `INFO == 0`, the packed
+   * factor \f$ \mathbf{U} \f$ or \f$ \mathbf{L} \f$.
+   * @param uplo Triangular part of \f$ \mathbf{A} \f$ that is stored in `ap`.
+   * @return Integer return code from the LAPACK call. If `INFO > 0`, the leading minor of order `INFO` is not positive
+   * definite.
+   */
+  template <MemoryVector AP>
+    requires(mem::on_host<AP> and is_blas_lapack_v<get_value_t<AP>>)
+  int pptrf(AP &&ap, char uplo = 'U') { // NOLINT (temporary views are allowed here)
+    // runtime checks
+    EXPECTS(uplo == 'U' or uplo == 'L');
+    EXPECTS(ap.indexmap().min_stride() == 1);
+
+    int info = 0;
+    f77::pptrf(uplo, get_packed_dim(ap.size()), ap.data(), info);
+    return info;
+  }
+
+} // namespace nda::lapack
@@ -0,0 +1,73 @@
+// Copyright (c) 2024 Simons Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file
+ * @brief Provides a generic interface to the LAPACK `pptrs` routine.
+ */
+
+#pragma once
+
+#include "./interface/cxx_interface.hpp"
+#include "../concepts.hpp"
+#include "../macros.hpp"
+#include "../mem/address_space.hpp"
+#include "../traits.hpp"
+
+#include <algorithm>
+
+namespace nda::lapack {
+
+  /**
+   * @ingroup linalg_lapack
+   * @brief Interface to the LAPACK `pptrs` routine.
+   *
+   * @details Solves a system of linear equations \f$ \mathbf{A X} = \mathbf{B} \f$ with a real symmetric or complex
+   * hermitian positive definite n-by-n matrix \f$ \mathbf{A} \f$ in packed storage using the Cholesky factorization
+   * computed by nda::lapack::pptrf.
+   *
+   * The right hand side has to be a vector or a matrix in Fortran order.
+   *
+   * @tparam AP nda::MemoryVector type.
+   * @tparam B nda::MemoryArray type.
+   * @param ap Input vector. The packed factor \f$ \mathbf{U} \f$ or \f$ \mathbf{L} \f$ from `pptrf`.
+   * @param b Input/output array. On entry, the right hand side vector/matrix \f$ \mathbf{B} \f$. On exit, the solution
+   * vector/matrix \f$ \mathbf{X} \f$.
+   * @param uplo Triangular part of \f$ \mathbf{A} \f$ that contains the factor (as in the call to `pptrf`).
+   * @return Integer return code from the LAPACK call.
+   */
+  template <MemoryVector AP, MemoryArray B>
+    requires(have_same_value_type_v<AP, B> and mem::on_host<AP, B> and is_blas_lapack_v<get_value_t<AP>>)
+  int pptrs(AP const &ap, B &&b, char uplo = 'U') { // NOLINT (temporary views are allowed here)
+    static_assert(MemoryVector<B> or MemoryMatrix<B>, "Error in nda::lapack::pptrs: B must be a vector or a matrix");
+    static_assert(has_F_layout<B>, "Error in nda::lapack::pptrs: C order not supported for B");
+
+    // runtime checks
+    EXPECTS(uplo == 'U' or uplo == 'L');
+    EXPECTS(ap.size() == b.extent(0) * (b.extent(0) + 1) / 2);
+    EXPECTS(ap.indexmap().min_stride() == 1);
+    EXPECTS(b.indexmap().min_stride() == 1);
+
+    int nrhs = 1, ldb = std::max(1, static_cast<int>(b.extent(0))); // defaults for B MemoryVector
+    if constexpr (MemoryMatrix<B>) {
+      nrhs = b.extent(1);
+      ldb  = get_ld(b);
+    }
+
+    int info = 0;
+    f77::pptrs(uplo, b.extent(0), nrhs, ap.data(), b.data(), ldb, info);
+    return info;
+  }
+
+} // namespace nda::lapack
@@ -0,0 +1,141 @@
+// Copyright (c) 2024 Simons Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file
+ * @brief Provides generic interfaces to the LAPACK `spev` and `hpev` routines.
+ */
+
+#pragma once
+
+#include "./interface/cxx_interface.hpp"
+#include "./workspace.hpp"
+#include "../concepts.hpp"
+#include "../exceptions.hpp"
+#include "../macros.hpp"
+#include "../mem/address_space.hpp"
+#include "../traits.hpp"
+
+#include <algorithm>
+#include <complex>
+#include <type_traits>
+#include <utility>
+
+namespace nda::lapack {
+
+  /**
+   * @addtogroup linalg_lapack
+   * @{
+   */
+
+  /**
+   * @brief Interface to the LAPACK `spev` and `hpev` routines.
+   *
+   * @details Computes all eigenvalues and, optionally, eigenvectors of a real symmetric or complex hermitian n-by-n
+   * matrix \f$ \mathbf{A} \f$ in packed storage (see nda::blas::spmv). For real value types, it calls `spev`, for
+   * complex value types `hpev`.
+   *
+   * The `work` and `rwork` buffers are taken from the given nda::lapack::workspace, so that repeated calls with the
+   * same workspace and problem size do not allocate.
+   *
+   * @tparam AP nda::MemoryVector type.
+   * @tparam W nda::MemoryVector type.
+   * @tparam Z nda::MemoryMatrix type.
+   * @param ap Input/output vector. On entry, the packed matrix \f$ \mathbf{A} \f$. On exit, its content is destroyed.
+   * @param w Output vector of size n. The eigenvalues in ascending order.
+   * @param z Output n-by-n matrix. If `jobz == 'V'`, it contains the orthonormal eigenvectors in its columns. If
+   * `jobz == 'N'`, it is not referenced.
+   * @param ws nda::lapack::workspace used for the `work` and `rwork` buffers.
+   * @param jobz Compute only eigenvalues (`jobz == 'N'`) or eigenvalues and eigenvectors (`jobz == 'V'`).
+   * @param uplo Triangular part of \f$ \mathbf{A} \f$ that is stored in `ap`.
+   * @return Integer return code from the LAPACK call.
+   */
+  template <MemoryVector AP, MemoryVector W, MemoryMatrix Z>
+    requires(mem::on_host<AP, W, Z> and have_same_value_type_v<AP, Z> and is_blas_lapack_v<get_value_t<AP>>
+             and std::is_same_v<get_value_t<W>, double>)
+  int spev(AP &&ap, W &&w, Z &&z, workspace<get_value_t<AP>> &ws, char jobz = 'V', // NOLINT (temporary views are allowed here)
+           char uplo = 'U') {
+    static_assert(has_F_layout<Z>, "Error in nda::lapack::spev: C order not supported");
+
+    // runtime checks
+    EXPECTS(jobz == 'N' or jobz == 'V');
+    EXPECTS(uplo == 'U' or uplo == 'L');
+    EXPECTS(ap.indexmap().min_stride() == 1);
+    EXPECTS(w.indexmap().min_stride() == 1);
+
+    int n = get_packed_dim(ap.size());
+    EXPECTS(w.size() >= n);
+    if (n == 0) return 0;
+
+    int ldz = 1;
+    if (jobz == 'V') {
+      EXPECTS(z.extent(0) == n and z.extent(1) == n);
+      EXPECTS(z.indexmap().min_stride() == 1);
+      ldz = get_ld(z);
+    }
+
+    // get the buffers and perform actual library call
+    int info = 0;
+    if constexpr (is_complex_v<get_value_t<AP>>) {
+      f77::hpev(jobz, uplo, n, ap.data(), w.data(), z.data(), ldz, ws.work(std::max(1, 2 * n - 1)), ws.rwork(std::max(1, 3 * n - 2)), info);
+    } else {
+      f77::spev(jobz, uplo, n, ap.data(), w.data(), z.data(), ldz, ws.work(3 * n), info);
+    }
+
+    if (info) NDA_RUNTIME_ERROR << "Error in nda::lapack::" << (is_complex_v<get_value_t<AP>> ? "hpev" : "spev") << ": info = " << info;
+    return info;
+  }
+
+  /**
+   * @brief Interface to the LAPACK `spev` and `hpev` routines with a temporary workspace.
+   *
+   * @details See nda::lapack::spev(AP &&, W &&, Z &&, workspace<get_value_t<AP>> &, char, char).
+   *
+   * @tparam AP nda::MemoryVector type.
+   * @tparam W nda::MemoryVector type.
+   * @tparam Z nda::MemoryMatrix type.
+   * @param ap Input/output vector containing the packed matrix.
+   * @param w Output vector of eigenvalues.
+   * @param z Output matrix of eigenvectors.
+   * @param jobz Compute only eigenvalues (`jobz == 'N'`) or eigenvalues and eigenvectors (`jobz == 'V'`).
+   * @param uplo Triangular part of \f$ \mathbf{A} \f$ that is stored in `ap`.
+   * @return Integer return code from the LAPACK call.
+   */
+  template <MemoryVector AP, MemoryVector W, MemoryMatrix Z>
+    requires(mem::on_host<AP, W, Z> and have_same_value_type_v<AP, Z> and is_blas_lapack_v<get_value_t<AP>>
+             and std::is_same_v<get_value_t<W>, double>)
+  int spev(AP &&ap, W &&w, Z &&z, char jobz = 'V', char uplo = 'U') { // NOLINT (temporary views are allowed here)
+    auto ws = workspace<get_value_t<AP>>{};
+    return spev(std::forward<AP>(ap), std::forward<W>(w), std::forward<Z>(z), ws, jobz, uplo);
+  }
+
+  /**
+   * @brief Interface to the LAPACK `hpev` routine.
+   *
+   * @details Alias of nda::lapack::spev, which calls `hpev` for complex value types.
+   *
+   * @tparam Args Types of the arguments.
+   * @param args Arguments forwarded to nda::lapack::spev.
+   * @return Integer return code from the LAPACK call.
+   */
+  template <typename... Args>
+  int hpev(Args &&...args)
+    requires(requires { spev(std::forward<Args>(args)...); })
+  {
+    return spev(std::forward<Args>(args)...);
+  }
+
+  /** @} */
+
+} // namespace nda::lapack
@@ -0,0 +1,192 @@
+// Copyright (c) 2024 Simons Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file
+ * @brief Provides generic interfaces to the LAPACK `syevd` and `heevd` routines.
+ */
+
+#pragma once
+
+#include "./interface/cxx_interface.hpp"
+#include "./workspace.hpp"
+#include "../concepts.hpp"
+#include "../exceptions.hpp"
+#include "../macros.hpp"
+#include "../mem/address_space.hpp"
+#include "../traits.hpp"
+
+#include <algorithm>
+#include <complex>
+#include <type_traits>
+#include <utility>
+
+namespace nda::lapack {
+
+  /**
+   * @addtogroup linalg_lapack
+   * @{
+   */
+
+  /**
+   * @brief Interface to the LAPACK `syevd` routine.
+   *
+   * @details Computes all eigenvalues and, optionally, eigenvectors of a real symmetric n-by-n matrix
+   * \f$ \mathbf{A} \f$ using a divide and conquer algorithm. For large matrices, it is considerably faster than `syev`
+   * if eigenvectors are requested.
+   *
+   * The optimal sizes of the `work` and `iwork` buffers are obtained from a workspace query. The buffers are taken from
+   * the given nda::lapack::workspace, so that repeated calls with the same workspace and problem size do not allocate.
+   *
+   * @tparam A nda::MemoryMatrix type.
+   * @tparam W nda::MemoryVector type.
+   * @param a Input/output matrix. On entry, the symmetric matrix \f$ \mathbf{A} \f$ (only the triangle specified by
+   * `uplo` is referenced). On exit, if `jobz == 'V'`, it contains the orthonormal eigenvectors in its columns, otherwise
+   * its content is destroyed.
+   * @param w Output vector of size n. The eigenvalues in ascending order.
+   * @param ws nda::lapack::workspace used for the `work` and `iwork` buffers.
+   * @param jobz Compute only eigenvalues (`jobz == 'N'`) or eigenvalues and eigenvectors (`jobz == 'V'`).
+   * @param uplo Triangular part of \f$ \mathbf{A} \f$ that is referenced.
+   * @return Integer return code from the LAPACK call.
+   */
+  template <MemoryMatrix A, MemoryVector W>
+    requires(mem::on_host<A, W> and std::is_same_v<get_value_t<A>, double> and std::is_same_v<get_value_t<W>, double>)
+  int syevd(A &&a, W &&w, workspace<double> &ws, char jobz = 'V', char uplo = 'U') { // NOLINT (temporary views are allowed here)
+    static_assert(has_F_layout<A>, "Error in nda::lapack::syevd: C order not supported");
+
+    // runtime checks
+    EXPECTS(jobz == 'N' or jobz == 'V');
+    EXPECTS(uplo == 'U' or uplo == 'L');
+    EXPECTS(a.extent(0) == a.extent(1));
+    EXPECTS(w.size() >= a.extent(0));
+    EXPECTS(a.indexmap().min_stride() == 1);
+    EXPECTS(w.indexmap().min_stride() == 1);
+
+    int n = a.extent(0);
+    if (n == 0) return 0;
+
+    // first call to get the optimal buffersizes
+    double bufferSize_T{};
+    int iwork_size = 0, info = 0;
+    f77::syevd(jobz, uplo, n, a.data(), get_ld(a), w.data(), &bufferSize_T, -1, &iwork_size, -1, info);
+    int lwork  = lwork_from_query(bufferSize_T);
+    int liwork = std::max(1, iwork_size);
+
+    // get the buffers and perform actual library call
+    f77::syevd(jobz, uplo, n, a.data(), get_ld(a), w.data(), ws.work(lwork), lwork, ws.iwork(liwork), liwork, info);
+
+    if (info) NDA_RUNTIME_ERROR << "Error in nda::lapack::syevd: info = " << info;
+    return info;
+  }
+
+  /**
+   * @brief Interface to the LAPACK `syevd` routine with a temporary workspace.
+   *
+   * @details See nda::lapack::syevd(A &&, W &&, workspace<double> &, char, char).
+   *
+   * @tparam A nda::MemoryMatrix type.
+   * @tparam W nda::MemoryVector type.
+   * @param a Input/output symmetric matrix.
+   * @param w Output vector of eigenvalues.
+   * @param jobz Compute only eigenvalues (`jobz == 'N'`) or eigenvalues and eigenvectors (`jobz == 'V'`).
+   * @param uplo Triangular part of \f$ \mathbf{A} \f$ that is referenced.
+   * @return Integer return code from the LAPACK call.
+   */
+  template <MemoryMatrix A, MemoryVector W>
+    requires(mem::on_host<A, W> and std::is_same_v<get_value_t<A>, double> and std::is_same_v<get_value_t<W>, double>)
+  int syevd(A &&a, W &&w, char jobz = 'V', char uplo = 'U') { // NOLINT (temporary views are allowed here)
+    auto ws = workspace<double>{};
+    return syevd(std::forward<A>(a), std::forward<W>(w), ws, jobz, uplo);
+  }
+
+  /**
+   * @brief Interface to the LAPACK `heevd` routine.
+   *
+   * @details Computes all eigenvalues and, optionally, eigenvectors of a complex hermitian n-by-n matrix
+   * \f$ \mathbf{A} \f$ using a divide and conquer algorithm. For real value types, it calls nda::lapack::syevd.
+   *
+   * The optimal sizes of the `work`, `rwork` and `iwork` buffers are obtained from a workspace query. The buffers are
+   * taken from the given nda::lapack::workspace, so that repeated calls with the same workspace and problem size do not
+   * allocate.
+   *
+   * @tparam A nda::MemoryMatrix type.
+   * @tparam W nda::MemoryVector type.
+   * @param a Input/output matrix. On entry, the hermitian matrix \f$ \mathbf{A} \f$ (only the triangle specified by
+   * `uplo` is referenced). On exit, if `jobz == 'V'`, it contains the orthonormal eigenvectors in its columns, otherwise
+   * its content is destroyed.
+   * @param w Output vector of size n. The eigenvalues in ascending order.
+   * @param ws nda::lapack::workspace used for the `work`, `rwork` and `iwork` buffers.
+   * @param jobz Compute only eigenvalues (`jobz == 'N'`) or eigenvalues and eigenvectors (`jobz == 'V'`).
+   * @param uplo Triangular part of \f$ \mathbf{A} \f$ that is referenced.
+   * @return Integer return code from the LAPACK call.
+   */
+  template <MemoryMatrix A, MemoryVector W>
+    requires(mem::on_host<A, W> and is_blas_lapack_v<get_value_t<A>> and std::is_same_v<get_value_t<W>, double>)
+  int heevd(A &&a, W &&w, workspace<get_value_t<A>> &ws, char jobz = 'V', char uplo = 'U') { // NOLINT (temporary views are allowed here)
+    if constexpr (not is_complex_v<get_value_t<A>>) {
+      return syevd(std::forward<A>(a), std::forward<W>(w), ws, jobz, uplo);
+    } else {
+      static_assert(has_F_layout<A>, "Error in nda::lapack::heevd: C order not supported");
+
+      // runtime checks
+      EXPECTS(jobz == 'N' or jobz == 'V');
+      EXPECTS(uplo == 'U' or uplo == 'L');
+      EXPECTS(a.extent(0) == a.extent(1));
+      EXPECTS(w.size() >= a.extent(0));
+      EXPECTS(a.indexmap().min_stride() == 1);
+      EXPECTS(w.indexmap().min_stride() == 1);
+
+      int n = a.extent(0);
+      if (n == 0) return 0;
+
+      // first call to get the optimal buffersizes
+      std::complex<double> bufferSize_T{};
+      double rwork_size = 0;
+      int iwork_size = 0, info = 0;
+      f77::heevd(jobz, uplo, n, a.data(), get_ld(a), w.data(), &bufferSize_T, -1, &rwork_size, -1, &iwork_size, -1, info);
+      int lwork  = lwork_from_query(bufferSize_T);
+      int lrwork = lwork_from_query(rwork_size);
+      int liwork = std::max(1, iwork_size);
+
+      // get the buffers and perform actual library call
+      f77::heevd(jobz, uplo, n, a.data(), get_ld(a), w.data(), ws.work(lwork), lwork, ws.rwork(lrwork), lrwork, ws.iwork(liwork), liwork, info);
+
+      if (info) NDA_RUNTIME_ERROR << "Error in nda::lapack::heevd: info = " << info;
+      return info;
+    }
+  }
+
+  /**
+   * @brief Interface to the LAPACK `heevd` routine with a temporary workspace.
+   *
+   * @details See nda::lapack::heevd(A &&, W &&, workspace<get_value_t<A>> &, char, char).
+   *
+   * @tparam A nda::MemoryMatrix type.
+   * @tparam W nda::MemoryVector type.
+   * @param a Input/output hermitian matrix.
+   * @param w Output vector of eigenvalues.
+   * @param jobz Compute only eigenvalues (`jobz == 'N'`) or eigenvalues and eigenvectors (`jobz == 'V'`).
+   * @param uplo Triangular part of \f$ \mathbf{A} \f$ that is referenced.
+   * @return Integer return code from the LAPACK call.
+   */
+  template <MemoryMatrix A, MemoryVector W>
+    requires(mem::on_host<A, W> and is_blas_lapack_v<get_value_t<A>> and std::is_same_v<get_value_t<W>, double>)
+  int heevd(A &&a, W &&w, char jobz = 'V', char uplo = 'U') { // NOLINT (temporary views are allowed here)
+    auto ws = workspace<get_value_t<A>>{};
+    return heevd(std::forward<A>(a), std::forward<W>(w), ws, jobz, uplo);
+  }
+
+  /** @} */
+
+} // namespace nda::lapack
@@ -0,0 +1,191 @@
+// Copyright (c) 2024 Simons Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file
+ * @brief Provides generic interfaces to the LAPACK `syevr` and `heevr` routines.
+ */
+
+#pragma once
+
+#include "./interface/cxx_interface.hpp"
+#include "./workspace.hpp"
+#include "../concepts.hpp"
+#include "../exceptions.hpp"
+#include "../macros.hpp"
+#include "../mem/address_space.hpp"
+#include "../traits.hpp"
+
+#include <algorithm>
+#include <complex>
+#include <type_traits>
+#include <utility>
+
+namespace nda::lapack {
+
+  /**
+   * @addtogroup linalg_lapack
+   * @{
+   */
+
+  /**
+   * @brief Interface to the LAPACK `syevr` and `heevr` routines.
+   *
+   * @details Computes selected eigenvalues and, optionally, eigenvectors of a real symmetric or complex hermitian
+   * n-by-n matrix \f$ \mathbf{A} \f$ using the Multiple Relatively Robust Representations (MRRR) algorithm. The
+   * eigenvalues to be computed are selected by `range`:
+   * - `range == 'A'`: all eigenvalues,
+   * - `range == 'V'`: all eigenvalues in the half-open interval `(vl, vu]`,
+   * - `range == 'I'`: the eigenvalues with (zero-based) indices `il` through `iu` in ascending order.
+   *
+   * Only the requested part of the spectrum is computed, which makes it the method of choice if a few eigenpairs of a
+   * large matrix are needed. For real value types, it calls `syevr`, for complex value types `heevr`.
+   *
+   * The optimal sizes of the `work`, `rwork` and `iwork` buffers are obtained from a workspace query. The buffers are
+   * taken from the given nda::lapack::workspace, so that repeated calls with the same workspace and problem size do not
+   * allocate.
+   *
+   * @tparam A nda::MemoryMatrix type.
+   * @tparam W nda::MemoryVector type.
+   * @tparam Z nda::MemoryMatrix type.
+   * @param a Input/output matrix. On entry, the symmetric/hermitian matrix \f$ \mathbf{A} \f$ (only the triangle
+   * specified by `uplo` is referenced). On exit, its content is destroyed.
+   * @param w Output vector of size n. The first `m` elements contain the selected eigenvalues in ascending order.
+   * @param z Output matrix. If `jobz == 'V'`, its first `m` columns contain the orthonormal eigenvectors corresponding
+   * to the selected eigenvalues. It needs to have n rows and at least `iu - il + 1` (`range == 'I'`) or n (otherwise)
+   * columns. If `jobz == 'N'`, it is not referenced.
+   * @param m Output variable. The number of eigenvalues found.
+   * @param ws nda::lapack::workspace used for the `work`, `rwork` and `iwork` buffers.
+   * @param jobz Compute only eigenvalues (`jobz == 'N'`) or eigenvalues and eigenvectors (`jobz == 'V'`).
+   * @param range Selection of the eigenvalues (see above).
+   * @param vl Lower bound of the interval (only used if `range == 'V'`).
+   * @param vu Upper bound of the interval (only used if `range == 'V'`).
+   * @param il Index of the smallest eigenvalue to be returned (only used if `range == 'I'`).
+   * @param iu Index of the largest eigenvalue to be returned (only used if `range == 'I'`).
+   * @param uplo Triangular part of \f$ \mathbf{A} \f$ that is referenced.
+   * @return Integer return code from the LAPACK call.
+   */
+  template <MemoryMatrix A, MemoryVector W, MemoryMatrix Z>
+    requires(mem::on_host<A, W, Z> and have_same_value_type_v<A, Z> and is_blas_lapack_v<get_value_t<A>>
+             and std::is_same_v<get_value_t<W>, double>)
+  int syevr(A &&a, W &&w, Z &&z, int &m, workspace<get_value_t<A>> &ws, char jobz = 'V', char range = 'A', double vl = 0.0, double vu = 0.0,
+            int il = 0, int iu = 0, char uplo = 'U') { // NOLINT (temporary views are allowed here)
+    static_assert(has_F_layout<A> and has_F_layout<Z>, "Error in nda::lapack::syevr: C order not supported");
+
+    // runtime checks
+    EXPECTS(jobz == 'N' or jobz == 'V');
+    EXPECTS(range == 'A' or range == 'V' or range == 'I');
+    EXPECTS(uplo == 'U' or uplo == 'L');
+    EXPECTS(a.extent(0) == a.extent(1));
+    EXPECTS(w.size() >= a.extent(0));
+    EXPECTS(a.indexmap().min_stride() == 1);
+    EXPECTS(w.indexmap().min_stride() == 1);
+
+    int n = a.extent(0);
+    m     = 0;
+    if (n == 0) return 0;
+
+    if (range == 'I') EXPECTS(0 <= il and il <= iu and iu < n);
+    if (range == 'V') EXPECTS(vl < vu);
+    int ldz = 1;
+    if (jobz == 'V') {
+      EXPECTS(z.extent(0) == n);
+      EXPECTS(z.extent(1) >= (range == 'I' ? iu - il + 1 : n));
+      EXPECTS(z.indexmap().min_stride() == 1);
+      ldz = get_ld(z);
+    }
+
+    // call the correct LAPACK routine (isuppz is stored in front of iwork)
+    using value_type = get_value_t<A>;
+    int info         = 0;
+    auto call        = [&](value_type *work, int lwork, double *rwork, int lrwork, int *iwork, int liwork) {
+      int *isuppz = iwork;
+      if (liwork != -1) iwork += 2 * n;
+      if constexpr (is_complex_v<value_type>) {
+        f77::heevr(jobz, range, uplo, n, a.data(), get_ld(a), vl, vu, il + 1, iu + 1, 0.0, m, w.data(), z.data(), ldz, isuppz, work, lwork, rwork,
+                   lrwork, iwork, liwork, info);
+      } else {
+        f77::syevr(jobz, range, uplo, n, a.data(), get_ld(a), vl, vu, il + 1, iu + 1, 0.0, m, w.data(), z.data(), ldz, isuppz, work, lwork, iwork,
+                   liwork, info);
+      }
+    };
+
+    // first call to get the optimal buffersizes
+    value_type bufferSize_T{};
+    double rwork_size = 0;
+    int iwork_size    = 0;
+    call(&bufferSize_T, -1, &rwork_size, -1, &iwork_size, -1);
+    if (info) NDA_RUNTIME_ERROR << "Error in nda::lapack::" << (is_complex_v<value_type> ? "heevr" : "syevr") << ": info = " << info;
+    int lwork  = lwork_from_query(bufferSize_T);
+    int lrwork = lwork_from_query(rwork_size);
+    int liwork = std::max(1, iwork_size);
+
+    // get the buffers and perform actual library call
+    double *rwork = (is_complex_v<value_type> ? ws.rwork(lrwork) : nullptr);
+    call(ws.work(lwork), lwork, rwork, lrwork, ws.iwork(2 * n + liwork), liwork);
+
+    if (info) NDA_RUNTIME_ERROR << "Error in nda::lapack::" << (is_complex_v<value_type> ? "heevr" : "syevr") << ": info = " << info;
+    return info;
+  }
+
+  /**
+   * @brief Interface to the LAPACK `syevr` and `heevr` routines with a temporary workspace.
+   *
+   * @details See nda::lapack::syevr(A &&, W &&, Z &&, int &, workspace<get_value_t<A>> &, char, char, double, double,
+   * int, int, char).
+   *
+   * @tparam A nda::MemoryMatrix type.
+   * @tparam W nda::MemoryVector type.
+   * @tparam Z nda::MemoryMatrix type.
+   * @param a Input/output symmetric/hermitian matrix.
+   * @param w Output vector of eigenvalues.
+   * @param z Output matrix of eigenvectors.
+   * @param m Output variable. The number of eigenvalues found.
+   * @param jobz Compute only eigenvalues (`jobz == 'N'`) or eigenvalues and eigenvectors (`jobz == 'V'`).
+   * @param range Selection of the eigenvalues: all (`'A'`), in an interval (`'V'`) or by index (`'I'`).
+   * @param vl Lower bound of the interval (only used if `range == 'V'`).
+   * @param vu Upper bound of the interval (only used if `range == 'V'`).
+   * @param il Index of the smallest eigenvalue to be returned (only used if `range == 'I'`).
+   * @param iu Index of the largest eigenvalue to be returned (only used if `range == 'I'`).
+   * @param uplo Triangular part of \f$ \mathbf{A} \f$ that is referenced.
+   * @return Integer return code from the LAPACK call.
+   */
+  template <MemoryMatrix A, MemoryVector W, MemoryMatrix Z>
+    requires(mem::on_host<A, W, Z> and have_same_value_type_v<A, Z> and is_blas_lapack_v<get_value_t<A>>
+             and std::is_same_v<get_value_t<W>, double>)
+  int syevr(A &&a, W &&w, Z &&z, int &m, char jobz = 'V', char range = 'A', double vl = 0.0, double vu = 0.0, int il = 0, int iu = 0,
+            char uplo = 'U') { // NOLINT (temporary views are allowed here)
+    auto ws = workspace<get_value_t<A>>{};
+    return syevr(std::forward<A>(a), std::forward<W>(w), std::forward<Z>(z), m, ws, jobz, range, vl, vu, il, iu, uplo);
+  }
+
+  /**
+   * @brief Interface to the LAPACK `heevr` routine.
+   *
+   * @details Alias of nda::lapack::syevr, which calls `heevr` for complex value types.
+   *
+   * @tparam Args Types of the arguments.
+   * @param args Arguments forwarded to nda::lapack::syevr.
+   * @return Integer return code from the LAPACK call.
+   */
+  template <typename... Args>
+  int heevr(Args &&...args)
+    requires(requires { syevr(std::forward<Args>(args)...); })
+  {
+    return syevr(std::forward<Args>(args)...);
+  }
+
+  /** @} */
+
+} // namespace nda::lapack
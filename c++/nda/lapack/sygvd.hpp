@@ -0,0 +1,225 @@
+// Copyright (c) 2024 Simons Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file
+ * @brief Provides generic interfaces to the LAPACK `sygvd` and `hegvd` routines.
+ */
+
+#pragma once
+
+#include "./interface/cxx_interface.hpp"
+#include "./workspace.hpp"
+#include "../concepts.hpp"
+#include "../exceptions.hpp"
+#include "../macros.hpp"
+#include "../mem/address_space.hpp"
+#include "../traits.hpp"
+
+#include <algorithm>
+#include <complex>
+#include <type_traits>
+#include <utility>
+
+namespace nda::lapack {
+
+  /**
+   * @addtogroup linalg_lapack
+   * @{
+   */
+
+  /**
+   * @brief Interface to the LAPACK `sygvd` routine.
+   *
+   * @details Computes all eigenvalues and, optionally, eigenvectors of a real generalized symmetric-definite
+   * eigenproblem of the form
+   * - `itype == 1`: \f$ \mathbf{A x} = \lambda \mathbf{B x} \f$,
+   * - `itype == 2`: \f$ \mathbf{A B x} = \lambda \mathbf{x} \f$,
+   * - `itype == 3`: \f$ \mathbf{B A x} = \lambda \mathbf{x} \f$,
+   *
+   * where \f$ \mathbf{A} \f$ is symmetric and \f$ \mathbf{B} \f$ is symmetric positive definite. It uses a divide and
+   * conquer algorithm for the reduced standard eigenproblem.
+   *
+   * The optimal sizes of the `work` and `iwork` buffers are obtained from a workspace query. The buffers are taken from
+   * the given nda::lapack::workspace, so that repeated calls with the same workspace and problem size do not allocate.
+   *
+   * @tparam A nda::MemoryMatrix type.
+   * @tparam B nda::MemoryMatrix type.
+   * @tparam W nda::MemoryVector type.
+   * @param a Input/output matrix. On entry, the symmetric matrix \f$ \mathbf{A} \f$ (only the triangle specified by
+   * `uplo` is referenced). On exit, if `jobz == 'V'`, it contains the eigenvectors in its columns, normalized such that
+   * \f$ \mathbf{X}^T \mathbf{B X} = \mathbf{1} \f$ (`itype == 1` or `itype == 2`) or \f$ \mathbf{X}^T \mathbf{B}^{-1}
+   * \mathbf{X} = \mathbf{1} \f$ (`itype == 3`). Otherwise, its content is destroyed.
+   * @param b Input/output matrix. On entry, the symmetric positive definite matrix \f$ \mathbf{B} \f$ (only the triangle
+   * specified by `uplo` is referenced). On exit, its Cholesky factor (see nda::lapack::potrf).
+   * @param w Output vector of size n. The eigenvalues in ascending order.
+   * @param ws nda::lapack::workspace used for the `work` and `iwork` buffers.
+   * @param jobz Compute only eigenvalues (`jobz == 'N'`) or eigenvalues and eigenvectors (`jobz == 'V'`).
+   * @param uplo Triangular part of \f$ \mathbf{A} \f$ and \f$ \mathbf{B} \f$ that is referenced.
+   * @param itype Type of the generalized eigenproblem (see above).
+   * @return Integer return code from the LAPACK call.
+   */
+  template <MemoryMatrix A, MemoryMatrix B, MemoryVector W>
+    requires(mem::on_host<A, B, W> and std::is_same_v<get_value_t<A>, double> and have_same_value_type_v<A, B, W>)
+  int sygvd(A &&a, B &&b, W &&w, workspace<double> &ws, char jobz = 'V', char uplo = 'U', // NOLINT (temporary views are allowed here)
+            int itype = 1) {
+    static_assert(has_F_layout<A> and has_F_layout<B>, "Error in nda::lapack::sygvd: C order not supported");
+
+    // runtime checks
+    EXPECTS(itype == 1 or itype == 2 or itype == 3);
+    EXPECTS(jobz == 'N' or jobz == 'V');
+    EXPECTS(uplo == 'U' or uplo == 'L');
+    EXPECTS(a.extent(0) == a.extent(1));
+    EXPECTS(b.shape() == a.shape());
+    EXPECTS(w.size() >= a.extent(0));
+    EXPECTS(a.indexmap().min_stride() == 1);
+    EXPECTS(b.indexmap().min_stride() == 1);
+    EXPECTS(w.indexmap().min_stride() == 1);
+
+    int n = a.extent(0);
+    if (n == 0) return 0;
+
+    // first call to get the optimal buffersizes
+    double bufferSize_T{};
+    int iwork_size = 0, info = 0;
+    f77::sygvd(itype, jobz, uplo, n, a.data(), get_ld(a), b.data(), get_ld(b), w.data(), &bufferSize_T, -1, &iwork_size, -1, info);
+    int lwork  = lwork_from_query(bufferSize_T);
+    int liwork = std::max(1, iwork_size);
+
+    // get the buffers and perform actual library call
+    f77::sygvd(itype, jobz, uplo, n, a.data(), get_ld(a), b.data(), get_ld(b), w.data(), ws.work(lwork), lwork, ws.iwork(liwork), liwork, info);
+
+    if (info) NDA_RUNTIME_ERROR << "Error in nda::lapack::sygvd: info = " << info;
+    return info;
+  }
+
+  /**
+   * @brief Interface to the LAPACK `sygvd` routine with a temporary workspace.
+   *
+   * @details See nda::lapack::sygvd(A &&, B &&, W &&, workspace<double> &, char, char, int).
+   *
+   * @tparam A nda::MemoryMatrix type.
+   * @tparam B nda::MemoryMatrix type.
+   * @tparam W nda::MemoryVector type.
+   * @param a Input/output symmetric matrix \f$ \mathbf{A} \f$.
+   * @param b Input/output symmetric positive definite matrix \f$ \mathbf{B} \f$.
+   * @param w Output vector of eigenvalues.
+   * @param jobz Compute only eigenvalues (`jobz == 'N'`) or eigenvalues and eigenvectors (`jobz == 'V'`).
+   * @param uplo Triangular part of \f$ \mathbf{A} \f$ and \f$ \mathbf{B} \f$ that is referenced.
+   * @param itype Type of the generalized eigenproblem.
+   * @return Integer return code from the LAPACK call.
+   */
+  template <MemoryMatrix A, MemoryMatrix B, MemoryVector W>
+    requires(mem::on_host<A, B, W> and std::is_same_v<get_value_t<A>, double> and have_same_value_type_v<A, B, W>)
+  int sygvd(A &&a, B &&b, W &&w, char jobz = 'V', char uplo = 'U', int itype = 1) { // NOLINT (temporary views are allowed here)
+    auto ws = workspace<double>{};
+    return sygvd(std::forward<A>(a), std::forward<B>(b), std::forward<W>(w), ws, jobz, uplo, itype);
+  }
+
+  /**
+   * @brief Interface to the LAPACK `hegvd` routine.
+   *
+   * @details Computes all eigenvalues and, optionally, eigenvectors of a complex generalized hermitian-definite
+   * eigenproblem, where \f$ \mathbf{A} \f$ is hermitian and \f$ \mathbf{B} \f$ is hermitian positive definite (see
+   * nda::lapack::sygvd for the different types of problems). For real value types, it calls nda::lapack::sygvd.
+   *
+   * The optimal sizes of the `work`, `rwork` and `iwork` buffers are obtained from a workspace query. The buffers are
+   * taken from the given nda::lapack::workspace, so that repeated calls with the same workspace and problem size do not
+   * allocate.
+   *
+   * @tparam A nda::MemoryMatrix type.
+   * @tparam B nda::MemoryMatrix type.
+   * @tparam W nda::MemoryVector type.
+   * @param a Input/output matrix. On entry, the hermitian matrix \f$ \mathbf{A} \f$ (only the triangle specified by
+   * `uplo` is referenced). On exit, if `jobz == 'V'`, it contains the \f$ \mathbf{B} \f$-orthonormal eigenvectors in
+   * its columns. Otherwise, its content is destroyed.
+   * @param b Input/output matrix. On entry, the hermitian positive definite matrix \f$ \mathbf{B} \f$ (only the
+   * triangle specified by `uplo` is referenced). On exit, its Cholesky factor (see nda::lapack::potrf).
+   * @param w Output vector of size n. The eigenvalues in ascending order.
+   * @param ws nda::lapack::workspace used for the `work`, `rwork` and `iwork` buffers.
+   * @param jobz Compute only eigenvalues (`jobz == 'N'`) or eigenvalues and eigenvectors (`jobz == 'V'`).
+   * @param uplo Triangular part of \f$ \mathbf{A} \f$ and \f$ \mathbf{B} \f$ that is referenced.
+   * @param itype Type of the generalized eigenproblem.
+   * @return Integer return code from the LAPACK call.
+   */
+  template <MemoryMatrix A, MemoryMatrix B, MemoryVector W>
+    requires(mem::on_host<A, B, W> and is_blas_lapack_v<get_value_t<A>> and have_same_value_type_v<A, B>
+             and std::is_same_v<get_value_t<W>, double>)
+  int hegvd(A &&a, B &&b, W &&w, workspace<get_value_t<A>> &ws, char jobz = 'V', // NOLINT (temporary views are allowed here)
+            char uplo = 'U', int itype = 1) {
+    if constexpr (not is_complex_v<get_value_t<A>>) {
+      return sygvd(std::forward<A>(a), std::forward<B>(b), std::forward<W>(w), ws, jobz, uplo, itype);
+    } else {
+      static_assert(has_F_layout<A> and has_F_layout<B>, "Error in nda::lapack::hegvd: C order not supported");
+
+      // runtime checks
+      EXPECTS(itype == 1 or itype == 2 or itype == 3);
+      EXPECTS(jobz == 'N' or jobz == 'V');
+      EXPECTS(uplo == 'U' or uplo == 'L');
+      EXPECTS(a.extent(0) == a.extent(1));
+      EXPECTS(b.shape() == a.shape());
+      EXPECTS(w.size() >= a.extent(0));
+      EXPECTS(a.indexmap().min_stride() == 1);
+      EXPECTS(b.indexmap().min_stride() == 1);
+      EXPECTS(w.indexmap().min_stride() == 1);
+
+      int n = a.extent(0);
+      if (n == 0) return 0;
+
+      // first call to get the optimal buffersizes
+      std::complex<double> bufferSize_T{};
+      double rwork_size = 0;
+      int iwork_size = 0, info = 0;
+      f77::hegvd(itype, jobz, uplo, n, a.data(), get_ld(a), b.data(), get_ld(b), w.data(), &bufferSize_T, -1, &rwork_size, -1, &iwork_size, -1,
+                 info);
+      int lwork  = lwork_from_query(bufferSize_T);
+      int lrwork = lwork_from_query(rwork_size);
+      int liwork = std::max(1, iwork_size);
+
+      // get the buffers and perform actual library call
+      f77::hegvd(itype, jobz, uplo, n, a.data(), get_ld(a), b.data(), get_ld(b), w.data(), ws.work(lwork), lwork, ws.rwork(lrwork), lrwork,
+                 ws.iwork(liwork), liwork, info);
+
+      if (info) NDA_RUNTIME_ERROR << "Error in nda::lapack::hegvd: info = " << info;
+      return info;
+    }
+  }
+
+  /**
+   * @brief Interface to the LAPACK `hegvd` routine with a temporary workspace.
+   *
+   * @details See nda::lapack::hegvd(A &&, B &&, W &&, workspace<get_value_t<A>> &, char, char, int).
+   *
+   * @tparam A nda::MemoryMatrix type.
+   * @tparam B nda::MemoryMatrix type.
+   * @tparam W nda::MemoryVector type.
+   * @param a Input/output hermitian matrix \f$ \mathbf{A} \f$.
+   * @param b Input/output hermitian positive definite matrix \f$ \mathbf{B} \f$.
+   * @param w Output vector of eigenvalues.
+   * @param jobz Compute only eigenvalues (`jobz == 'N'`) or eigenvalues and eigenvectors (`jobz == 'V'`).
+   * @param uplo Triangular part of \f$ \mathbf{A} \f$ and \f$ \mathbf{B} \f$ that is referenced.
+   * @param itype Type of the generalized eigenproblem.
+   * @return Integer return code from the LAPACK call.
+   */
+  template <MemoryMatrix A, MemoryMatrix B, MemoryVector W>
+    requires(mem::on_host<A, B, W> and is_blas_lapack_v<get_value_t<A>> and have_same_value_type_v<A, B>
+             and std::is_same_v<get_value_t<W>, double>)
+  int hegvd(A &&a, B &&b, W &&w, char jobz = 'V', char uplo = 'U', int itype = 1) { // NOLINT (temporary views are allowed here)
+    auto ws = workspace<get_value_t<A>>{};
+    return hegvd(std::forward<A>(a), std::forward<B>(b), std::forward<W>(w), ws, jobz, uplo, itype);
+  }
+
+  /** @} */
+
+} // namespace nda::lapack
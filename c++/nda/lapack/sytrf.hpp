@@ -0,0 +1,196 @@
+// Copyright (c) 2024 Simons Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file
+ * @brief Provides generic interfaces to the LAPACK `sytrf` and `hetrf` routines.
+ */
+
+#pragma once
+
+#include "./interface/cxx_interface.hpp"
+#include "./workspace.hpp"
+#include "../concepts.hpp"
+#include "../macros.hpp"
+#include "../mem/address_space.hpp"
+#include "../traits.hpp"
+
+#include <type_traits>
+#include <utility>
+
+namespace nda::lapack {
+
+  /**
+   * @addtogroup linalg_lapack
+   * @{
+   */
+
+  /**
+   * @brief Interface to the LAPACK `sytrf` routine.
+   *
+   * @details Computes the factorization of a real or complex symmetric n-by-n matrix \f$ \mathbf{A} \f$ using the
+   * Bunch-Kaufman diagonal pivoting method:
+   * \f[
+   *   \mathbf{A} = \mathbf{U} \mathbf{D} \mathbf{U}^T \quad \mathrm{or} \quad \mathbf{A} = \mathbf{L} \mathbf{D}
+   *   \mathbf{L}^T \;,
+   * \f]
+   * if `uplo == 'U'` or `uplo == 'L'`, respectively, where \f$ \mathbf{U} \f$ (\f$ \mathbf{L} \f$) is a product of
+   * permutation and unit upper (lower) triangular matrices, and \f$ \mathbf{D} \f$ is symmetric and block diagonal
+   * with 1-by-1 and 2-by-2 diagonal blocks. Unlike `potrf`, it does not require \f$ \mathbf{A} \f$ to be positive
+   * definite.
+   *
+   * The matrix can be in C or Fortran order. For a matrix in C order, the factorization of its transpose is computed,
+   * which is the same matrix with the other triangle referenced. The result should only be used with
+   * nda::lapack::sytrs and the same `uplo`.
+   *
+   * The optimal size of the `work` buffer is obtained from a workspace query and the buffer is taken from the given
+   * nda::lapack::workspace.
+   *
+   * @tparam A nda::MemoryMatrix type.
+   * @tparam IPIV nda::MemoryVector type.
+   * @param a Input/output matrix. On entry, the symmetric matrix \f$ \mathbf{A} \f$ (only the triangle specified by
+   * `uplo` is referenced). On exit, the block diagonal matrix \f$ \mathbf{D} \f$ and the multipliers used to obtain
+   * the factor \f$ \mathbf{U} \f$ or \f$ \mathbf{L} \f$.
+   * @param ipiv Output vector. Details of the interchanges and the block structure of \f$ \mathbf{D} \f$.
+   * @param ws nda::lapack::workspace used for the `work` buffer.
+   * @param uplo Triangular part of \f$ \mathbf{A} \f$ that is referenced and overwritten.
+   * @return Integer return code from the LAPACK call. If `INFO > 0`, `D(INFO, INFO)` is exactly zero and the matrix is
+   * singular.
+   */
+  template <MemoryMatrix A, MemoryVector IPIV>
+    requires(mem::on_host<A, IPIV> and is_blas_lapack_v<get_value_t<A>>)
+  int sytrf(A &&a, IPIV &&ipiv, workspace<get_value_t<A>> &ws, char uplo = 'U') { // NOLINT (temporary views are allowed here)
+    static_assert(std::is_same_v<get_value_t<IPIV>, int>, "Error in nda::lapack::sytrf: Pivoting array must have elements of type int");
+
+    // runtime checks
+    EXPECTS(uplo == 'U' or uplo == 'L');
+    EXPECTS(a.extent(0) == a.extent(1));
+    EXPECTS(ipiv.size() >= a.extent(0));
+    EXPECTS(a.indexmap().min_stride() == 1);
+    EXPECTS(ipiv.indexmap().min_stride() == 1);
+
+    // for a matrix in C order, the other triangle is referenced in Fortran order
+    char uplo_f = (has_C_layout<A> ? flip_uplo(uplo) : uplo);
+    int n       = a.extent(0);
+
+    // first call to get the optimal buffersize
+    using value_type = get_value_t<A>;
+    value_type bufferSize_T{};
+    int info = 0;
+    f77::sytrf(uplo_f, n, a.data(), get_ld(a), ipiv.data(), &bufferSize_T, -1, info);
+    int bufferSize = lwork_from_query(bufferSize_T);
+
+    // get the work buffer and perform actual library call
+    f77::sytrf(uplo_f, n, a.data(), get_ld(a), ipiv.data(), ws.work(bufferSize), bufferSize, info);
+    return info;
+  }
+
+  /**
+   * @brief Interface to the LAPACK `sytrf` routine with a temporary workspace.
+   *
+   * @details See nda::lapack::sytrf(A &&, IPIV &&, workspace<get_value_t<A>> &, char).
+   *
+   * @tparam A nda::MemoryMatrix type.
+   * @tparam IPIV nda::MemoryVector type.
+   * @param a Input/output symmetric matrix.
+   * @param ipiv Output vector of pivot indices.
+   * @param uplo Triangular part of \f$ \mathbf{A} \f$ that is referenced and overwritten.
+   * @return Integer return code from the LAPACK call.
+   */
+  template <MemoryMatrix A, MemoryVector IPIV>
+    requires(mem::on_host<A, IPIV> and is_blas_lapack_v<get_value_t<A>>)
+  int sytrf(A &&a, IPIV &&ipiv, char uplo = 'U') { // NOLINT (temporary views are allowed here)
+    auto ws = workspace<get_value_t<A>>{};
+    return sytrf(std::forward<A>(a), std::forward<IPIV>(ipiv), ws, uplo);
+  }
+
+  /**
+   * @brief Interface to the LAPACK `hetrf` routine.
+   *
+   * @details Computes the factorization of a complex hermitian n-by-n matrix \f$ \mathbf{A} \f$ using the
+   * Bunch-Kaufman diagonal pivoting method:
+   * \f[
+   *   \mathbf{A} = \mathbf{U} \mathbf{D} \mathbf{U}^H \quad \mathrm{or} \quad \mathbf{A} = \mathbf{L} \mathbf{D}
+   *   \mathbf{L}^H \;,
+   * \f]
+   * if `uplo == 'U'` or `uplo == 'L'`, respectively. For real value types, it calls nda::lapack::sytrf.
+   *
+   * The matrix can be in C or Fortran order. For a matrix in C order, the factorization of its transpose, i.e. its
+   * complex conjugate, is computed. The result should only be used with nda::lapack::hetrs and the same `uplo`.
+   *
+   * @tparam A nda::MemoryMatrix type.
+   * @tparam IPIV nda::MemoryVector type.
+   * @param a Input/output matrix. On entry, the hermitian matrix \f$ \mathbf{A} \f$ (only the triangle specified by
+   * `uplo` is referenced). On exit, the block diagonal matrix \f$ \mathbf{D} \f$ and the multipliers used to obtain
+   * the factor \f$ \mathbf{U} \f$ or \f$ \mathbf{L} \f$.
+   * @param ipiv Output vector. Details of the interchanges and the block structure of \f$ \mathbf{D} \f$.
+   * @param ws nda::lapack::workspace used for the `work` buffer.
+   * @param uplo Triangular part of \f$ \mathbf{A} \f$ that is referenced and overwritten.
+   * @return Integer return code from the LAPACK call. If `INFO > 0`, `D(INFO, INFO)` is exactly zero and the matrix is
+   * singular.
+   */
+  template <MemoryMatrix A, MemoryVector IPIV>
+    requires(mem::on_host<A, IPIV> and is_blas_lapack_v<get_value_t<A>>)
+  int hetrf(A &&a, IPIV &&ipiv, workspace<get_value_t<A>> &ws, char uplo = 'U') { // NOLINT (temporary views are allowed here)
+    if constexpr (not is_complex_v<get_value_t<A>>) {
+      return sytrf(std::forward<A>(a), std::forward<IPIV>(ipiv), ws, uplo);
+    } else {
+      static_assert(std::is_same_v<get_value_t<IPIV>, int>, "Error in nda::lapack::hetrf: Pivoting array must have elements of type int");
+
+      // runtime checks
+      EXPECTS(uplo == 'U' or uplo == 'L');
+      EXPECTS(a.extent(0) == a.extent(1));
+      EXPECTS(ipiv.size() >= a.extent(0));
+      EXPECTS(a.indexmap().min_stride() == 1);
+      EXPECTS(ipiv.indexmap().min_stride() == 1);
+
+      // for a matrix in C order, the other triangle is referenced in Fortran order
+      char uplo_f = (has_C_layout<A> ? flip_uplo(uplo) : uplo);
+      int n       = a.extent(0);
+
+      // first call to get the optimal buffersize
+      using value_type = get_value_t<A>;
+      value_type bufferSize_T{};
+      int info = 0;
+      f77::hetrf(uplo_f, n, a.data(), get_ld(a), ipiv.data(), &bufferSize_T, -1, info);
+      int bufferSize = lwork_from_query(bufferSize_T);
+
+      // get the work buffer and perform actual library call
+      f77::hetrf(uplo_f, n, a.data(), get_ld(a), ipiv.data(), ws.work(bufferSize), bufferSize, info);
+      return info;
+    }
+  }
+
+  /**
+   * @brief Interface to the LAPACK `hetrf` routine with a temporary workspace.
+   *
+   * @details See nda::lapack::hetrf(A &&, IPIV &&, workspace<get_value_t<A>> &, char).
+   *
+   * @tparam A nda::MemoryMatrix type.
+   * @tparam IPIV nda::MemoryVector type.
+   * @param a Input/output hermitian matrix.
+   * @param ipiv Output vector of pivot indices.
+   * @param uplo Triangular part of \f$ \mathbf{A} \f$ that is referenced and overwritten.
+   * @return Integer return code from the LAPACK call.
+   */
+  template <MemoryMatrix A, MemoryVector IPIV>
+    requires(mem::on_host<A, IPIV> and is_blas_lapack_v<get_value_t<A>>)
+  int hetrf(A &&a, IPIV &&ipiv, char uplo = 'U') { // NOLINT (temporary views are allowed here)
+    auto ws = workspace<get_value_t<A>>{};
+    return hetrf(std::forward<A>(a), std::forward<IPIV>(ipiv), ws, uplo);
+  }
+
+  /** @} */
+
+} // namespace nda::lapack
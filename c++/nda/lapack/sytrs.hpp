@@ -0,0 +1,133 @@
+// Copyright (c) 2024 Simons Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file
+ * @brief Provides generic interfaces to the LAPACK `sytrs` and `hetrs` routines.
+ */
+
+#pragma once
+
+#include "./interface/cxx_interface.hpp"
+#include "../concepts.hpp"
+#include "../macros.hpp"
+#include "../mapped_functions.hpp"
+#include "../mem/address_space.hpp"
+#include "../traits.hpp"
+
+#include <algorithm>
+#include <type_traits>
+
+namespace nda::lapack {
+
+  /**
+   * @addtogroup linalg_lapack
+   * @{
+   */
+
+  namespace detail {
+
+    // Common implementation of sytrs (hermitian == false) and hetrs (hermitian == true).
+    template <bool hermitian, typename A, typename B, typename IPIV>
+    int sytrs_impl(A const &a, B &b, IPIV const &ipiv, char uplo) {
+      static_assert(MemoryVector<B> or MemoryMatrix<B>, "Error in nda::lapack::sytrs/hetrs: B must be a vector or a matrix");
+      static_assert(has_F_layout<B>, "Error in nda::lapack::sytrs/hetrs: C order not supported for B");
+      static_assert(std::is_same_v<get_value_t<IPIV>, int>, "Error in nda::lapack::sytrs/hetrs: Pivoting array must have elements of type int");
+
+      // runtime checks
+      EXPECTS(uplo == 'U' or uplo == 'L');
+      EXPECTS(a.extent(0) == a.extent(1));
+      EXPECTS(a.extent(0) == b.extent(0));
+      EXPECTS(ipiv.size() >= a.extent(0));
+      EXPECTS(a.indexmap().min_stride() == 1);
+      EXPECTS(b.indexmap().min_stride() == 1);
+      EXPECTS(ipiv.indexmap().min_stride() == 1);
+
+      int nrhs = 1, ldb = std::max(1, static_cast<int>(b.extent(0))); // defaults for B MemoryVector
+      if constexpr (MemoryMatrix<B>) {
+        nrhs = b.extent(1);
+        ldb  = get_ld(b);
+      }
+
+      // for a hermitian matrix in C order, LAPACK sees its complex conjugate
+      static constexpr bool conj_b = hermitian and has_C_layout<A> and is_complex_v<get_value_t<A>>;
+      char uplo_f                  = (has_C_layout<A> ? flip_uplo(uplo) : uplo);
+      if constexpr (conj_b) b = conj(b);
+
+      int info = 0;
+      if constexpr (hermitian and is_complex_v<get_value_t<A>>)
+        f77::hetrs(uplo_f, a.extent(0), nrhs, a.data(), get_ld(a), ipiv.data(), b.data(), ldb, info);
+      else
+        f77::sytrs(uplo_f, a.extent(0), nrhs, a.data(), get_ld(a), ipiv.data(), b.data(), ldb, info);
+
+      if constexpr (conj_b) b = conj(b);
+      return info;
+    }
+
+  } // namespace detail
+
+  /**
+   * @brief Interface to the LAPACK `sytrs` routine.
+   *
+   * @details Solves a system of linear equations \f$ \mathbf{A X} = \mathbf{B} \f$ with a real or complex symmetric
+   * n-by-n matrix \f$ \mathbf{A} \f$ using the factorization computed by nda::lapack::sytrf.
+   *
+   * The factored matrix can be in C or Fortran order, but it has to be in the same order as in the call to `sytrf`.
+   * The right hand side has to be a vector or a matrix in Fortran order.
+   *
+   * @tparam A nda::MemoryMatrix type.
+   * @tparam B nda::MemoryArray type.
+   * @tparam IPIV nda::MemoryVector type.
+   * @param a Input matrix. The factored matrix as computed by `sytrf`.
+   * @param b Input/output array. On entry, the right hand side vector/matrix \f$ \mathbf{B} \f$. On exit, the solution
+   * vector/matrix \f$ \mathbf{X} \f$.
+   * @param ipiv Input vector. The pivot indices from `sytrf`.
+   * @param uplo Triangular part of \f$ \mathbf{A} \f$ that contains the factor (as in the call to `sytrf`).
+   * @return Integer return code from the LAPACK call.
+   */
+  template <MemoryMatrix A, MemoryArray B, MemoryVector IPIV>
+    requires(have_same_value_type_v<A, B> and mem::on_host<A, B, IPIV> and is_blas_lapack_v<get_value_t<A>>)
+  int sytrs(A const &a, B &&b, IPIV const &ipiv, char uplo = 'U') { // NOLINT (temporary views are allowed here)
+    return detail::sytrs_impl<false>(a, b, ipiv, uplo);
+  }
+
+  /**
+   * @brief Interface to the LAPACK `hetrs` routine.
+   *
+   * @details Solves a system of linear equations \f$ \mathbf{A X} = \mathbf{B} \f$ with a complex hermitian n-by-n
+   * matrix \f$ \mathbf{A} \f$ using the factorization computed by nda::lapack::hetrf. For real value types, it calls
+   * `sytrs`.
+   *
+   * The factored matrix can be in C or Fortran order, but it has to be in the same order as in the call to `hetrf`.
+   * The right hand side has to be a vector or a matrix in Fortran order.
+   *
+   * @tparam A nda::MemoryMatrix type.
+   * @tparam B nda::MemoryArray type.
+   * @tparam IPIV nda::MemoryVector type.
+   * @param a Input matrix. The factored matrix as computed by `hetrf`.
+   * @param b Input/output array. On entry, the right hand side vector/matrix \f$ \mathbf{B} \f$. On exit, the solution
+   * vector/matrix \f$ \mathbf{X} \f$.
+   * @param ipiv Input vector. The pivot indices from `hetrf`.
+   * @param uplo Triangular part of \f$ \mathbf{A} \f$ that contains the factor (as in the call to `hetrf`).
+   * @return Integer return code from the LAPACK call.
+   */
+  template <MemoryMatrix A, MemoryArray B, MemoryVector IPIV>
+    requires(have_same_value_type_v<A, B> and mem::on_host<A, B, IPIV> and is_blas_lapack_v<get_value_t<A>>)
+  int hetrs(A const &a, B &&b, IPIV const &ipiv, char uplo = 'U') { // NOLINT (temporary views are allowed here)
+    return detail::sytrs_impl<true>(a, b, ipiv, uplo);
+  }
+
+  /** @} */
+
+} // namespace nda::lapack
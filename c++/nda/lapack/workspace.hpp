@@ -0,0 +1,127 @@
+// Copyright (c) 2024 Simons Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file
+ * @brief Provides a reusable workspace for LAPACK routines.
+ */
+
+#pragma once
+
+#include "../basic_array.hpp"
+#include "../declarations.hpp"
+#include "../layout/policies.hpp"
+#include "../mem/address_space.hpp"
+#include "../mem/policies.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+
+namespace nda::lapack {
+
+  /**
+   * @addtogroup linalg_lapack
+   * @{
+   */
+
+  /**
+   * @brief Convert the optimal workspace size returned by a LAPACK workspace query (`lwork == -1`) to an integer.
+   *
+   * @tparam T Value type of the workspace.
+   * @param w Value written to the first element of the work array by the query.
+   * @return Optimal workspace size (at least 1).
+   */
+  template <typename T>
+  int lwork_from_query(T const &w) {
+    return std::max(1, static_cast<int>(std::ceil(std::real(w))));
+  }
+
+  /**
+   * @brief Reusable workspace for LAPACK routines.
+   *
+   * @details It holds the `work`, `rwork` and `iwork` buffers required by most LAPACK routines. The buffers only grow,
+   * i.e. they are reallocated only if a routine requests more memory than is currently available. Passing the same
+   * workspace to repeated calls of a routine with the same problem size therefore performs no allocation after the
+   * first call.
+   *
+   * A workspace must not be shared between threads.
+   *
+   * @tparam T Value type of the `work` buffer.
+   * @tparam AdrSp nda::mem::AddressSpace of the buffers.
+   */
+  template <typename T, mem::AddressSpace AdrSp = mem::Host>
+  class workspace {
+    // Buffer for elements of type T.
+    array<T, 1, C_layout, heap<AdrSp>> work_;
+
+    // Buffer for real elements (only used by complex routines).
+    array<double, 1, C_layout, heap<AdrSp>> rwork_;
+
+    // Buffer for integer elements.
+    array<int, 1, C_layout, heap<AdrSp>> iwork_;
+
+    // Grow a buffer to at least the given size.
+    static auto *grow(auto &buf, long n) {
+      if (buf.size() < n) buf.resize(n);
+      return buf.data();
+    }
+
+    public:
+    /// Value type of the `work` buffer.
+    using value_type = T;
+
+    /**
+     * @brief Get a `work` buffer with at least the given number of elements.
+     * @param n Required number of elements.
+     * @return Pointer to the buffer.
+     */
+    T *work(long n) { return grow(work_, n); }
+
+    /**
+     * @brief Get a `rwork` buffer with at least the given number of elements.
+     * @param n Required number of elements.
+     * @return Pointer to the buffer.
+     */
+    double *rwork(long n) { return grow(rwork_, n); }
+
+    /**
+     * @brief Get an `iwork` buffer with at least the given number of elements.
+     * @param n Required number of elements.
+     * @return Pointer to the buffer.
+     */
+    int *iwork(long n) { return grow(iwork_, n); }
+
+    /**
+     * @brief Get the current size of the `work` buffer.
+     * @return Number of elements in the `work` buffer.
+     */
+    [[nodiscard]] long work_size() const { return work_.size(); }
+
+    /**
+     * @brief Get the current size of the `rwork` buffer.
+     * @return Number of elements in the `rwork` buffer.
+     */
+    [[nodiscard]] long rwork_size() const { return rwork_.size(); }
+
+    /**
+     * @brief Get the current size of the `iwork` buffer.
+     * @return Number of elements in the `iwork` buffer.
+     */
+    [[nodiscard]] long iwork_size() const { return iwork_.size(); }
+  };
+
+  /** @} */
+
+} // namespace nda::lapack
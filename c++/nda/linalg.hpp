@@ -24,9 +24,22 @@
 #include "./blas.hpp"
 #include "./lapack.hpp"
 
+#include "./linalg/banded_matrix.hpp"
+#include "./linalg/batched.hpp"
+#include "./linalg/block_diagonal.hpp"
+#include "./linalg/cholesky.hpp"
 #include "./linalg/cross_product.hpp"
 #include "./linalg/det_and_inverse.hpp"
+#include "./linalg/det_manip.hpp"
 #include "./linalg/dot.hpp"
 #include "./linalg/eigenelements.hpp"
+#include "./linalg/eigensolvers.hpp"
+#include "./linalg/einsum.hpp"
+#include "./linalg/interleaved.hpp"
+#include "./linalg/krylov.hpp"
+#include "./linalg/lu.hpp"
 #include "./linalg/matmul.hpp"
+#include "./linalg/matrix_functions.hpp"
 #include "./linalg/norm.hpp"
+#include "./linalg/packed_matrix.hpp"
+#include "./linalg/randomized_svd.hpp"
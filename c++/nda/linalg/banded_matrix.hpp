@@ -0,0 +1,426 @@
+// Copyright (c) 2024 Simons Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file
+ * @brief Provides a band matrix type in LAPACK band storage and its LU factorization.
+ */
+
+#pragma once
+
+#include "../basic_array.hpp"
+#include "../blas/gbmv.hpp"
+#include "../concepts.hpp"
+#include "../declarations.hpp"
+#include "../exceptions.hpp"
+#include "../lapack/gbtrf.hpp"
+#include "../lapack/gbtrs.hpp"
+#include "../layout/policies.hpp"
+#include "../layout/range.hpp"
+#include "../macros.hpp"
+#include "../mem/address_space.hpp"
+#include "../traits.hpp"
+
+#include <algorithm>
+#include <array>
+#include <type_traits>
+
+namespace nda::linalg {
+
+  /**
+   * @addtogroup linalg_tools
+   * @{
+   */
+
+  /**
+   * @brief n-by-n band matrix with `kl` sub-diagonals and `ku` super-diagonals in LAPACK band storage.
+   *
+   * @details The element \f$ A_{ij} \f$ with \f$ j - k_u \leq i \leq j + k_l \f$ is stored in the (kl + ku + 1)-by-n
+   * matrix `storage()` at position `(ku + i - j, j)`, i.e. the diagonals of \f$ \mathbf{A} \f$ are stored in the rows
+   * of the storage matrix. All other elements are zero. Compared to a full nda::matrix, matrix-vector products
+   * (nda::blas::gbmv) and linear solves (nda::linalg::banded_lu) scale linearly with n:
+   *
+   * @code{.cpp}
+   * auto A = nda::linalg::banded_matrix<double>::zeros(n, 1, 1); // tridiagonal matrix
+   * A.diagonal(-1) = -1.0;
+   * A.diagonal(0)  = 2.0;
+   * A.diagonal(1)  = -1.0;
+   * auto y = A * x;
+   * auto f = nda::linalg::banded_lu{A};
+   * f.solve(y); // y <- A^{-1} y
+   * @endcode
+   *
+   * @tparam T Value type of the matrix (double or std::complex<double>).
+   */
+  template <typename T>
+    requires(is_blas_lapack_v<T>)
+  class banded_matrix {
+    // Number of rows/columns.
+    long n_ = 0;
+
+    // Number of sub-diagonals.
+    long kl_ = 0;
+
+    // Number of super-diagonals.
+    long ku_ = 0;
+
+    // Band storage.
+    matrix<T, F_layout> data_;
+
+    public:
+    /// Value type of the matrix.
+    using value_type = T;
+
+    /// Default constructor creates an empty matrix.
+    banded_matrix() = default;
+
+    /**
+     * @brief Construct an n-by-n band matrix.
+     *
+     * @details The elements are not initialized.
+     *
+     * @param n Number of rows/columns.
+     * @param kl Number of sub-diagonals.
+     * @param ku Number of super-diagonals.
+     */
+    banded_matrix(long n, long kl, long ku) : n_(n), kl_(kl), ku_(ku), data_(kl + ku + 1, n) { EXPECTS(n >= 0 and kl >= 0 and ku >= 0); }
+
+    /**
+     * @brief Construct a band matrix from the band of a square matrix.
+     *
+     * @details The elements outside of the band are ignored.
+     *
+     * @tparam M nda::Matrix type.
+     * @param m Square matrix.
+     * @param kl Number of sub-diagonals.
+     * @param ku Number of super-diagonals.
+     */
+    template <Matrix M>
+      requires(std::is_convertible_v<get_value_t<M>, T>)
+    banded_matrix(M const &m, long kl, long ku) : banded_matrix(zeros(m.extent(0), kl, ku)) {
+      if (m.extent(0) != m.extent(1)) NDA_RUNTIME_ERROR << "Error in nda::linalg::banded_matrix: Matrix is not square: " << m.shape();
+      for (long j = 0; j < n_; ++j)
+        for (long i = std::max(0l, j - ku_); i <= std::min(n_ - 1, j + kl_); ++i) data_(ku_ + i - j, j) = m(i, j);
+    }
+
+    /**
+     * @brief Make an n-by-n band matrix with all elements set to zero.
+     * @param n Number of rows/columns.
+     * @param kl Number of sub-diagonals.
+     * @param ku Number of super-diagonals.
+     * @return Zero matrix.
+     */
+    static banded_matrix zeros(long n, long kl, long ku) {
+      auto res  = banded_matrix(n, kl, ku);
+      res.data_ = T{0};
+      return res;
+    }
+
+    /**
+     * @brief Get the extent of the matrix in a given dimension.
+     * @param i Dimension (0 or 1).
+     * @return Number of rows/columns.
+     */
+    [[nodiscard]] long extent([[maybe_unused]] int i) const { return n_; }
+
+    /**
+     * @brief Get the shape of the matrix.
+     * @return `std::array<long, 2>` containing the number of rows and columns.
+     */
+    [[nodiscard]] std::array<long, 2> shape() const { return {n_, n_}; }
+
+    /**
+     * @brief Get the number of sub-diagonals.
+     * @return `kl`.
+     */
+    [[nodiscard]] long sub_diagonals() const { return kl_; }
+
+    /**
+     * @brief Get the number of super-diagonals.
+     * @return `ku`.
+     */
+    [[nodiscard]] long super_diagonals() const { return ku_; }
+
+    /**
+     * @brief Get the band storage.
+     * @return Const reference to the (kl + ku + 1)-by-n storage matrix.
+     */
+    [[nodiscard]] matrix<T, F_layout> const &storage() const { return data_; }
+
+    /**
+     * @brief Get a view of the band storage.
+     * @return View of the storage matrix, which can be passed to the BLAS/LAPACK band routines.
+     */
+    [[nodiscard]] matrix_view<T, F_layout> storage() { return data_; }
+
+    /**
+     * @brief Check if an element lies in the band.
+     * @param i Row index.
+     * @param j Column index.
+     * @return True if the element is stored.
+     */
+    [[nodiscard]] bool is_stored(long i, long j) const noexcept { return j - ku_ <= i and i <= j + kl_; }
+
+    /**
+     * @brief Access an element of the full matrix.
+     * @param i Row index.
+     * @param j Column index.
+     * @return Value of the element (zero outside of the band).
+     */
+    [[nodiscard]] T operator()(long i, long j) const {
+      EXPECTS(0 <= i and i < n_ and 0 <= j and j < n_);
+      return (is_stored(i, j) ? data_(ku_ + i - j, j) : T{0});
+    }
+
+    /**
+     * @brief Access an element of the band.
+     * @param i Row index.
+     * @param j Column index.
+     * @return Reference to the element.
+     */
+    [[nodiscard]] T &stored(long i, long j) {
+      EXPECTS(is_stored(i, j));
+      return data_(ku_ + i - j, j);
+    }
+
+    /**
+     * @brief Access an element of the band.
+     * @param i Row index.
+     * @param j Column index.
+     * @return Const reference to the element.
+     */
+    [[nodiscard]] T const &stored(long i, long j) const {
+      EXPECTS(is_stored(i, j));
+      return data_(ku_ + i - j, j);
+    }
+
+    /**
+     * @brief Get a view of a diagonal of the matrix.
+     *
+     * @param k Index of the diagonal, i.e. 0 for the main diagonal, `k > 0` for the super-diagonals and `k < 0` for the
+     * sub-diagonals (\f$ -k_l \leq k \leq k_u \f$).
+     * @return Strided view of size \f$ n - |k| \f$ containing the elements \f$ A_{i,i+k} \f$.
+     */
+    [[nodiscard]] auto diagonal(long k) {
+      EXPECTS(-kl_ <= k and k <= ku_);
+      long const first = std::max(0l, k);
+      return data_(ku_ - k, range(first, std::max(first, n_ + std::min(0l, k))));
+    }
+
+    /**
+     * @brief Get a view of a diagonal of the matrix.
+     * @param k Index of the diagonal (see above).
+     * @return Const strided view of size \f$ n - |k| \f$ containing the elements \f$ A_{i,i+k} \f$.
+     */
+    [[nodiscard]] auto diagonal(long k) const {
+      EXPECTS(-kl_ <= k and k <= ku_);
+      long const first = std::max(0l, k);
+      return data_(ku_ - k, range(first, std::max(first, n_ + std::min(0l, k))));
+    }
+
+    /**
+     * @brief Convert to a full matrix.
+     * @return Matrix in Fortran order.
+     */
+    [[nodiscard]] matrix<T, F_layout> to_dense() const {
+      auto res = matrix<T, F_layout>::zeros(shape());
+      for (long j = 0; j < n_; ++j)
+        for (long i = std::max(0l, j - ku_); i <= std::min(n_ - 1, j + kl_); ++i) res(i, j) = data_(ku_ + i - j, j);
+      return res;
+    }
+  };
+
+  /**
+   * @brief Compute the matrix-vector product \f$ \mathbf{y} \leftarrow \alpha \mathrm{op}(\mathbf{A}) \mathbf{x} +
+   * \beta \mathbf{y} \f$ with a band matrix.
+   *
+   * @details It calls nda::blas::gbmv.
+   *
+   * @tparam T Value type of the matrix.
+   * @tparam X nda::MemoryVector type.
+   * @tparam Y nda::MemoryVector type.
+   * @param alpha Input scalar.
+   * @param a Band matrix \f$ \mathbf{A} \f$.
+   * @param x Input vector.
+   * @param beta Input scalar.
+   * @param y Input/output vector.
+   * @param op Operation applied to \f$ \mathbf{A} \f$ ('N', 'T' or 'C').
+   */
+  template <typename T, MemoryVector X, MemoryVector Y>
+    requires(have_same_value_type_v<X, Y> and std::is_same_v<get_value_t<X>, T>)
+  void gemv(T alpha, banded_matrix<T> const &a, X const &x, T beta, Y &&y, char op = 'N') { // NOLINT (temporary views are allowed here)
+    EXPECTS(x.size() == a.extent(1) and y.size() == a.extent(0));
+    blas::gbmv(alpha, a.storage(), a.sub_diagonals(), a.super_diagonals(), x, beta, y, op);
+  }
+
+  /**
+   * @brief Multiplication operator for a band matrix and a vector.
+   *
+   * @tparam T Value type of the matrix.
+   * @tparam V nda::Vector type.
+   * @param a Band matrix.
+   * @param x Vector.
+   * @return Product \f$ \mathbf{A x} \f$.
+   */
+  template <typename T, Vector V>
+    requires(std::is_same_v<get_value_t<V>, T>)
+  vector<T> operator*(banded_matrix<T> const &a, V const &x) {
+    auto y = vector<T>(a.extent(0));
+    if constexpr (MemoryVector<V>) {
+      gemv(T{1}, a, x, T{0}, y);
+    } else {
+      gemv(T{1}, a, vector<T>{x}, T{0}, y);
+    }
+    return y;
+  }
+
+  /**
+   * @brief LU factorization \f$ \mathbf{A} = \mathbf{P L U} \f$ of an n-by-n band matrix.
+   *
+   * @details The factorization is computed once with nda::lapack::gbtrf and stored together with the pivot indices in
+   * a (2 kl + ku + 1)-by-n matrix. Linear systems with any number of right hand sides and the determinant can then be
+   * obtained without refactorizing the matrix, at a cost that is linear in n (see also nda::linalg::lu).
+   *
+   * Calling nda::linalg::banded_lu::factorize with matrices of the same size and bandwidths reuses the storage of the
+   * object, which avoids any allocation when many systems with the same structure are solved, e.g. in implicit time
+   * stepping.
+   *
+   * @tparam T Value type of the matrix (double or std::complex<double>).
+   */
+  template <typename T>
+    requires(is_blas_lapack_v<T>)
+  class banded_lu {
+    // Number of sub-diagonals.
+    long kl_ = 0;
+
+    // Number of super-diagonals.
+    long ku_ = 0;
+
+    // Factors L and U in band storage as computed by gbtrf.
+    matrix<T, F_layout> lu_;
+
+    // Pivot indices (1-based as returned by gbtrf).
+    array<int, 1> ipiv_;
+
+    // Return code of gbtrf.
+    int info_ = 0;
+
+    // Throw an exception if the matrix is singular.
+    void check_singular(const char *fname) const {
+      if (info_ > 0) NDA_RUNTIME_ERROR << "Error in nda::linalg::banded_lu::" << fname << ": Matrix is singular: info = " << info_;
+    }
+
+    public:
+    /// Default constructor leaves the object without a factorization.
+    banded_lu() = default;
+
+    /**
+     * @brief Construct the LU factorization of a band matrix.
+     * @param a Band matrix to be factorized (it is not modified).
+     */
+    explicit banded_lu(banded_matrix<T> const &a) { factorize(a); }
+
+    /**
+     * @brief Compute the LU factorization of a band matrix.
+     *
+     * @details It replaces the current factorization. If the size and the bandwidths of the matrix are the same as
+     * before, no memory is allocated.
+     *
+     * A singular matrix does not throw an exception here (see nda::linalg::banded_lu::is_singular), but only once the
+     * factorization is used to solve a linear system.
+     *
+     * @param a Band matrix to be factorized (it is not modified).
+     */
+    void factorize(banded_matrix<T> const &a) {
+      kl_     = a.sub_diagonals();
+      ku_     = a.super_diagonals();
+      long n  = a.extent(0);
+      auto sh = std::array<long, 2>{2 * kl_ + ku_ + 1, n};
+      if (lu_.shape() != sh) lu_.resize(sh);
+      if (ipiv_.size() != n) ipiv_.resize(n);
+      lu_(range(kl_, 2 * kl_ + ku_ + 1), range::all) = a.storage();
+      info_                                          = lapack::gbtrf(lu_, kl_, ku_, ipiv_);
+      if (info_ < 0) NDA_RUNTIME_ERROR << "Error in nda::linalg::banded_lu: info = " << info_;
+    }
+
+    /**
+     * @brief Get the size of the factorized matrix.
+     * @return Number of rows/columns of the matrix.
+     */
+    [[nodiscard]] long size() const { return lu_.extent(1); }
+
+    /**
+     * @brief Check if the factorized matrix is exactly singular, i.e. if one of the diagonal elements of
+     * \f$ \mathbf{U} \f$ is zero.
+     * @return True if the matrix is singular.
+     */
+    [[nodiscard]] bool is_singular() const { return info_ > 0; }
+
+    /**
+     * @brief Get the factors \f$ \mathbf{L} \f$ and \f$ \mathbf{U} \f$ as computed by nda::lapack::gbtrf.
+     * @return Const reference to the (2 kl + ku + 1)-by-n matrix containing the factors.
+     */
+    [[nodiscard]] matrix<T, F_layout> const &factors() const { return lu_; }
+
+    /**
+     * @brief Get the pivot indices as computed by nda::lapack::gbtrf.
+     * @return Const reference to the array of (1-based) pivot indices.
+     */
+    [[nodiscard]] array<int, 1> const &pivots() const { return ipiv_; }
+
+    /**
+     * @brief Solve the linear system \f$ \mathrm{op}(\mathbf{A}) \mathbf{X} = \mathbf{B} \f$ in place.
+     *
+     * @details The right hand side can be a vector with unit stride or a matrix. Matrices in Fortran order are passed
+     * directly to nda::lapack::gbtrs, matrices in C order are solved in a temporary copy.
+     *
+     * @tparam B nda::MemoryArray type.
+     * @param b Input/output array. On entry, the right hand side \f$ \mathbf{B} \f$. On exit, the solution
+     * \f$ \mathbf{X} \f$.
+     * @param op Operation applied to \f$ \mathbf{A} \f$ ('N', 'T' or 'C').
+     */
+    template <MemoryArray B>
+      requires((MemoryVector<B> or MemoryMatrix<B>) and mem::on_host<B> and std::is_same_v<get_value_t<B>, T>)
+    void solve(B &&b, char op = 'N') const { // NOLINT (temporary views are allowed here)
+      check_singular("solve");
+      EXPECTS(b.extent(0) == size());
+
+      int info = 0;
+      if constexpr (MemoryVector<B> or lapack::has_F_layout<B>) {
+        info = lapack::gbtrs(lu_, kl_, ku_, ipiv_, b, op);
+      } else {
+        auto b_f = matrix<T, F_layout>{b};
+        info     = lapack::gbtrs(lu_, kl_, ku_, ipiv_, b_f, op);
+        b        = b_f;
+      }
+      if (info != 0) NDA_RUNTIME_ERROR << "Error in nda::linalg::banded_lu::solve: info = " << info;
+    }
+
+    /**
+     * @brief Get the determinant of the factorized matrix.
+     * @return Product of the diagonal elements of \f$ \mathbf{U} \f$ times the sign of the permutation.
+     */
+    [[nodiscard]] T det() const {
+      auto res = T{1};
+      for (long i = 0; i < size(); ++i) {
+        res *= lu_(kl_ + ku_, i);
+        if (ipiv_(i) != i + 1) res = -res;
+      }
+      return res;
+    }
+  };
+
+  /** @} */
+
+} // namespace nda::linalg
@@ -0,0 +1,272 @@
+// Copyright (c) 2024 Simons Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file
+ * @brief Provides batched versions of the inverse, determinant and eigenelements for stacks of small matrices.
+ */
+
+#pragma once
+
+#include "./det_and_inverse.hpp"
+#include "./eigenelements.hpp"
+#include "../basic_array.hpp"
+#include "../basic_functions.hpp"
+#include "../blas/threads.hpp"
+#include "../concepts.hpp"
+#include "../declarations.hpp"
+#include "../exceptions.hpp"
+#include "../lapack/interface/cxx_interface.hpp"
+#include "../layout/range.hpp"
+#include "../macros.hpp"
+#include "../mem/address_space.hpp"
+#include "../traits.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace nda {
+
+  namespace detail {
+
+    // Check that the matrices a(i, _, _) of a rank-3 array are square and can be passed to LAPACK.
+    template <typename A>
+    void check_matrix_batch(A const &a) {
+      EXPECTS(a.extent(1) == a.extent(2));
+      if (a.extent(0) > 0 and a.extent(1) > 0) EXPECTS(a(0, range::all, range::all).indexmap().min_stride() == 1);
+    }
+
+    // Determinant of a 1-by-1, 2-by-2 or 3-by-3 matrix.
+    template <typename M>
+    auto small_determinant(M const &m) {
+      switch (m.extent(0)) {
+        case 1: return m(0, 0);
+        case 2: return m(0, 0) * m(1, 1) - m(0, 1) * m(1, 0);
+        default:
+          return m(0, 0) * (m(1, 1) * m(2, 2) - m(1, 2) * m(2, 1)) - m(0, 1) * (m(1, 0) * m(2, 2) - m(1, 2) * m(2, 0))
+             + m(0, 2) * (m(1, 0) * m(2, 1) - m(1, 1) * m(2, 0));
+      }
+    }
+
+    // LU factorize all matrices a(i, _, _) of a rank-3 array in place (ipiv must be of size batch x n).
+    template <typename A>
+    void getrf_batch(A &a, array<int, 2> &ipiv) {
+      long batch = a.extent(0);
+      int n      = a.extent(1);
+      auto info  = array<int, 1>(batch);
+      lapack::f77::getrf_batch_strided(n, n, a.data(), lapack::get_ld(a(0, range::all, range::all)), a.indexmap().strides()[0], ipiv.data(), n,
+                                       batch, info.data());
+      auto it = std::find_if(info.begin(), info.end(), [](int i) { return i < 0; });
+      if (it != info.end()) NDA_RUNTIME_ERROR << "Error in nda::getrf_batch: info = " << *it;
+    }
+
+  } // namespace detail
+
+  /**
+   * @addtogroup linalg_tools
+   * @{
+   */
+
+  /**
+   * @brief Compute the inverses of a stack of n-by-n matrices.
+   *
+   * @details The matrices are given by `a(i, _, _)` and are inverted in place, i.e. it is equivalent to
+   *
+   * @code{.cpp}
+   * for (long i = 0; i < a.extent(0); ++i) nda::inverse_in_place(nda::make_matrix_view(a(i, _, _)));
+   * @endcode
+   *
+   * For 1-by-1, 2-by-2 and 3-by-3 matrices, the closed forms nda::inverse1_in_place, nda::inverse2_in_place and
+   * nda::inverse3_in_place are used. For larger matrices, the whole batch is passed to
+   * nda::lapack::f77::getrf_batch_strided and nda::lapack::f77::getri_batch_strided, which call the batched MKL routines
+   * if available. Otherwise, the matrices are distributed over the OpenMP threads (each thread owning its own workspace)
+   * while the BLAS/LAPACK backend runs single-threaded.
+   *
+   * The matrices `a(i, _, _)` are required to have unit stride in one of their dimensions. It throws an exception if
+   * any of the matrices is not invertible.
+   *
+   * @tparam A nda::MemoryArrayOfRank<3> type.
+   * @param a Stack of matrices to be inverted.
+   */
+  template <MemoryArrayOfRank<3> A>
+    requires(mem::on_host<A> and is_blas_lapack_v<get_value_t<A>>)
+  void inverse_batch_in_place(A &&a) { // NOLINT (temporary views are allowed here)
+    detail::check_matrix_batch(a);
+    long batch = a.extent(0);
+    int n      = a.extent(1);
+    if (batch == 0 or n == 0) return;
+
+    // use optimized routines for small matrices
+    if (n <= 3) {
+      blas::detail::parallel_batch(
+         batch, [] { return 0; },
+         [&](int, long i) {
+           auto m = make_matrix_view(a(i, range::all, range::all));
+           if (n == 1) inverse1_in_place(m);
+           if (n == 2) inverse2_in_place(m);
+           if (n == 3) inverse3_in_place(m);
+         });
+      return;
+    }
+
+    // use batched getrf and getri for larger matrices (it is ok to be in C order)
+    auto ipiv = array<int, 2>(batch, n);
+    detail::getrf_batch(a, ipiv);
+    auto info = array<int, 1>(batch);
+    lapack::f77::getri_batch_strided(n, a.data(), lapack::get_ld(a(0, range::all, range::all)), a.indexmap().strides()[0], ipiv.data(), n, batch,
+                                     info.data());
+    auto it = std::find_if(info.begin(), info.end(), [](int i) { return i != 0; });
+    if (it != info.end())
+      NDA_RUNTIME_ERROR << "Error in nda::inverse_batch_in_place: Matrix " << (it - info.begin()) << " is not invertible: info = " << *it;
+  }
+
+  /**
+   * @brief Compute the inverses of a stack of n-by-n matrices.
+   *
+   * @details The given array is not modified. It first makes a copy and then calls nda::inverse_batch_in_place.
+   *
+   * @tparam A nda::ArrayOfRank<3> type.
+   * @param a Stack of matrices `a(i, _, _)` to be inverted.
+   * @return Rank-3 array containing the inverses.
+   */
+  template <ArrayOfRank<3> A>
+    requires(is_blas_lapack_v<get_value_t<A>>)
+  auto inverse_batch(A const &a) {
+    auto r = array<get_value_t<A>, 3>{a};
+    inverse_batch_in_place(r);
+    return r;
+  }
+
+  /**
+   * @brief Compute the determinants of a stack of n-by-n matrices.
+   *
+   * @details The matrices are given by `a(i, _, _)`. For 1-by-1, 2-by-2 and 3-by-3 matrices, the determinants are
+   * computed directly. For larger matrices, a copy of the stack is LU factorized with
+   * nda::lapack::f77::getrf_batch_strided (see nda::inverse_batch_in_place) and the determinants are obtained from the
+   * diagonals of the factors.
+   *
+   * The given array is not modified.
+   *
+   * @tparam A nda::ArrayOfRank<3> type.
+   * @param a Stack of matrices.
+   * @return Rank-1 array containing the determinants.
+   */
+  template <ArrayOfRank<3> A>
+    requires(is_blas_lapack_v<get_value_t<A>>)
+  auto determinant_batch(A const &a) {
+    using value_t = get_value_t<A>;
+    EXPECTS(a.extent(1) == a.extent(2));
+    long batch = a.extent(0);
+    int n      = a.extent(1);
+    auto res   = array<value_t, 1>(batch);
+    if (n == 0) {
+      res = value_t{1};
+      return res;
+    }
+
+    // compute the determinants of small matrices directly
+    if (n <= 3) {
+      for (long i = 0; i < batch; ++i) res(i) = detail::small_determinant(a(i, range::all, range::all));
+      return res;
+    }
+
+    // LU factorize a copy of the stack
+    auto lu   = array<value_t, 3>{a};
+    auto ipiv = array<int, 2>(batch, n);
+    if (batch > 0) detail::getrf_batch(lu, ipiv);
+
+    // calculate the determinants from the LU decompositions
+    for (long i = 0; i < batch; ++i) {
+      auto det    = value_t{1};
+      int n_flips = 0;
+      for (int j = 0; j < n; ++j) {
+        det *= lu(i, j, j);
+        if (ipiv(i, j) != j + 1) ++n_flips;
+      }
+      res(i) = ((n_flips % 2 == 1) ? -det : det);
+    }
+    return res;
+  }
+
+  /** @} */
+
+} // namespace nda
+
+namespace nda::linalg {
+
+  /**
+   * @addtogroup linalg_tools
+   * @{
+   */
+
+  /**
+   * @brief Find the eigenvalues of a stack of symmetric (real) or hermitian (complex) n-by-n matrices.
+   *
+   * @details The matrices are given by `a(i, _, _)`. They are distributed over the OpenMP threads, each thread
+   * owning an nda::linalg::eigen_worker, while the BLAS/LAPACK backend runs single-threaded.
+   *
+   * The given array is not modified.
+   *
+   * @tparam A nda::ArrayOfRank<3> type.
+   * @param a Stack of matrices.
+   * @return Rank-2 array `ev` where `ev(i, _)` contains the eigenvalues of `a(i, _, _)` in ascending order.
+   */
+  template <ArrayOfRank<3> A>
+    requires(is_blas_lapack_v<get_value_t<A>>)
+  auto eigenvalues_batch(A const &a) {
+    EXPECTS(a.extent(1) == a.extent(2));
+    long batch = a.extent(0), n = a.extent(1);
+    auto ev    = array<double, 2>(batch, n);
+    if (n == 0) return ev;
+    blas::detail::parallel_batch(
+       batch, [n] { return eigen_worker<get_value_t<A>>(n); },
+       [&](auto &worker, long i) { ev(i, range::all) = worker.eigenvalues(a(i, range::all, range::all)); });
+    return ev;
+  }
+
+  /**
+   * @brief Find the eigenvalues and eigenvectors of a stack of symmetric (real) or hermitian (complex) n-by-n matrices.
+   *
+   * @details The matrices are given by `a(i, _, _)`. They are distributed over the OpenMP threads, each thread
+   * owning an nda::linalg::eigen_worker, while the BLAS/LAPACK backend runs single-threaded.
+   *
+   * The given array is not modified.
+   *
+   * @tparam A nda::ArrayOfRank<3> type.
+   * @param a Stack of matrices.
+   * @return std::pair consisting of a rank-2 array `ev` and a rank-3 array `vecs`, where `ev(i, _)` contains the
+   * eigenvalues of `a(i, _, _)` in ascending order and the columns of `vecs(i, _, _)` the corresponding eigenvectors.
+   */
+  template <ArrayOfRank<3> A>
+    requires(is_blas_lapack_v<get_value_t<A>>)
+  auto eigenelements_batch(A const &a) {
+    EXPECTS(a.extent(1) == a.extent(2));
+    long batch = a.extent(0), n = a.extent(1);
+    auto ev    = array<double, 2>(batch, n);
+    auto vecs  = array<get_value_t<A>, 3>(batch, n, n);
+    if (n > 0) {
+      blas::detail::parallel_batch(
+         batch, [n] { return eigen_worker<get_value_t<A>>(n); },
+         [&](auto &worker, long i) {
+           auto const &[ev_i, vecs_i]      = worker.eigenelements(a(i, range::all, range::all));
+           ev(i, range::all)               = ev_i;
+           vecs(i, range::all, range::all) = vecs_i;
+         });
+    }
+    return std::pair{ev, vecs};
+  }
+
+  /** @} */
+
+} // namespace nda::linalg
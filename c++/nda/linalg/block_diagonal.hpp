@@ -0,0 +1,496 @@
+// Copyright (c) 2024 Simons Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file
+ * @brief Provides a block-diagonal matrix type with block-wise products, inverse, determinant and eigensolver.
+ */
+
+#pragma once
+
+#include "./det_and_inverse.hpp"
+#include "./eigenelements.hpp"
+#include "../basic_array.hpp"
+#include "../basic_array_view.hpp"
+#include "../blas/gemm_batch.hpp"
+#include "../blas/threads.hpp"
+#include "../blas/tools.hpp"
+#include "../concepts.hpp"
+#include "../declarations.hpp"
+#include "../exceptions.hpp"
+#include "../layout/policies.hpp"
+#include "../layout/range.hpp"
+#include "../macros.hpp"
+#include "../mem/address_space.hpp"
+#include "../traits.hpp"
+
+#include <algorithm>
+#include <array>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace nda::linalg {
+
+  /**
+   * @addtogroup linalg_tools
+   * @{
+   */
+
+  /**
+   * @brief Block-diagonal n-by-n matrix \f$ \mathbf{A} = \mathrm{diag}(\mathbf{A}_0, \mathbf{A}_1, \ldots) \f$.
+   *
+   * @details Only the square diagonal blocks \f$ \mathbf{A}_b \f$ of size \f$ n_b \f$ are stored. They are kept in
+   * Fortran order one after the other in a single contiguous buffer and can be accessed as ordinary matrix views with
+   * nda::linalg::block_diagonal_matrix::block.
+   *
+   * Products (see nda::linalg::matmul(block_diagonal_matrix<T> const &, block_diagonal_matrix<T> const &)) are passed
+   * to nda::blas::gemm_vbatch, while the inverse, the determinant and the eigenelements are computed block by block with
+   * the blocks distributed over the OpenMP threads. This reduces the cost of these operations from
+   * \f$ \mathcal{O}(n^3) \f$ for the equivalent dense matrix to \f$ \mathcal{O}(\sum_b n_b^3) \f$.
+   *
+   * @code{.cpp}
+   * auto A     = nda::linalg::block_diagonal_matrix<double>::zeros({2, 3, 1});
+   * A.block(1) = nda::eye<double>(3);
+   * auto Ainv  = nda::linalg::inverse(A);
+   * auto [ev, vecs] = nda::linalg::eigenelements(A);
+   * @endcode
+   *
+   * @tparam T Value type of the matrix (double or std::complex<double>).
+   */
+  template <typename T>
+    requires(is_blas_lapack_v<T>)
+  class block_diagonal_matrix {
+    // Sizes of the diagonal blocks.
+    std::vector<long> sizes_;
+
+    // Index of the first row/column of each block (the last element is the size of the matrix).
+    array<long, 1> starts_;
+
+    // Position of each block in the buffer (the last element is the size of the buffer).
+    array<long, 1> offsets_;
+
+    // Contiguous buffer containing the blocks in Fortran order.
+    array<T, 1> data_;
+
+    public:
+    /// Value type of the matrix.
+    using value_type = T;
+
+    /// Default constructor creates an empty matrix without blocks.
+    block_diagonal_matrix() : block_diagonal_matrix(std::vector<long>{}) {}
+
+    /**
+     * @brief Construct a block-diagonal matrix with the given block sizes.
+     *
+     * @details The elements of the blocks are not initialized.
+     *
+     * @param sizes Sizes of the diagonal blocks (non-negative).
+     */
+    explicit block_diagonal_matrix(std::vector<long> sizes) : sizes_(std::move(sizes)), starts_(sizes_.size() + 1), offsets_(sizes_.size() + 1) {
+      starts_(0)  = 0;
+      offsets_(0) = 0;
+      for (long b = 0; b < n_blocks(); ++b) {
+        EXPECTS(sizes_[b] >= 0);
+        starts_(b + 1)  = starts_(b) + sizes_[b];
+        offsets_(b + 1) = offsets_(b) + sizes_[b] * sizes_[b];
+      }
+      data_.resize(offsets_(n_blocks()));
+    }
+
+    /**
+     * @brief Construct a block-diagonal matrix from the diagonal blocks of a square matrix.
+     *
+     * @details All elements outside of the diagonal blocks are ignored.
+     *
+     * @tparam M nda::Matrix type.
+     * @param m Square matrix.
+     * @param sizes Sizes of the diagonal blocks (they have to add up to the size of the matrix).
+     */
+    template <Matrix M>
+      requires(std::is_convertible_v<get_value_t<M>, T>)
+    block_diagonal_matrix(M const &m, std::vector<long> const &sizes) : block_diagonal_matrix(sizes) {
+      if (m.shape() != shape()) NDA_RUNTIME_ERROR << "Error in nda::linalg::block_diagonal_matrix: Incompatible shapes: " << m.shape();
+      for (long b = 0; b < n_blocks(); ++b) {
+        auto rg  = range(starts_(b), starts_(b + 1));
+        block(b) = m(rg, rg);
+      }
+    }
+
+    /**
+     * @brief Make a block-diagonal matrix with the given block sizes and all elements set to zero.
+     * @param sizes Sizes of the diagonal blocks (non-negative).
+     * @return Zero matrix.
+     */
+    static block_diagonal_matrix zeros(std::vector<long> const &sizes) {
+      auto res  = block_diagonal_matrix(sizes);
+      res.data_ = T{0};
+      return res;
+    }
+
+    /**
+     * @brief Get the number of diagonal blocks.
+     * @return Number of blocks.
+     */
+    [[nodiscard]] long n_blocks() const { return static_cast<long>(sizes_.size()); }
+
+    /**
+     * @brief Get the extent of the matrix in a given dimension.
+     * @param i Dimension (0 or 1).
+     * @return Number of rows/columns of the matrix, i.e. the sum of the block sizes.
+     */
+    [[nodiscard]] long extent([[maybe_unused]] int i) const { return starts_(n_blocks()); }
+
+    /**
+     * @brief Get the shape of the matrix.
+     * @return `std::array<long, 2>` containing the number of rows and columns.
+     */
+    [[nodiscard]] std::array<long, 2> shape() const { return {extent(0), extent(1)}; }
+
+    /**
+     * @brief Get the sizes of the diagonal blocks.
+     * @return Const reference to the vector of block sizes.
+     */
+    [[nodiscard]] std::vector<long> const &block_sizes() const { return sizes_; }
+
+    /**
+     * @brief Get the index of the first row/column of a block in the full matrix.
+     * @param b Block index.
+     * @return Row/column index.
+     */
+    [[nodiscard]] long block_start(long b) const { return starts_(b); }
+
+    /**
+     * @brief Get the range of rows/columns of a block in the full matrix.
+     * @param b Block index.
+     * @return nda::range of the rows/columns.
+     */
+    [[nodiscard]] range block_range(long b) const { return {starts_(b), starts_(b + 1)}; }
+
+    /**
+     * @brief Get a view of a diagonal block.
+     * @param b Block index.
+     * @return Matrix view in Fortran order of the block.
+     */
+    [[nodiscard]] matrix_view<T, F_layout> block(long b) {
+      EXPECTS(0 <= b and b < n_blocks());
+      return {{sizes_[b], sizes_[b]}, data_.data() + offsets_(b)};
+    }
+
+    /**
+     * @brief Get a const view of a diagonal block.
+     * @param b Block index.
+     * @return Const matrix view in Fortran order of the block.
+     */
+    [[nodiscard]] matrix_const_view<T, F_layout> block(long b) const {
+      EXPECTS(0 <= b and b < n_blocks());
+      return {{sizes_[b], sizes_[b]}, data_.data() + offsets_(b)};
+    }
+
+    /**
+     * @brief Get the buffer containing all blocks.
+     * @return Const reference to the buffer.
+     */
+    [[nodiscard]] array<T, 1> const &storage() const { return data_; }
+
+    /**
+     * @brief Get a view of the buffer containing all blocks.
+     * @return View of the buffer.
+     */
+    [[nodiscard]] array_view<T, 1> storage() { return data_; }
+
+    /**
+     * @brief Access an element of the full matrix.
+     *
+     * @details The block containing the row is found by a binary search. Elements outside of the diagonal blocks are
+     * zero.
+     *
+     * @param i Row index.
+     * @param j Column index.
+     * @return Value of the element.
+     */
+    [[nodiscard]] T operator()(long i, long j) const {
+      EXPECTS(0 <= i and i < extent(0) and 0 <= j and j < extent(1));
+      long b = std::upper_bound(starts_.begin(), starts_.end(), i) - starts_.begin() - 1;
+      if (j < starts_(b) or j >= starts_(b + 1)) return T{0};
+      return block(b)(i - starts_(b), j - starts_(b));
+    }
+
+    /**
+     * @brief Check if two block-diagonal matrices have the same block sizes.
+     * @param other Other block-diagonal matrix.
+     * @return True if the block sizes are the same.
+     */
+    [[nodiscard]] bool has_same_blocks(block_diagonal_matrix const &other) const { return sizes_ == other.sizes_; }
+
+    /**
+     * @brief Convert to a dense matrix.
+     * @return Dense matrix with zeros outside of the diagonal blocks.
+     */
+    [[nodiscard]] matrix<T, F_layout> to_dense() const {
+      auto res = matrix<T, F_layout>::zeros(shape());
+      for (long b = 0; b < n_blocks(); ++b) res(block_range(b), block_range(b)) = block(b);
+      return res;
+    }
+  };
+
+  /**
+   * @brief Compute the product \f$ \mathbf{C} \leftarrow \alpha \mathbf{A B} + \beta \mathbf{C} \f$ of two block-diagonal
+   * matrices with the same block sizes.
+   *
+   * @details The block products \f$ \mathbf{C}_b \leftarrow \alpha \mathbf{A}_b \mathbf{B}_b + \beta \mathbf{C}_b \f$
+   * are computed with a single call to nda::blas::gemm_vbatch.
+   *
+   * @tparam T Value type of the matrices.
+   * @param alpha Input scalar.
+   * @param a Block-diagonal matrix \f$ \mathbf{A} \f$.
+   * @param b Block-diagonal matrix \f$ \mathbf{B} \f$.
+   * @param beta Input scalar.
+   * @param c Input/output block-diagonal matrix \f$ \mathbf{C} \f$.
+   */
+  template <typename T>
+  void gemm(T alpha, block_diagonal_matrix<T> const &a, block_diagonal_matrix<T> const &b, T beta, block_diagonal_matrix<T> &c) {
+    if (not a.has_same_blocks(b) or not a.has_same_blocks(c))
+      NDA_RUNTIME_ERROR << "Error in nda::linalg::gemm: Block-diagonal matrices have different block sizes";
+    auto va = std::vector<matrix_const_view<T, F_layout>>{};
+    auto vb = std::vector<matrix_const_view<T, F_layout>>{};
+    auto vc = std::vector<matrix_view<T, F_layout>>{};
+    for (long i = 0; i < a.n_blocks(); ++i) {
+      if (a.block_sizes()[i] == 0) continue;
+      va.push_back(a.block(i));
+      vb.push_back(b.block(i));
+      vc.push_back(c.block(i));
+    }
+    blas::gemm_vbatch(alpha, va, vb, beta, vc);
+  }
+
+  /**
+   * @brief Compute the product \f$ \mathbf{C} \leftarrow \alpha \mathbf{A B} + \beta \mathbf{C} \f$ of a block-diagonal
+   * matrix and a dense matrix.
+   *
+   * @details The rows of \f$ \mathbf{B} \f$ and \f$ \mathbf{C} \f$ belonging to the same block are multiplied with a
+   * single call to nda::blas::gemm_vbatch. Both dense matrices need to have unit stride in one of their dimensions and
+   * the same memory layout.
+   *
+   * @tparam T Value type of the block-diagonal matrix.
+   * @tparam B nda::MemoryMatrix type.
+   * @tparam C nda::MemoryMatrix type.
+   * @param alpha Input scalar.
+   * @param a Block-diagonal matrix \f$ \mathbf{A} \f$.
+   * @param b Dense matrix \f$ \mathbf{B} \f$.
+   * @param beta Input scalar.
+   * @param c Input/output dense matrix \f$ \mathbf{C} \f$.
+   */
+  template <typename T, MemoryMatrix B, MemoryMatrix C>
+    requires(mem::on_host<B, C> and have_same_value_type_v<B, C> and std::is_same_v<get_value_t<B>, T>)
+  void gemm(T alpha, block_diagonal_matrix<T> const &a, B const &b, T beta, C &&c) { // NOLINT (temporary views are allowed here)
+    static_assert(blas::has_F_layout<B> == blas::has_F_layout<C>, "Error in nda::linalg::gemm: B and C need to have the same layout");
+    EXPECTS(b.extent(0) == a.extent(0) and c.extent(0) == a.extent(0) and b.extent(1) == c.extent(1));
+    if (b.extent(1) == 0) return;
+    auto va = std::vector<matrix_const_view<T, F_layout>>{};
+    auto vb = std::vector<decltype(b(range(0), range::all))>{};
+    auto vc = std::vector<decltype(c(range(0), range::all))>{};
+    for (long i = 0; i < a.n_blocks(); ++i) {
+      if (a.block_sizes()[i] == 0) continue;
+      va.push_back(a.block(i));
+      vb.push_back(b(a.block_range(i), range::all));
+      vc.push_back(c(a.block_range(i), range::all));
+    }
+    blas::gemm_vbatch(alpha, va, vb, beta, vc);
+  }
+
+  /**
+   * @brief Multiply two block-diagonal matrices with the same block sizes.
+   *
+   * @tparam T Value type of the matrices.
+   * @param a Left hand side block-diagonal matrix.
+   * @param b Right hand side block-diagonal matrix.
+   * @return Block-diagonal product.
+   */
+  template <typename T>
+  block_diagonal_matrix<T> matmul(block_diagonal_matrix<T> const &a, block_diagonal_matrix<T> const &b) {
+    auto res = block_diagonal_matrix<T>(a.block_sizes());
+    gemm(T{1}, a, b, T{0}, res);
+    return res;
+  }
+
+  /**
+   * @brief Multiply a block-diagonal matrix with a dense matrix.
+   *
+   * @details Matrices in C order are copied to Fortran order before the product is computed.
+   *
+   * @tparam T Value type of the block-diagonal matrix.
+   * @tparam M nda::Matrix type.
+   * @param a Block-diagonal matrix.
+   * @param m Dense matrix.
+   * @return Dense product in Fortran order.
+   */
+  template <typename T, Matrix M>
+    requires(std::is_same_v<get_value_t<M>, T>)
+  matrix<T, F_layout> matmul(block_diagonal_matrix<T> const &a, M const &m) {
+    auto res = matrix<T, F_layout>(a.extent(0), m.extent(1));
+    if constexpr (MemoryMatrix<M>) {
+      if constexpr (mem::on_host<M> and blas::has_F_layout<M>) {
+        gemm(T{1}, a, m, T{0}, res);
+        return res;
+      }
+    }
+    gemm(T{1}, a, matrix<T, F_layout>{m}, T{0}, res);
+    return res;
+  }
+
+  /**
+   * @brief Multiplication operator for two block-diagonal matrices.
+   *
+   * @details See nda::linalg::matmul(block_diagonal_matrix<T> const &, block_diagonal_matrix<T> const &).
+   *
+   * @tparam T Value type of the matrices.
+   * @param a Left hand side block-diagonal matrix.
+   * @param b Right hand side block-diagonal matrix.
+   * @return Block-diagonal product.
+   */
+  template <typename T>
+  block_diagonal_matrix<T> operator*(block_diagonal_matrix<T> const &a, block_diagonal_matrix<T> const &b) {
+    return matmul(a, b);
+  }
+
+  /**
+   * @brief Multiplication operator for a block-diagonal matrix and a dense matrix.
+   *
+   * @details See nda::linalg::matmul(block_diagonal_matrix<T> const &, M const &).
+   *
+   * @tparam T Value type of the block-diagonal matrix.
+   * @tparam M nda::Matrix type.
+   * @param a Block-diagonal matrix.
+   * @param m Dense matrix.
+   * @return Dense product in Fortran order.
+   */
+  template <typename T, Matrix M>
+    requires(std::is_same_v<get_value_t<M>, T>)
+  matrix<T, F_layout> operator*(block_diagonal_matrix<T> const &a, M const &m) {
+    return matmul(a, m);
+  }
+
+  /**
+   * @brief Invert a block-diagonal matrix in place.
+   *
+   * @details Each block is inverted with nda::inverse_in_place. The blocks are distributed over the OpenMP threads
+   * while the BLAS/LAPACK backend runs single-threaded. It throws an exception if any of the blocks is not invertible.
+   *
+   * @tparam T Value type of the matrix.
+   * @param a Block-diagonal matrix to be inverted.
+   */
+  template <typename T>
+  void inverse_in_place(block_diagonal_matrix<T> &a) {
+    blas::detail::parallel_batch(
+       a.n_blocks(), [] { return 0; },
+       [&a](int, long b) {
+         if (a.block_sizes()[b] > 0) nda::inverse_in_place(a.block(b));
+       });
+  }
+
+  /**
+   * @brief Compute the inverse of a block-diagonal matrix.
+   *
+   * @details See nda::linalg::inverse_in_place(block_diagonal_matrix<T> &).
+   *
+   * @tparam T Value type of the matrix.
+   * @param a Block-diagonal matrix.
+   * @return Block-diagonal inverse.
+   */
+  template <typename T>
+  block_diagonal_matrix<T> inverse(block_diagonal_matrix<T> const &a) {
+    auto res = a;
+    inverse_in_place(res);
+    return res;
+  }
+
+  /**
+   * @brief Compute the determinant of a block-diagonal matrix.
+   *
+   * @details The determinants of copies of the blocks are computed with nda::determinant_in_place, where the blocks
+   * are distributed over the OpenMP threads, and multiplied.
+   *
+   * @tparam T Value type of the matrix.
+   * @param a Block-diagonal matrix.
+   * @return Product of the determinants of the blocks.
+   */
+  template <typename T>
+  T determinant(block_diagonal_matrix<T> const &a) {
+    auto dets = array<T, 1>(a.n_blocks());
+    auto tmp  = a;
+    blas::detail::parallel_batch(
+       a.n_blocks(), [] { return 0; },
+       [&](int, long b) {
+         auto blk = tmp.block(b);
+         dets(b)  = (a.block_sizes()[b] > 0 ? nda::determinant_in_place(blk) : T{1});
+       });
+    auto res = T{1};
+    for (auto d : dets) res *= d;
+    return res;
+  }
+
+  /**
+   * @brief Find the eigenvalues of a symmetric (real) or hermitian (complex) block-diagonal matrix.
+   *
+   * @details The blocks are diagonalized with nda::linalg::eigenvalues, where the blocks are distributed over the
+   * OpenMP threads.
+   *
+   * @tparam T Value type of the matrix.
+   * @param a Block-diagonal matrix.
+   * @return Array of eigenvalues, where the eigenvalues of each block are stored in ascending order in the range of
+   * rows of the block (see nda::linalg::block_diagonal_matrix::block_range).
+   */
+  template <typename T>
+  array<double, 1> eigenvalues(block_diagonal_matrix<T> const &a) {
+    auto ev = array<double, 1>(a.extent(0));
+    blas::detail::parallel_batch(
+       a.n_blocks(), [] { return 0; },
+       [&](int, long b) {
+         if (a.block_sizes()[b] > 0) ev(a.block_range(b)) = eigenvalues(a.block(b));
+       });
+    return ev;
+  }
+
+  /**
+   * @brief Find the eigenvalues and eigenvectors of a symmetric (real) or hermitian (complex) block-diagonal matrix.
+   *
+   * @details The blocks are diagonalized with nda::linalg::eigenelements, where the blocks are distributed over the
+   * OpenMP threads. Since the eigenvectors of a block-diagonal matrix can be chosen block-diagonal as well, they are
+   * returned as a block-diagonal matrix with the same block sizes.
+   *
+   * @tparam T Value type of the matrix.
+   * @param a Block-diagonal matrix.
+   * @return std::pair consisting of the array of eigenvalues (ordered as in
+   * nda::linalg::eigenvalues(block_diagonal_matrix<T> const &)) and the block-diagonal matrix containing the
+   * eigenvectors in its columns.
+   */
+  template <typename T>
+  std::pair<array<double, 1>, block_diagonal_matrix<T>> eigenelements(block_diagonal_matrix<T> const &a) {
+    auto ev   = array<double, 1>(a.extent(0));
+    auto vecs = block_diagonal_matrix<T>(a.block_sizes());
+    blas::detail::parallel_batch(
+       a.n_blocks(), [] { return 0; },
+       [&](int, long b) {
+         if (a.block_sizes()[b] == 0) return;
+         auto [ev_b, vecs_b]  = eigenelements(a.block(b));
+         ev(a.block_range(b)) = ev_b;
+         vecs.block(b)        = vecs_b;
+       });
+    return {ev, vecs};
+  }
+
+  /** @} */
+
+} // namespace nda::linalg
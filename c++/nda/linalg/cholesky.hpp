@@ -0,0 +1,184 @@
+// Copyright (c) 2024 Simons Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file
+ * @brief Provides a reusable Cholesky factorization of a symmetric/hermitian positive definite matrix.
+ */
+
+#pragma once
+
+#include "../basic_array.hpp"
+#include "../concepts.hpp"
+#include "../declarations.hpp"
+#include "../exceptions.hpp"
+#include "../lapack/potrf.hpp"
+#include "../lapack/potri.hpp"
+#include "../lapack/potrs.hpp"
+#include "../layout/policies.hpp"
+#include "../macros.hpp"
+#include "../mem/address_space.hpp"
+#include "../traits.hpp"
+
+#include <cmath>
+#include <complex>
+#include <type_traits>
+
+namespace nda::linalg {
+
+  /**
+   * @ingroup linalg_tools
+   * @brief Cholesky factorization \f$ \mathbf{A} = \mathbf{L L}^H \f$ of a real symmetric or complex hermitian positive
+   * definite n-by-n matrix.
+   *
+   * @details The factorization is computed once with nda::lapack::potrf and stored. Linear systems with any number of
+   * right hand sides, the determinant and the inverse can then be obtained without refactorizing the matrix (see
+   * nda::linalg::lu for the general case).
+   *
+   * Only the lower triangle of the given matrix is referenced. Calling nda::linalg::cholesky::factorize with matrices
+   * of the same size reuses the storage of the object.
+   *
+   * @tparam T Value type of the matrix (double or std::complex<double>).
+   */
+  template <typename T>
+    requires(is_blas_lapack_v<T>)
+  class cholesky {
+    // Lower triangular factor L (the strictly upper triangle is zero).
+    matrix<T, F_layout> l_;
+
+    public:
+    /// Default constructor leaves the object without a factorization.
+    cholesky() = default;
+
+    /**
+     * @brief Construct the Cholesky factorization of a positive definite matrix.
+     *
+     * @tparam M nda::Matrix type.
+     * @param m Matrix to be factorized (it is not modified).
+     */
+    template <Matrix M>
+      requires(mem::on_host<M>)
+    explicit cholesky(M const &m) {
+      factorize(m);
+    }
+
+    /**
+     * @brief Compute the Cholesky factorization of a positive definite matrix.
+     *
+     * @details It replaces the current factorization. If the size of the matrix is the same as before, no memory is
+     * allocated. It throws an exception if the matrix is not positive definite.
+     *
+     * @tparam M nda::Matrix type.
+     * @param m Matrix to be factorized (it is not modified).
+     */
+    template <Matrix M>
+      requires(mem::on_host<M>)
+    void factorize(M const &m) {
+      if (m.extent(0) != m.extent(1)) NDA_RUNTIME_ERROR << "Error in nda::linalg::cholesky: Matrix is not square: " << m.shape();
+      if (l_.shape() != m.shape()) l_.resize(m.shape());
+      l_() = m;
+      if (l_.empty()) return;
+      int info = lapack::potrf(l_, 'L');
+      if (info != 0) NDA_RUNTIME_ERROR << "Error in nda::linalg::cholesky: Matrix is not positive definite: info = " << info;
+      for (long j = 1; j < size(); ++j)
+        for (long i = 0; i < j; ++i) l_(i, j) = T{0};
+    }
+
+    /**
+     * @brief Get the size of the factorized matrix.
+     * @return Number of rows/columns of the matrix.
+     */
+    [[nodiscard]] long size() const { return l_.extent(0); }
+
+    /**
+     * @brief Get the lower triangular factor \f$ \mathbf{L} \f$.
+     * @return Const reference to the matrix \f$ \mathbf{L} \f$.
+     */
+    [[nodiscard]] matrix<T, F_layout> const &factor() const { return l_; }
+
+    /**
+     * @brief Solve the linear system \f$ \mathbf{A X} = \mathbf{B} \f$ in place.
+     *
+     * @details The right hand side can be a vector with unit stride or a matrix. Matrices in Fortran order are passed
+     * directly to nda::lapack::potrs, matrices in C order are solved in a temporary copy.
+     *
+     * @tparam B nda::MemoryArray type.
+     * @param b Input/output array. On entry, the right hand side \f$ \mathbf{B} \f$. On exit, the solution
+     * \f$ \mathbf{X} \f$.
+     */
+    template <MemoryArray B>
+      requires((MemoryVector<B> or MemoryMatrix<B>) and mem::on_host<B> and std::is_same_v<get_value_t<B>, T>)
+    void solve(B &&b) const { // NOLINT (temporary views are allowed here)
+      EXPECTS(b.extent(0) == size());
+      if (b.empty()) return;
+
+      int info = 0;
+      if constexpr (MemoryVector<B> or lapack::has_F_layout<B>) {
+        info = lapack::potrs(l_, b, 'L');
+      } else {
+        auto b_f = matrix<T, F_layout>{b};
+        info     = lapack::potrs(l_, b_f, 'L');
+        b        = b_f;
+      }
+      if (info != 0) NDA_RUNTIME_ERROR << "Error in nda::linalg::cholesky::solve: info = " << info;
+    }
+
+    /**
+     * @brief Get the determinant of the factorized matrix.
+     * @return \f$ \prod_i |L_{ii}|^2 \f$.
+     */
+    [[nodiscard]] double det() const {
+      double res = 1.0;
+      for (long i = 0; i < size(); ++i) res *= std::norm(l_(i, i));
+      return res;
+    }
+
+    /**
+     * @brief Get the logarithm of the determinant of the factorized matrix.
+     * @details Contrary to nda::linalg::cholesky::det, it does not overflow/underflow for large matrices.
+     * @return \f$ 2 \sum_i \log |L_{ii}| \f$.
+     */
+    [[nodiscard]] double log_det() const {
+      double res = 0.0;
+      for (long i = 0; i < size(); ++i) res += std::log(std::abs(l_(i, i)));
+      return 2 * res;
+    }
+
+    /**
+     * @brief Get the inverse of the factorized matrix.
+     * @details It calls nda::lapack::potri on a copy of the factor and fills the upper triangle of the result.
+     * @return Inverse of the matrix.
+     */
+    [[nodiscard]] matrix<T, F_layout> inverse() const {
+      auto res = l_;
+      if (res.empty()) return res;
+      int info = lapack::potri(res, 'L');
+      if (info != 0) NDA_RUNTIME_ERROR << "Error in nda::linalg::cholesky::inverse: info = " << info;
+      for (long j = 1; j < size(); ++j) {
+        for (long i = 0; i < j; ++i) {
+          if constexpr (is_complex_v<T>)
+            res(i, j) = std::conj(res(j, i));
+          else
+            res(i, j) = res(j, i);
+        }
+      }
+      return res;
+    }
+  };
+
+  /// Deduce the value type of nda::linalg::cholesky from the matrix.
+  template <Matrix M>
+  cholesky(M const &) -> cholesky<get_value_t<M>>;
+
+} // namespace nda::linalg
@@ -28,6 +28,9 @@
 #include "../exceptions.hpp"
 #include "../lapack/getrf.hpp"
 #include "../lapack/getri.hpp"
+#include "../lapack/potrf.hpp"
+#include "../lapack/potri.hpp"
+#include "../lapack/workspace.hpp"
 #include "../layout/policies.hpp"
 #include "../matrix_functions.hpp"
 #include "../mem/address_space.hpp"
@@ -35,6 +38,7 @@
 #include "../print.hpp"
 #include "../traits.hpp"
 
+#include <complex>
 #include <iostream>
 #include <type_traits>
 #include <utility>
@@ -276,7 +280,7 @@ namespace nda {
     }
 
     // use getrf and getri from lapack for larger matrices
-    array<int, 1> ipiv(m.extent(0));
+    basic_array<int, 1, C_layout, 'A', sso<100>> ipiv(m.extent(0));
     int info = lapack::getrf(m, ipiv); // it is ok to be in C order
     if (info != 0) NDA_RUNTIME_ERROR << "Error in nda::inverse_in_place: Matrix is not invertible: info = " << info;
     info = lapack::getri(m, ipiv);
@@ -303,6 +307,140 @@ namespace nda {
     return r;
   }
 
+  /**
+   * @brief Compute the inverse of a real symmetric or complex hermitian positive definite n-by-n matrix.
+   *
+   * @details The inversion is performed in place. It uses the Cholesky factorization nda::lapack::potrf followed by
+   * nda::lapack::potri, which is about twice as fast as the general nda::inverse_in_place. Only the upper triangle of
+   * the given matrix is referenced. The lower triangle of the result is filled from the upper one.
+   *
+   * It throws an exception if the matrix is not positive definite.
+   *
+   * @tparam M nda::MemoryMatrix type.
+   * @param m nda::MemoryMatrix object to be inverted.
+   */
+  template <MemoryMatrix M>
+    requires(get_algebra<M> == 'M' and mem::on_host<M> and is_blas_lapack_v<get_value_t<M>>)
+  void inverse_spd_in_place(M &&m) { // NOLINT (temporary views are allowed here)
+    EXPECTS(is_matrix_square(m, true));
+
+    // nothing to do if the matrix/view is empty
+    if (m.empty()) return;
+
+    // use potrf and potri from lapack
+    int info = lapack::potrf(m, 'U'); // it is ok to be in C order
+    if (info != 0) NDA_RUNTIME_ERROR << "Error in nda::inverse_spd_in_place: Matrix is not positive definite: info = " << info;
+    info = lapack::potri(m, 'U');
+    if (info != 0) NDA_RUNTIME_ERROR << "Error in nda::inverse_spd_in_place: Matrix is not invertible: info = " << info;
+
+    // fill the lower triangle
+    long n = m.extent(0);
+    for (long j = 0; j < n; ++j) {
+      for (long i = j + 1; i < n; ++i) {
+        if constexpr (is_complex_v<get_value_t<M>>)
+          m(i, j) = std::conj(m(j, i));
+        else
+          m(i, j) = m(j, i);
+      }
+    }
+  }
+
+  /**
+   * @brief Compute the inverse of a real symmetric or complex hermitian positive definite n-by-n matrix.
+   *
+   * @details The given matrix/view is not modified. It first makes copy of the given matrix/view and then calls
+   * nda::inverse_spd_in_place with the copy.
+   *
+   * @tparam M nda::MemoryMatrix type.
+   * @param m nda::MemoryMatrix object to be inverted.
+   * @return Inverse of the matrix.
+   */
+  template <Matrix M>
+  auto inverse_spd(M const &m)
+    requires(get_algebra<M> == 'M' and is_blas_lapack_v<get_value_t<M>>)
+  {
+    EXPECTS(is_matrix_square(m, true));
+    auto r = make_regular(m);
+    inverse_spd_in_place(r);
+    return r;
+  }
+
+  /**
+   * @brief Worker class to invert many n-by-n matrices of the same size.
+   *
+   * @details It determines the optimal LAPACK workspace size of `getri` once at construction and owns the pivot array
+   * as well as the workspace. Repeated inversions with the same worker therefore perform neither a workspace query nor
+   * any allocation.
+   *
+   * As for nda::inverse_in_place, 1-by-1, 2-by-2 and 3-by-3 matrices are inverted directly.
+   *
+   * @tparam T Value type of the matrices (double or std::complex<double>).
+   */
+  template <typename T>
+    requires(is_blas_lapack_v<T>)
+  class inverse_worker {
+    // Size of the matrices.
+    int dim_;
+
+    // Optimal size of the work buffer.
+    int lwork_ = 1;
+
+    // Pivot indices.
+    array<int, 1> ipiv_;
+
+    // LAPACK workspace.
+    lapack::workspace<T> ws_;
+
+    public:
+    /**
+     * @brief Construct a worker for n-by-n matrices.
+     * @param n Size of the matrices.
+     */
+    explicit inverse_worker(long n) : dim_(n), ipiv_(n) {
+      if (dim_ > 3) {
+        T bufferSize_T{};
+        int info = 0;
+        lapack::f77::getri(dim_, nullptr, dim_, ipiv_.data(), &bufferSize_T, -1, info);
+        lwork_ = lapack::lwork_from_query(bufferSize_T);
+        ws_.work(lwork_);
+      }
+    }
+
+    /**
+     * @brief Get the size of the matrices.
+     * @return Number of rows/columns of the matrices.
+     */
+    [[nodiscard]] long size() const { return dim_; }
+
+    /**
+     * @brief Compute the inverse of an n-by-n matrix in place.
+     *
+     * @tparam M nda::MemoryMatrix type.
+     * @param m nda::MemoryMatrix object to be inverted.
+     */
+    template <MemoryMatrix M>
+      requires(get_algebra<M> == 'M' and mem::on_host<M> and std::is_same_v<get_value_t<M>, T>)
+    void operator()(M &&m) { // NOLINT (temporary views are allowed here)
+      EXPECTS(m.extent(0) == dim_ and m.extent(1) == dim_);
+      EXPECTS(m.indexmap().min_stride() == 1);
+
+      // use optimized routines for small matrices
+      switch (dim_) {
+        case 0: return;
+        case 1: inverse1_in_place(m); return;
+        case 2: inverse2_in_place(m); return;
+        case 3: inverse3_in_place(m); return;
+        default: break;
+      }
+
+      // use getrf and getri from lapack with the preallocated buffers
+      int info = lapack::getrf(m, ipiv_); // it is ok to be in C order
+      if (info != 0) NDA_RUNTIME_ERROR << "Error in nda::inverse_worker: Matrix is not invertible: info = " << info;
+      lapack::f77::getri(dim_, m.data(), lapack::get_ld(m), ipiv_.data(), ws_.work(lwork_), lwork_, info);
+      if (info != 0) NDA_RUNTIME_ERROR << "Error in nda::inverse_worker: Matrix is not invertible: info = " << info;
+    }
+  };
+
   /** @} */
 
 } // namespace nda
@@ -0,0 +1,659 @@
+// Copyright (c) 2024 Simons Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+/**
+ * @file
+ * @brief Provides a class to incrementally update the inverse and the determinant of a matrix under row/column
+ * insertions, removals and replacements.
+ */
+
+#pragma once
+
+#include "./lu.hpp"
+#include "../basic_array.hpp"
+#include "../blas/gemm.hpp"
+#include "../blas/gemv.hpp"
+#include "../blas/ger.hpp"
+#include "../concepts.hpp"
+#include "../declarations.hpp"
+#include "../exceptions.hpp"
+#include "../layout/policies.hpp"
+#include "../layout/range.hpp"
+#include "../macros.hpp"
+#include "../mem/address_space.hpp"
+#include "../traits.hpp"
+
+#include <algorithm>
+#include <array>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace nda::linalg {
+
+  /**
+   * @ingroup linalg_tools
+   * @brief Incremental update of the inverse and the determinant of an n-by-n matrix under low-rank modifications.
+   *
+   * @details Monte Carlo algorithms typically modify a matrix \f$ \mathbf{A} \f$ by inserting, removing or replacing a
+   * few rows and columns at a time and only need the ratio of the determinants before and after the modification to
+   * accept or reject it. Recomputing the inverse and the determinant from scratch costs \f$ \mathcal{O}(n^3) \f$
+   * operations, while the Sherman-Morrison-Woodbury formula and the Schur complement give both in
+   * \f$ \mathcal{O}(n^2) \f$ (rank-1) or \f$ \mathcal{O}(n^2 k) \f$ (rank-k) operations.
+   *
+   * Every modification is done in two steps:
+   * - A `try_*` method computes and returns the ratio \f$ \det \mathbf{A}' / \det \mathbf{A} \f$ of the new and the
+   * current determinant without modifying the object.
+   * - nda::linalg::det_manip::complete_operation applies the last tried modification, while
+   * nda::linalg::det_manip::reject_last_try discards it.
+   *
+   * @code{.cpp}
+   * auto dm = nda::linalg::det_manip{A};
+   * auto r  = dm.try_insert(i, j, row, col, diag); // O(n^2)
+   * if (accept(r)) dm.complete_operation();        // O(n^2)
+   * else dm.reject_last_try();
+   * @endcode
+   *
+   * Rank-1 modifications are implemented with BLAS level 2 (`gemv` and `ger`), rank-k insertions and removals with the
+   * Woodbury formula and BLAS level 3 (`gemm`).
+   *
+   * To control the accumulation of rounding errors, the inverse and the determinant are recomputed from scratch with
+   * an nda::linalg::lu factorization after every `recompute_period` completed operations (see
+   * nda::linalg::det_manip::regenerate). The storage grows geometrically, i.e. a sequence of insertions and removals
+   * only allocates when the size of the matrix exceeds its previous maximum.
+   *
+   * @tparam T Value type of the matrix (double or std::complex<double>).
+   */
+  template <typename T>
+    requires(is_blas_lapack_v<T>)
+  class det_manip {
+    // Type of the pending operation.
+    enum class move_t { none, insert, insert_k, remove, remove_k, change_row, change_col, change_row_col };
+
+    // Current size of the matrix.
+    long n_ = 0;
+
+    // Matrix A and its inverse (only the top left n-by-n blocks are used).
+    matrix<T, F_layout> a_, ainv_;
+
+    // Determinant of A.
+    T det_ = T{1};
+
+    // Number of completed operations after which the inverse and the determinant are recomputed (0 means never).
+    long recompute_period_ = 100;
+
+    // Number of completed operations since the last recomputation.
+    long n_ops_ = 0;
+
+    // Pending operation and its determinant ratio.
+    move_t move_ = move_t::none;
+    T ratio_     = T{1};
+
+    // Row/column positions and data of pending rank-1 operations.
+    long i_ = 0, j_ = 0;
+    T diag_ = T{0}, s_ = T{0};
+    vector<T> row_, col_, x_, y_;
+
+    // Row/column positions and data of pending rank-k operations.
+    std::vector<long> ik_, jk_;
+    matrix<T, F_layout> rk_, ck_, dk_, xk_, yk_;
+    lu<T> s_lu_;
+
+    // Get the top left n-by-n block of a matrix.
+    static auto block(matrix<T, F_layout> &m, long n) { return m(range(n), range(n)); }
+
+    // Sign of the permutation moving rows/columns from the border of the matrix to the given positions.
+    static T border_sign(long i, long j) { return ((i + j) % 2 == 0 ? T{1} : T{-1}); }
+
+    // Move row `from` of the top left block with n columns to position `to` and shift the rows in between.
+    static void move_row(matrix<T, F_layout> &m, long n, long from, long to) {
+      if (from == to) return;
+      for (long c = 0; c < n; ++c) {
+        auto *p = &m(0, c);
+        if (from > to)
+          std::rotate(p + to, p + from, p + from + 1);
+        else
+          std::rotate(p + from, p + from + 1, p + to + 1);
+      }
+    }
+
+    // Move column `from` of the top left block with n rows to position `to` and shift the columns in between.
+    static void move_col(matrix<T, F_layout> &m, long n, long from, long to) {
+      if (from == to) return;
+      for (long r = 0; r < n; ++r) {
+        auto v = m(r, from);
+        if (from > to)
+          for (long c = from; c > to; --c) m(r, c) = m(r, c - 1);
+        else
+          for (long c = from; c < to; ++c) m(r, c) = m(r, c + 1);
+        m(r, to) = v;
+      }
+    }
+
+    // Check that the positions of a rank-k operation are strictly increasing and within bounds.
+    static void check_positions(std::vector<long> const &p, long n, const char *fname) {
+      for (long m = 0; m < std::ssize(p); ++m) {
+        if (p[m] < 0 or p[m] >= n or (m > 0 and p[m] <= p[m - 1]))
+          NDA_RUNTIME_ERROR << "Error in nda::linalg::det_manip::" << fname << ": Positions must be strictly increasing and in [0, " << n << ")";
+      }
+    }
+
+    // Make sure that the matrix can hold at least n rows/columns without reallocation.
+    void grow(long n) {
+      if (n <= capacity()) return;
+      reserve(std::max(n, 2 * capacity()));
+    }
+
+    // Add the (already moved) new row i and column j of a rank-1 insertion to A.
+    void insert_in_a() {
+      for (long c = 0; c < n_; ++c) a_(n_, c) = row_(c);
+      for (long r = 0; r < n_; ++r) a_(r, n_) = col_(r);
+      a_(n_, n_) = diag_;
+      move_row(a_, n_ + 1, n_, i_);
+      move_col(a_, n_ + 1, n_, j_);
+    }
+
+    // Apply a rank-1 insertion to the inverse given x = A^{-1} c, y = r A^{-1} and the Schur complement s.
+    void insert_in_ainv() {
+      auto xv = x_(range(n_));
+      auto yv = y_(range(n_));
+      if (n_ > 0) blas::ger(T{1} / s_, xv, yv, block(ainv_, n_));
+      for (long c = 0; c < n_; ++c) ainv_(n_, c) = -yv(c) / s_;
+      for (long r = 0; r < n_; ++r) ainv_(r, n_) = -xv(r) / s_;
+      ainv_(n_, n_) = T{1} / s_;
+      move_row(ainv_, n_ + 1, n_, j_);
+      move_col(ainv_, n_ + 1, n_, i_);
+    }
+
+    // Remove row i and column j from A and update the inverse.
+    void remove_rank1(long i, long j) {
+      auto ainv = block(ainv_, n_);
+      auto xv   = x_(range(n_));
+      auto yv   = y_(range(n_));
+      xv        = ainv(range::all, i);
+      yv        = ainv(j, range::all);
+      blas::ger(-T{1} / ainv(j, i), xv, yv, ainv);
+      move_row(ainv_, n_, j, n_ - 1);
+      move_col(ainv_, n_, i, n_ - 1);
+      move_row(a_, n_, i, n_ - 1);
+      move_col(a_, n_, j, n_ - 1);
+      --n_;
+    }
+
+    // Compute x = A^{-1} c, y = r A^{-1} and the Schur complement s = d - r A^{-1} c for a rank-1 insertion.
+    void prepare_insert() {
+      auto ainv = block(ainv_, n_);
+      auto xv   = x_(range(n_));
+      auto yv   = y_(range(n_));
+      s_        = diag_;
+      if (n_ == 0) return;
+      blas::gemv(T{1}, ainv, col_(range(n_)), T{0}, xv);
+      blas::gemv(T{1}, transpose(ainv), row_(range(n_)), T{0}, yv);
+      for (long k = 0; k < n_; ++k) s_ -= row_(k) * xv(k);
+    }
+
+    // Set the pending operation and return its determinant ratio.
+    T set_move(move_t m, T ratio) {
+      move_  = m;
+      ratio_ = ratio;
+      return ratio_;
+    }
+
+    public:
+    /// Default constructor creates an empty matrix with determinant 1.
+    det_manip() = default;
+
+    /**
+     * @brief Construct the object from a given square matrix.
+     *
+     * @tparam M nda::Matrix type.
+     * @param m Initial matrix \f$ \mathbf{A} \f$ (it has to be invertible).
+     * @param recompute_period Number of completed operations after which the inverse and the determinant are recomputed
+     * from scratch (0 means never).
+     */
+    template <Matrix M>
+      requires(mem::on_host<M>)
+    explicit det_manip(M const &m, long recompute_period = 100) : recompute_period_(recompute_period) {
+      if (m.extent(0) != m.extent(1)) NDA_RUNTIME_ERROR << "Error in nda::linalg::det_manip: Matrix is not square: " << m.shape();
+      reserve(m.extent(0));
+      n_            = m.extent(0);
+      block(a_, n_) = m;
+      regenerate();
+    }
+
+    /**
+     * @brief Reserve storage for matrices with up to the given number of rows/columns.
+     * @param cap Requested capacity.
+     */
+    void reserve(long cap) {
+      if (cap <= capacity()) return;
+      auto a    = matrix<T, F_layout>(cap, cap);
+      auto ainv = matrix<T, F_layout>(cap, cap);
+      block(a, n_)    = block(a_, n_);
+      block(ainv, n_) = block(ainv_, n_);
+      a_              = std::move(a);
+      ainv_           = std::move(ainv);
+      for (auto *v : {&row_, &col_, &x_, &y_}) v->resize(cap);
+    }
+
+    /**
+     * @brief Get the number of rows/columns that can be stored without reallocation.
+     * @return Capacity of the storage.
+     */
+    [[nodiscard]] long capacity() const { return a_.extent(0); }
+
+    /**
+     * @brief Get the current size of the matrix.
+     * @return Number of rows/columns of \f$ \mathbf{A} \f$.
+     */
+    [[nodiscard]] long size() const { return n_; }
+
+    /**
+     * @brief Get the current determinant.
+     * @return \f$ \det \mathbf{A} \f$.
+     */
+    [[nodiscard]] T determinant() const { return det_; }
+
+    /**
+     * @brief Get the current matrix.
+     * @return Const view of \f$ \mathbf{A} \f$.
+     */
+    [[nodiscard]] auto mat() const { return a_(range(n_), range(n_)); }
+
+    /**
+     * @brief Get the current inverse.
+     * @return Const view of \f$ \mathbf{A}^{-1} \f$.
+     */
+    [[nodiscard]] auto inverse() const { return ainv_(range(n_), range(n_)); }
+
+    /**
+     * @brief Get the number of completed operations after which the inverse and the determinant are recomputed.
+     * @return Recomputation period (0 means never).
+     */
+    [[nodiscard]] long recompute_period() const { return recompute_period_; }
+
+    /**
+     * @brief Set the number of completed operations after which the inverse and the determinant are recomputed.
+     * @param p Recomputation period (0 means never).
+     */
+    void set_recompute_period(long p) { recompute_period_ = p; }
+
+    /**
+     * @brief Recompute the inverse and the determinant of the current matrix from scratch.
+     *
+     * @details It uses an nda::linalg::lu factorization and costs \f$ \mathcal{O}(n^3) \f$ operations. It is called
+     * automatically every `recompute_period` completed operations and throws an exception if the matrix is singular.
+     */
+    void regenerate() {
+      n_ops_ = 0;
+      move_  = move_t::none;
+      if (n_ == 0) {
+        det_ = T{1};
+        return;
+      }
+      auto f = lu{block(a_, n_)};
+      if (f.is_singular()) NDA_RUNTIME_ERROR << "Error in nda::linalg::det_manip::regenerate: Matrix is singular";
+      det_             = f.det();
+      block(ainv_, n_) = f.inverse();
+    }
+
+    /**
+     * @brief Try to insert a new row at position i and a new column at position j.
+     *
+     * @details After the insertion, the matrix has n + 1 rows/columns and
+     * - row i (without column j) is given by `row`,
+     * - column j (without row i) is given by `col`,
+     * - the element at (i, j) is given by `diag`.
+     *
+     * The ratio is \f$ (-1)^{i + j} (d - \mathbf{r} \mathbf{A}^{-1} \mathbf{c}) \f$.
+     *
+     * @tparam R nda::Vector type.
+     * @tparam C nda::Vector type.
+     * @param i Position of the new row in [0, n].
+     * @param j Position of the new column in [0, n].
+     * @param row New row of size n.
+     * @param col New column of size n.
+     * @param diag New diagonal element.
+     * @return Determinant ratio \f$ \det \mathbf{A}' / \det \mathbf{A} \f$.
+     */
+    template <Vector R, Vector C>
+    T try_insert(long i, long j, R const &row, C const &col, T diag) {
+      EXPECTS(0 <= i and i <= n_ and 0 <= j and j <= n_);
+      EXPECTS(row.size() == n_ and col.size() == n_);
+      grow(n_ + 1);
+      i_              = i;
+      j_              = j;
+      diag_           = diag;
+      row_(range(n_)) = row;
+      col_(range(n_)) = col;
+      prepare_insert();
+      return set_move(move_t::insert, border_sign(i, j) * s_);
+    }
+
+    /**
+     * @brief Try to remove row i and column j.
+     *
+     * @details The ratio is \f$ (-1)^{i + j} (\mathbf{A}^{-1})_{ji} \f$.
+     *
+     * @param i Position of the row to be removed.
+     * @param j Position of the column to be removed.
+     * @return Determinant ratio \f$ \det \mathbf{A}' / \det \mathbf{A} \f$.
+     */
+    T try_remove(long i, long j) {
+      EXPECTS(0 <= i and i < n_ and 0 <= j and j < n_);
+      i_ = i;
+      j_ = j;
+      return set_move(move_t::remove, border_sign(i, j) * ainv_(j, i));
+    }
+
+    /**
+     * @brief Try to replace column j.
+     *
+     * @details The ratio is \f$ (\mathbf{A}^{-1} \mathbf{c})_j \f$.
+     *
+     * @tparam C nda::Vector type.
+     * @param j Position of the column to be replaced.
+     * @param col New column of size n.
+     * @return Determinant ratio \f$ \det \mathbf{A}' / \det \mathbf{A} \f$.
+     */
+    template <Vector C>
+    T try_change_col(long j, C const &col) {
+      EXPECTS(0 <= j and j < n_);
+      EXPECTS(col.size() == n_);
+      j_              = j;
+      col_(range(n_)) = col;
+      blas::gemv(T{1}, block(ainv_, n_), col_(range(n_)), T{0}, x_(range(n_)));
+      return set_move(move_t::change_col, x_(j));
+    }
+
+    /**
+     * @brief Try to replace row i.
+     *
+     * @details The ratio is \f$ (\mathbf{r} \mathbf{A}^{-1})_i \f$.
+     *
+     * @tparam R nda::Vector type.
+     * @param i Position of the row to be replaced.
+     * @param row New row of size n.
+     * @return Determinant ratio \f$ \det \mathbf{A}' / \det \mathbf{A} \f$.
+     */
+    template <Vector R>
+    T try_change_row(long i, R const &row) {
+      EXPECTS(0 <= i and i < n_);
+      EXPECTS(row.size() == n_);
+      i_              = i;
+      row_(range(n_)) = row;
+      blas::gemv(T{1}, transpose(block(ainv_, n_)), row_(range(n_)), T{0}, y_(range(n_)));
+      return set_move(move_t::change_row, y_(i));
+    }
+
+    /**
+     * @brief Try to replace row i and column j at the same time.
+     *
+     * @details The arguments are the same as for nda::linalg::det_manip::try_insert, except that `row` and `col` have
+     * size n - 1. The operation is equivalent to a removal followed by an insertion at the same positions.
+     *
+     * @tparam R nda::Vector type.
+     * @tparam C nda::Vector type.
+     * @param i Position of the row to be replaced.
+     * @param j Position of the column to be replaced.
+     * @param row New row of size n - 1 (without column j).
+     * @param col New column of size n - 1 (without row i).
+     * @param diag New element at (i, j).
+     * @return Determinant ratio \f$ \det \mathbf{A}' / \det \mathbf{A} \f$.
+     */
+    template <Vector R, Vector C>
+    T try_change_row_col(long i, long j, R const &row, C const &col, T diag) {
+      EXPECTS(0 <= i and i < n_ and 0 <= j and j < n_);
+      EXPECTS(row.size() == n_ - 1 and col.size() == n_ - 1);
+      i_    = i;
+      j_    = j;
+      diag_ = diag;
+
+      // embed the new row/column into vectors of size n with a zero at the replaced position
+      for (long k = 0, l = 0; k < n_; ++k) row_(k) = (k == j ? T{0} : row(l++));
+      for (long k = 0, l = 0; k < n_; ++k) col_(k) = (k == i ? T{0} : col(l++));
+
+      // x and y of the insertion into the matrix with row i and column j removed (rank-1 downdate of A^{-1})
+      auto ainv = block(ainv_, n_);
+      auto xv   = x_(range(n_));
+      auto yv   = y_(range(n_));
+      blas::gemv(T{1}, ainv, col_(range(n_)), T{0}, xv);
+      blas::gemv(T{1}, transpose(ainv), row_(range(n_)), T{0}, yv);
+      auto h  = ainv(j, i);
+      auto xj = xv(j), yi = yv(i);
+      for (long k = 0; k < n_; ++k) xv(k) -= ainv(k, i) * xj / h;
+      for (long k = 0; k < n_; ++k) yv(k) -= ainv(j, k) * yi / h;
+      s_ = diag;
+      for (long k = 0; k < n_; ++k) s_ -= row_(k) * xv(k);
+      return set_move(move_t::change_row_col, h * s_);
+    }
+
+    /**
+     * @brief Try to insert k new rows and k new columns at the given positions.
+     *
+     * @details After the insertion, the matrix has n + k rows/columns and
+     * - row `i[m]` (without the new columns) is given by `r(m, _)`,
+     * - column `j[m]` (without the new rows) is given by `c(_, m)`,
+     * - the element at (`i[m]`, `j[l]`) is given by `d(m, l)`.
+     *
+     * The positions refer to the new matrix and have to be strictly increasing. The ratio is the determinant of the
+     * Schur complement \f$ \mathbf{D} - \mathbf{R} \mathbf{A}^{-1} \mathbf{C} \f$ times the sign of the permutation.
+     * The inverse is updated with the Woodbury formula using `gemm`.
+     *
+     * @tparam R nda::Matrix type.
+     * @tparam C nda::Matrix type.
+     * @tparam D nda::Matrix type.
+     * @param i Positions of the new rows.
+     * @param j Positions of the new columns.
+     * @param r New rows (k-by-n matrix).
+     * @param c New columns (n-by-k matrix).
+     * @param d New block at the intersection of the new rows and columns (k-by-k matrix).
+     * @return Determinant ratio \f$ \det \mathbf{A}' / \det \mathbf{A} \f$.
+     */
+    template <Matrix R, Matrix C, Matrix D>
+    T try_insert_k(std::vector<long> const &i, std::vector<long> const &j, R const &r, C const &c, D const &d) {
+      long k = std::ssize(i);
+      EXPECTS(std::ssize(j) == k);
+      EXPECTS(r.shape() == (std::array{k, n_}) and c.shape() == (std::array{n_, k}) and d.shape() == (std::array{k, k}));
+      check_positions(i, n_ + k, "try_insert_k");
+      check_positions(j, n_ + k, "try_insert_k");
+      grow(n_ + k);
+      ik_ = i;
+      jk_ = j;
+      rk_.resize(k, n_);
+      ck_.resize(n_, k);
+      dk_.resize(k, k);
+      xk_.resize(n_, k);
+      yk_.resize(k, n_);
+      rk_ = r;
+      ck_ = c;
+      dk_ = d;
+
+      // X = A^{-1} C, Y = R A^{-1} and the Schur complement S = D - R X
+      auto ainv = block(ainv_, n_);
+      auto s    = matrix<T, F_layout>{dk_};
+      if (n_ > 0) {
+        blas::gemm(T{1}, ainv, ck_, T{0}, xk_);
+        blas::gemm(T{1}, rk_, ainv, T{0}, yk_);
+        blas::gemm(T{-1}, rk_, xk_, T{1}, s);
+      }
+      s_lu_.factorize(s);
+      auto sign = T{1};
+      for (long m = 0; m < k; ++m) sign *= border_sign(i[m], j[m]);
+      return set_move(move_t::insert_k, sign * s_lu_.det());
+    }
+
+    /**
+     * @brief Try to remove the rows and columns at the given positions.
+     *
+     * @details The positions have to be strictly increasing. The ratio is the determinant of the k-by-k block of
+     * \f$ \mathbf{A}^{-1} \f$ at the intersection of the rows `j` and columns `i` times the sign of the permutation. The
+     * inverse is updated with the Woodbury formula using `gemm`.
+     *
+     * @param i Positions of the rows to be removed.
+     * @param j Positions of the columns to be removed.
+     * @return Determinant ratio \f$ \det \mathbf{A}' / \det \mathbf{A} \f$.
+     */
+    T try_remove_k(std::vector<long> const &i, std::vector<long> const &j) {
+      long k = std::ssize(i);
+      EXPECTS(std::ssize(j) == k and k <= n_);
+      check_positions(i, n_, "try_remove_k");
+      check_positions(j, n_, "try_remove_k");
+      ik_ = i;
+      jk_ = j;
+      dk_.resize(k, k);
+      auto sign = T{1};
+      for (long m = 0; m < k; ++m) {
+        sign *= border_sign(i[m], j[m]);
+        for (long l = 0; l < k; ++l) dk_(m, l) = ainv_(j[m], i[l]);
+      }
+      s_lu_.factorize(dk_);
+      return set_move(move_t::remove_k, sign * s_lu_.det());
+    }
+
+    /**
+     * @brief Apply the last tried operation.
+     *
+     * @details It updates the matrix, its inverse and its determinant. If no operation is pending, it does nothing. A
+     * tried operation with a zero determinant ratio cannot be completed (the new matrix would be singular).
+     */
+    void complete_operation() {
+      if (move_ == move_t::none) return;
+      if (ratio_ == T{0}) NDA_RUNTIME_ERROR << "Error in nda::linalg::det_manip::complete_operation: New matrix is singular";
+
+      switch (move_) {
+        case move_t::insert: {
+          insert_in_a();
+          insert_in_ainv();
+          ++n_;
+          break;
+        }
+        case move_t::remove: {
+          remove_rank1(i_, j_);
+          break;
+        }
+        case move_t::change_col: {
+          // A^{-1} <- A^{-1} - (x - e_j) A^{-1}(j, _) / x_j
+          auto ainv = block(ainv_, n_);
+          auto yv   = y_(range(n_));
+          yv        = ainv(j_, range::all);
+          x_(j_) -= T{1};
+          blas::ger(-T{1} / ratio_, x_(range(n_)), yv, ainv);
+          a_(range(n_), j_) = col_(range(n_));
+          break;
+        }
+        case move_t::change_row: {
+          // A^{-1} <- A^{-1} - A^{-1}(_, i) (y - e_i) / y_i
+          auto ainv = block(ainv_, n_);
+          auto xv   = x_(range(n_));
+          xv        = ainv(range::all, i_);
+          y_(i_) -= T{1};
+          blas::ger(-T{1} / ratio_, xv, y_(range(n_)), ainv);
+          a_(i_, range(n_)) = row_(range(n_));
+          break;
+        }
+        case move_t::change_row_col: {
+          // x and y are embedded with respect to the old matrix: drop the elements at the removed positions
+          auto xv = x_(range(n_));
+          auto yv = y_(range(n_));
+          std::rotate(&xv(j_), &xv(j_) + 1, &xv(0) + n_);
+          std::rotate(&yv(i_), &yv(i_) + 1, &yv(0) + n_);
+          std::rotate(&row_(j_), &row_(j_) + 1, &row_(0) + n_);
+          std::rotate(&col_(i_), &col_(i_) + 1, &col_(0) + n_);
+
+          // remove the old row/column without touching x and y, then insert the new ones
+          auto ainv = block(ainv_, n_);
+          auto h    = ainv(j_, i_);
+          for (long c = 0; c < n_; ++c) {
+            if (c == i_) continue;
+            auto f = ainv(j_, c) / h;
+            for (long r = 0; r < n_; ++r) ainv(r, c) -= ainv(r, i_) * f;
+          }
+          move_row(ainv_, n_, j_, n_ - 1);
+          move_col(ainv_, n_, i_, n_ - 1);
+          move_row(a_, n_, i_, n_ - 1);
+          move_col(a_, n_, j_, n_ - 1);
+          --n_;
+          insert_in_a();
+          insert_in_ainv();
+          ++n_;
+          break;
+        }
+        case move_t::insert_k: {
+          long k = std::ssize(ik_);
+          auto n = n_;
+
+          // fill the border of A
+          a_(range(n, n + k), range(n))        = rk_;
+          a_(range(n), range(n, n + k))        = ck_;
+          a_(range(n, n + k), range(n, n + k)) = dk_;
+
+          // Woodbury update of the inverse with W = S^{-1} Y
+          auto sinv = s_lu_.inverse();
+          auto w    = matrix<T, F_layout>(k, n);
+          if (n > 0) {
+            blas::gemm(T{1}, sinv, yk_, T{0}, w);
+            blas::gemm(T{-1}, xk_, sinv, T{0}, ainv_(range(n), range(n, n + k)));
+            blas::gemm(T{1}, xk_, w, T{1}, block(ainv_, n));
+          }
+          ainv_(range(n, n + k), range(n))        = -w;
+          ainv_(range(n, n + k), range(n, n + k)) = sinv;
+
+          // move the new rows/columns to their final positions
+          for (long m = 0; m < k; ++m) {
+            move_row(a_, n + k, n + m, ik_[m]);
+            move_col(a_, n + k, n + m, jk_[m]);
+            move_row(ainv_, n + k, n + m, jk_[m]);
+            move_col(ainv_, n + k, n + m, ik_[m]);
+          }
+          n_ += k;
+          break;
+        }
+        case move_t::remove_k: {
+          long k = std::ssize(ik_);
+          auto n = n_ - k;
+
+          // move the rows/columns to be removed to the border
+          for (long m = k - 1; m >= 0; --m) {
+            move_row(a_, n_, ik_[m], n + m);
+            move_col(a_, n_, jk_[m], n + m);
+            move_row(ainv_, n_, jk_[m], n + m);
+            move_col(ainv_, n_, ik_[m], n + m);
+          }
+
+          // Woodbury update of the inverse: A'^{-1} = E - F H^{-1} G
+          if (n > 0) {
+            auto w = matrix<T, F_layout>{ainv_(range(n, n_), range(n))};
+            s_lu_.solve(w);
+            blas::gemm(T{-1}, ainv_(range(n), range(n, n_)), w, T{1}, block(ainv_, n));
+          }
+          n_ = n;
+          break;
+        }
+        default: break;
+      }
+
+      det_ *= ratio_;
+      move_ = move_t::none;
+      if (recompute_period_ > 0 and ++n_ops_ >= recompute_period_) regenerate();
+    }
+
+    /// Discard the last tried operation.
+    void reject_last_try() { move_ = move_t::none; }
+  };
+
+  /// Deduce the value type of nda::linalg::det_manip from the matrix.
+  template <Matrix M>
+  det_manip(M const &, long = 100) -> det_manip<get_value_t<M>>;
+
+} // namespace nda::linalg
@@ -26,10 +26,12 @@
 #include "../declarations.hpp"
 #include "../exceptions.hpp"
 #include "../lapack/interface/cxx_interface.hpp"
+#include "../lapack/workspace.hpp"
 #include "../layout/policies.hpp"
 #include "../macros.hpp"
 #include "../traits.hpp"
 
+#include <algorithm>
 #include <type_traits>
 #include <utility>
 
@@ -37,39 +39,64 @@ namespace nda::linalg {
 
   namespace detail {
 
-    // Dispatch the call to the appropriate LAPACK routine based on the value type of the matrix.
-    template <typename M>
-    auto _eigen_element_impl(M &&m, char compz) { // NOLINT (temporary views are allowed here)
-      using value_type = typename std::decay_t<M>::value_type;
+    // Query the optimal workspace size of the LAPACK routine syev/heev for a dim-by-dim matrix.
+    template <typename T>
+    int _eigen_element_lwork(int dim, char compz) {
+      T bufferSize_T{};
+      double w_dummy{};
+      int lwork = -1, info = 0;
+      if constexpr (not is_complex_v<T>) {
+        lapack::f77::syev(compz, 'U', dim, nullptr, std::max(dim, 1), &w_dummy, &bufferSize_T, lwork, info);
+      } else {
+        lapack::f77::heev(compz, 'U', dim, nullptr, std::max(dim, 1), &w_dummy, &bufferSize_T, lwork, &w_dummy, info);
+      }
+      return lapack::lwork_from_query(bufferSize_T);
+    }
+
+    // Dispatch the call to the appropriate LAPACK routine based on the value type of the matrix (the eigenvalues are
+    // written to ev and the buffers are taken from the workspace ws, the size of the work buffer is lwork).
+    template <typename M, typename EV>
+    void _eigen_element_impl(M &&m, char compz, EV &ev, lapack::workspace<get_value_t<M>> &ws, // NOLINT (temporary views are allowed here)
+                             int lwork) {
+      using value_type = get_value_t<M>;
 
       // runtime checks
       EXPECTS((not m.empty()));
       EXPECTS(is_matrix_square(m, true));
       EXPECTS(m.indexmap().is_contiguous());
+      EXPECTS(ev.size() == m.extent(0));
 
-      // set up the workspace
-      int dim   = m.extent(0);
-      int lwork = 64 * dim;
-      array<double, 1> ev(dim);
-      array<value_type, 1> work(lwork);
-      array<double, 1> work2(is_complex_v<value_type> ? lwork : 0);
+      // get the buffers from the workspace
+      int dim     = m.extent(0);
+      auto *work  = ws.work(lwork);
+      auto *work2 = (is_complex_v<value_type> ? ws.rwork(std::max(1, 3 * dim - 2)) : nullptr);
 
 #if defined(__has_feature)
 #if __has_feature(memory_sanitizer)
-      work2 = 0;
-      work  = 0;
-      ev    = 0;
+      std::fill(work, work + lwork, value_type{});
+      if (work2) std::fill(work2, work2 + std::max(1, 3 * dim - 2), 0.0);
+      ev = 0;
 #endif
 #endif
 
       // call the correct LAPACK routine
       int info = 0;
       if constexpr (not is_complex_v<value_type>) {
-        lapack::f77::syev(compz, 'U', dim, m.data(), dim, ev.data(), work.data(), lwork, info);
+        lapack::f77::syev(compz, 'U', dim, m.data(), dim, ev.data(), work, lwork, info);
       } else {
-        lapack::f77::heev(compz, 'U', dim, m.data(), dim, ev.data(), work.data(), lwork, work2.data(), info);
+        lapack::f77::heev(compz, 'U', dim, m.data(), dim, ev.data(), work, lwork, work2, info);
       }
       if (info) NDA_RUNTIME_ERROR << "Error in nda::linalg::detail::_eigen_element_impl: Diagonalization error";
+    }
+
+    // Same as above with a temporary workspace of optimal size and a newly allocated array of eigenvalues.
+    template <typename M>
+    auto _eigen_element_impl(M &&m, char compz) { // NOLINT (temporary views are allowed here)
+      EXPECTS((not m.empty()));
+      int dim = m.extent(0);
+      array<double, 1> ev(dim);
+      auto ws = lapack::workspace<get_value_t<M>>{};
+      _eigen_element_impl(m, compz, ev, ws, _eigen_element_lwork<get_value_t<M>>(dim, compz));
       return ev;
     }
 
@@ -95,7 +122,7 @@ namespace nda::linalg {
    */
   template <typename M>
   auto eigenelements(M const &m) {
-    auto m_copy = matrix<typename M::value_type, F_layout>(m);
+    auto m_copy = matrix<get_value_t<M>, F_layout>(m);
     auto ev     = detail::_eigen_element_impl(m_copy, 'V');
     return std::pair<array<double, 1>, typename M::regular_type>{ev, m_copy};
   }
@@ -114,7 +141,7 @@ namespace nda::linalg {
    */
   template <typename M>
   auto eigenvalues(M const &m) {
-    auto m_copy = matrix<typename M::value_type, F_layout>(m);
+    auto m_copy = matrix<get_value_t<M>, F_layout>(m);
     return detail::_eigen_element_impl(m_copy, 'N');
   }
 
@@ -135,6 +162,88 @@ namespace nda::linalg {
     return detail::_eigen_element_impl(m, 'N');
   }
 
+  /**
+   * @brief Worker class to diagonalize many symmetric (real) or hermitian (complex) matrices of the same size.
+   *
+   * @details It determines the optimal LAPACK workspace size once at construction and owns all the buffers needed
+   * by `syev`/`heev`, including a copy of the matrix and the array of eigenvalues. Repeated diagonalizations with the
+   * same worker therefore perform neither a workspace query nor any allocation.
+   *
+   * The results are stored in the worker and are overwritten by the next call.
+   *
+   * @tparam T Value type of the matrices (double or std::complex<double>).
+   */
+  template <typename T>
+    requires(is_blas_lapack_v<T>)
+  class eigen_worker {
+    // Size of the matrices.
+    int dim_;
+
+    // Optimal size of the work buffer.
+    int lwork_;
+
+    // Matrix which is diagonalized in place (contains the eigenvectors afterwards).
+    matrix<T, F_layout> m_;
+
+    // Eigenvalues.
+    array<double, 1> ev_;
+
+    // LAPACK workspace.
+    lapack::workspace<T> ws_;
+
+    // Copy the given matrix and diagonalize it.
+    template <typename M>
+    void diagonalize(M const &m, char compz) {
+      EXPECTS(m.shape() == m_.shape());
+      m_() = m;
+      detail::_eigen_element_impl(m_, compz, ev_, ws_, lwork_);
+    }
+
+    public:
+    /**
+     * @brief Construct a worker for n-by-n matrices.
+     * @param n Size of the matrices (must be positive).
+     */
+    explicit eigen_worker(long n) : dim_(n), lwork_(detail::_eigen_element_lwork<T>(dim_, 'V')), m_(n, n), ev_(n) {
+      EXPECTS(n > 0);
+      ws_.work(lwork_);
+      if constexpr (is_complex_v<T>) ws_.rwork(std::max(1, 3 * dim_ - 2));
+    }
+
+    /**
+     * @brief Get the size of the matrices.
+     * @return Number of rows/columns of the matrices.
+     */
+    [[nodiscard]] long size() const { return dim_; }
+
+    /**
+     * @brief Find the eigenvalues of a symmetric (real) or hermitian (complex) matrix/view.
+     *
+     * @tparam M Type of the matrix/view.
+     * @param m Matrix/View to diagonalize.
+     * @return Reference to the array of eigenvalues in ascending order.
+     */
+    template <typename M>
+    array<double, 1> const &eigenvalues(M const &m) {
+      diagonalize(m, 'N');
+      return ev_;
+    }
+
+    /**
+     * @brief Find the eigenvalues and eigenvectors of a symmetric (real) or hermitian (complex) matrix/view.
+     *
+     * @tparam M Type of the matrix/view.
+     * @param m Matrix/View to diagonalize.
+     * @return std::pair consisting of references to the array of eigenvalues in ascending order and to the matrix
+     * containing the eigenvectors in its columns.
+     */
+    template <typename M>
+    std::pair<array<double, 1> const &, matrix<T, F_layout> const &> eigenelements(M const &m) {
+      diagonalize(m, 'V');
+      return {ev_, m_};
+    }
+  };
+
   /** @} */
 
 } // namespace nda::linalg
@@ -0,0 +1,382 @@
+// Copyright (c) 2024 Simons Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+/**
+ * @file
+ * @brief Provides matrix-free Lanczos and Davidson eigensolvers for the lowest eigenpairs of hermitian operators.
+ */
+
+#pragma once
+
+#include "./eigenelements.hpp"
+#include "./krylov.hpp"
+#include "./randomized_svd.hpp"
+#include "../basic_array.hpp"
+#include "../blas/gemm.hpp"
+#include "../blas/gemv.hpp"
+#include "../blas/scal.hpp"
+#include "../concepts.hpp"
+#include "../declarations.hpp"
+#include "../exceptions.hpp"
+#include "../layout/policies.hpp"
+#include "../layout/range.hpp"
+#include "../macros.hpp"
+#include "../mapped_functions.hpp"
+#include "../mem/address_space.hpp"
+#include "../traits.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <tuple>
+#include <utility>
+
+namespace nda::linalg {
+
+  namespace detail {
+
+    // Orthogonalize w against the orthonormal columns of v with classical Gram-Schmidt and reorthogonalization. The
+    // coefficients are added to h (if not empty), c is a work vector. Returns the norm of w after orthogonalization.
+    template <typename V, typename W, typename H, typename C>
+    double orthogonalize(V const &v, W &&w, H &&h, C &&c) { // NOLINT (temporary views are allowed here)
+      using T = get_value_t<V>;
+      if (v.extent(1) > 0) {
+        for (int pass = 0; pass < 2; ++pass) {
+          blas::gemv(T{1}, dagger(v), w, T{0}, c);
+          blas::gemv(T{-1}, v, c, T{1}, w);
+          if (not h.empty()) h += c;
+        }
+      }
+      return nrm2(w);
+    }
+
+    // Check the arguments of the eigensolvers.
+    inline void check_eigensolver_args(long n, long k, const char *fname) {
+      if (k <= 0 or k > n) NDA_RUNTIME_ERROR << "Error in nda::linalg::" << fname << ": Invalid number of eigenvalues k = " << k;
+    }
+
+  } // namespace detail
+
+  /**
+   * @addtogroup linalg_tools
+   * @{
+   */
+
+  /**
+   * @brief Compute the lowest eigenpairs of a hermitian operator with the thick-restart Lanczos method.
+   *
+   * @details The operator is only accessed through the callable `a`, which is either called in place as `a(x, y)` to
+   * compute \f$ \mathbf{y} = \mathbf{A x} \f$ or as `y = a(x)` (see nda::linalg::cg_worker).
+   *
+   * Starting from a random vector, the Lanczos process builds an orthonormal basis of a Krylov subspace of dimension
+   * `krylov_dim`. Every new Lanczos vector is fully reorthogonalized against the basis (classical Gram-Schmidt applied
+   * twice with `gemv`), which avoids spurious copies of converged eigenvalues. The projected matrix is diagonalized with
+   * nda::linalg::eigen_worker and, if the k lowest Ritz pairs have not converged, the method is restarted with the
+   * lowest Ritz vectors (computed with `gemm`) and the last residual vector (K. Wu and H. Simon, SIAM J. Matrix Anal.
+   * Appl. 22, 602 (2000)). The memory is therefore O(n * krylov_dim).
+   *
+   * A Ritz pair \f$ (\theta, \mathbf{y}) \f$ is converged if \f$ \|\mathbf{A y} - \theta \mathbf{y}\| \leq
+   * \mathrm{tol} \, \|\mathbf{A}\| \f$, where \f$ \|\mathbf{A}\| \f$ is estimated by the largest absolute Ritz value.
+   *
+   * @tparam T Value type of the operator (double or std::complex<double>).
+   * @tparam Op Callable type of the operator.
+   * @param n Dimension of the operator.
+   * @param a Hermitian operator \f$ \mathbf{A} \f$.
+   * @param k Number of eigenpairs to compute (`0 < k <= n`).
+   * @param tol Relative tolerance of the residuals.
+   * @param max_iter Maximum number of applications of the operator.
+   * @param krylov_dim Maximum dimension of the Krylov subspace (default: `max(2k + 1, 20)`, at most n).
+   * @param seed Seed of the random number generator for the starting vector.
+   * @return std::tuple containing the k lowest eigenvalues in ascending order, the n-by-k matrix of the corresponding
+   * orthonormal eigenvectors and an nda::linalg::krylov_info with the number of operator applications and the largest
+   * relative residual.
+   */
+  template <typename T, typename Op>
+    requires(is_blas_lapack_v<T>)
+  auto lanczos(long n, Op &&a, long k, double tol = 1e-10, long max_iter = 10000, long krylov_dim = 0, std::uint64_t seed = 0) {
+    using matrix_t = matrix<T, F_layout>;
+    detail::check_eigensolver_args(n, k, "lanczos");
+    long m = std::min(n, std::max(k + 2, (krylov_dim > 0 ? krylov_dim : std::max(2 * k + 1, 20l))));
+    auto _ = range::all;
+
+    // Krylov basis (plus residual vector), projected matrix and work buffers
+    auto v      = matrix_t(n, m + 1);
+    auto y      = matrix_t(n, m);
+    auto t      = matrix_t::zeros(m, m);
+    auto h      = vector<T>(m + 1);
+    auto c      = vector<T>(m + 1);
+    auto worker = eigen_worker<T>{m};
+
+    // random starting vector
+    detail::fill_gaussian(v(_, 0), seed);
+    blas::scal(T(1.0 / detail::nrm2(v(_, 0))), v(_, 0));
+
+    long l = 0, n_apply = 0;
+    double anorm = 0.0;
+    while (true) {
+      // extend the Lanczos factorization A V = V T + beta v_m e_m^H from l to m vectors
+      double beta = 0.0;
+      for (long j = l; j < m; ++j) {
+        auto w = v(_, j + 1);
+        detail::apply_op(a, v(_, j), w);
+        ++n_apply;
+        auto hj = h(range(j + 1));
+        hj      = 0;
+        beta    = detail::orthogonalize(v(_, range(j + 1)), w, hj, c(range(j + 1)));
+        for (long i = 0; i <= j; ++i) {
+          t(i, j) = hj(i);
+          t(j, i) = nda::conj(hj(i));
+          anorm   = std::max(anorm, std::abs(hj(i)));
+        }
+        t(j, j) = std::real(hj(j));
+        anorm   = std::max(anorm, beta);
+
+        // replace the next vector by a random one in case of an invariant subspace
+        if (beta <= 100 * std::numeric_limits<double>::epsilon() * anorm) {
+          beta = 0.0;
+          if (j + 1 == m) break;
+          detail::fill_gaussian(w, seed + j + 1);
+          detail::orthogonalize(v(_, range(j + 1)), w, vector<T>{}, c(range(j + 1)));
+        }
+        blas::scal(T(1.0 / detail::nrm2(w)), w);
+        if (j + 1 < m) {
+          t(j + 1, j) = beta;
+          t(j, j + 1) = beta;
+        }
+      }
+
+      // Ritz pairs and residual norms |beta * s(m - 1, i)|
+      auto const &[theta, s] = worker.eigenelements(t);
+      anorm                  = std::max(std::abs(theta(0)), std::abs(theta(m - 1)));
+      double res             = 0.0;
+      for (long i = 0; i < k; ++i) res = std::max(res, beta * std::abs(s(m - 1, i)));
+      bool converged = (res <= tol * anorm);
+      if (converged or n_apply >= max_iter) {
+        auto x = matrix_t(n, k);
+        blas::gemm(T{1}, v(_, range(m)), s(_, range(k)), T{0}, x);
+        return std::make_tuple(array<double, 1>{theta(range(k))}, std::move(x), krylov_info{n_apply, (anorm > 0 ? res / anorm : 0.0), converged});
+      }
+
+      // thick restart with the p lowest Ritz vectors and the residual vector
+      long p = std::min(m - 1, k + (m - k) / 2);
+      blas::gemm(T{1}, v(_, range(m)), s(_, range(p)), T{0}, y(_, range(p)));
+      v(_, range(p)) = y(_, range(p));
+      v(_, p)        = v(_, m);
+      t              = 0;
+      for (long i = 0; i < p; ++i) t(i, i) = theta(i);
+      l = p;
+    }
+  }
+
+  /**
+   * @brief Compute the lowest eigenpairs of a hermitian matrix with the thick-restart Lanczos method.
+   *
+   * @details See nda::linalg::lanczos(long, Op &&, long, double, long, long, std::uint64_t). The operator is applied
+   * with nda::blas::gemv.
+   *
+   * @tparam M nda::MemoryMatrix type.
+   * @param a Hermitian matrix \f$ \mathbf{A} \f$.
+   * @param k Number of eigenpairs to compute (`0 < k <= n`).
+   * @param tol Relative tolerance of the residuals.
+   * @param max_iter Maximum number of applications of the operator.
+   * @param krylov_dim Maximum dimension of the Krylov subspace (default: `max(2k + 1, 20)`, at most n).
+   * @param seed Seed of the random number generator for the starting vector.
+   * @return std::tuple containing the eigenvalues, the eigenvectors and an nda::linalg::krylov_info.
+   */
+  template <MemoryMatrix M>
+    requires(mem::on_host<M> and is_blas_lapack_v<get_value_t<M>>)
+  auto lanczos(M const &a, long k, double tol = 1e-10, long max_iter = 10000, long krylov_dim = 0, std::uint64_t seed = 0) {
+    using T = get_value_t<M>;
+    EXPECTS(a.extent(0) == a.extent(1));
+    auto op = [&a](auto const &x, auto &y) { blas::gemv(T{1}, a, x, T{0}, y); };
+    return lanczos<T>(a.extent(0), op, k, tol, max_iter, krylov_dim, seed);
+  }
+
+  /**
+   * @brief Compute the lowest eigenpairs of a hermitian operator with the block Davidson method.
+   *
+   * @details The operator is only accessed through the callable `a` (see nda::linalg::lanczos). In addition, the
+   * Davidson method requires its diagonal \f$ \mathbf{D} \f$, which is used to precondition the residuals
+   * \f$ \mathbf{r}_i \f$ of the unconverged Ritz pairs \f$ (\theta_i, \mathbf{y}_i) \f$. The corrections
+   * \f$ (\theta_i - \mathbf{D})^{-1} \mathbf{r}_i \f$ are orthogonalized against the current subspace (classical
+   * Gram-Schmidt applied twice with `gemm`) and added to it. The method converges fast for diagonally dominant
+   * operators, e.g. Hamiltonians in a basis where the interaction is a small perturbation.
+   *
+   * The initial subspace is spanned by the unit vectors of the k smallest diagonal elements with a small random
+   * perturbation. The operator is applied once to every new basis vector and the results are stored, i.e. the
+   * projected matrix, the Ritz vectors and the residuals are computed with `gemm`. If the subspace dimension would
+   * exceed `max_subspace`, the method is restarted with the k current Ritz vectors. The memory is therefore
+   * O(n * max_subspace).
+   *
+   * The convergence criterion is the same as for nda::linalg::lanczos.
+   *
+   * @tparam T Value type of the operator (double or std::complex<double>).
+   * @tparam Op Callable type of the operator.
+   * @tparam D nda::Vector type.
+   * @param n Dimension of the operator.
+   * @param a Hermitian operator \f$ \mathbf{A} \f$.
+   * @param diag Diagonal of \f$ \mathbf{A} \f$ (real vector of size n).
+   * @param k Number of eigenpairs to compute (`0 < k <= n`).
+   * @param tol Relative tolerance of the residuals.
+   * @param max_iter Maximum number of applications of the operator.
+   * @param max_subspace Maximum dimension of the subspace (default: `max(4k, 20)`, at least 2k and at most n).
+   * @param seed Seed of the random number generator for the initial perturbation.
+   * @return std::tuple containing the k lowest eigenvalues in ascending order, the n-by-k matrix of the corresponding
+   * orthonormal eigenvectors and an nda::linalg::krylov_info with the number of operator applications and the largest
+   * relative residual.
+   */
+  template <typename T, typename Op, Vector D>
+    requires(is_blas_lapack_v<T> and std::is_same_v<get_value_t<D>, double>)
+  auto davidson(long n, Op &&a, D const &diag, long k, double tol = 1e-10, long max_iter = 10000, long max_subspace = 0,
+                std::uint64_t seed = 0) {
+    using matrix_t = matrix<T, F_layout>;
+    detail::check_eigensolver_args(n, k, "davidson");
+    EXPECTS(diag.size() == n);
+    long m = std::min(n, std::max(2 * k, (max_subspace > 0 ? max_subspace : std::max(4 * k, 20l))));
+    auto _ = range::all;
+
+    // subspace basis, operator applied to the basis, projected matrix, Ritz vectors, W times the Ritz coefficients and
+    // residuals
+    auto v  = matrix_t(n, m);
+    auto w  = matrix_t(n, m);
+    auto h  = matrix_t::zeros(m, m);
+    auto x  = matrix_t(n, k);
+    auto ws = matrix_t(n, k);
+    auto r  = matrix_t(n, k);
+    auto c  = matrix_t(m, k);
+    auto cv = vector<T>(m);
+
+    // add the columns v(_, [cur, cur + nb)) to the basis after orthonormalization and return the number of new vectors
+    auto add_vectors = [&](long cur, long nb) {
+      if (cur > 0) {
+        auto vb = v(_, range(cur));
+        auto bl = v(_, range(cur, cur + nb));
+        auto cb = c(range(cur), range(nb));
+        for (int pass = 0; pass < 2; ++pass) {
+          blas::gemm(T{1}, dagger(vb), bl, T{0}, cb);
+          blas::gemm(T{-1}, vb, cb, T{1}, bl);
+        }
+      }
+      long added = 0;
+      for (long j = cur; j < cur + nb; ++j) {
+        auto vj    = v(_, cur + added);
+        vj         = v(_, j);
+        double nrm = detail::nrm2(vj);
+        if (nrm == 0.0) continue;
+        blas::scal(T(1.0 / nrm), vj);
+        nrm = detail::orthogonalize(v(_, range(cur + added)), vj, vector<T>{}, cv(range(cur + added)));
+        if (nrm < 1e-8) continue;
+        blas::scal(T(1.0 / nrm), vj);
+        ++added;
+      }
+      return added;
+    };
+
+    // initial subspace: unit vectors of the smallest diagonal elements with a small random perturbation
+    auto idx = std::vector<long>(n);
+    std::iota(idx.begin(), idx.end(), 0);
+    std::partial_sort(idx.begin(), idx.begin() + k, idx.end(), [&](long i, long j) { return diag(i) < diag(j); });
+    auto init = v(_, range(k));
+    detail::fill_gaussian(init, seed);
+    init *= 1e-3 / std::sqrt(double(n));
+    for (long i = 0; i < k; ++i) init(idx[i], i) += 1.0;
+    long cur = 0, nb = add_vectors(0, k), n_apply = 0;
+
+    while (true) {
+      // apply the operator to the new vectors and extend the projected matrix H = V^H A V
+      for (long j = cur; j < cur + nb; ++j) {
+        detail::apply_op(a, v(_, j), w(_, j));
+        ++n_apply;
+      }
+      long m1 = cur + nb;
+      blas::gemm(T{1}, dagger(v(_, range(m1))), w(_, range(cur, m1)), T{0}, h(range(m1), range(cur, m1)));
+      for (long j = cur; j < m1; ++j) {
+        for (long i = 0; i < j; ++i) h(j, i) = nda::conj(h(i, j));
+        h(j, j) = std::real(h(j, j));
+      }
+      cur = m1;
+
+      // Ritz pairs and residuals R = W S - X theta
+      auto [theta, s] = eigenelements(h(range(cur), range(cur)));
+      auto sk         = s(_, range(k));
+      blas::gemm(T{1}, v(_, range(cur)), sk, T{0}, x);
+      blas::gemm(T{1}, w(_, range(cur)), sk, T{0}, ws);
+      double anorm = std::max(std::abs(theta(0)), std::abs(theta(cur - 1)));
+      double res   = 0.0;
+      nb           = 0;
+      for (long i = 0; i < k; ++i) {
+        auto ri = r(_, nb);
+        ri      = ws(_, i) - theta(i) * x(_, i);
+        auto ni = detail::nrm2(ri);
+        res     = std::max(res, ni);
+        if (ni <= tol * anorm) continue;
+
+        // diagonal preconditioner (theta - D)^{-1}
+        for (long q = 0; q < n; ++q) {
+          double d = theta(i) - diag(q);
+          ri(q) /= (std::abs(d) < 1e-8 ? std::copysign(1e-8, d) : d);
+        }
+        ++nb;
+      }
+      bool converged = (nb == 0);
+      if (converged or n_apply >= max_iter) {
+        return std::make_tuple(array<double, 1>{theta(range(k))}, std::move(x), krylov_info{n_apply, (anorm > 0 ? res / anorm : 0.0), converged});
+      }
+
+      // restart with the current Ritz vectors if the corrections do not fit into the subspace
+      if (cur + nb > m) {
+        v(_, range(k)) = x;
+        w(_, range(k)) = ws;
+        h              = 0;
+        for (long i = 0; i < k; ++i) h(i, i) = theta(i);
+        cur = k;
+      }
+      nb                          = std::min(nb, m - cur);
+      v(_, range(cur, cur + nb)) = r(_, range(nb));
+      nb                          = add_vectors(cur, nb);
+      if (nb == 0) return std::make_tuple(array<double, 1>{theta(range(k))}, std::move(x), krylov_info{n_apply, res / anorm, false});
+    }
+  }
+
+  /**
+   * @brief Compute the lowest eigenpairs of a hermitian matrix with the block Davidson method.
+   *
+   * @details See nda::linalg::davidson(long, Op &&, D const &, long, double, long, long, std::uint64_t). The operator is
+   * applied with nda::blas::gemv and the diagonal is taken from the matrix.
+   *
+   * @tparam M nda::MemoryMatrix type.
+   * @param a Hermitian matrix \f$ \mathbf{A} \f$.
+   * @param k Number of eigenpairs to compute (`0 < k <= n`).
+   * @param tol Relative tolerance of the residuals.
+   * @param max_iter Maximum number of applications of the operator.
+   * @param max_subspace Maximum dimension of the subspace (default: `max(4k, 20)`, at least 2k and at most n).
+   * @param seed Seed of the random number generator for the initial perturbation.
+   * @return std::tuple containing the eigenvalues, the eigenvectors and an nda::linalg::krylov_info.
+   */
+  template <MemoryMatrix M>
+    requires(mem::on_host<M> and is_blas_lapack_v<get_value_t<M>>)
+  auto davidson(M const &a, long k, double tol = 1e-10, long max_iter = 10000, long max_subspace = 0, std::uint64_t seed = 0) {
+    using T = get_value_t<M>;
+    EXPECTS(a.extent(0) == a.extent(1));
+    auto op   = [&a](auto const &x, auto &y) { blas::gemv(T{1}, a, x, T{0}, y); };
+    auto diag = vector<double>(a.extent(0));
+    for (long i = 0; i < diag.size(); ++i) diag(i) = std::real(a(i, i));
+    return davidson<T>(a.extent(0), op, diag, k, tol, max_iter, max_subspace, seed);
+  }
+
+  /** @} */
+
+} // namespace nda::linalg
@@ -0,0 +1,587 @@
+// Copyright (c) 2024 Simons Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file
+ * @brief Provides an einsum-style tensor contraction which is lowered to BLAS `gemm` calls.
+ */
+
+#pragma once
+
+#include "../basic_array.hpp"
+#include "../blas/interface/cxx_interface.hpp"
+#include "../concepts.hpp"
+#include "../declarations.hpp"
+#include "../exceptions.hpp"
+#include "../layout_transforms.hpp"
+#include "../macros.hpp"
+#include "../mem/address_space.hpp"
+#include "../traits.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace nda {
+
+  /**
+   * @addtogroup linalg_tools
+   * @{
+   */
+
+  /**
+   * @brief Subscripts of an nda::einsum contraction given as a string literal template argument.
+   *
+   * @details The subscripts consist of one term of labels (ASCII letters) per operand, separated by commas, and an
+   * optional output term after `->`, e.g. `"ijk,kjl->il"`. Without an output term, the output labels are the labels
+   * that occur exactly once in alphabetical order (as in numpy).
+   *
+   * @tparam N Size of the string literal (including the terminating null character).
+   */
+  template <size_t N>
+  struct einsum_subscripts {
+    /// Characters of the string literal.
+    std::array<char, N> str{};
+
+    /**
+     * @brief Construct the subscripts from a string literal.
+     * @param s String literal.
+     */
+    constexpr einsum_subscripts(char const (&s)[N]) { std::copy_n(s, N, str.begin()); } // NOLINT (implicit conversion is intended)
+
+    /**
+     * @brief Get the subscripts as a string view.
+     * @return `std::string_view` without the terminating null character.
+     */
+    [[nodiscard]] constexpr std::string_view view() const { return {str.data(), N - 1}; }
+  };
+
+  /** @} */
+
+  namespace detail {
+
+    // Check if a character is a valid einsum label.
+    constexpr bool einsum_is_label(char c) { return ('a' <= c and c <= 'z') or ('A' <= c and c <= 'Z'); }
+
+    // Get the input terms of the subscripts, i.e. everything before "->".
+    constexpr std::string_view einsum_inputs(std::string_view s) { return s.substr(0, s.find("->")); }
+
+    // Get the number of input terms.
+    constexpr long einsum_n_terms(std::string_view s) {
+      auto in = einsum_inputs(s);
+      return std::count(in.begin(), in.end(), ',') + 1;
+    }
+
+    // Get the i-th input term.
+    constexpr std::string_view einsum_term(std::string_view s, long i) {
+      auto in = einsum_inputs(s);
+      for (; i > 0; --i) in.remove_prefix(in.find(',') + 1);
+      return in.substr(0, in.find(','));
+    }
+
+    // Check if a label belongs to the output term.
+    constexpr bool einsum_is_output_label(std::string_view s, char c) {
+      auto in = einsum_inputs(s);
+      if (s.find("->") != std::string_view::npos) return s.substr(s.find("->") + 2).find(c) != std::string_view::npos;
+      return einsum_is_label(c) and std::count(in.begin(), in.end(), c) == 1;
+    }
+
+    // Get the output term (in implicit mode, the labels occurring exactly once in alphabetical order).
+    inline std::string einsum_output(std::string_view s) {
+      if (s.find("->") != std::string_view::npos) return std::string{s.substr(s.find("->") + 2)};
+      auto res = std::string{};
+      for (char c = 'A'; c <= 'z'; ++c)
+        if (einsum_is_output_label(s, c)) res += c;
+      return res;
+    }
+
+    // Get the number of output labels.
+    constexpr long einsum_output_rank(std::string_view s) {
+      if (s.find("->") != std::string_view::npos) return static_cast<long>(s.size() - s.find("->") - 2);
+      long res = 0;
+      for (char c = 'A'; c <= 'z'; ++c)
+        if (einsum_is_output_label(s, c)) ++res;
+      return res;
+    }
+
+    // Check the syntax of the subscripts for a given number of operands.
+    constexpr bool einsum_is_valid(std::string_view s, long n_operands) {
+      auto in = einsum_inputs(s);
+      if (einsum_n_terms(s) != n_operands) return false;
+      if (not std::all_of(in.begin(), in.end(), [](char c) { return einsum_is_label(c) or c == ','; })) return false;
+      if (s.find("->") == std::string_view::npos) return true;
+      auto out = s.substr(s.find("->") + 2);
+      return std::all_of(out.begin(), out.end(), [&](char c) {
+        return einsum_is_label(c) and in.find(c) != std::string_view::npos and std::count(out.begin(), out.end(), c) == 1;
+      });
+    }
+
+    // Check if the number of labels of each input term matches the rank of the corresponding operand.
+    template <typename... As>
+    constexpr bool einsum_ranks_match(std::string_view s) {
+      return [&]<size_t... Is>(std::index_sequence<Is...>) {
+        return ((static_cast<int>(einsum_term(s, Is).size()) == get_rank<As>) and ...);
+      }(std::index_sequence_for<As...>{});
+    }
+
+    // Extents of the labels (indexed by the label character).
+    using einsum_extents = std::array<long, 128>;
+
+    // Labels, lengths and strides of a tensor taking part in an einsum contraction (one label per dimension).
+    struct einsum_dims {
+      std::string labels;
+      std::vector<long> lengths;
+      std::vector<long> strides;
+
+      // Stride of the dimension with the given label (0 if the label is not present).
+      [[nodiscard]] long stride(char c) const {
+        auto p = labels.find(c);
+        return (p == std::string::npos ? 0 : strides[p]);
+      }
+    };
+
+    // Dimensions of a tensor in C order with the given labels.
+    inline einsum_dims einsum_packed_dims(std::string const &labels, einsum_extents const &ext) {
+      auto d    = einsum_dims{labels, std::vector<long>(labels.size()), std::vector<long>(labels.size())};
+      long size = 1;
+      for (long i = static_cast<long>(labels.size()) - 1; i >= 0; --i) {
+        d.lengths[i] = ext[labels[i]];
+        d.strides[i] = size;
+        size *= d.lengths[i];
+      }
+      return d;
+    }
+
+    // Merge the dimensions of a group of labels (from outermost to innermost) into a single strided dimension.
+    // Returns the length and the stride of the merged dimension or nothing if the dimensions cannot be merged.
+    inline std::optional<std::pair<long, long>> einsum_merge(einsum_dims const &d, std::string const &grp) {
+      long len = 1, str = 0;
+      for (auto it = grp.rbegin(); it != grp.rend(); ++it) {
+        auto p = d.labels.find(*it);
+        if (d.lengths[p] == 1) continue;
+        if (len == 1)
+          str = d.strides[p];
+        else if (d.strides[p] != str * len)
+          return std::nullopt;
+        len *= d.lengths[p];
+      }
+      return std::pair{len, str};
+    }
+
+    // Get the BLAS operation and leading dimension of a rows-by-cols matrix with the given strides.
+    // Returns nothing if the matrix is not BLAS compatible.
+    inline std::optional<std::pair<char, long>> einsum_blas_layout(long rows, long rs, long cols, long cs) {
+      if (rows <= 1 or rs == 1) {
+        long ld = (cols <= 1 ? std::max(1l, rows) : cs);
+        if (ld >= std::max(1l, rows)) return std::pair{'N', ld};
+      }
+      if (cols <= 1 or cs == 1) {
+        long ld = (rows <= 1 ? std::max(1l, cols) : rs);
+        if (ld >= std::max(1l, cols)) return std::pair{'T', ld};
+      }
+      return std::nullopt;
+    }
+
+    // View a tensor as a strided batch of matrices with row labels g0 and column labels g1.
+    // Returns the batch stride, the BLAS operation and the leading dimension or nothing if this is not possible.
+    inline std::optional<std::tuple<long, char, long>> einsum_as_matrices(einsum_dims const &d, std::string const &bat, std::string const &g0,
+                                                                          std::string const &g1) {
+      auto b = einsum_merge(d, bat);
+      auto r = einsum_merge(d, g0);
+      auto c = einsum_merge(d, g1);
+      if (not(b and r and c)) return std::nullopt;
+      auto lay = einsum_blas_layout(r->first, r->second, c->first, c->second);
+      if (not lay) return std::nullopt;
+      return std::tuple{b->second, lay->first, lay->second};
+    }
+
+    // Sort a group of labels by decreasing strides in the given tensor.
+    inline std::string einsum_sorted(std::string grp, einsum_dims const &d) {
+      std::stable_sort(grp.begin(), grp.end(), [&](char x, char y) { return d.stride(x) > d.stride(y); });
+      return grp;
+    }
+
+    // Call f(dst(idx), src(idx)) for all multi-indices idx of the given lengths.
+    template <typename T, typename F>
+    void einsum_for_each(std::vector<long> const &lengths, T const *src, std::vector<long> const &sstr, T *dst, std::vector<long> const &dstr, F f) {
+      long const r = lengths.size();
+      if (std::any_of(lengths.begin(), lengths.end(), [](long l) { return l == 0; })) return;
+      if (r == 0) {
+        f(*dst, *src);
+        return;
+      }
+      auto idx = std::vector<long>(r, 0);
+      while (true) {
+        for (long i = 0; i < lengths[r - 1]; ++i) f(dst[i * dstr[r - 1]], src[i * sstr[r - 1]]);
+        long d = r - 2;
+        for (; d >= 0; --d) {
+          src += sstr[d];
+          dst += dstr[d];
+          if (++idx[d] < lengths[d]) break;
+          src -= sstr[d] * lengths[d];
+          dst -= dstr[d] * lengths[d];
+          idx[d] = 0;
+        }
+        if (d < 0) return;
+      }
+    }
+
+    // Tensor taking part in an einsum contraction. It either refers to the data of an operand or owns its data.
+    template <typename T>
+    struct einsum_tensor {
+      einsum_dims dims;
+      T const *data = nullptr;
+      array<T, 1> buffer;
+    };
+
+    // Allocate a zero-initialized tensor in C order with the given labels.
+    template <typename T>
+    einsum_tensor<T> einsum_alloc(std::string const &labels, einsum_extents const &ext) {
+      auto t   = einsum_tensor<T>{};
+      t.dims   = einsum_packed_dims(labels, ext);
+      t.buffer = array<T, 1>::zeros(std::accumulate(t.dims.lengths.begin(), t.dims.lengths.end(), 1l, std::multiplies<>{}));
+      t.data   = t.buffer.data();
+      return t;
+    }
+
+    // Add a tensor to a zero-initialized destination whose labels are a subset of the labels of the tensor (all other
+    // labels are summed over).
+    template <typename T>
+    void einsum_sum_into(einsum_tensor<T> const &t, einsum_dims const &dst_dims, T *dst) {
+      auto dstr = std::vector<long>(t.dims.labels.size());
+      for (size_t i = 0; i < dstr.size(); ++i) dstr[i] = dst_dims.stride(t.dims.labels[i]);
+      einsum_for_each(t.dims.lengths, t.data, t.dims.strides, dst, dstr, [](T &d, T const &s) { d += s; });
+    }
+
+    // Copy a tensor into a zero-initialized tensor in C order with the given labels (other labels are summed over).
+    template <typename T>
+    einsum_tensor<T> einsum_pack(einsum_tensor<T> const &t, std::string const &labels, einsum_extents const &ext) {
+      auto res = einsum_alloc<T>(labels, ext);
+      einsum_sum_into(t, res.dims, res.buffer.data());
+      return res;
+    }
+
+    // Compute c(bat, m, n) = sum_k a(bat, m, k) * b(bat, k, n), where c is zero-initialized and the batch labels bat,
+    // the row labels m, the column labels n and the contracted labels k are determined from the labels of a, b and c.
+    // The tensors are viewed as strided batches of matrices without copying them whenever possible. Otherwise, they
+    // are permuted into a temporary tensor in C order.
+    template <typename T>
+    void einsum_contract(einsum_tensor<T> const &a, einsum_tensor<T> const &b, einsum_dims const &c, T *c_data, einsum_extents const &ext) {
+      auto in = [](einsum_dims const &d, char x) { return d.labels.find(x) != std::string::npos; };
+      auto ln = [&](std::string const &grp) {
+        return std::accumulate(grp.begin(), grp.end(), 1l, [&](long p, char x) { return p * ext[x]; });
+      };
+
+      // classify the labels
+      std::string bat, m, n, k;
+      for (char x : c.labels) (in(a.dims, x) and in(b.dims, x) ? bat : (in(a.dims, x) ? m : n)) += x;
+      for (char x : a.dims.labels)
+        if (in(b.dims, x) and not in(c, x)) k += x;
+      long nb = ln(bat), M = ln(m), N = ln(n), K = ln(k);
+      if (nb * M * N == 0 or K == 0) return;
+
+      // order the labels within the groups such that c and a can be viewed as matrices
+      bat = einsum_sorted(bat, c);
+      m   = einsum_sorted(m, c);
+      n   = einsum_sorted(n, c);
+      k   = einsum_sorted(k, a.dims);
+      auto mc = einsum_as_matrices(c, bat, m, n);
+      if (not mc) {
+        bat = einsum_sorted(bat, a.dims);
+        m   = einsum_sorted(m, a.dims);
+        n   = einsum_sorted(n, b.dims);
+      }
+      auto ma = einsum_as_matrices(a.dims, bat, m, k);
+      if (not ma) k = einsum_sorted(k, b.dims);
+
+      // permute a and/or b if they cannot be viewed as matrices
+      auto a_tmp = std::optional<einsum_tensor<T>>{};
+      auto b_tmp = std::optional<einsum_tensor<T>>{};
+      if (not(ma = einsum_as_matrices(a.dims, bat, m, k))) {
+        a_tmp = einsum_pack(a, bat + m + k, ext);
+        ma    = einsum_as_matrices(a_tmp->dims, bat, m, k);
+      }
+      auto mb = einsum_as_matrices(b.dims, bat, k, n);
+      if (not mb) {
+        b_tmp = einsum_pack(b, bat + k + n, ext);
+        mb    = einsum_as_matrices(b_tmp->dims, bat, k, n);
+      }
+      T const *pa = (a_tmp ? a_tmp->data : a.data);
+      T const *pb = (b_tmp ? b_tmp->data : b.data);
+
+      // compute the result in a temporary tensor if c cannot be viewed as matrices
+      auto c_tmp = std::optional<einsum_tensor<T>>{};
+      if (not(mc = einsum_as_matrices(c, bat, m, n))) {
+        c_tmp = einsum_alloc<T>(bat + m + n, ext);
+        mc    = einsum_as_matrices(c_tmp->dims, bat, m, n);
+      }
+      T *pc = (c_tmp ? c_tmp->buffer.data() : c_data);
+
+      // call gemm or gemm_batch_strided (if c is row-major, compute its transpose c^T = b^T a^T)
+      auto [sa, op_a, lda] = *ma;
+      auto [sb, op_b, ldb] = *mb;
+      auto [sc, op_c, ldc] = *mc;
+      auto flip            = [](char op) { return (op == 'N' ? 'T' : 'N'); };
+      auto gemm            = [&](char op_x, char op_y, long r, long s, T const *x, long ldx, long sx, T const *y, long ldy, long sy) {
+        if (nb == 1)
+          blas::f77::gemm(op_x, op_y, r, s, K, T{1}, x, ldx, y, ldy, T{0}, pc, ldc);
+        else
+          blas::f77::gemm_batch_strided(op_x, op_y, r, s, K, T{1}, x, ldx, sx, y, ldy, sy, T{0}, pc, ldc, sc, nb);
+      };
+      if (op_c == 'N')
+        gemm(op_a, op_b, M, N, pa, lda, sa, pb, ldb, sb);
+      else
+        gemm(flip(op_b), flip(op_a), N, M, pb, ldb, sb, pa, lda, sa);
+
+      // copy the temporary result to c
+      if (c_tmp) einsum_sum_into(*c_tmp, c, c_data);
+    }
+
+    // Get the labels of the intermediate result of a pairwise contraction: labels of a and b that are still needed,
+    // ordered as batch, row and column labels.
+    inline std::string einsum_result_labels(einsum_dims const &a, einsum_dims const &b, std::string const &needed) {
+      std::string bat, m, n;
+      for (char x : einsum_sorted(a.labels, a))
+        if (needed.find(x) != std::string::npos) (b.labels.find(x) != std::string::npos ? bat : m) += x;
+      for (char x : einsum_sorted(b.labels, b))
+        if (needed.find(x) != std::string::npos and a.labels.find(x) == std::string::npos) n += x;
+      return bat + m + n;
+    }
+
+    // Get the labels of the terms other than i and j and of the output.
+    inline std::string einsum_needed_labels(std::vector<std::string> const &terms, size_t i, size_t j, std::string const &out) {
+      auto res = out;
+      for (size_t l = 0; l < terms.size(); ++l)
+        if (l != i and l != j) res += terms[l];
+      return res;
+    }
+
+    // Get the labels of the terms i and j (each label once) which are still needed after their contraction.
+    inline std::string einsum_kept_labels(std::vector<std::string> const &terms, size_t i, size_t j, std::string const &out) {
+      auto needed = einsum_needed_labels(terms, i, j, out);
+      auto res    = std::string{};
+      for (char x : terms[i] + terms[j])
+        if (needed.find(x) != std::string::npos and res.find(x) == std::string::npos) res += x;
+      return res;
+    }
+
+    // Get the number of multiply-add operations of the contraction of the terms i and j.
+    inline double einsum_cost(std::vector<std::string> const &terms, size_t i, size_t j, einsum_extents const &ext) {
+      auto all   = terms[i] + terms[j];
+      double res = 1.0;
+      for (size_t l = 0; l < all.size(); ++l)
+        if (all.find(all[l]) == l) res *= static_cast<double>(ext[all[l]]);
+      return res;
+    }
+
+    // Find the order of the pairwise contractions which minimizes the number of multiply-add operations. All orders are
+    // tried for up to 6 terms, otherwise the cheapest pair is contracted first. After each contraction, the terms i and j
+    // are removed and the result is appended to the list of terms (as in numpy). Returns the total cost.
+    inline double einsum_path(std::vector<std::string> const &terms, std::string const &out, einsum_extents const &ext,
+                              std::vector<std::pair<size_t, size_t>> &path) {
+      if (terms.size() <= 1) return 0.0;
+      bool const optimal = (terms.size() <= 6);
+
+      // terms after the contraction of i and j
+      auto contracted = [&](size_t i, size_t j) {
+        auto res = std::vector<std::string>{};
+        for (size_t l = 0; l < terms.size(); ++l)
+          if (l != i and l != j) res.push_back(terms[l]);
+        res.push_back(einsum_kept_labels(terms, i, j, out));
+        return res;
+      };
+
+      // try all pairs (and all subsequent orders if optimal)
+      double best = std::numeric_limits<double>::infinity();
+      for (size_t i = 0; i < terms.size(); ++i) {
+        for (size_t j = i + 1; j < terms.size(); ++j) {
+          auto rest   = std::vector<std::pair<size_t, size_t>>{};
+          double cost = einsum_cost(terms, i, j, ext);
+          if (optimal) cost += einsum_path(contracted(i, j), out, ext, rest);
+          if (cost < best) {
+            best = cost;
+            path = {{i, j}};
+            path.insert(path.end(), rest.begin(), rest.end());
+          }
+        }
+      }
+
+      // continue with the cheapest pair if not optimal
+      if (not optimal) {
+        auto rest = std::vector<std::pair<size_t, size_t>>{};
+        best += einsum_path(contracted(path[0].first, path[0].second), out, ext, rest);
+        path.insert(path.end(), rest.begin(), rest.end());
+      }
+      return best;
+    }
+
+    // Contract the given tensors into the zero-initialized result.
+    template <typename T>
+    void einsum_impl(std::vector<einsum_tensor<T>> ops, std::string const &out, einsum_extents const &ext, einsum_dims const &res_dims, T *res) {
+      // sum over labels which occur only in a single operand and not in the output
+      for (size_t i = 0; i < ops.size(); ++i) {
+        auto terms = std::vector<std::string>{};
+        for (auto const &op : ops) terms.push_back(op.dims.labels);
+        auto needed = einsum_needed_labels(terms, i, i, out);
+        auto kept   = std::string{};
+        for (char x : ops[i].dims.labels)
+          if (needed.find(x) != std::string::npos) kept += x;
+        if (kept.size() < ops[i].dims.labels.size()) ops[i] = einsum_pack(ops[i], kept, ext);
+      }
+      if (ops.size() == 1) {
+        einsum_sum_into(ops[0], res_dims, res);
+        return;
+      }
+
+      // contract pairs of tensors in the optimal order
+      auto terms = std::vector<std::string>{};
+      for (auto const &op : ops) terms.push_back(op.dims.labels);
+      auto path = std::vector<std::pair<size_t, size_t>>{};
+      einsum_path(terms, out, ext, path);
+      for (auto [i, j] : path) {
+        if (ops.size() == 2) {
+          einsum_contract(ops[i], ops[j], res_dims, res, ext);
+          return;
+        }
+        terms.clear();
+        for (auto const &op : ops) terms.push_back(op.dims.labels);
+        auto labels = einsum_result_labels(ops[i].dims, ops[j].dims, einsum_needed_labels(terms, i, j, out));
+        auto c      = einsum_alloc<T>(labels, ext);
+        einsum_contract(ops[i], ops[j], c.dims, c.buffer.data(), ext);
+        ops.erase(ops.begin() + j);
+        ops.erase(ops.begin() + i);
+        ops.push_back(std::move(c));
+      }
+    }
+
+    // Make an einsum tensor from an operand. Repeated labels refer to the diagonal of the corresponding dimensions.
+    template <typename T, typename A>
+    einsum_tensor<T> einsum_operand(std::string_view term, A const &a, einsum_extents &ext) {
+      auto t        = einsum_tensor<T>{};
+      auto set_dims = [&t](auto const &x) {
+        for (int d = 0; d < get_rank<A>; ++d) {
+          t.dims.lengths.push_back(x.extent(d));
+          t.dims.strides.push_back(x.indexmap().strides()[d]);
+        }
+      };
+      if constexpr (MemoryArray<A>) {
+        static_assert(mem::on_host<A>, "Error in nda::einsum: Only arrays on the host are supported");
+        set_dims(a);
+        t.data = a.data();
+      } else {
+        auto r = make_regular(a);
+        set_dims(r);
+        t.buffer = flatten(std::move(r));
+        t.data   = t.buffer.data();
+      }
+
+      // merge repeated labels and check the extents
+      auto dims = einsum_dims{};
+      for (size_t d = 0; d < term.size(); ++d) {
+        char x = term[d];
+        if (ext[x] >= 0 and ext[x] != t.dims.lengths[d])
+          NDA_RUNTIME_ERROR << "Error in nda::einsum: Inconsistent extents for label " << x << ": " << ext[x] << " != " << t.dims.lengths[d];
+        ext[x] = t.dims.lengths[d];
+        if (auto p = dims.labels.find(x); p != std::string::npos) {
+          dims.strides[p] += t.dims.strides[d];
+        } else {
+          dims.labels += x;
+          dims.lengths.push_back(t.dims.lengths[d]);
+          dims.strides.push_back(t.dims.strides[d]);
+        }
+      }
+      t.dims = std::move(dims);
+      return t;
+    }
+
+  } // namespace detail
+
+  /**
+   * @addtogroup linalg_tools
+   * @{
+   */
+
+  /**
+   * @brief Contract arrays according to the given einsum subscripts.
+   *
+   * @details The subscripts (see nda::einsum_subscripts) label the dimensions of each operand. Labels occurring in
+   * several operands refer to the same index, labels occurring twice in the same operand to a diagonal, and all labels
+   * which do not occur in the output are summed over, e.g.
+   *
+   * @code{.cpp}
+   * auto C  = nda::einsum<"ijk,kjl->il">(A, B);    // C(i, l) = sum_jk A(i, j, k) B(k, j, l)
+   * auto D  = nda::einsum<"bij,bjk->bik">(X, Y);   // batched matrix product
+   * auto E  = nda::einsum<"ij,jk,kl->il">(P, Q, R); // matrix chain
+   * auto tr = nda::einsum<"ii">(M);                // trace (a scalar)
+   * @endcode
+   *
+   * Each pairwise contraction is lowered to a single BLAS `gemm` call (or `gemm_batch_strided` if there are labels
+   * which occur in both operands and in the result): the labels are grouped into batch, row, column and contracted
+   * labels, and each group is merged into a single strided dimension. The operands are only copied (permuted) if their
+   * strides do not allow such a view, e.g. no copy is needed for a rank-3 array in C or Fortran order whose contracted
+   * dimensions are adjacent. For more than two operands, the order of the pairwise contractions is chosen to minimize
+   * the number of operations.
+   *
+   * Lazy expressions are evaluated before the contraction.
+   *
+   * @tparam S Einsum subscripts given as a string literal.
+   * @tparam A0 nda::Array type of the first operand.
+   * @tparam As nda::Array types of the other operands.
+   * @param a0 First operand.
+   * @param as Other operands.
+   * @return nda::array in C order containing the result or a scalar if the output term is empty.
+   */
+  template <einsum_subscripts S, Array A0, Array... As>
+    requires(have_same_value_type_v<A0, As...> and is_blas_lapack_v<get_value_t<A0>>)
+  auto einsum(A0 const &a0, As const &...as) {
+    static_assert(detail::einsum_is_valid(S.view(), 1 + sizeof...(As)), "Error in nda::einsum: Invalid subscripts");
+    static_assert(detail::einsum_ranks_match<A0, As...>(S.view()), "Error in nda::einsum: Number of labels does not match the rank of an operand");
+    using T          = get_value_t<A0>;
+    constexpr long R = detail::einsum_output_rank(S.view());
+
+    // make the tensors and the result
+    auto ext = detail::einsum_extents{};
+    ext.fill(-1);
+    auto ops = std::vector<detail::einsum_tensor<T>>{};
+    long i   = 0;
+    ops.push_back(detail::einsum_operand<T>(detail::einsum_term(S.view(), i++), a0, ext));
+    (ops.push_back(detail::einsum_operand<T>(detail::einsum_term(S.view(), i++), as, ext)), ...);
+    auto out      = detail::einsum_output(S.view());
+    auto res_dims = detail::einsum_packed_dims(out, ext);
+
+    if constexpr (R == 0) {
+      auto res = T{0};
+      detail::einsum_impl(std::move(ops), out, ext, res_dims, &res);
+      return res;
+    } else {
+      auto shape = std::array<long, R>{};
+      std::copy(res_dims.lengths.begin(), res_dims.lengths.end(), shape.begin());
+      auto res = array<T, R>::zeros(shape);
+      detail::einsum_impl(std::move(ops), out, ext, res_dims, res.data());
+      return res;
+    }
+  }
+
+  /** @} */
+
+} // namespace nda
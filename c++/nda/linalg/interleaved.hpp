@@ -0,0 +1,421 @@
+// Copyright (c) 2024 Simons Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file
+ * @brief Provides batch kernels for tiny matrices stored in an interleaved (structure-of-arrays) layout.
+ */
+
+#pragma once
+
+#include "../basic_array.hpp"
+#include "../concepts.hpp"
+#include "../declarations.hpp"
+#include "../exceptions.hpp"
+#include "../layout/range.hpp"
+#include "../macros.hpp"
+#include "../traits.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <limits>
+#include <utility>
+
+namespace nda::linalg {
+
+  /**
+   * @ingroup linalg_tools
+   * @brief Batch of tiny n-by-n matrices stored in an interleaved (structure-of-arrays) layout.
+   *
+   * @details For a batch of m matrices \f$ \mathbf{A}_b \f$, the element \f$ (\mathbf{A}_b)_{ij} \f$ is stored at
+   * position `(i, j, b)` of a contiguous rank-3 array of shape `(n, n, m)`, i.e. the same element of all matrices is
+   * contiguous in memory. All kernels loop over the matrices in their innermost loop and perform the same operations on
+   * each of them, so that the compiler can vectorize them and process 4 or 8 matrices per SIMD instruction. This avoids
+   * the per-call overhead of LAPACK, which dominates for matrices up to about 8-by-8 (see nda::inverse_batch_in_place
+   * for larger matrices).
+   *
+   * Pivoting decisions are taken per matrix, so that the kernels are as stable as the corresponding LAPACK routines
+   * with partial pivoting.
+   *
+   * Conversions from and to the usual stack layout `a(b, _, _)` are done by the constructor and
+   * nda::linalg::interleaved_matrices::to_stack.
+   *
+   * @tparam T Value type of the matrices (double or std::complex<double>).
+   */
+  template <typename T>
+    requires(is_blas_lapack_v<T>)
+  class interleaved_matrices {
+    // Size of the matrices.
+    long n_ = 0;
+
+    // Number of matrices.
+    long m_ = 0;
+
+    // Interleaved storage of shape (n, n, m).
+    array<T, 3> data_;
+
+    // Number of matrices which are processed together, such that their elements fit into the L1 cache.
+    static constexpr long block_size = 64;
+
+    // Pointer to the elements (i, j) of all matrices in an interleaved array with the same shape as data_.
+    [[nodiscard]] T *lane(array<T, 3> &x, long i, long j) const { return x.data() + (i * n_ + j) * m_; }
+
+    // Squared absolute value used for pivoting.
+    static double abs2(T const &x) { return std::norm(x); }
+
+    // Find the pivot rows piv[b] >= k in column k of the matrices b0, ..., b1 - 1 in x (pmax[b] is set to the squared
+    // absolute value of the pivot).
+    void find_pivots(array<T, 3> &x, long k, long *piv, double *pmax, long b0, long b1) const {
+      T *xkk = lane(x, k, k);
+      for (long b = b0; b < b1; ++b) {
+        piv[b]  = k;
+        pmax[b] = abs2(xkk[b]);
+      }
+      for (long i = k + 1; i < n_; ++i) {
+        T *xik = lane(x, i, k);
+        for (long b = b0; b < b1; ++b) {
+          double a2   = abs2(xik[b]);
+          bool larger = a2 > pmax[b];
+          pmax[b]     = (larger ? a2 : pmax[b]);
+          piv[b]      = (larger ? i : piv[b]);
+        }
+      }
+    }
+
+    // Interchange the elements a(b) and c(i)(b) of all matrices for which piv[b] == i (i = k + 1, ..., n - 1), where
+    // c(i) is a pointer to lane i. The interchanges are done with selects, so that the loops can be vectorized.
+    template <typename C>
+    void swap_lanes(T *a, C const &c, long k, long const *piv, long b0, long b1) const {
+      for (long i = k + 1; i < n_; ++i) {
+        T *ci = c(i);
+        for (long b = b0; b < b1; ++b) {
+          bool sw = (piv[b] == i);
+          T tmp   = a[b];
+          a[b]    = (sw ? ci[b] : tmp);
+          ci[b]   = (sw ? tmp : ci[b]);
+        }
+      }
+    }
+
+    // Gaussian elimination with partial pivoting of the matrices in x (destroyed), applying the same row interchanges
+    // and eliminations to the right hand sides in rhs (shape (n, nrhs, m)). The solutions are written to rhs, the
+    // determinants are returned.
+    array<T, 1> eliminate(array<T, 3> &x, array<T, 3> &rhs) const {
+      long const nrhs = rhs.extent(1);
+      auto det        = array<T, 1>(m_);
+      auto piv_arr    = array<long, 1>(m_);
+      auto pmax_arr   = array<double, 1>(m_);
+      auto f_arr      = array<T, 1>(m_);
+      det             = T{1};
+      T *d            = det.data();
+      T *f            = f_arr.data();
+      long *piv       = piv_arr.data();
+      auto rhs_lane   = [&](long i, long r) { return rhs.data() + (i * nrhs + r) * m_; };
+
+      // process the matrices in blocks
+      for (long b0 = 0; b0 < m_; b0 += block_size) {
+        long const b1 = std::min(m_, b0 + block_size);
+        for (long k = 0; k < n_; ++k) {
+          // find the pivot rows and interchange the rows
+          find_pivots(x, k, piv, pmax_arr.data(), b0, b1);
+          for (long j = 0; j < n_; ++j) swap_lanes(lane(x, k, j), [&](long i) { return lane(x, i, j); }, k, piv, b0, b1);
+          for (long r = 0; r < nrhs; ++r) swap_lanes(rhs_lane(k, r), [&](long i) { return rhs_lane(i, r); }, k, piv, b0, b1);
+          T *xkk = lane(x, k, k);
+          for (long b = b0; b < b1; ++b) d[b] *= (piv[b] == k ? xkk[b] : -xkk[b]);
+
+          // eliminate the entries below the pivot (singular matrices are skipped)
+          for (long i = k + 1; i < n_; ++i) {
+            T *xik = lane(x, i, k);
+            for (long b = b0; b < b1; ++b) f[b] = (xkk[b] == T{0} ? T{0} : xik[b] / xkk[b]);
+            for (long j = k + 1; j < n_; ++j) {
+              T *xij = lane(x, i, j), *xkj = lane(x, k, j);
+              for (long b = b0; b < b1; ++b) xij[b] -= f[b] * xkj[b];
+            }
+            for (long r = 0; r < nrhs; ++r) {
+              T *ri = rhs_lane(i, r), *rk = rhs_lane(k, r);
+              for (long b = b0; b < b1; ++b) ri[b] -= f[b] * rk[b];
+            }
+          }
+        }
+
+        // back substitution
+        for (long r = 0; r < nrhs; ++r) {
+          for (long i = n_ - 1; i >= 0; --i) {
+            T *ri = rhs_lane(i, r);
+            for (long j = i + 1; j < n_; ++j) {
+              T *xij = lane(x, i, j), *rj = rhs_lane(j, r);
+              for (long b = b0; b < b1; ++b) ri[b] -= xij[b] * rj[b];
+            }
+            T *xii = lane(x, i, i);
+            for (long b = b0; b < b1; ++b) ri[b] /= xii[b];
+          }
+        }
+      }
+
+      return det;
+    }
+
+    public:
+    /**
+     * @brief Construct an uninitialized batch.
+     * @param n Size of the matrices.
+     * @param m Number of matrices.
+     */
+    interleaved_matrices(long n, long m) : n_(n), m_(m), data_(n, n, m) {}
+
+    /**
+     * @brief Construct a batch from a stack of matrices `a(b, _, _)`.
+     *
+     * @tparam A nda::ArrayOfRank<3> type.
+     * @param a Stack of square matrices.
+     */
+    template <ArrayOfRank<3> A>
+    explicit interleaved_matrices(A const &a) : interleaved_matrices(a.extent(1), a.extent(0)) {
+      EXPECTS(a.extent(1) == a.extent(2));
+      for (long b0 = 0; b0 < m_; b0 += block_size) {
+        long const b1 = std::min(m_, b0 + block_size);
+        for (long i = 0; i < n_; ++i) {
+          for (long j = 0; j < n_; ++j) {
+            T *xij = lane(data_, i, j);
+            for (long b = b0; b < b1; ++b) xij[b] = a(b, i, j);
+          }
+        }
+      }
+    }
+
+    /**
+     * @brief Get the size of the matrices.
+     * @return Number of rows/columns of the matrices.
+     */
+    [[nodiscard]] long dim() const { return n_; }
+
+    /**
+     * @brief Get the number of matrices.
+     * @return Number of matrices in the batch.
+     */
+    [[nodiscard]] long size() const { return m_; }
+
+    /**
+     * @brief Get the interleaved storage.
+     * @return Const reference to the rank-3 array of shape `(n, n, m)`.
+     */
+    [[nodiscard]] array<T, 3> const &data() const { return data_; }
+
+    /**
+     * @brief Convert the batch to the stack layout.
+     * @return Rank-3 array `a` of shape `(m, n, n)` with the matrices `a(b, _, _)`.
+     */
+    [[nodiscard]] array<T, 3> to_stack() const {
+      auto a = array<T, 3>(m_, n_, n_);
+      T const *x    = data_.data();
+      T *y          = a.data();
+      long const nn = n_ * n_;
+      for (long b0 = 0; b0 < m_; b0 += block_size) {
+        long const b1 = std::min(m_, b0 + block_size);
+        for (long ij = 0; ij < nn; ++ij)
+          for (long b = b0; b < b1; ++b) y[b * nn + ij] = x[ij * m_ + b];
+      }
+      return a;
+    }
+
+    /**
+     * @brief Compute the determinants of all matrices.
+     * @details It uses Gaussian elimination with partial pivoting on a copy of the matrices.
+     * @return Rank-1 array containing the determinants.
+     */
+    [[nodiscard]] array<T, 1> determinant() const {
+      auto x   = data_;
+      auto rhs = array<T, 3>(n_, 0, m_);
+      return eliminate(x, rhs);
+    }
+
+    /**
+     * @brief Solve the linear systems \f$ \mathbf{A}_b \mathbf{x}_b = \mathbf{y}_b \f$ for all matrices.
+     *
+     * @details It uses Gaussian elimination with partial pivoting on a copy of the matrices. It throws an exception if
+     * any of the matrices is singular.
+     *
+     * @tparam Y nda::ArrayOfRank<2> type.
+     * @param y Right hand sides in stack layout, i.e. \f$ \mathbf{y}_b \f$ = `y(b, _)`.
+     * @return Rank-2 array `x` of shape `(m, n)` with the solutions \f$ \mathbf{x}_b \f$ = `x(b, _)`.
+     */
+    template <ArrayOfRank<2> Y>
+    [[nodiscard]] array<T, 2> solve(Y const &y) const {
+      EXPECTS(y.extent(0) == m_ and y.extent(1) == n_);
+      auto x   = data_;
+      auto rhs = array<T, 3>(n_, 1, m_);
+      for (long i = 0; i < n_; ++i)
+        for (long b = 0; b < m_; ++b) rhs(i, 0, b) = y(b, i);
+      auto det = eliminate(x, rhs);
+      for (long b = 0; b < m_; ++b)
+        if (det(b) == T{0}) NDA_RUNTIME_ERROR << "Error in nda::linalg::interleaved_matrices::solve: Matrix " << b << " is singular";
+
+      auto res = array<T, 2>(m_, n_);
+      for (long b = 0; b < m_; ++b)
+        for (long i = 0; i < n_; ++i) res(b, i) = rhs(i, 0, b);
+      return res;
+    }
+
+    /**
+     * @brief Invert all matrices in place.
+     *
+     * @details It uses Gauss-Jordan elimination with partial pivoting. It throws an exception if any of the matrices is
+     * singular.
+     */
+    void invert() {
+      auto piv_arr  = array<long, 2>(n_, m_);
+      auto pmax_arr = array<double, 1>(m_);
+      auto d_arr    = array<T, 1>(m_);
+      double *pmax  = pmax_arr.data();
+      T *d          = d_arr.data();
+
+      // process the matrices in blocks
+      for (long b0 = 0; b0 < m_; b0 += block_size) {
+        long const b1 = std::min(m_, b0 + block_size);
+        for (long k = 0; k < n_; ++k) {
+          // find the pivot rows and interchange the rows
+          long *piv = piv_arr.data() + k * m_;
+          find_pivots(data_, k, piv, pmax, b0, b1);
+          for (long b = b0; b < b1; ++b)
+            if (pmax[b] == 0.0) NDA_RUNTIME_ERROR << "Error in nda::linalg::interleaved_matrices::invert: Matrix " << b << " is singular";
+          for (long j = 0; j < n_; ++j) swap_lanes(lane(data_, k, j), [&](long i) { return lane(data_, i, j); }, k, piv, b0, b1);
+
+          // scale the pivot row
+          T *xkk = lane(data_, k, k);
+          for (long b = b0; b < b1; ++b) {
+            d[b]   = T{1} / xkk[b];
+            xkk[b] = T{1};
+          }
+          for (long j = 0; j < n_; ++j) {
+            T *xkj = lane(data_, k, j);
+            for (long b = b0; b < b1; ++b) xkj[b] *= d[b];
+          }
+
+          // eliminate the column in all other rows
+          for (long i = 0; i < n_; ++i) {
+            if (i == k) continue;
+            T *xik = lane(data_, i, k);
+            for (long b = b0; b < b1; ++b) {
+              d[b]   = xik[b];
+              xik[b] = T{0};
+            }
+            for (long j = 0; j < n_; ++j) {
+              T *xij = lane(data_, i, j), *xkj = lane(data_, k, j);
+              for (long b = b0; b < b1; ++b) xij[b] -= d[b] * xkj[b];
+            }
+          }
+        }
+
+        // undo the row interchanges by interchanging the columns in reverse order
+        for (long k = n_ - 1; k >= 0; --k) {
+          long *piv = piv_arr.data() + k * m_;
+          for (long i = 0; i < n_; ++i) swap_lanes(lane(data_, i, k), [&](long j) { return lane(data_, i, j); }, k, piv, b0, b1);
+        }
+      }
+    }
+
+    /**
+     * @brief Find the eigenvalues and eigenvectors of all matrices, which are assumed to be real symmetric.
+     *
+     * @details It uses the cyclic Jacobi method, which applies the same sequence of plane rotations to all matrices and
+     * iterates until all of them are diagonal to machine precision.
+     *
+     * @return std::pair consisting of a rank-2 array `ev` and a rank-3 array `vecs` in stack layout, where `ev(b, _)`
+     * contains the eigenvalues of the b-th matrix in ascending order and the columns of `vecs(b, _, _)` the
+     * corresponding eigenvectors.
+     */
+    [[nodiscard]] std::pair<array<double, 2>, array<T, 3>> eigenelements() const
+      requires(not is_complex_v<T>)
+    {
+      auto a = data_;
+      auto v = array<T, 3>(n_, n_, m_);
+      v      = 0.0;
+      for (long i = 0; i < n_; ++i) v(i, i, range::all) = 1.0;
+
+      // cyclic Jacobi sweeps (block by block) until the off-diagonal parts of all matrices are negligible
+      auto c_arr = array<double, 1>(m_), s_arr = array<double, 1>(m_);
+      double *c = c_arr.data(), *s = s_arr.data();
+      constexpr double eps2 = std::numeric_limits<double>::epsilon() * std::numeric_limits<double>::epsilon();
+      for (long b0 = 0; b0 < m_; b0 += block_size) {
+        long const b1 = std::min(m_, b0 + block_size);
+        for (int sweep = 0; sweep < 50; ++sweep) {
+          bool converged = true;
+          for (long b = b0; b < b1 and converged; ++b) {
+            double off = 0.0, tot = 0.0;
+            for (long i = 0; i < n_; ++i) {
+              for (long j = 0; j < n_; ++j) {
+                double x2 = a(i, j, b) * a(i, j, b);
+                tot += x2;
+                if (i != j) off += x2;
+              }
+            }
+            converged = (off <= eps2 * tot);
+          }
+          if (converged) break;
+
+          for (long p = 0; p < n_; ++p) {
+            for (long q = p + 1; q < n_; ++q) {
+              // rotation angles which annihilate the elements (p, q)
+              T *app = lane(a, p, p), *aqq = lane(a, q, q), *apq = lane(a, p, q);
+              for (long b = b0; b < b1; ++b) {
+                double theta = (apq[b] == 0.0 ? 0.0 : (aqq[b] - app[b]) / (2.0 * apq[b]));
+                double t     = (apq[b] == 0.0 ? 0.0 : std::copysign(1.0, theta) / (std::abs(theta) + std::sqrt(theta * theta + 1.0)));
+                c[b]         = 1.0 / std::sqrt(t * t + 1.0);
+                s[b]         = t * c[b];
+              }
+
+              // apply the rotations to the columns and rows of the matrices and to the eigenvectors
+              for (long k = 0; k < n_; ++k) {
+                T *akp = lane(a, k, p), *akq = lane(a, k, q), *vkp = lane(v, k, p), *vkq = lane(v, k, q);
+                for (long b = b0; b < b1; ++b) {
+                  double x = akp[b], y = akq[b];
+                  akp[b]   = c[b] * x - s[b] * y;
+                  akq[b]   = s[b] * x + c[b] * y;
+                  x        = vkp[b];
+                  y        = vkq[b];
+                  vkp[b]   = c[b] * x - s[b] * y;
+                  vkq[b]   = s[b] * x + c[b] * y;
+                }
+              }
+              for (long k = 0; k < n_; ++k) {
+                T *apk = lane(a, p, k), *aqk = lane(a, q, k);
+                for (long b = b0; b < b1; ++b) {
+                  double x = apk[b], y = aqk[b];
+                  apk[b]   = c[b] * x - s[b] * y;
+                  aqk[b]   = s[b] * x + c[b] * y;
+                }
+              }
+            }
+          }
+        }
+      }
+
+      // sort the eigenvalues and eigenvectors and convert them to the stack layout
+      auto ev   = array<double, 2>(m_, n_);
+      auto vecs = array<T, 3>(m_, n_, n_);
+      auto idx  = array<long, 1>(n_);
+      for (long b = 0; b < m_; ++b) {
+        for (long i = 0; i < n_; ++i) idx(i) = i;
+        std::sort(idx.begin(), idx.end(), [&](long i, long j) { return a(i, i, b) < a(j, j, b); });
+        for (long j = 0; j < n_; ++j) {
+          ev(b, j) = a(idx(j), idx(j), b);
+          for (long i = 0; i < n_; ++i) vecs(b, i, j) = v(i, idx(j), b);
+        }
+      }
+      return {ev, vecs};
+    }
+  };
+
+} // namespace nda::linalg
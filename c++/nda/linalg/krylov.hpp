@@ -0,0 +1,519 @@
+// Copyright (c) 2024 Simons Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+/**
+ * @file
+ * @brief Provides matrix-free Krylov subspace solvers (CG, MINRES and GMRES) for linear systems.
+ */
+
+#pragma once
+
+#include "../basic_array.hpp"
+#include "../blas/axpy.hpp"
+#include "../blas/dot.hpp"
+#include "../blas/gemv.hpp"
+#include "../blas/scal.hpp"
+#include "../concepts.hpp"
+#include "../declarations.hpp"
+#include "../layout/policies.hpp"
+#include "../layout/range.hpp"
+#include "../macros.hpp"
+#include "../mapped_functions.hpp"
+#include "../mem/address_space.hpp"
+#include "../traits.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+namespace nda::linalg {
+
+  namespace detail {
+
+    // Preconditioner which does nothing (the solvers skip its application).
+    struct identity_preconditioner {};
+
+    // Compute y = op(x) either in place with op(x, y) or by assigning the return value of op(x).
+    template <typename Op, typename X, typename Y>
+    void apply_op(Op &op, X const &x, Y &&y) {
+      if constexpr (std::is_same_v<std::remove_cvref_t<Op>, identity_preconditioner>)
+        y = x;
+      else if constexpr (std::is_invocable_v<Op &, X const &, Y &>)
+        op(x, y);
+      else
+        y = op(x);
+    }
+
+    // Euclidean norm of a vector.
+    template <typename X>
+    double nrm2(X const &x) {
+      return std::sqrt(std::real(blas::dotc(x, x)));
+    }
+
+    // Check the arguments of the Krylov solvers and return the norm of the right hand side.
+    template <typename B, typename X>
+    double check_krylov_args(B const &b, X const &x, const char *fname) {
+      if (b.size() != x.size()) NDA_RUNTIME_ERROR << "Error in nda::linalg::" << fname << ": Size mismatch: " << b.size() << " != " << x.size();
+      return nrm2(b);
+    }
+
+  } // namespace detail
+
+  /**
+   * @addtogroup linalg_tools
+   * @{
+   */
+
+  /// Convergence information returned by the Krylov solvers.
+  struct krylov_info {
+    /// Number of iterations, i.e. applications of the operator (not counting the computation of initial residuals).
+    long iterations = 0;
+
+    /// Final relative residual \f$ \|\mathbf{b} - \mathbf{A x}\| / \|\mathbf{b}\| \f$ (see the solvers for details).
+    double residual = 0.0;
+
+    /// True if the relative residual is below the requested tolerance.
+    bool converged = false;
+  };
+
+  /**
+   * @brief Worker class for the preconditioned conjugate gradient (CG) method.
+   *
+   * @details Solves \f$ \mathbf{A x} = \mathbf{b} \f$ for a hermitian positive definite operator \f$ \mathbf{A} \f$.
+   *
+   * The operator and the preconditioner are arbitrary callables acting on vectors with value type `T`. They are either
+   * called in place as `op(x, y)` to compute \f$ \mathbf{y} = \mathbf{A x} \f$ or as `y = op(x)`. Only the former
+   * avoids temporary vectors. The preconditioner applies an approximation of \f$ \mathbf{A}^{-1} \f$ and has to be
+   * hermitian positive definite as well.
+   *
+   * The worker owns the residual and search direction vectors, i.e. no memory is allocated inside the iteration loop
+   * and none at all in repeated calls with the same problem size.
+   *
+   * @tparam T Value type of the vectors (double or std::complex<double>).
+   */
+  template <typename T>
+    requires(is_blas_lapack_v<T>)
+  class cg_worker {
+    // Residual, preconditioned residual, search direction and A times the search direction.
+    vector<T> r_, z_, p_, q_;
+
+    public:
+    /**
+     * @brief Solve the linear system.
+     *
+     * @details The iteration stops if \f$ \|\mathbf{r}\| \leq \mathrm{tol} \|\mathbf{b}\| \f$, where
+     * \f$ \mathbf{r} \f$ is the (recursively updated) residual.
+     *
+     * @tparam Op Callable type of the operator.
+     * @tparam B nda::MemoryVector type.
+     * @tparam X nda::MemoryVector type.
+     * @tparam P Callable type of the preconditioner.
+     * @param a Operator \f$ \mathbf{A} \f$.
+     * @param b Right hand side \f$ \mathbf{b} \f$.
+     * @param x Input/output vector. On entry, the initial guess. On exit, the approximate solution.
+     * @param tol Relative tolerance.
+     * @param max_iter Maximum number of iterations.
+     * @param p Preconditioner (default: none).
+     * @return nda::linalg::krylov_info.
+     */
+    template <typename Op, MemoryVector B, MemoryVector X, typename P = detail::identity_preconditioner>
+      requires(mem::on_host<B, X> and have_same_value_type_v<B, X> and std::is_same_v<get_value_t<B>, T>)
+    krylov_info operator()(Op &&a, B const &b, X &&x, double tol = 1e-10, long max_iter = 1000,
+                           P &&p = {}) { // NOLINT (temporary views are allowed here)
+      double bnorm = detail::check_krylov_args(b, x, "cg");
+      if (bnorm == 0.0) {
+        x = 0;
+        return {0, 0.0, true};
+      }
+      for (auto *v : {&r_, &z_, &p_, &q_})
+        if (v->size() != b.size()) v->resize(b.size());
+
+      // r = b - A x, z = M r, p = z
+      detail::apply_op(a, x, r_);
+      blas::axpby(T{1}, b, T{-1}, r_);
+      auto res = detail::nrm2(r_) / bnorm;
+      if (res <= tol) return {0, res, true};
+      detail::apply_op(p, r_, z_);
+      p_      = z_;
+      auto rz = blas::dotc(r_, z_);
+
+      for (long k = 1; k <= max_iter; ++k) {
+        detail::apply_op(a, p_, q_);
+        auto pq = blas::dotc(p_, q_);
+        if (pq == T{0}) return {k, res, false};
+        auto alpha = rz / pq;
+        blas::axpy(alpha, p_, x);
+        blas::axpy(-alpha, q_, r_);
+        res = detail::nrm2(r_) / bnorm;
+        if (res <= tol) return {k, res, true};
+
+        detail::apply_op(p, r_, z_);
+        auto rz_new = blas::dotc(r_, z_);
+        blas::axpby(T{1}, z_, rz_new / rz, p_);
+        rz = rz_new;
+      }
+      return {max_iter, res, false};
+    }
+  };
+
+  /**
+   * @brief Worker class for the preconditioned minimal residual (MINRES) method.
+   *
+   * @details Solves \f$ \mathbf{A x} = \mathbf{b} \f$ for a hermitian, possibly indefinite operator
+   * \f$ \mathbf{A} \f$ (C. C. Paige and M. A. Saunders, SIAM J. Numer. Anal. 12, 617 (1975)). The Lanczos vectors are
+   * obtained by a three-term recurrence, i.e. only a fixed number of vectors is stored.
+   *
+   * The operator and the preconditioner are called as described in nda::linalg::cg_worker. The preconditioner has to
+   * be hermitian positive definite.
+   *
+   * The worker owns all vectors, i.e. no memory is allocated inside the iteration loop and none at all in repeated
+   * calls with the same problem size.
+   *
+   * @tparam T Value type of the vectors (double or std::complex<double>).
+   */
+  template <typename T>
+    requires(is_blas_lapack_v<T>)
+  class minres_worker {
+    // Lanczos vectors, work vector and the search directions of the last three iterations.
+    vector<T> v_, y_, r1_, r2_, w_, w1_, w2_;
+
+    public:
+    /**
+     * @brief Solve the linear system.
+     *
+     * @details The iteration stops if the residual estimate of MINRES \f$ \bar{\phi} \f$ satisfies
+     * \f$ \bar{\phi} \leq \mathrm{tol} \|\mathbf{b}\|_{\mathbf{M}} \f$, where \f$ \|\cdot\|_{\mathbf{M}} \f$ is the
+     * norm induced by the preconditioner. Without preconditioner, this is the relative residual.
+     *
+     * @tparam Op Callable type of the operator.
+     * @tparam B nda::MemoryVector type.
+     * @tparam X nda::MemoryVector type.
+     * @tparam P Callable type of the preconditioner.
+     * @param a Operator \f$ \mathbf{A} \f$.
+     * @param b Right hand side \f$ \mathbf{b} \f$.
+     * @param x Input/output vector. On entry, the initial guess. On exit, the approximate solution.
+     * @param tol Relative tolerance.
+     * @param max_iter Maximum number of iterations.
+     * @param p Preconditioner (default: none).
+     * @return nda::linalg::krylov_info.
+     */
+    template <typename Op, MemoryVector B, MemoryVector X, typename P = detail::identity_preconditioner>
+      requires(mem::on_host<B, X> and have_same_value_type_v<B, X> and std::is_same_v<get_value_t<B>, T>)
+    krylov_info operator()(Op &&a, B const &b, X &&x, double tol = 1e-10, long max_iter = 1000,
+                           P &&p = {}) { // NOLINT (temporary views are allowed here)
+      if (detail::check_krylov_args(b, x, "minres") == 0.0) {
+        x = 0;
+        return {0, 0.0, true};
+      }
+      for (auto *v : {&v_, &y_, &r1_, &r2_, &w_, &w1_, &w2_})
+        if (v->size() != b.size()) v->resize(b.size());
+
+      // M-norm of b
+      detail::apply_op(p, b, y_);
+      double bnorm = std::sqrt(std::real(blas::dotc(b, y_)));
+
+      // r1 = r2 = b - A x, y = M r1
+      detail::apply_op(a, x, r1_);
+      blas::axpby(T{1}, b, T{-1}, r1_);
+      detail::apply_op(p, r1_, y_);
+      r2_          = r1_;
+      double beta1 = std::sqrt(std::real(blas::dotc(r1_, y_)));
+      if (beta1 <= tol * bnorm) return {0, beta1 / bnorm, true};
+
+      double beta = beta1, oldb = 0.0, dbar = 0.0, epsln = 0.0, phibar = beta1, cs = -1.0, sn = 0.0;
+      w_  = 0;
+      w2_ = 0;
+      for (long k = 1; k <= max_iter; ++k) {
+        // Lanczos step: v = y / beta, y = A v - (beta / oldb) r1 - (alpha / beta) r2
+        blas::copy(y_, v_);
+        blas::scal(T(1.0 / beta), v_);
+        detail::apply_op(a, v_, y_);
+        if (k >= 2) blas::axpy(T(-beta / oldb), r1_, y_);
+        double alpha = std::real(blas::dotc(v_, y_));
+        blas::axpy(T(-alpha / beta), r2_, y_);
+        std::swap(r1_, r2_);
+        std::swap(r2_, y_);
+        detail::apply_op(p, r2_, y_);
+        oldb = beta;
+        beta = std::sqrt(std::real(blas::dotc(r2_, y_)));
+
+        // apply the previous plane rotation and compute the next one
+        double oldeps = epsln;
+        double delta  = cs * dbar + sn * alpha;
+        double gbar   = sn * dbar - cs * alpha;
+        epsln         = sn * beta;
+        dbar          = -cs * beta;
+        double gamma  = std::max(std::hypot(gbar, beta), std::numeric_limits<double>::epsilon());
+        cs            = gbar / gamma;
+        sn            = beta / gamma;
+        double phi    = cs * phibar;
+        phibar        = sn * phibar;
+
+        // update the search direction w = (v - oldeps w1 - delta w2) / gamma and the solution
+        std::swap(w1_, w2_);
+        std::swap(w2_, w_);
+        blas::copy(v_, w_);
+        blas::axpy(T(-oldeps), w1_, w_);
+        blas::axpy(T(-delta), w2_, w_);
+        blas::scal(T(1.0 / gamma), w_);
+        blas::axpy(T(phi), w_, x);
+
+        if (phibar <= tol * bnorm) return {k, phibar / bnorm, true};
+        if (beta == 0.0) return {k, phibar / bnorm, false};
+      }
+      return {max_iter, phibar / bnorm, false};
+    }
+  };
+
+  /**
+   * @brief Worker class for the restarted generalized minimal residual (GMRES) method.
+   *
+   * @details Solves \f$ \mathbf{A x} = \mathbf{b} \f$ for a general operator \f$ \mathbf{A} \f$. The Krylov basis is
+   * built by the Arnoldi process with classical Gram-Schmidt and reorthogonalization (two `gemv` calls per pass) and
+   * the method is restarted after `restart` iterations. The preconditioner is applied from the right, i.e. the
+   * residual is the one of the original system.
+   *
+   * The operator and the preconditioner are called as described in nda::linalg::cg_worker.
+   *
+   * The worker owns the Krylov basis, the Hessenberg matrix and all other vectors, i.e. no memory is allocated inside
+   * the iteration loop and none at all in repeated calls with the same problem size.
+   *
+   * @tparam T Value type of the vectors (double or std::complex<double>).
+   */
+  template <typename T>
+    requires(is_blas_lapack_v<T>)
+  class gmres_worker {
+    // Maximum dimension of the Krylov subspace before a restart.
+    long restart_;
+
+    // Krylov basis (n-by-(restart + 1)) and Hessenberg matrix ((restart + 1)-by-restart).
+    matrix<T, F_layout> v_, h_;
+
+    // Cosines and sines of the Givens rotations, rotated right hand side and Gram-Schmidt coefficients.
+    vector<double> cs_;
+    vector<T> sn_, g_, c_;
+
+    // Work vectors.
+    vector<T> r_, z_;
+
+    public:
+    /**
+     * @brief Construct a GMRES worker.
+     * @param restart Maximum dimension of the Krylov subspace before a restart.
+     */
+    explicit gmres_worker(long restart = 30) : restart_(restart) {
+      EXPECTS(restart > 0);
+      h_.resize(restart + 1, restart);
+      for (auto *v : {&sn_, &g_, &c_}) v->resize(restart + 1);
+      cs_.resize(restart + 1);
+    }
+
+    /**
+     * @brief Get the maximum dimension of the Krylov subspace before a restart.
+     * @return Restart length.
+     */
+    [[nodiscard]] long restart() const { return restart_; }
+
+    /**
+     * @brief Solve the linear system.
+     *
+     * @details The iteration stops if the residual estimate obtained from the Givens rotations satisfies
+     * \f$ \|\mathbf{r}\| \leq \mathrm{tol} \|\mathbf{b}\| \f$.
+     *
+     * @tparam Op Callable type of the operator.
+     * @tparam B nda::MemoryVector type.
+     * @tparam X nda::MemoryVector type.
+     * @tparam P Callable type of the preconditioner.
+     * @param a Operator \f$ \mathbf{A} \f$.
+     * @param b Right hand side \f$ \mathbf{b} \f$.
+     * @param x Input/output vector. On entry, the initial guess. On exit, the approximate solution.
+     * @param tol Relative tolerance.
+     * @param max_iter Maximum number of iterations (summed over all restarts).
+     * @param p Preconditioner (default: none).
+     * @return nda::linalg::krylov_info.
+     */
+    template <typename Op, MemoryVector B, MemoryVector X, typename P = detail::identity_preconditioner>
+      requires(mem::on_host<B, X> and have_same_value_type_v<B, X> and std::is_same_v<get_value_t<B>, T>)
+    krylov_info operator()(Op &&a, B const &b, X &&x, double tol = 1e-10, long max_iter = 1000,
+                           P &&p = {}) { // NOLINT (temporary views are allowed here)
+      double bnorm = detail::check_krylov_args(b, x, "gmres");
+      if (bnorm == 0.0) {
+        x = 0;
+        return {0, 0.0, true};
+      }
+      long n = b.size();
+      if (v_.extent(0) != n) v_.resize(n, restart_ + 1);
+      for (auto *v : {&r_, &z_})
+        if (v->size() != n) v->resize(n);
+
+      constexpr bool has_precond = not std::is_same_v<std::remove_cvref_t<P>, detail::identity_preconditioner>;
+      auto _                     = range::all;
+      long iter                  = 0;
+      double res                 = 0.0;
+      while (true) {
+        // r = b - A x
+        detail::apply_op(a, x, r_);
+        blas::axpby(T{1}, b, T{-1}, r_);
+        double beta = detail::nrm2(r_);
+        res         = beta / bnorm;
+        if (res <= tol) return {iter, res, true};
+        if (iter >= max_iter) return {iter, res, false};
+
+        // first basis vector and right hand side of the least squares problem
+        v_(_, 0) = r_;
+        blas::scal(T(1.0 / beta), v_(_, 0));
+        g_    = 0;
+        g_(0) = beta;
+
+        long k = 0;
+        while (k < restart_ and iter < max_iter and res > tol) {
+          ++iter;
+
+          // Arnoldi step: w = A M^{-1} v_k orthogonalized against v_0, ..., v_k (twice)
+          auto w = v_(_, k + 1);
+          if constexpr (has_precond) {
+            detail::apply_op(p, v_(_, k), z_);
+            detail::apply_op(a, z_, w);
+          } else {
+            detail::apply_op(a, v_(_, k), w);
+          }
+          auto vk = v_(_, range(k + 1));
+          auto hk = h_(range(k + 1), k);
+          auto ck = c_(range(k + 1));
+          blas::gemv(T{1}, dagger(vk), w, T{0}, hk);
+          blas::gemv(T{-1}, vk, hk, T{1}, w);
+          blas::gemv(T{1}, dagger(vk), w, T{0}, ck);
+          blas::gemv(T{-1}, vk, ck, T{1}, w);
+          hk += ck;
+          double hnext = detail::nrm2(w);
+          if (hnext > 0.0) blas::scal(T(1.0 / hnext), w);
+
+          // apply the previous Givens rotations to the new column of H and compute the next one
+          for (long i = 0; i < k; ++i) {
+            auto tmp     = cs_(i) * h_(i, k) + sn_(i) * h_(i + 1, k);
+            h_(i + 1, k) = -nda::conj(sn_(i)) * h_(i, k) + cs_(i) * h_(i + 1, k);
+            h_(i, k)     = tmp;
+          }
+          double hk_abs = std::abs(h_(k, k));
+          if (hk_abs == 0.0) {
+            cs_(k)   = 0.0;
+            sn_(k)   = T{1};
+            h_(k, k) = hnext;
+          } else {
+            double t = std::hypot(hk_abs, hnext);
+            auto ph  = h_(k, k) / hk_abs;
+            cs_(k)   = hk_abs / t;
+            sn_(k)   = ph * hnext / t;
+            h_(k, k) = ph * t;
+          }
+          h_(k + 1, k) = 0;
+          g_(k + 1)    = -nda::conj(sn_(k)) * g_(k);
+          g_(k)        = cs_(k) * g_(k);
+          res          = std::abs(g_(k + 1)) / bnorm;
+          ++k;
+          if (hnext == 0.0) break;
+        }
+
+        // solve the triangular system H y = g (y is stored in g) and update x += M^{-1} V y
+        for (long i = k - 1; i >= 0; --i) {
+          for (long j = i + 1; j < k; ++j) g_(i) -= h_(i, j) * g_(j);
+          g_(i) /= h_(i, i);
+        }
+        if constexpr (has_precond) {
+          blas::gemv(T{1}, v_(_, range(k)), g_(range(k)), T{0}, r_);
+          detail::apply_op(p, r_, z_);
+          blas::axpy(T{1}, z_, x);
+        } else {
+          blas::gemv(T{1}, v_(_, range(k)), g_(range(k)), T{1}, x);
+        }
+      }
+    }
+  };
+
+  /**
+   * @brief Solve a hermitian positive definite linear system with the preconditioned conjugate gradient method.
+   *
+   * @details See nda::linalg::cg_worker. Repeated solves should use a worker to avoid allocating its vectors.
+   *
+   * @tparam Op Callable type of the operator.
+   * @tparam B nda::MemoryVector type.
+   * @tparam X nda::MemoryVector type.
+   * @tparam P Callable type of the preconditioner.
+   * @param a Operator \f$ \mathbf{A} \f$.
+   * @param b Right hand side \f$ \mathbf{b} \f$.
+   * @param x Input/output vector. On entry, the initial guess. On exit, the approximate solution.
+   * @param tol Relative tolerance.
+   * @param max_iter Maximum number of iterations.
+   * @param p Preconditioner (default: none).
+   * @return nda::linalg::krylov_info.
+   */
+  template <typename Op, MemoryVector B, MemoryVector X, typename P = detail::identity_preconditioner>
+    requires(mem::on_host<B, X> and have_same_value_type_v<B, X> and is_blas_lapack_v<get_value_t<B>>)
+  krylov_info cg(Op &&a, B const &b, X &&x, double tol = 1e-10, long max_iter = 1000, P &&p = {}) { // NOLINT (temporary views are allowed here)
+    return cg_worker<get_value_t<B>>{}(a, b, std::forward<X>(x), tol, max_iter, p);
+  }
+
+  /**
+   * @brief Solve a hermitian linear system with the preconditioned minimal residual method.
+   *
+   * @details See nda::linalg::minres_worker. Repeated solves should use a worker to avoid allocating its vectors.
+   *
+   * @tparam Op Callable type of the operator.
+   * @tparam B nda::MemoryVector type.
+   * @tparam X nda::MemoryVector type.
+   * @tparam P Callable type of the preconditioner.
+   * @param a Operator \f$ \mathbf{A} \f$.
+   * @param b Right hand side \f$ \mathbf{b} \f$.
+   * @param x Input/output vector. On entry, the initial guess. On exit, the approximate solution.
+   * @param tol Relative tolerance.
+   * @param max_iter Maximum number of iterations.
+   * @param p Preconditioner (default: none).
+   * @return nda::linalg::krylov_info.
+   */
+  template <typename Op, MemoryVector B, MemoryVector X, typename P = detail::identity_preconditioner>
+    requires(mem::on_host<B, X> and have_same_value_type_v<B, X> and is_blas_lapack_v<get_value_t<B>>)
+  krylov_info minres(Op &&a, B const &b, X &&x, double tol = 1e-10, long max_iter = 1000, P &&p = {}) { // NOLINT (temporary views are allowed here)
+    return minres_worker<get_value_t<B>>{}(a, b, std::forward<X>(x), tol, max_iter, p);
+  }
+
+  /**
+   * @brief Solve a general linear system with the restarted generalized minimal residual method.
+   *
+   * @details See nda::linalg::gmres_worker. Repeated solves should use a worker to avoid allocating the Krylov basis.
+   *
+   * @tparam Op Callable type of the operator.
+   * @tparam B nda::MemoryVector type.
+   * @tparam X nda::MemoryVector type.
+   * @tparam P Callable type of the preconditioner.
+   * @param a Operator \f$ \mathbf{A} \f$.
+   * @param b Right hand side \f$ \mathbf{b} \f$.
+   * @param x Input/output vector. On entry, the initial guess. On exit, the approximate solution.
+   * @param tol Relative tolerance.
+   * @param max_iter Maximum number of iterations (summed over all restarts).
+   * @param restart Maximum dimension of the Krylov subspace before a restart.
+   * @param p Preconditioner (default: none).
+   * @return nda::linalg::krylov_info.
+   */
+  template <typename Op, MemoryVector B, MemoryVector X, typename P = detail::identity_preconditioner>
+    requires(mem::on_host<B, X> and have_same_value_type_v<B, X> and is_blas_lapack_v<get_value_t<B>>)
+  krylov_info gmres(Op &&a, B const &b, X &&x, double tol = 1e-10, long max_iter = 1000, long restart = 30,
+                    P &&p = {}) { // NOLINT (temporary views are allowed here)
+    return gmres_worker<get_value_t<B>>{restart}(a, b, std::forward<X>(x), tol, max_iter, p);
+  }
+
+  /** @} */
+
+} // namespace nda::linalg
@@ -0,0 +1,238 @@
+// Copyright (c) 2024 Simons Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file
+ * @brief Provides a reusable LU factorization of a general square matrix.
+ */
+
+#pragma once
+
+#include "../basic_array.hpp"
+#include "../concepts.hpp"
+#include "../declarations.hpp"
+#include "../exceptions.hpp"
+#include "../lapack/getrf.hpp"
+#include "../lapack/getri.hpp"
+#include "../lapack/getrs.hpp"
+#include "../lapack/interface/cxx_interface.hpp"
+#include "../layout/policies.hpp"
+#include "../macros.hpp"
+#include "../mem/address_space.hpp"
+#include "../traits.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <limits>
+#include <type_traits>
+
+namespace nda::linalg {
+
+  /**
+   * @ingroup linalg_tools
+   * @brief LU factorization \f$ \mathbf{A} = \mathbf{P L U} \f$ of a general n-by-n matrix.
+   *
+   * @details The factorization is computed once with nda::lapack::getrf and stored together with the pivot indices.
+   * Linear systems with any number of right hand sides, the determinant and the inverse can then be obtained without
+   * refactorizing the matrix:
+   *
+   * @code{.cpp}
+   * auto f = nda::linalg::lu{A};
+   * auto d = f.det();
+   * f.solve(B1); // B1 <- A^{-1} B1
+   * f.solve(B2); // B2 <- A^{-1} B2
+   * auto Ainv = f.inverse();
+   * @endcode
+   *
+   * Calling nda::linalg::lu::factorize with matrices of the same size reuses the storage of the object.
+   *
+   * @tparam T Value type of the matrix (double or std::complex<double>).
+   */
+  template <typename T>
+    requires(is_blas_lapack_v<T>)
+  class lu {
+    // Factors L and U (the unit diagonal of L is not stored).
+    matrix<T, F_layout> lu_;
+
+    // Pivot indices (1-based as returned by getrf).
+    array<int, 1> ipiv_;
+
+    // Return code of getrf.
+    int info_ = 0;
+
+    // Throw an exception if the matrix is singular.
+    void check_singular(const char *fname) const {
+      if (info_ > 0) NDA_RUNTIME_ERROR << "Error in nda::linalg::lu::" << fname << ": Matrix is singular: info = " << info_;
+    }
+
+    // Sign of the permutation P.
+    [[nodiscard]] int perm_sign() const {
+      int n_flips = 0;
+      for (long i = 0; i < size(); ++i)
+        if (ipiv_(i) != i + 1) ++n_flips;
+      return (n_flips % 2 == 1 ? -1 : 1);
+    }
+
+    public:
+    /// Default constructor leaves the object without a factorization.
+    lu() = default;
+
+    /**
+     * @brief Construct the LU factorization of a square matrix.
+     *
+     * @tparam M nda::Matrix type.
+     * @param m Matrix to be factorized (it is not modified).
+     */
+    template <Matrix M>
+      requires(mem::on_host<M>)
+    explicit lu(M const &m) {
+      factorize(m);
+    }
+
+    /**
+     * @brief Compute the LU factorization of a square matrix.
+     *
+     * @details It replaces the current factorization. If the size of the matrix is the same as before, no memory is
+     * allocated.
+     *
+     * A singular matrix does not throw an exception here (see nda::linalg::lu::is_singular), but only once the
+     * factorization is used to solve a linear system or compute the inverse.
+     *
+     * @tparam M nda::Matrix type.
+     * @param m Matrix to be factorized (it is not modified).
+     */
+    template <Matrix M>
+      requires(mem::on_host<M>)
+    void factorize(M const &m) {
+      if (m.extent(0) != m.extent(1)) NDA_RUNTIME_ERROR << "Error in nda::linalg::lu: Matrix is not square: " << m.shape();
+      if (lu_.shape() != m.shape()) lu_.resize(m.shape());
+      lu_() = m;
+      if (ipiv_.size() != m.extent(0)) ipiv_.resize(m.extent(0));
+      info_ = (lu_.empty() ? 0 : lapack::getrf(lu_, ipiv_));
+      if (info_ < 0) NDA_RUNTIME_ERROR << "Error in nda::linalg::lu: info = " << info_;
+    }
+
+    /**
+     * @brief Get the size of the factorized matrix.
+     * @return Number of rows/columns of the matrix.
+     */
+    [[nodiscard]] long size() const { return lu_.extent(0); }
+
+    /**
+     * @brief Check if the factorized matrix is exactly singular, i.e. if one of the diagonal elements of
+     * \f$ \mathbf{U} \f$ is zero.
+     * @return True if the matrix is singular.
+     */
+    [[nodiscard]] bool is_singular() const { return info_ > 0; }
+
+    /**
+     * @brief Get the factors \f$ \mathbf{L} \f$ and \f$ \mathbf{U} \f$ as computed by nda::lapack::getrf.
+     * @return Const reference to the matrix containing the factors.
+     */
+    [[nodiscard]] matrix<T, F_layout> const &factors() const { return lu_; }
+
+    /**
+     * @brief Get the pivot indices as computed by nda::lapack::getrf.
+     * @return Const reference to the array of (1-based) pivot indices.
+     */
+    [[nodiscard]] array<int, 1> const &pivots() const { return ipiv_; }
+
+    /**
+     * @brief Solve the linear system \f$ \mathbf{A X} = \mathbf{B} \f$ in place.
+     *
+     * @details The right hand side can be a vector with unit stride or a matrix. Matrices in Fortran order are passed
+     * directly to nda::lapack::getrs, matrices in C order are solved in a temporary copy.
+     *
+     * @tparam B nda::MemoryArray type.
+     * @param b Input/output array. On entry, the right hand side \f$ \mathbf{B} \f$. On exit, the solution
+     * \f$ \mathbf{X} \f$.
+     */
+    template <MemoryArray B>
+      requires((MemoryVector<B> or MemoryMatrix<B>) and mem::on_host<B> and std::is_same_v<get_value_t<B>, T>)
+    void solve(B &&b) const { // NOLINT (temporary views are allowed here)
+      check_singular("solve");
+      EXPECTS(b.extent(0) == size());
+      if (b.empty()) return;
+
+      int info = 0;
+      if constexpr (MemoryVector<B>) {
+        EXPECTS(b.indexmap().min_stride() == 1);
+        lapack::f77::getrs('N', size(), 1, lu_.data(), lapack::get_ld(lu_), ipiv_.data(), b.data(), size(), info);
+      } else if constexpr (lapack::has_F_layout<B>) {
+        info = lapack::getrs(lu_, b, ipiv_);
+      } else {
+        auto b_f = matrix<T, F_layout>{b};
+        info     = lapack::getrs(lu_, b_f, ipiv_);
+        b        = b_f;
+      }
+      if (info != 0) NDA_RUNTIME_ERROR << "Error in nda::linalg::lu::solve: info = " << info;
+    }
+
+    /**
+     * @brief Get the determinant of the factorized matrix.
+     * @return Product of the diagonal elements of \f$ \mathbf{U} \f$ times the sign of the permutation.
+     */
+    [[nodiscard]] T det() const {
+      auto res = T{1};
+      for (long i = 0; i < size(); ++i) res *= lu_(i, i);
+      return perm_sign() * res;
+    }
+
+    /**
+     * @brief Get the logarithm of the absolute value of the determinant of the factorized matrix.
+     *
+     * @details Contrary to nda::linalg::lu::det, it does not overflow/underflow for large matrices. The determinant is
+     * given by `sign() * std::exp(log_det())`. For a singular matrix, it returns `-inf`.
+     *
+     * @return \f$ \log |\det \mathbf{A}| \f$.
+     */
+    [[nodiscard]] double log_det() const {
+      if (is_singular()) return -std::numeric_limits<double>::infinity();
+      double res = 0.0;
+      for (long i = 0; i < size(); ++i) res += std::log(std::abs(lu_(i, i)));
+      return res;
+    }
+
+    /**
+     * @brief Get the sign (real matrices) or the phase (complex matrices) of the determinant of the factorized matrix.
+     * @return \f$ \det \mathbf{A} / |\det \mathbf{A}| \f$ or 0 if the matrix is singular.
+     */
+    [[nodiscard]] T sign() const {
+      if (is_singular()) return T{0};
+      auto res = T(perm_sign());
+      for (long i = 0; i < size(); ++i) res *= lu_(i, i) / std::abs(lu_(i, i));
+      return res;
+    }
+
+    /**
+     * @brief Get the inverse of the factorized matrix.
+     * @details It calls nda::lapack::getri on a copy of the factors.
+     * @return Inverse of the matrix.
+     */
+    [[nodiscard]] matrix<T, F_layout> inverse() const {
+      check_singular("inverse");
+      auto res = lu_;
+      if (res.empty()) return res;
+      int info = lapack::getri(res, ipiv_);
+      if (info != 0) NDA_RUNTIME_ERROR << "Error in nda::linalg::lu::inverse: info = " << info;
+      return res;
+    }
+  };
+
+  /// Deduce the value type of nda::linalg::lu from the matrix.
+  template <Matrix M>
+  lu(M const &) -> lu<get_value_t<M>>;
+
+} // namespace nda::linalg
@@ -23,7 +23,9 @@
 
 #include "../basic_functions.hpp"
 #include "../blas/gemm.hpp"
+#include "../blas/gemm_small.hpp"
 #include "../blas/gemv.hpp"
+#include "../blas/syrk.hpp"
 #include "../blas/tools.hpp"
 #include "../concepts.hpp"
 #include "../declarations.hpp"
@@ -32,6 +34,7 @@
 #include "../mem/policies.hpp"
 #include "../traits.hpp"
 
+#include <algorithm>
 #include <type_traits>
 #include <utility>
 
@@ -67,6 +70,35 @@ namespace nda {
     template <Array A>
     using get_layout_policy = typename std::remove_reference_t<decltype(make_regular(std::declval<A>()))>::layout_policy_t;
 
+    // Get the underlying matrix of a conjugate lazy expression or the matrix itself.
+    template <Matrix M>
+    auto const &get_underlying_matrix(M const &m) {
+      if constexpr (blas::is_conj_array_expr<M>)
+        return std::get<0>(m.a);
+      else
+        return m;
+    }
+
+    // Check if the matrix y is a transposed view of the matrix x.
+    template <MemoryMatrix X, MemoryMatrix Y>
+    bool is_transposed_view(X const &x, Y const &y) {
+      auto const &x_str = x.indexmap().strides();
+      auto const &y_str = y.indexmap().strides();
+      return x.data() == y.data() and x.extent(0) == y.extent(1) and x.extent(1) == y.extent(0) and x_str[0] == y_str[1] and x_str[1] == y_str[0];
+    }
+
+    // Fill the lower triangle of a square matrix from its upper triangle such that it becomes symmetric or hermitian.
+    // If conj_upper is true, the upper triangle is complex conjugated first.
+    template <MemoryMatrix M>
+    void fill_lower_triangle(M &m, bool hermitian, bool conj_upper) {
+      for (long i = 0; i < m.extent(0); ++i) {
+        for (long j = i; j < m.extent(1); ++j) {
+          if (conj_upper) m(i, j) = nda::conj(m(i, j));
+          if (j > i) m(j, i) = (hermitian ? nda::conj(m(i, j)) : m(i, j));
+        }
+      }
+    }
+
   } // namespace detail
 
   /**
@@ -75,7 +107,14 @@ namespace nda {
    * @details It is generic in the sense that it allows the input matrices to belong to a different
    * nda::mem::AddressSpace (as long as they are compatible).
    *
-   * If possible, it uses nda::blas::gemm, otherwise it calls nda::blas::gemm_generic.
+   * If both matrices have extents known at compile-time (e.g. nda::stack_matrix), it uses the unrolled kernel
+   * nda::blas::gemm_small and returns an nda::stack_matrix. Otherwise, if possible, it uses nda::blas::gemm (or
+   * nda::blas::gemm_small if no extent exceeds nda::blas::small_gemm_max_extent). In all other cases, it calls
+   * nda::blas::gemm_generic.
+   *
+   * Products of the form `a * transpose(a)` or `a * dagger(a)` (also `transpose(a) * a` and `dagger(a) * a`) are
+   * detected at runtime and computed with nda::blas::syrk or nda::blas::herk, which require only half the operations.
+   * The detection only works if the transposed operand is a view/lazy expression of the same data.
    *
    * @tparam A nda::Matrix type of lhs operand.
    * @tparam B nda::Matrix type of rhs operand.
@@ -93,45 +132,88 @@ namespace nda {
     static constexpr auto R_adr_spc = mem::get_addr_space<B>;
     mem::check_adr_sp_valid<L_adr_spc, R_adr_spc>();
 
-    // get resulting value type, layout policy and matrix type
+    // get resulting value type
     using value_t = decltype(get_value_t<A>{} * get_value_t<B>{});
-    using layout_policy =
-       std::conditional_t<get_layout_info<A>.stride_order == get_layout_info<B>.stride_order, detail::get_layout_policy<A>, C_layout>;
-    using matrix_t = basic_array<value_t, 2, layout_policy, 'M', nda::heap<mem::combine<L_adr_spc, R_adr_spc>>>;
-
-    // perform matrix-matrix multiplication
-    auto result = matrix_t(a.shape()[0], b.shape()[1]);
-    if constexpr (is_blas_lapack_v<value_t>) {
-      // for double or complex value types we use blas::gemm
-      // lambda to form a new matrix with the correct value type if necessary
-      auto as_container = []<Matrix M>(M &&m) -> decltype(auto) {
-        if constexpr (std::is_same_v<get_value_t<M>, value_t> and (MemoryMatrix<M> or blas::is_conj_array_expr<M>))
-          return std::forward<M>(m);
-        else
-          return matrix_t{std::forward<M>(m)};
-      };
-
-      // MSAN has no way to know that we are calling with beta = 0, hence this is not necessary.
-      // Of course, in production code, we do NOT waste time to do this.
+
+    if constexpr (blas::has_static_extents<A> and blas::has_static_extents<B> and mem::on_host<A, B>) {
+      // for compile-time extents we use the unrolled kernel and return a matrix on the stack
+      auto result = stack_matrix<value_t, blas::static_extent<A, 0>, blas::static_extent<B, 1>>{};
+      blas::gemm_small(1, a, b, 0, result);
+      return result;
+    } else {
+      // get resulting layout policy and matrix type
+      using layout_policy =
+         std::conditional_t<get_layout_info<A>.stride_order == get_layout_info<B>.stride_order, detail::get_layout_policy<A>, C_layout>;
+      using matrix_t = basic_array<value_t, 2, layout_policy, 'M', nda::heap<mem::combine<L_adr_spc, R_adr_spc>>>;
+
+      // perform matrix-matrix multiplication
+      auto result = matrix_t(a.shape()[0], b.shape()[1]);
+      if constexpr (is_blas_lapack_v<value_t>) {
+        // for double or complex value types we use blas::gemm
+        // lambda to form a new matrix with the correct value type if necessary
+        auto as_container = []<Matrix M>(M &&m) -> decltype(auto) {
+          if constexpr (std::is_same_v<get_value_t<M>, value_t> and (MemoryMatrix<M> or blas::is_conj_array_expr<M>))
+            return std::forward<M>(m);
+          else
+            return matrix_t{std::forward<M>(m)};
+        };
+
+        // MSAN has no way to know that we are calling with beta = 0, hence this is not necessary.
+        // Of course, in production code, we do NOT waste time to do this.
 #if defined(__has_feature)
 #if __has_feature(memory_sanitizer)
-      result = 0;
+        result = 0;
 #endif
 #endif
 
-      // check if we can call gemm directly
-      if constexpr (detail::is_valid_gemm_triple<decltype(as_container(a)), decltype(as_container(b)), matrix_t>) {
-        blas::gemm(1, as_container(a), as_container(b), 0, result);
+        // for small matrices we avoid the overhead of the BLAS call (same preconditions as for blas::gemm)
+        if constexpr (mem::on_host<A, B> and MemoryMatrix<A> and MemoryMatrix<B>) {
+          if (std::max({a.extent(0), a.extent(1), b.extent(1)}) <= blas::small_gemm_max_extent and a.indexmap().min_stride() == 1
+              and b.indexmap().min_stride() == 1) {
+            blas::gemm_small(1, a, b, 0, result);
+            return result;
+          }
+        }
+
+        // for products of the form a * transpose(a) or a * dagger(a), we only compute one triangle with syrk/herk
+        static constexpr bool conj_A = blas::is_conj_array_expr<A>;
+        static constexpr bool conj_B = blas::is_conj_array_expr<B>;
+        if constexpr (mem::on_host<A, B> and std::is_same_v<get_value_t<A>, value_t> and std::is_same_v<get_value_t<B>, value_t>
+                      and (MemoryMatrix<A> or conj_A) and (MemoryMatrix<B> or conj_B) and not(conj_A and conj_B)) {
+          auto const &mat_a = detail::get_underlying_matrix(a);
+          if (detail::is_transposed_view(mat_a, detail::get_underlying_matrix(b))) {
+            if constexpr (not conj_A and not conj_B) {
+              blas::syrk(1, a, 0, result);
+              detail::fill_lower_triangle(result, false, false);
+            } else {
+              // herk can only compute the product directly for certain layouts, otherwise we compute its complex conjugate
+              static constexpr bool direct = ((conj_A == blas::has_C_layout<decltype(mat_a)>) != blas::has_C_layout<matrix_t>);
+              if constexpr (direct)
+                blas::herk(1, a, 0, result);
+              else if constexpr (conj_A)
+                blas::herk(1, mat_a, 0, result);
+              else
+                blas::herk(1, conj(a), 0, result);
+              detail::fill_lower_triangle(result, true, not direct);
+            }
+            return result;
+          }
+        }
+
+        // check if we can call gemm directly
+        if constexpr (detail::is_valid_gemm_triple<decltype(as_container(a)), decltype(as_container(b)), matrix_t>) {
+          blas::gemm(1, as_container(a), as_container(b), 0, result);
+        } else {
+          // otherwise, turn the lhs and rhs first into regular matrices and then call gemm
+          blas::gemm(1, make_regular(as_container(a)), make_regular(as_container(b)), 0, result);
+        }
+
       } else {
-        // otherwise, turn the lhs and rhs first into regular matrices and then call gemm
-        blas::gemm(1, make_regular(as_container(a)), make_regular(as_container(b)), 0, result);
+        // for other value types we use a generic implementation
+        blas::gemm_generic(1, a, b, 0, result);
       }
-
-    } else {
-      // for other value types we use a generic implementation
-      blas::gemm_generic(1, a, b, 0, result);
+      return result;
     }
-    return result;
   }
 
   /**
@@ -140,7 +222,10 @@ namespace nda {
    * @details It is generic in the sense that it allows the input matrix and vector to belong to a different
    * nda::mem::AddressSpace (as long as they are compatible).
    *
-   * If possible, it uses nda::blas::gemv, otherwise it calls nda::blas::gemv_generic.
+   * If both the matrix and the vector have extents known at compile-time, it uses the unrolled kernel
+   * nda::blas::gemv_small and returns an nda::stack_vector. Otherwise, if possible, it uses nda::blas::gemv (or
+   * nda::blas::gemv_small if no extent exceeds nda::blas::small_gemm_max_extent). In all other cases, it calls
+   * nda::blas::gemv_generic.
    *
    * @tparam A nda::Matrix type of lhs operand.
    * @tparam X nda::Vector type of rhs operand.
@@ -159,42 +244,59 @@ namespace nda {
     static_assert(L_adr_spc == R_adr_spc, "Error in nda::matvecmul: Matrix-vector product requires arguments with same address spaces");
     static_assert(L_adr_spc != mem::None);
 
-    // get resulting value type and vector type
-    using value_t  = decltype(get_value_t<A>{} * get_value_t<X>{});
-    using vector_t = vector<value_t, heap<L_adr_spc>>;
-
-    // perform matrix-matrix multiplication
-    auto result = vector_t(a.shape()[0]);
-    if constexpr (is_blas_lapack_v<value_t>) {
-      // for double or complex value types we use blas::gemv
-      // lambda to form a new array with the correct value type if necessary
-      auto as_container = []<Array B>(B &&b) -> decltype(auto) {
-        if constexpr (std::is_same_v<get_value_t<B>, value_t> and (MemoryMatrix<B> or (Matrix<B> and blas::is_conj_array_expr<B>)))
-          return std::forward<B>(b);
-        else
-          return basic_array<value_t, get_rank<B>, C_layout, 'A', heap<L_adr_spc>>{std::forward<B>(b)};
-      };
-
-      // MSAN has no way to know that we are calling with beta = 0, hence this is not necessary.
-      // Of course, in production code, we do NOT waste time to do this.
+    // get resulting value type
+    using value_t = decltype(get_value_t<A>{} * get_value_t<X>{});
+
+    if constexpr (blas::has_static_extents<A> and blas::has_static_extents<X> and mem::on_host<A, X>) {
+      // for compile-time extents we use the unrolled kernel and return a vector on the stack
+      auto result = stack_vector<value_t, blas::static_extent<A, 0>>{};
+      blas::gemv_small(1, a, x, 0, result);
+      return result;
+    } else {
+      // get resulting vector type
+      using vector_t = vector<value_t, heap<L_adr_spc>>;
+
+      // perform matrix-matrix multiplication
+      auto result = vector_t(a.shape()[0]);
+      if constexpr (is_blas_lapack_v<value_t>) {
+        // for double or complex value types we use blas::gemv
+        // lambda to form a new array with the correct value type if necessary
+        auto as_container = []<Array B>(B &&b) -> decltype(auto) {
+          if constexpr (std::is_same_v<get_value_t<B>, value_t> and (MemoryMatrix<B> or (Matrix<B> and blas::is_conj_array_expr<B>)))
+            return std::forward<B>(b);
+          else
+            return basic_array<value_t, get_rank<B>, C_layout, 'A', heap<L_adr_spc>>{std::forward<B>(b)};
+        };
+
+        // MSAN has no way to know that we are calling with beta = 0, hence this is not necessary.
+        // Of course, in production code, we do NOT waste time to do this.
 #if defined(__has_feature)
 #if __has_feature(memory_sanitizer)
-      result = 0;
+        result = 0;
 #endif
 #endif
 
-      // for expressions of the kind 'conj(M) * V' with a Matrix in Fortran Layout, we have to explicitly
-      // form the conj operation in memory as gemv only provides op tags 'N', 'T' and 'C' (hermitian conjugate)
-      if constexpr (blas::is_conj_array_expr<decltype(as_container(a))> and blas::has_F_layout<decltype(as_container(a))>) {
-        blas::gemv(1, make_regular(as_container(a)), as_container(x), 0, result);
+        // for small matrices we avoid the overhead of the BLAS call (same preconditions as for blas::gemv)
+        if constexpr (mem::on_host<A, X> and MemoryMatrix<A> and MemoryVector<X>) {
+          if (std::max(a.extent(0), a.extent(1)) <= blas::small_gemm_max_extent and a.indexmap().min_stride() == 1) {
+            blas::gemv_small(1, a, x, 0, result);
+            return result;
+          }
+        }
+
+        // for expressions of the kind 'conj(M) * V' with a Matrix in Fortran Layout, we have to explicitly
+        // form the conj operation in memory as gemv only provides op tags 'N', 'T' and 'C' (hermitian conjugate)
+        if constexpr (blas::is_conj_array_expr<decltype(as_container(a))> and blas::has_F_layout<decltype(as_container(a))>) {
+          blas::gemv(1, make_regular(as_container(a)), as_container(x), 0, result);
+        } else {
+          blas::gemv(1, as_container(a), as_container(x), 0, result);
+        }
       } else {
-        blas::gemv(1, as_container(a), as_container(x), 0, result);
+        // for other value types we use a generic implementation
+        blas::gemv_generic(1, a, x, 0, result);
       }
-    } else {
-      // for other value types we use a generic implementation
-      blas::gemv_generic(1, a, x, 0, result);
+      return result;
     }
-    return result;
   }
 
   /** @} */
@@ -0,0 +1,625 @@
+// Copyright (c) 2024 Simons Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file
+ * @brief Provides functions of dense matrices like the matrix exponential, logarithm and square root.
+ */
+
+#pragma once
+
+#include "./eigenelements.hpp"
+#include "./lu.hpp"
+#include "../basic_array.hpp"
+#include "../basic_functions.hpp"
+#include "../blas/gemm.hpp"
+#include "../blas/threads.hpp"
+#include "../concepts.hpp"
+#include "../declarations.hpp"
+#include "../exceptions.hpp"
+#include "../layout/policies.hpp"
+#include "../layout/range.hpp"
+#include "../macros.hpp"
+#include "../matrix_functions.hpp"
+#include "../mem/address_space.hpp"
+#include "../traits.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <complex>
+#include <functional>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+namespace nda::linalg {
+
+  namespace detail {
+
+    // 1-norm (maximum absolute column sum) of a matrix.
+    template <typename M>
+    double norm_1(M const &m) {
+      double res = 0.0;
+      for (long j = 0; j < m.extent(1); ++j) {
+        double col = 0.0;
+        for (long i = 0; i < m.extent(0); ++i) col += std::abs(m(i, j));
+        res = std::max(res, col);
+      }
+      return res;
+    }
+
+    // Add a scalar multiple of the identity to a square matrix.
+    template <typename M, typename T>
+    void add_identity(M &m, T alpha) {
+      for (long i = 0; i < m.extent(0); ++i) m(i, i) += alpha;
+    }
+
+    // Check that the input and output matrices of a matrix function are square and have the same shape.
+    template <typename A, typename R>
+    void check_matrix_function_args(A const &a, R const &r, const char *fname) {
+      if (a.extent(0) != a.extent(1)) NDA_RUNTIME_ERROR << "Error in nda::linalg::" << fname << ": Matrix is not square: " << a.shape();
+      EXPECTS(r.shape() == a.shape());
+    }
+
+    // Principal square root of a matrix with the scaled Denman-Beavers iteration.
+    template <typename T>
+    matrix<T, F_layout> sqrtm_db(matrix<T, F_layout> y, const char *fname) {
+      long n           = y.extent(0);
+      auto z           = matrix<T, F_layout>{eye<T>(n)};
+      auto lu_y        = lu<T>{};
+      auto lu_z        = lu<T>{};
+      bool scale       = true;
+      bool last_step   = false;
+      double const tol = std::sqrt(std::numeric_limits<double>::epsilon());
+      for (int it = 0; it < 100; ++it) {
+        lu_y.factorize(y);
+        lu_z.factorize(z);
+        if (lu_y.is_singular() or lu_z.is_singular())
+          NDA_RUNTIME_ERROR << "Error in nda::linalg::" << fname << ": Matrix is singular or has no principal square root";
+
+        // determinant scaling accelerates the initial phase of the iteration
+        double mu  = (scale ? std::exp(-(lu_y.log_det() + lu_z.log_det()) / (2.0 * static_cast<double>(n))) : 1.0);
+        auto y_inv = lu_y.inverse();
+        auto z_inv = lu_z.inverse();
+        auto y_new = matrix<T, F_layout>{0.5 * (mu * y + z_inv / mu)};
+        z          = 0.5 * (mu * z + y_inv / mu);
+
+        // the iteration converges quadratically, i.e. one more step after reaching sqrt(eps) is sufficient
+        double change = norm_1(matrix<T, F_layout>{y_new - y}) / norm_1(y_new);
+        y             = std::move(y_new);
+        if (last_step) return y;
+        if (change < 1e-2) scale = false;
+        if (change < tol) last_step = true;
+      }
+      NDA_RUNTIME_ERROR << "Error in nda::linalg::" << fname << ": Denman-Beavers iteration did not converge";
+      return y;
+    }
+
+    // Apply a function to one matrix of a stack of matrices in a parallel batch.
+    template <typename A, typename R, typename MakeState, typename F>
+    void matrix_function_batch(A const &a, R &r, MakeState make_state, F f) {
+      EXPECTS(a.extent(1) == a.extent(2));
+      EXPECTS(r.shape() == a.shape());
+      auto _ = range::all;
+      blas::detail::parallel_batch(a.extent(0), make_state,
+                                   [&](auto &state, long i) { f(state, make_matrix_view(a(i, _, _)), make_matrix_view(r(i, _, _))); });
+    }
+
+  } // namespace detail
+
+  /**
+   * @addtogroup linalg_tools
+   * @{
+   */
+
+  /**
+   * @brief Worker class to compute the exponential of n-by-n matrices.
+   *
+   * @details The exponential is computed with the scaling and squaring algorithm with Padé approximants of degree 3, 5,
+   * 7, 9 or 13 (N. J. Higham, SIAM J. Matrix Anal. Appl. 26, 1179 (2005)). The degree and the number of squarings are
+   * chosen from the 1-norm of the matrix such that the result is accurate to double precision.
+   *
+   * The worker owns all intermediate matrices and the LU factorization. Calling it repeatedly with matrices of the same
+   * size, e.g. in a time evolution loop, therefore does not allocate any memory after the first call.
+   *
+   * @tparam T Value type of the matrices (double or std::complex<double>).
+   */
+  template <typename T>
+    requires(is_blas_lapack_v<T>)
+  class expm_worker {
+    // Scaled input matrix and its even powers.
+    matrix<T, F_layout> a_, a2_, a4_, a6_, a8_;
+
+    // Odd (u_) and even (v_) parts of the Padé approximant and a temporary matrix.
+    matrix<T, F_layout> u_, v_, tmp_;
+
+    // LU factorization of V - U.
+    lu<T> lu_;
+
+    // Compute U and V for a Padé approximant of degree m <= 9.
+    void pade_low(int m) {
+      static constexpr std::array<std::array<double, 10>, 4> b = {{{120, 60, 12, 1},
+                                                                   {30240, 15120, 3360, 420, 30, 1},
+                                                                   {17297280, 8648640, 1995840, 277200, 25200, 1512, 56, 1},
+                                                                   {17643225600, 8821612800, 2075673600, 302702400, 30270240, 2162160, 110880,
+                                                                    3960, 90, 1}}};
+      auto const &c = b[(m - 3) / 2];
+      auto pows     = std::array<matrix<T, F_layout> *, 4>{&a2_, &a4_, &a6_, &a8_};
+      blas::gemm(T{1}, a_, a_, T{0}, a2_);
+      if (m >= 5) blas::gemm(T{1}, a2_, a2_, T{0}, a4_);
+      if (m >= 7) blas::gemm(T{1}, a4_, a2_, T{0}, a6_);
+      if (m >= 9) blas::gemm(T{1}, a4_, a4_, T{0}, a8_);
+
+      // V = sum_k c[2k] A^{2k} and U = A * sum_k c[2k+1] A^{2k}
+      v_   = 0;
+      tmp_ = 0;
+      detail::add_identity(v_, T(c[0]));
+      detail::add_identity(tmp_, T(c[1]));
+      for (int k = 1; 2 * k <= m; ++k) {
+        v_ += c[2 * k] * (*pows[k - 1]);
+        tmp_ += c[2 * k + 1] * (*pows[k - 1]);
+      }
+      blas::gemm(T{1}, a_, tmp_, T{0}, u_);
+    }
+
+    // Compute U and V for the Padé approximant of degree 13.
+    void pade_13() {
+      static constexpr std::array<double, 14> b = {64764752532480000., 32382376266240000., 7771770303897600., 1187353796428800., 129060195264000.,
+                                                   10559470521600.,    670442572800.,      33522128640.,      1323241920.,       40840800.,
+                                                   960960.,            16380.,             182.,              1.};
+      blas::gemm(T{1}, a_, a_, T{0}, a2_);
+      blas::gemm(T{1}, a2_, a2_, T{0}, a4_);
+      blas::gemm(T{1}, a4_, a2_, T{0}, a6_);
+
+      // U = A * (A6 * (b13 A6 + b11 A4 + b9 A2) + b7 A6 + b5 A4 + b3 A2 + b1 I)
+      tmp_ = b[13] * a6_ + b[11] * a4_ + b[9] * a2_;
+      blas::gemm(T{1}, a6_, tmp_, T{0}, v_);
+      v_ += b[7] * a6_ + b[5] * a4_ + b[3] * a2_;
+      detail::add_identity(v_, T(b[1]));
+      blas::gemm(T{1}, a_, v_, T{0}, u_);
+
+      // V = A6 * (b12 A6 + b10 A4 + b8 A2) + b6 A6 + b4 A4 + b2 A2 + b0 I
+      tmp_ = b[12] * a6_ + b[10] * a4_ + b[8] * a2_;
+      blas::gemm(T{1}, a6_, tmp_, T{0}, v_);
+      v_ += b[6] * a6_ + b[4] * a4_ + b[2] * a2_;
+      detail::add_identity(v_, T(b[0]));
+    }
+
+    public:
+    /**
+     * @brief Compute the exponential of a square matrix.
+     *
+     * @tparam A nda::Matrix type.
+     * @tparam R nda::MemoryMatrix type.
+     * @param a Input matrix \f$ \mathbf{A} \f$.
+     * @param r Output matrix of the same shape as \f$ \mathbf{A} \f$. On exit, it contains \f$ e^{\mathbf{A}} \f$.
+     */
+    template <Matrix A, MemoryMatrix R>
+      requires(mem::on_host<A, R> and std::is_same_v<get_value_t<R>, T>)
+    void operator()(A const &a, R &&r) { // NOLINT (temporary views are allowed here)
+      detail::check_matrix_function_args(a, r, "expm");
+      long n = a.extent(0);
+      if (n == 0) return;
+      for (auto *m : {&a_, &a2_, &a4_, &a6_, &a8_, &u_, &v_, &tmp_}) m->resize(n, n);
+      a_() = a;
+
+      // choose the degree of the Padé approximant and the number of squarings
+      static constexpr std::array<double, 4> theta = {1.495585217958292e-2, 2.539398330063230e-1, 9.504178996162932e-1, 2.097847961257068e0};
+      static constexpr double theta_13             = 5.371920351148152e0;
+
+      double const nrm = detail::norm_1(a_);
+      int s            = 0;
+      auto it          = std::find_if(theta.begin(), theta.end(), [nrm](double t) { return nrm <= t; });
+      if (it != theta.end()) {
+        pade_low(3 + 2 * static_cast<int>(it - theta.begin()));
+      } else {
+        if (nrm > theta_13) {
+          s = static_cast<int>(std::ceil(std::log2(nrm / theta_13)));
+          a_ /= std::pow(2.0, s);
+        }
+        pade_13();
+      }
+
+      // solve (V - U) R = V + U
+      tmp_ = v_ - u_;
+      v_ += u_;
+      lu_.factorize(tmp_);
+      lu_.solve(v_);
+
+      // undo the scaling by repeated squaring
+      for (int i = 0; i < s; ++i) {
+        blas::gemm(T{1}, v_, v_, T{0}, tmp_);
+        std::swap(v_, tmp_);
+      }
+      r() = v_;
+    }
+  };
+
+  /**
+   * @brief Compute the matrix exponential \f$ e^{\mathbf{A}} \f$ and write it into a preallocated matrix.
+   *
+   * @details See nda::linalg::expm_worker. To avoid allocations in repeated calls, use an nda::linalg::expm_worker
+   * directly.
+   *
+   * @tparam A nda::Matrix type.
+   * @tparam R nda::MemoryMatrix type.
+   * @param a Input square matrix.
+   * @param r Output matrix of the same shape as \f$ \mathbf{A} \f$.
+   */
+  template <Matrix A, MemoryMatrix R>
+    requires(mem::on_host<A, R> and is_blas_lapack_v<get_value_t<A>> and std::is_same_v<get_value_t<A>, get_value_t<R>>)
+  void expm(A const &a, R &&r) { // NOLINT (temporary views are allowed here)
+    expm_worker<get_value_t<A>>{}(a, r);
+  }
+
+  /**
+   * @brief Compute the matrix exponential \f$ e^{\mathbf{A}} \f$.
+   *
+   * @details See nda::linalg::expm_worker.
+   *
+   * @tparam A nda::Matrix type.
+   * @param a Input square matrix.
+   * @return Matrix exponential.
+   */
+  template <Matrix A>
+    requires(mem::on_host<A> and is_blas_lapack_v<get_value_t<A>>)
+  auto expm(A const &a) {
+    auto r = matrix<get_value_t<A>>(a.shape());
+    expm(a, r);
+    return r;
+  }
+
+  /**
+   * @brief Compute the principal square root \f$ \mathbf{A}^{1/2} \f$ of a matrix and write it into a preallocated
+   * matrix.
+   *
+   * @details It uses the Denman-Beavers iteration with determinant scaling, which requires two matrix inversions per
+   * step and converges quadratically. The principal square root is the unique square root whose eigenvalues have
+   * positive real parts. It exists if \f$ \mathbf{A} \f$ has no eigenvalues on the closed negative real axis. For real
+   * matrices with negative eigenvalues, a complex matrix has to be passed.
+   *
+   * It throws an exception if the matrix is singular or the iteration does not converge.
+   *
+   * @tparam A nda::Matrix type.
+   * @tparam R nda::MemoryMatrix type.
+   * @param a Input square matrix.
+   * @param r Output matrix of the same shape as \f$ \mathbf{A} \f$.
+   */
+  template <Matrix A, MemoryMatrix R>
+    requires(mem::on_host<A, R> and is_blas_lapack_v<get_value_t<A>> and std::is_same_v<get_value_t<A>, get_value_t<R>>)
+  void sqrtm(A const &a, R &&r) { // NOLINT (temporary views are allowed here)
+    detail::check_matrix_function_args(a, r, "sqrtm");
+    if (a.extent(0) == 0) return;
+    r() = detail::sqrtm_db(matrix<get_value_t<A>, F_layout>{a}, "sqrtm");
+  }
+
+  /**
+   * @brief Compute the principal square root \f$ \mathbf{A}^{1/2} \f$ of a matrix.
+   *
+   * @details See nda::linalg::sqrtm(A const &, R &&).
+   *
+   * @tparam A nda::Matrix type.
+   * @param a Input square matrix.
+   * @return Principal square root.
+   */
+  template <Matrix A>
+    requires(mem::on_host<A> and is_blas_lapack_v<get_value_t<A>>)
+  auto sqrtm(A const &a) {
+    auto r = matrix<get_value_t<A>>(a.shape());
+    sqrtm(a, r);
+    return r;
+  }
+
+  /**
+   * @brief Compute the principal logarithm \f$ \log \mathbf{A} \f$ of a matrix and write it into a preallocated
+   * matrix.
+   *
+   * @details It uses the inverse scaling and squaring method: Square roots are taken with nda::linalg::sqrtm until
+   * \f$ |\mathbf{A}^{1/2^k} - \mathbf{1}|_1 \leq 1/4 \f$. Then \f$ \log(\mathbf{1} + \mathbf{X}) \f$ is evaluated with
+   * the [8/8] Padé approximant in its partial fraction form (8-point Gauss-Legendre quadrature of
+   * \f$ \int_0^1 \mathbf{X} (\mathbf{1} + t \mathbf{X})^{-1} dt \f$) and multiplied by \f$ 2^k \f$.
+   *
+   * The principal logarithm exists if \f$ \mathbf{A} \f$ has no eigenvalues on the closed negative real axis. For real
+   * matrices with negative eigenvalues, a complex matrix has to be passed. For hermitian positive definite matrices,
+   * nda::linalg::apply_hermitian is faster.
+   *
+   * @tparam A nda::Matrix type.
+   * @tparam R nda::MemoryMatrix type.
+   * @param a Input square matrix.
+   * @param r Output matrix of the same shape as \f$ \mathbf{A} \f$.
+   */
+  template <Matrix A, MemoryMatrix R>
+    requires(mem::on_host<A, R> and is_blas_lapack_v<get_value_t<A>> and std::is_same_v<get_value_t<A>, get_value_t<R>>)
+  void logm(A const &a, R &&r) { // NOLINT (temporary views are allowed here)
+    using value_t = get_value_t<A>;
+    using mat_t   = matrix<value_t, F_layout>;
+    detail::check_matrix_function_args(a, r, "logm");
+    long n = a.extent(0);
+    if (n == 0) return;
+
+    // take square roots until A is close to the identity
+    auto x = mat_t{a};
+    detail::add_identity(x, value_t{-1});
+    int k = 0;
+    while (detail::norm_1(x) > 0.25) {
+      if (++k > 64) NDA_RUNTIME_ERROR << "Error in nda::linalg::logm: Too many square roots required";
+      detail::add_identity(x, value_t{1});
+      x = detail::sqrtm_db(std::move(x), "logm");
+      detail::add_identity(x, value_t{-1});
+    }
+
+    // log(1 + X) = sum_j w_j X (1 + t_j X)^{-1} with Gauss-Legendre nodes t_j and weights w_j on [0, 1]
+    static constexpr std::array<double, 4> gl_x = {0.1834346424956498, 0.5255324099163290, 0.7966664774136267, 0.9602898564975363};
+    static constexpr std::array<double, 4> gl_w = {0.3626837833783620, 0.3137066458778873, 0.2223810344533745, 0.1012285362903763};
+    auto res  = mat_t::zeros(n, n);
+    auto lhs  = mat_t(n, n);
+    auto y    = mat_t(n, n);
+    auto lu_t = lu<value_t>{};
+    for (int j = 0; j < 8; ++j) {
+      double t = 0.5 * (1.0 + (j < 4 ? -gl_x[j] : gl_x[j - 4]));
+      double w = 0.5 * gl_w[j % 4];
+      lhs      = t * x;
+      detail::add_identity(lhs, value_t{1});
+      lu_t.factorize(lhs);
+      y = x;
+      lu_t.solve(y);
+      res += w * y;
+    }
+    r = std::pow(2.0, k) * res;
+  }
+
+  /**
+   * @brief Compute the principal logarithm \f$ \log \mathbf{A} \f$ of a matrix.
+   *
+   * @details See nda::linalg::logm(A const &, R &&).
+   *
+   * @tparam A nda::Matrix type.
+   * @param a Input square matrix.
+   * @return Principal logarithm.
+   */
+  template <Matrix A>
+    requires(mem::on_host<A> and is_blas_lapack_v<get_value_t<A>>)
+  auto logm(A const &a) {
+    auto r = matrix<get_value_t<A>>(a.shape());
+    logm(a, r);
+    return r;
+  }
+
+  /**
+   * @brief Value type of the result of nda::linalg::apply_hermitian.
+   *
+   * @tparam F Callable type.
+   * @tparam T Value type of the hermitian matrix.
+   */
+  template <typename F, typename T>
+  using apply_hermitian_t = std::common_type_t<T, std::invoke_result_t<F, double>>;
+
+  /**
+   * @brief Worker class to apply a scalar function to real symmetric or complex hermitian n-by-n matrices.
+   *
+   * @details For a hermitian matrix \f$ \mathbf{H} = \mathbf{V} \mathrm{diag}(\lambda_i) \mathbf{V}^H \f$, it
+   * computes
+   * \f[
+   *   f(\mathbf{H}) = \mathbf{V} \mathrm{diag}(f(\lambda_i)) \mathbf{V}^H
+   * \f]
+   * from a single eigendecomposition (nda::linalg::eigen_worker) and one call to nda::blas::gemm. The function may
+   * return complex values, e.g. \f$ f(x) = e^{-i t x} \f$ for the time evolution operator.
+   *
+   * The worker owns the eigensolver workspace and all intermediate matrices. Calling it repeatedly with matrices of the
+   * same size does not allocate any memory after the first call.
+   *
+   * @tparam T Value type of the hermitian matrices (double or std::complex<double>).
+   * @tparam RT Value type of the result.
+   */
+  template <typename T, typename RT = T>
+    requires(is_blas_lapack_v<T> and is_blas_lapack_v<RT>)
+  class apply_hermitian_worker {
+    // Eigensolver.
+    eigen_worker<T> eig_;
+
+    // Eigenvectors (converted to the result type) and eigenvectors scaled by the function values.
+    matrix<RT, F_layout> v_, fv_, res_;
+
+    public:
+    /**
+     * @brief Construct a worker for n-by-n matrices.
+     * @param n Size of the matrices (must be positive).
+     */
+    explicit apply_hermitian_worker(long n) : eig_(n), fv_(n, n), res_(n, n) {
+      if constexpr (not std::is_same_v<T, RT>) v_.resize(n, n);
+    }
+
+    /**
+     * @brief Compute \f$ f(\mathbf{H}) \f$ for a hermitian matrix.
+     *
+     * @tparam F Callable type.
+     * @tparam H nda::Matrix type.
+     * @tparam R nda::MemoryMatrix type.
+     * @param f Scalar function.
+     * @param h Input hermitian matrix.
+     * @param r Output matrix of the same shape as \f$ \mathbf{H} \f$.
+     */
+    template <typename F, Matrix H, MemoryMatrix R>
+      requires(std::is_same_v<get_value_t<R>, RT>)
+    void operator()(F const &f, H const &h, R &&r) { // NOLINT (temporary views are allowed here)
+      EXPECTS(h.shape() == r.shape());
+      auto const &[ev, vecs] = eig_.eigenelements(h);
+      auto const &v          = [&]() -> matrix<RT, F_layout> const & {
+        if constexpr (std::is_same_v<T, RT>) {
+          return vecs;
+        } else {
+          v_() = vecs;
+          return v_;
+        }
+      }();
+      for (long j = 0; j < ev.size(); ++j) {
+        auto fj = static_cast<RT>(f(ev(j)));
+        for (long i = 0; i < ev.size(); ++i) fv_(i, j) = v(i, j) * fj;
+      }
+      blas::gemm(RT{1}, fv_, dagger(v), RT{0}, res_);
+      r() = res_;
+    }
+  };
+
+  /**
+   * @brief Apply a scalar function to a real symmetric or complex hermitian matrix and write the result into a
+   * preallocated matrix.
+   *
+   * @details See nda::linalg::apply_hermitian_worker.
+   *
+   * @tparam F Callable type.
+   * @tparam H nda::Matrix type.
+   * @tparam R nda::MemoryMatrix type.
+   * @param f Scalar function.
+   * @param h Input hermitian matrix.
+   * @param r Output matrix of the same shape as \f$ \mathbf{H} \f$.
+   */
+  template <typename F, Matrix H, MemoryMatrix R>
+    requires(mem::on_host<H, R> and is_blas_lapack_v<get_value_t<H>>)
+  void apply_hermitian(F const &f, H const &h, R &&r) { // NOLINT (temporary views are allowed here)
+    if (h.extent(0) == 0) return;
+    apply_hermitian_worker<get_value_t<H>, get_value_t<R>>(h.extent(0))(f, h, r);
+  }
+
+  /**
+   * @brief Apply a scalar function to a real symmetric or complex hermitian matrix.
+   *
+   * @details See nda::linalg::apply_hermitian_worker.
+   *
+   * @tparam F Callable type.
+   * @tparam H nda::Matrix type.
+   * @param f Scalar function.
+   * @param h Input hermitian matrix.
+   * @return Matrix \f$ f(\mathbf{H}) \f$.
+   */
+  template <typename F, Matrix H>
+    requires(mem::on_host<H> and is_blas_lapack_v<get_value_t<H>>)
+  auto apply_hermitian(F const &f, H const &h) {
+    auto r = matrix<apply_hermitian_t<F, get_value_t<H>>>(h.shape());
+    apply_hermitian(f, h, r);
+    return r;
+  }
+
+  /**
+   * @brief Compute the matrix exponentials of a stack of n-by-n matrices.
+   *
+   * @details The matrices `a(i, _, _)` are distributed over the OpenMP threads, each thread owning its own
+   * nda::linalg::expm_worker, while the BLAS/LAPACK backend runs single-threaded.
+   *
+   * @tparam A nda::ArrayOfRank<3> type.
+   * @tparam R nda::MemoryArrayOfRank<3> type.
+   * @param a Stack of input matrices.
+   * @param r Stack of output matrices of the same shape.
+   */
+  template <ArrayOfRank<3> A, MemoryArrayOfRank<3> R>
+    requires(mem::on_host<A, R> and is_blas_lapack_v<get_value_t<A>> and std::is_same_v<get_value_t<A>, get_value_t<R>>)
+  void expm_batch(A const &a, R &&r) { // NOLINT (temporary views are allowed here)
+    detail::matrix_function_batch(
+       a, r, [] { return expm_worker<get_value_t<A>>{}; }, [](auto &worker, auto const &a_i, auto &&r_i) { worker(a_i, r_i); });
+  }
+
+  /**
+   * @brief Compute the matrix exponentials of a stack of n-by-n matrices.
+   *
+   * @details See nda::linalg::expm_batch(A const &, R &&).
+   *
+   * @tparam A nda::ArrayOfRank<3> type.
+   * @param a Stack of input matrices.
+   * @return Stack of matrix exponentials.
+   */
+  template <ArrayOfRank<3> A>
+    requires(mem::on_host<A> and is_blas_lapack_v<get_value_t<A>>)
+  auto expm_batch(A const &a) {
+    auto r = array<get_value_t<A>, 3>(a.shape());
+    expm_batch(a, r);
+    return r;
+  }
+
+  /**
+   * @brief Compute the principal logarithms of a stack of n-by-n matrices.
+   *
+   * @details See nda::linalg::logm(A const &, R &&). The matrices `a(i, _, _)` are distributed over the OpenMP threads.
+   *
+   * @tparam A nda::ArrayOfRank<3> type.
+   * @tparam R nda::MemoryArrayOfRank<3> type.
+   * @param a Stack of input matrices.
+   * @param r Stack of output matrices of the same shape.
+   */
+  template <ArrayOfRank<3> A, MemoryArrayOfRank<3> R>
+    requires(mem::on_host<A, R> and is_blas_lapack_v<get_value_t<A>> and std::is_same_v<get_value_t<A>, get_value_t<R>>)
+  void logm_batch(A const &a, R &&r) { // NOLINT (temporary views are allowed here)
+    detail::matrix_function_batch(a, r, [] { return 0; }, [](int, auto const &a_i, auto &&r_i) { logm(a_i, r_i); });
+  }
+
+  /**
+   * @brief Compute the principal square roots of a stack of n-by-n matrices.
+   *
+   * @details See nda::linalg::sqrtm(A const &, R &&). The matrices `a(i, _, _)` are distributed over the OpenMP threads.
+   *
+   * @tparam A nda::ArrayOfRank<3> type.
+   * @tparam R nda::MemoryArrayOfRank<3> type.
+   * @param a Stack of input matrices.
+   * @param r Stack of output matrices of the same shape.
+   */
+  template <ArrayOfRank<3> A, MemoryArrayOfRank<3> R>
+    requires(mem::on_host<A, R> and is_blas_lapack_v<get_value_t<A>> and std::is_same_v<get_value_t<A>, get_value_t<R>>)
+  void sqrtm_batch(A const &a, R &&r) { // NOLINT (temporary views are allowed here)
+    detail::matrix_function_batch(a, r, [] { return 0; }, [](int, auto const &a_i, auto &&r_i) { sqrtm(a_i, r_i); });
+  }
+
+  /**
+   * @brief Apply a scalar function to a stack of real symmetric or complex hermitian n-by-n matrices.
+   *
+   * @details See nda::linalg::apply_hermitian_worker. The matrices `h(i, _, _)` are distributed over the OpenMP
+   * threads, each thread owning its own worker.
+   *
+   * @tparam F Callable type.
+   * @tparam H nda::ArrayOfRank<3> type.
+   * @tparam R nda::MemoryArrayOfRank<3> type.
+   * @param f Scalar function.
+   * @param h Stack of input hermitian matrices.
+   * @param r Stack of output matrices of the same shape.
+   */
+  template <typename F, ArrayOfRank<3> H, MemoryArrayOfRank<3> R>
+    requires(mem::on_host<H, R> and is_blas_lapack_v<get_value_t<H>>)
+  void apply_hermitian_batch(F const &f, H const &h, R &&r) { // NOLINT (temporary views are allowed here)
+    if (h.extent(1) == 0) return;
+    detail::matrix_function_batch(
+       h, r, [n = h.extent(1)] { return apply_hermitian_worker<get_value_t<H>, get_value_t<R>>(n); },
+       [&f](auto &worker, auto const &h_i, auto &&r_i) { worker(f, h_i, r_i); });
+  }
+
+  /**
+   * @brief Apply a scalar function to a stack of real symmetric or complex hermitian n-by-n matrices.
+   *
+   * @details See nda::linalg::apply_hermitian_batch(F const &, H const &, R &&).
+   *
+   * @tparam F Callable type.
+   * @tparam H nda::ArrayOfRank<3> type.
+   * @param f Scalar function.
+   * @param h Stack of input hermitian matrices.
+   * @return Stack of matrices \f$ f(\mathbf{H}_i) \f$.
+   */
+  template <typename F, ArrayOfRank<3> H>
+    requires(mem::on_host<H> and is_blas_lapack_v<get_value_t<H>>)
+  auto apply_hermitian_batch(F const &f, H const &h) {
+    auto r = array<apply_hermitian_t<F, get_value_t<H>>, 3>(h.shape());
+    apply_hermitian_batch(f, h, r);
+    return r;
+  }
+
+  /** @} */
+
+} // namespace nda::linalg
@@ -0,0 +1,366 @@
+// Copyright (c) 2024 Simons Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file
+ * @brief Provides a symmetric/hermitian matrix type in packed storage.
+ */
+
+#pragma once
+
+#include "../basic_array.hpp"
+#include "../blas/spmv.hpp"
+#include "../blas/spr.hpp"
+#include "../concepts.hpp"
+#include "../declarations.hpp"
+#include "../exceptions.hpp"
+#include "../lapack/pptrf.hpp"
+#include "../lapack/pptrs.hpp"
+#include "../lapack/spev.hpp"
+#include "../layout/policies.hpp"
+#include "../macros.hpp"
+#include "../mapped_functions.hpp"
+#include "../mem/address_space.hpp"
+#include "../traits.hpp"
+
+#include <array>
+#include <type_traits>
+#include <utility>
+
+namespace nda::linalg {
+
+  /**
+   * @addtogroup linalg_tools
+   * @{
+   */
+
+  /**
+   * @brief Index map of a triangular n-by-n matrix in packed storage.
+   *
+   * @details It maps the indices `(i, j)` of an element in the upper (`UpLo == 'U'`, \f$ i \leq j \f$) or lower
+   * (`UpLo == 'L'`, \f$ i \geq j \f$) triangle to its position in a 1-dimensional array of size \f$ n(n+1)/2 \f$, where
+   * the triangle is stored column by column as expected by BLAS and LAPACK:
+   * - `UpLo == 'U'`: \f$ (i, j) \mapsto i + j(j+1)/2 \f$,
+   * - `UpLo == 'L'`: \f$ (i, j) \mapsto i + j(2n-j-1)/2 \f$.
+   *
+   * Its interface mirrors the one of nda::idx_map.
+   *
+   * @tparam UpLo Stored triangle ('U' or 'L').
+   */
+  template <char UpLo = 'U'>
+    requires(UpLo == 'U' or UpLo == 'L')
+  class packed_idx_map {
+    // Number of rows/columns of the matrix.
+    long n_ = 0;
+
+    public:
+    /// Stored triangle.
+    static constexpr char uplo = UpLo;
+
+    /// Default constructor maps an empty matrix.
+    packed_idx_map() = default;
+
+    /**
+     * @brief Construct the index map of an n-by-n matrix.
+     * @param n Number of rows/columns.
+     */
+    explicit packed_idx_map(long n) : n_(n) { EXPECTS(n >= 0); }
+
+    /**
+     * @brief Get the extents of the matrix.
+     * @return `std::array<long, 2>` containing the number of rows and columns.
+     */
+    [[nodiscard]] std::array<long, 2> lengths() const noexcept { return {n_, n_}; }
+
+    /**
+     * @brief Get the number of stored elements.
+     * @return \f$ n(n+1)/2 \f$.
+     */
+    [[nodiscard]] long size() const noexcept { return n_ * (n_ + 1) / 2; }
+
+    /**
+     * @brief Check if an element lies in the stored triangle.
+     * @param i Row index.
+     * @param j Column index.
+     * @return True if the element is stored.
+     */
+    [[nodiscard]] static constexpr bool is_stored(long i, long j) noexcept { return (UpLo == 'U' ? i <= j : i >= j); }
+
+    /**
+     * @brief Get the position of an element of the stored triangle in the packed array.
+     * @param i Row index.
+     * @param j Column index.
+     * @return Linear index of the element.
+     */
+    [[nodiscard]] long operator()(long i, long j) const noexcept {
+      EXPECTS(0 <= i and i < n_ and 0 <= j and j < n_ and is_stored(i, j));
+      if constexpr (UpLo == 'U')
+        return i + j * (j + 1) / 2;
+      else
+        return i + j * (2 * n_ - j - 1) / 2;
+    }
+
+    /// Default equal-to operator.
+    bool operator==(packed_idx_map const &) const = default;
+  };
+
+  /**
+   * @brief Real symmetric or complex hermitian n-by-n matrix in packed storage.
+   *
+   * @details Only the upper (`UpLo == 'U'`) or lower (`UpLo == 'L'`) triangle is stored column by column in a
+   * 1-dimensional array (see nda::linalg::packed_idx_map). Compared to a full nda::matrix, it needs about half the
+   * memory, and matrix-vector products (nda::blas::spmv/hpmv), rank-1 updates (nda::blas::spr/hpr), Cholesky
+   * factorizations (nda::lapack::pptrf) and eigensolvers (nda::lapack::spev/hpev) work directly on the packed array:
+   *
+   * @code{.cpp}
+   * auto H = nda::linalg::packed_matrix<std::complex<double>>{A}; // copies the upper triangle of A
+   * auto y = H * x;
+   * H.rank1_update(0.5, x); // H <- H + 0.5 x x^H
+   * auto [ev, vecs] = nda::linalg::eigenelements(H);
+   * @endcode
+   *
+   * @tparam T Value type of the matrix (double or std::complex<double>).
+   * @tparam UpLo Stored triangle ('U' or 'L').
+   */
+  template <typename T, char UpLo = 'U'>
+    requires(is_blas_lapack_v<T> and (UpLo == 'U' or UpLo == 'L'))
+  class packed_matrix {
+    // Index map of the stored triangle.
+    packed_idx_map<UpLo> idxm_;
+
+    // Packed array.
+    array<T, 1> data_;
+
+    public:
+    /// Value type of the matrix.
+    using value_type = T;
+
+    /// Stored triangle.
+    static constexpr char uplo = UpLo;
+
+    /// Default constructor creates an empty matrix.
+    packed_matrix() = default;
+
+    /**
+     * @brief Construct an n-by-n matrix.
+     *
+     * @details The elements are not initialized.
+     *
+     * @param n Number of rows/columns.
+     */
+    explicit packed_matrix(long n) : idxm_(n), data_(idxm_.size()) {}
+
+    /**
+     * @brief Construct a packed matrix from the stored triangle of a square matrix.
+     *
+     * @details The elements of the other triangle are ignored, i.e. the matrix is assumed to be symmetric/hermitian.
+     *
+     * @tparam M nda::Matrix type.
+     * @param m Square matrix.
+     */
+    template <Matrix M>
+      requires(std::is_convertible_v<get_value_t<M>, T>)
+    explicit packed_matrix(M const &m) : packed_matrix(m.extent(0)) {
+      if (m.extent(0) != m.extent(1)) NDA_RUNTIME_ERROR << "Error in nda::linalg::packed_matrix: Matrix is not square: " << m.shape();
+      for (long j = 0; j < extent(1); ++j)
+        for (long i = (UpLo == 'U' ? 0 : j); i < (UpLo == 'U' ? j + 1 : extent(0)); ++i) data_(idxm_(i, j)) = m(i, j);
+    }
+
+    /**
+     * @brief Make an n-by-n packed matrix with all elements set to zero.
+     * @param n Number of rows/columns.
+     * @return Zero matrix.
+     */
+    static packed_matrix zeros(long n) {
+      auto res  = packed_matrix(n);
+      res.data_ = T{0};
+      return res;
+    }
+
+    /**
+     * @brief Get the index map of the stored triangle.
+     * @return Const reference to the nda::linalg::packed_idx_map.
+     */
+    [[nodiscard]] packed_idx_map<UpLo> const &indexmap() const { return idxm_; }
+
+    /**
+     * @brief Get the extent of the matrix in a given dimension.
+     * @param i Dimension (0 or 1).
+     * @return Number of rows/columns.
+     */
+    [[nodiscard]] long extent([[maybe_unused]] int i) const { return idxm_.lengths()[0]; }
+
+    /**
+     * @brief Get the shape of the matrix.
+     * @return `std::array<long, 2>` containing the number of rows and columns.
+     */
+    [[nodiscard]] std::array<long, 2> shape() const { return idxm_.lengths(); }
+
+    /**
+     * @brief Get the packed array.
+     * @return Const reference to the packed array.
+     */
+    [[nodiscard]] array<T, 1> const &storage() const { return data_; }
+
+    /**
+     * @brief Get a view of the packed array.
+     * @return View of the packed array, which can be passed to the BLAS/LAPACK packed routines.
+     */
+    [[nodiscard]] array_view<T, 1> storage() { return data_; }
+
+    /**
+     * @brief Access an element of the full matrix.
+     *
+     * @details Elements outside of the stored triangle are obtained from the symmetry/hermiticity of the matrix.
+     *
+     * @param i Row index.
+     * @param j Column index.
+     * @return Value of the element.
+     */
+    [[nodiscard]] T operator()(long i, long j) const {
+      if (idxm_.is_stored(i, j)) return data_(idxm_(i, j));
+      return nda::conj(data_(idxm_(j, i)));
+    }
+
+    /**
+     * @brief Access an element of the stored triangle.
+     * @param i Row index.
+     * @param j Column index.
+     * @return Reference to the element.
+     */
+    [[nodiscard]] T &stored(long i, long j) { return data_(idxm_(i, j)); }
+
+    /**
+     * @brief Access an element of the stored triangle.
+     * @param i Row index.
+     * @param j Column index.
+     * @return Const reference to the element.
+     */
+    [[nodiscard]] T const &stored(long i, long j) const { return data_(idxm_(i, j)); }
+
+    /**
+     * @brief Perform the rank-1 update \f$ \mathbf{A} \leftarrow \alpha \mathbf{x} \mathbf{x}^H + \mathbf{A} \f$.
+     *
+     * @details It calls nda::blas::spr.
+     *
+     * @tparam X nda::MemoryVector type.
+     * @param alpha Real scalar.
+     * @param x Vector of size n.
+     */
+    template <MemoryVector X>
+      requires(std::is_same_v<get_value_t<X>, T>)
+    void rank1_update(double alpha, X const &x) {
+      EXPECTS(x.size() == extent(0));
+      blas::spr(alpha, x, data_, UpLo);
+    }
+
+    /**
+     * @brief Convert to a full matrix.
+     * @return Matrix in Fortran order containing both triangles.
+     */
+    [[nodiscard]] matrix<T, F_layout> to_dense() const {
+      auto res = matrix<T, F_layout>(shape());
+      for (long j = 0; j < extent(1); ++j)
+        for (long i = 0; i < extent(0); ++i) res(i, j) = (*this)(i, j);
+      return res;
+    }
+  };
+
+  /**
+   * @brief Compute the matrix-vector product \f$ \mathbf{y} \leftarrow \alpha \mathbf{A x} + \beta \mathbf{y} \f$ with a
+   * packed matrix.
+   *
+   * @details It calls nda::blas::spmv.
+   *
+   * @tparam T Value type of the matrix.
+   * @tparam UpLo Stored triangle.
+   * @tparam X nda::MemoryVector type.
+   * @tparam Y nda::MemoryVector type.
+   * @param alpha Input scalar.
+   * @param a Packed matrix \f$ \mathbf{A} \f$.
+   * @param x Input vector.
+   * @param beta Input scalar.
+   * @param y Input/output vector.
+   */
+  template <typename T, char UpLo, MemoryVector X, MemoryVector Y>
+    requires(have_same_value_type_v<X, Y> and std::is_same_v<get_value_t<X>, T>)
+  void gemv(T alpha, packed_matrix<T, UpLo> const &a, X const &x, T beta, Y &&y) { // NOLINT (temporary views are allowed here)
+    EXPECTS(x.size() == a.extent(1) and y.size() == a.extent(0));
+    blas::spmv(alpha, a.storage(), x, beta, y, UpLo);
+  }
+
+  /**
+   * @brief Multiplication operator for a packed matrix and a vector.
+   *
+   * @tparam T Value type of the matrix.
+   * @tparam UpLo Stored triangle.
+   * @tparam V nda::Vector type.
+   * @param a Packed matrix.
+   * @param x Vector.
+   * @return Product \f$ \mathbf{A x} \f$.
+   */
+  template <typename T, char UpLo, Vector V>
+    requires(std::is_same_v<get_value_t<V>, T>)
+  vector<T> operator*(packed_matrix<T, UpLo> const &a, V const &x) {
+    auto y = vector<T>(a.extent(0));
+    if constexpr (MemoryVector<V>) {
+      gemv(T{1}, a, x, T{0}, y);
+    } else {
+      gemv(T{1}, a, vector<T>{x}, T{0}, y);
+    }
+    return y;
+  }
+
+  /**
+   * @brief Find the eigenvalues of a packed symmetric (real) or hermitian (complex) matrix.
+   *
+   * @details It calls nda::lapack::spev on a copy of the packed array.
+   *
+   * @tparam T Value type of the matrix.
+   * @tparam UpLo Stored triangle.
+   * @param a Packed matrix.
+   * @return An nda::array of rank 1 containing the eigenvalues in ascending order.
+   */
+  template <typename T, char UpLo>
+  array<double, 1> eigenvalues(packed_matrix<T, UpLo> const &a) {
+    auto ap = a.storage();
+    auto ev = array<double, 1>(a.extent(0));
+    auto z  = matrix<T, F_layout>(1, 1);
+    lapack::spev(ap, ev, z, 'N', UpLo);
+    return ev;
+  }
+
+  /**
+   * @brief Find the eigenvalues and eigenvectors of a packed symmetric (real) or hermitian (complex) matrix.
+   *
+   * @details It calls nda::lapack::spev on a copy of the packed array.
+   *
+   * @tparam T Value type of the matrix.
+   * @tparam UpLo Stored triangle.
+   * @param a Packed matrix.
+   * @return std::pair consisting of the array of eigenvalues in ascending order and the matrix containing the
+   * eigenvectors in its columns.
+   */
+  template <typename T, char UpLo>
+  std::pair<array<double, 1>, matrix<T, F_layout>> eigenelements(packed_matrix<T, UpLo> const &a) {
+    auto ap   = a.storage();
+    auto ev   = array<double, 1>(a.extent(0));
+    auto vecs = matrix<T, F_layout>(a.shape());
+    lapack::spev(ap, ev, vecs, 'V', UpLo);
+    return {ev, vecs};
+  }
+
+  /** @} */
+
+} // namespace nda::linalg
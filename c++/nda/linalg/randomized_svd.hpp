@@ -0,0 +1,197 @@
+// Copyright (c) 2024 Simons Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file
+ * @brief Provides a randomized algorithm for the truncated singular value decomposition of (numerically) low-rank
+ * matrices.
+ */
+
+#pragma once
+
+#include "../basic_array.hpp"
+#include "../blas/gemm.hpp"
+#include "../concepts.hpp"
+#include "../declarations.hpp"
+#include "../exceptions.hpp"
+#include "../lapack/geqp3.hpp"
+#include "../lapack/gesvd.hpp"
+#include "../lapack/orgqr.hpp"
+#include "../lapack/ungqr.hpp"
+#include "../layout/policies.hpp"
+#include "../layout/range.hpp"
+#include "../matrix_functions.hpp"
+#include "../mem/address_space.hpp"
+#include "../traits.hpp"
+
+#include <algorithm>
+#include <complex>
+#include <cstdint>
+#include <random>
+#include <tuple>
+#include <utility>
+
+namespace nda::linalg {
+
+  /**
+   * @addtogroup linalg_tools
+   * @{
+   */
+
+  namespace detail {
+
+    // Fill an array with independent standard normal random numbers (real and imaginary parts are independent).
+    template <typename A>
+    void fill_gaussian(A &&m, std::uint64_t seed) { // NOLINT (temporary views are allowed here)
+      using T   = get_value_t<A>;
+      auto gen  = std::mt19937_64{seed};
+      auto dist = std::normal_distribution<double>{};
+      for (auto &x : m) {
+        if constexpr (is_complex_v<T>)
+          x = T{dist(gen), dist(gen)};
+        else
+          x = dist(gen);
+      }
+    }
+
+    // Replace the columns of a tall matrix by an orthonormal basis of their span (QR with column pivoting).
+    template <typename T>
+    void orthonormalize_columns(matrix<T, F_layout> &y) {
+      auto jpvt = nda::zeros<int>(y.extent(1));
+      auto tau  = nda::vector<T>(std::min(y.extent(0), y.extent(1)));
+      lapack::geqp3(y, jpvt, tau);
+      if constexpr (is_complex_v<T>)
+        lapack::ungqr(y, tau);
+      else
+        lapack::orgqr(y, tau);
+    }
+
+  } // namespace detail
+
+  /**
+   * @brief Compute the leading singular triplets of a linear operator with a randomized algorithm.
+   *
+   * @details Matrix-free version of nda::linalg::randomized_svd. The m-by-n operator \f$ \mathbf{A} \f$ is only
+   * accessed through the two callables
+   * - `apply(X)`: returns \f$ \mathbf{A X} \f$ (m-by-l) for an n-by-l Fortran matrix \f$ \mathbf{X} \f$,
+   * - `apply_adjoint(Y)`: returns \f$ \mathbf{A}^H \mathbf{Y} \f$ (n-by-l) for an m-by-l Fortran matrix
+   * \f$ \mathbf{Y} \f$,
+   *
+   * where `l = min(k + oversampling, m, n)`. The results are converted to `nda::matrix<T, nda::F_layout>`.
+   *
+   * The algorithm (Halko, Martinsson and Tropp, SIAM Rev. 53, 217 (2011)) applies \f$ \mathbf{A} \f$ to a Gaussian
+   * random n-by-l matrix, orthonormalizes the result to get a basis \f$ \mathbf{Q} \f$ of the approximate range of
+   * \f$ \mathbf{A} \f$, optionally refines it with power iterations and finally computes the SVD of the small l-by-n
+   * matrix \f$ \mathbf{Q}^H \mathbf{A} \f$. It requires `2 * (power_iterations + 1)` applications of the operator
+   * (or its adjoint) to l vectors, i.e. O(mnk) operations and O((m + n)k) memory.
+   *
+   * The accuracy depends on the decay of the singular values. Power iterations improve it for slowly decaying
+   * spectra.
+   *
+   * @tparam T Value type of the operator (double or std::complex<double>).
+   * @tparam F Callable type of `apply`.
+   * @tparam G Callable type of `apply_adjoint`.
+   * @param m Number of rows of \f$ \mathbf{A} \f$.
+   * @param n Number of columns of \f$ \mathbf{A} \f$.
+   * @param apply Callable computing \f$ \mathbf{A X} \f$.
+   * @param apply_adjoint Callable computing \f$ \mathbf{A}^H \mathbf{Y} \f$.
+   * @param k Number of singular triplets to compute (`0 < k <= min(m, n)`).
+   * @param oversampling Number of additional random vectors used to sample the range of \f$ \mathbf{A} \f$.
+   * @param power_iterations Number of power iterations.
+   * @param seed Seed of the random number generator.
+   * @return std::tuple containing the m-by-k matrix \f$ \mathbf{U} \f$ of left singular vectors, the k largest
+   * singular values in descending order and the k-by-n matrix \f$ \mathbf{V}^H \f$ of right singular vectors.
+   */
+  template <typename T, typename F, typename G>
+    requires(is_blas_lapack_v<T>)
+  auto randomized_svd(long m, long n, F &&apply, G &&apply_adjoint, long k, long oversampling = 10, int power_iterations = 2,
+                      std::uint64_t seed = 0) {
+    using matrix_t = matrix<T, F_layout>;
+    if (k <= 0 or k > std::min(m, n)) NDA_RUNTIME_ERROR << "Error in nda::linalg::randomized_svd: Invalid number of singular values k = " << k;
+    long l = std::min({k + std::max(0l, oversampling), m, n});
+
+    // sample the range of A and refine it with power iterations
+    auto omega = matrix_t(n, l);
+    detail::fill_gaussian(omega, seed);
+    matrix_t q = apply(std::as_const(omega));
+    EXPECTS(q.extent(0) == m and q.extent(1) == l);
+    detail::orthonormalize_columns(q);
+    for (int i = 0; i < power_iterations; ++i) {
+      matrix_t z = apply_adjoint(std::as_const(q));
+      detail::orthonormalize_columns(z);
+      q = apply(std::as_const(z));
+      detail::orthonormalize_columns(q);
+    }
+
+    // SVD of the small matrix B = Q^H A
+    matrix_t b = dagger(matrix_t{apply_adjoint(std::as_const(q))});
+    auto s     = nda::vector<double>(l);
+    auto u_b   = matrix_t(l, l);
+    auto vh_b  = matrix_t(l, n);
+    lapack::gesvd(b, s, u_b, vh_b, 'S');
+
+    // truncate to the leading k singular triplets
+    auto _     = range::all;
+    matrix_t u = q * u_b(_, range(k));
+    return std::make_tuple(std::move(u), nda::vector<double>{s(range(k))}, matrix_t{vh_b(range(k), _)});
+  }
+
+  /**
+   * @brief Compute the leading singular triplets of a matrix with a randomized algorithm.
+   *
+   * @details It approximates the truncated SVD \f$ \mathbf{A} \approx \mathbf{U}_k \mathbf{S}_k \mathbf{V}^H_k \f$
+   * of an m-by-n matrix, where only the k largest singular values and the corresponding singular vectors are
+   * computed. For numerically low-rank matrices, it is much faster than the full SVD with nda::lapack::gesvd, which
+   * requires O(mn min(m, n)) operations.
+   *
+   * The products with \f$ \mathbf{A} \f$ and \f$ \mathbf{A}^H \f$ are computed with nda::blas::gemm. See
+   * nda::linalg::randomized_svd(long, long, F &&, G &&, long, long, int, std::uint64_t) for more details and for a
+   * matrix-free version.
+   *
+   * @tparam A nda::Matrix type.
+   * @param a Input matrix (it is not modified).
+   * @param k Number of singular triplets to compute (`0 < k <= min(m, n)`).
+   * @param oversampling Number of additional random vectors used to sample the range of \f$ \mathbf{A} \f$.
+   * @param power_iterations Number of power iterations.
+   * @param seed Seed of the random number generator.
+   * @return std::tuple containing the m-by-k matrix \f$ \mathbf{U} \f$ of left singular vectors, the k largest
+   * singular values in descending order and the k-by-n matrix \f$ \mathbf{V}^H \f$ of right singular vectors.
+   */
+  template <Matrix A>
+    requires(mem::on_host<A> and is_blas_lapack_v<get_value_t<A>>)
+  auto randomized_svd(A const &a, long k, long oversampling = 10, int power_iterations = 2, std::uint64_t seed = 0) {
+    using value_t  = get_value_t<A>;
+    using matrix_t = matrix<value_t, F_layout>;
+    if constexpr (not MemoryMatrix<A>) {
+      return randomized_svd(matrix_t{a}, k, oversampling, power_iterations, seed);
+    } else {
+      auto [m, n] = a.shape();
+      auto apply  = [&a, m](matrix_t const &x) {
+        auto y = matrix_t(m, x.extent(1));
+        blas::gemm(value_t{1}, a, x, value_t{0}, y);
+        return y;
+      };
+      auto apply_adjoint = [&a, n](matrix_t const &y) {
+        // compute (Y^H A)^H to avoid a conjugated operand with C layout
+        auto z = matrix_t(y.extent(1), n);
+        blas::gemm(value_t{1}, dagger(y), a, value_t{0}, z);
+        return matrix_t{dagger(z)};
+      };
+      return randomized_svd<value_t>(m, n, apply, apply_adjoint, k, oversampling, power_iterations, seed);
+    }
+  }
+
+  /** @} */
+
+} // namespace nda::linalg
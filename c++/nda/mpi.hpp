@@ -23,5 +23,6 @@
 
 #include "./mpi/broadcast.hpp"
 #include "./mpi/gather.hpp"
+#include "./mpi/nonblocking.hpp"
 #include "./mpi/reduce.hpp"
 #include "./mpi/scatter.hpp"
@@ -0,0 +1,556 @@
+// Copyright (c) 2024 Simons Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file
+ * @brief Provides non-blocking MPI reduce, gather, scatter and broadcast functions for nda::Array types.
+ */
+
+#pragma once
+
+#include "../basic_array.hpp"
+#include "../basic_functions.hpp"
+#include "../concepts.hpp"
+#include "../declarations.hpp"
+#include "../exceptions.hpp"
+#include "../layout/policies.hpp"
+#include "../mem/address_space.hpp"
+#include "../mem/policies.hpp"
+#include "../traits.hpp"
+
+#include <mpi/mpi.hpp>
+
+#include <array>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace nda {
+
+  namespace detail {
+
+    // Heap allocated array on host memory which is used to receive the result of a non-blocking MPI operation on an
+    // array of type A (the address of its data does not change when it is moved).
+    template <typename A, typename RT = get_regular_t<A>>
+    using mpi_buffer_t = basic_array<get_value_t<RT>, get_rank<RT>, get_contiguous_layout_policy<get_rank<RT>, get_layout_info<RT>.stride_order>,
+                                     get_algebra<RT>, heap<mem::Host>>;
+
+    // Take ownership of an rvalue array/view which is used as a send buffer of a non-blocking MPI operation. Lvalues
+    // are not owned and have to be kept alive by the caller.
+    template <typename A>
+    std::shared_ptr<std::decay_t<A> const> mpi_keep_alive(std::remove_reference_t<A> &a) {
+      if constexpr (std::is_lvalue_reference_v<A>) {
+        return {};
+      } else {
+        return std::make_shared<std::decay_t<A> const>(std::move(a));
+      }
+    }
+
+    // Check the requirements on an array/view which is passed to a non-blocking MPI operation.
+    template <typename A>
+    void mpi_check_nonblocking(A const &a, const char *fname) {
+      static_assert(mpi::has_mpi_type<get_value_t<A>>, "Error in non-blocking MPI operation for nda::Array: Value type has no MPI type");
+      if (not a.is_contiguous()) NDA_RUNTIME_ERROR << "Error in nda::" << fname << ": Array needs to be contiguous";
+    }
+
+  } // namespace detail
+
+  /**
+   * @ingroup av_mpi
+   * @brief Handle to a pending non-blocking MPI operation on nda::Array objects.
+   *
+   * @details It is returned by nda::mpi_ireduce, nda::mpi_igather, nda::mpi_iscatter and nda::mpi_ibroadcast. The
+   * object owns everything the MPI library accesses while the operation is in progress, i.e. the receive buffer, the
+   * send buffer if it has been passed as an rvalue and the counts and displacements of the `v`-collectives. Send
+   * buffers passed as lvalues and the target of a broadcast are not owned and must neither be modified nor destroyed
+   * before the operation has completed.
+   *
+   * The result is obtained with nda::mpi_future::get, which waits for the operation to complete. The destructor waits
+   * as well, so that a future going out of scope never leaves a dangling MPI request behind.
+   *
+   * @tparam T Type of the result, i.e. an nda::basic_array or an nda::basic_array_view.
+   */
+  template <typename T>
+  class mpi_future {
+    // Receive buffer.
+    T result_;
+
+    // Send buffer (only if it is owned by the future).
+    std::shared_ptr<void const> send_;
+
+    // Counts and displacements of the v-collectives.
+    std::vector<int> counts_, displs_;
+
+    // MPI request handle.
+    MPI_Request req_ = MPI_REQUEST_NULL;
+
+    public:
+    /// Default constructor constructs a future without a pending operation.
+    mpi_future() = default;
+
+    /**
+     * @brief Construct a future and start the non-blocking MPI operation.
+     *
+     * @details The operation is started by calling `start(result, counts, displs, request)` with references to the
+     * members of the future. In a non-MPI run, it is not called at all.
+     *
+     * @tparam F Callable type.
+     * @param result Receive buffer.
+     * @param send Owned send buffer or a `nullptr`.
+     * @param counts Counts of the v-collectives.
+     * @param displs Displacements of the v-collectives.
+     * @param start Callable which starts the operation.
+     */
+    template <typename F>
+    mpi_future(T result, std::shared_ptr<void const> send, std::vector<int> counts, std::vector<int> displs, F &&start)
+       : result_(std::move(result)), send_(std::move(send)), counts_(std::move(counts)), displs_(std::move(displs)) {
+      if (mpi::has_env) start(result_, counts_, displs_, &req_);
+    }
+
+    /// Deleted copy constructor.
+    mpi_future(mpi_future const &) = delete;
+
+    /// Deleted copy assignment operator.
+    mpi_future &operator=(mpi_future const &) = delete;
+
+    /// Move constructor takes over the pending operation.
+    mpi_future(mpi_future &&other) noexcept
+       : result_(std::move(other.result_)),
+         send_(std::move(other.send_)),
+         counts_(std::move(other.counts_)),
+         displs_(std::move(other.displs_)),
+         req_(std::exchange(other.req_, MPI_REQUEST_NULL)) {}
+
+    /// Move assignment operator waits for the current operation before it takes over the pending one of the other
+    /// future.
+    mpi_future &operator=(mpi_future &&other) noexcept {
+      if (this != &other) {
+        wait();
+        // views have to be rebound, since their assignment operator copies the data
+        if constexpr (is_view_v<T>)
+          result_.rebind(other.result_);
+        else
+          result_ = std::move(other.result_);
+        send_   = std::move(other.send_);
+        counts_ = std::move(other.counts_);
+        displs_ = std::move(other.displs_);
+        req_    = std::exchange(other.req_, MPI_REQUEST_NULL);
+      }
+      return *this;
+    }
+
+    /// Destructor waits for the pending operation to complete.
+    ~mpi_future() { wait(); }
+
+    /**
+     * @brief Check if the operation has completed without blocking.
+     * @return True if there is no pending operation.
+     */
+    [[nodiscard]] bool test() {
+      if (req_ == MPI_REQUEST_NULL) return true;
+      int flag = 0;
+      MPI_Test(&req_, &flag, MPI_STATUS_IGNORE);
+      return flag != 0;
+    }
+
+    /// Block until the operation has completed.
+    void wait() {
+      if (req_ != MPI_REQUEST_NULL) MPI_Wait(&req_, MPI_STATUS_IGNORE);
+    }
+
+    /**
+     * @brief Wait for the operation to complete and get the result.
+     * @details The result is moved out of the future, i.e. this function should only be called once.
+     * @return Result of the operation.
+     */
+    [[nodiscard]] T get() {
+      wait();
+      return std::move(result_);
+    }
+  };
+
+  /**
+   * @ingroup av_mpi
+   * @brief Non-blocking MPI reduce for nda::basic_array or nda::basic_array_view types.
+   *
+   * @details It calls `MPI_Ireduce` or, if `all == true`, `MPI_Iallreduce` and returns immediately. The reduction of one
+   * block can therefore be overlapped with the computation of the next one:
+   *
+   * @code{.cpp}
+   * auto f = nda::mpi_ireduce(compute_block(0), comm, 0, true);
+   * for (int i = 1; i < n_blocks; ++i) {
+   *   auto next = compute_block(i);                  // overlaps with the reduction of block i - 1
+   *   res(i - 1, nda::ellipsis{}) = f.get();
+   *   f = nda::mpi_ireduce(std::move(next), comm, 0, true);
+   * }
+   * res(n_blocks - 1, nda::ellipsis{}) = f.get();
+   * @endcode
+   *
+   * If an array is passed as an rvalue, the future takes it over and the reduction is performed in-place in its memory.
+   * Otherwise, a new array is allocated for the result, which has the same shape as the input on the receiving
+   * processes and is empty on all other processes.
+   *
+   * @tparam A nda::basic_array or nda::basic_array_view type with a contiguous layout.
+   * @param a Array or view to be reduced.
+   * @param comm `mpi::communicator` object.
+   * @param root Rank of the root process.
+   * @param all Should all processes receive the result of the reduction.
+   * @param op MPI reduction operation.
+   * @return nda::mpi_future holding the result.
+   */
+  template <typename A>
+  auto mpi_ireduce(A &&a, mpi::communicator comm = {}, int root = 0, bool all = false, MPI_Op op = MPI_SUM)
+    requires(is_regular_or_view_v<A>)
+  {
+    detail::mpi_check_nonblocking(a, "mpi_ireduce");
+    using buffer_t   = detail::mpi_buffer_t<A>;
+    using value_type = get_value_t<A>;
+    bool const recv  = all or comm.rank() == root;
+
+    if constexpr (not std::is_reference_v<A> and std::is_same_v<std::decay_t<A>, buffer_t>) {
+      // reduce in-place in the memory of the given array
+      return mpi_future<buffer_t>{std::move(a), nullptr, {}, {}, [&](auto &res, auto &, auto &, MPI_Request *req) {
+                                    int count = static_cast<int>(res.size());
+                                    auto type = mpi::mpi_type<value_type>::get();
+                                    if (all)
+                                      MPI_Iallreduce(MPI_IN_PLACE, res.data(), count, type, op, comm.get(), req);
+                                    else
+                                      MPI_Ireduce((recv ? MPI_IN_PLACE : res.data()), res.data(), count, type, op, root, comm.get(), req);
+                                  }};
+    } else {
+      // reduce into a newly allocated array
+      auto send       = detail::mpi_keep_alive<A>(a);
+      auto const &src = (send ? *send : a);
+      auto res        = buffer_t{};
+      if (not mpi::has_env)
+        res = src;
+      else if (recv)
+        res.resize(src.shape());
+      return mpi_future<buffer_t>{std::move(res), std::move(send), {}, {}, [&](auto &r, auto &, auto &, MPI_Request *req) {
+                                    int count = static_cast<int>(src.size());
+                                    auto type = mpi::mpi_type<value_type>::get();
+                                    if (all)
+                                      MPI_Iallreduce((void *)src.data(), r.data(), count, type, op, comm.get(), req);
+                                    else
+                                      MPI_Ireduce((void *)src.data(), r.data(), count, type, op, root, comm.get(), req);
+                                  }};
+    }
+  }
+
+  /**
+   * @ingroup av_mpi
+   * @brief Non-blocking MPI gather for nda::basic_array or nda::basic_array_view types.
+   *
+   * @details Like nda::mpi_gather, the arrays are concatenated along their first dimension. The extents of the first
+   * dimensions are exchanged with a (small) blocking call, since they determine the shape of the result. The data is
+   * then gathered with `MPI_Igatherv` or, if `all == true`, `MPI_Iallgatherv`.
+   *
+   * The result is empty on all processes that do not receive the gathered array. If the input is passed as an rvalue,
+   * it is kept alive by the returned future.
+   *
+   * @tparam A nda::basic_array or nda::basic_array_view type with a contiguous layout.
+   * @param a Array or view to be gathered.
+   * @param comm `mpi::communicator` object.
+   * @param root Rank of the root process.
+   * @param all Should all processes receive the result of the gather.
+   * @return nda::mpi_future holding the result.
+   */
+  template <typename A>
+  auto mpi_igather(A &&a, mpi::communicator comm = {}, int root = 0, bool all = false)
+    requires(is_regular_or_view_v<A>)
+  {
+    detail::mpi_check_nonblocking(a, "mpi_igather");
+    using buffer_t   = detail::mpi_buffer_t<A>;
+    using value_type = get_value_t<A>;
+    auto send        = detail::mpi_keep_alive<A>(a);
+    auto const &src  = (send ? *send : a);
+    auto res         = buffer_t{};
+    auto counts      = std::vector<int>{};
+    auto displs      = std::vector<int>{};
+
+    if (not mpi::has_env) {
+      res = src;
+    } else {
+      // exchange the extents of the first dimension
+      auto dims    = src.shape();
+      long dim0    = dims[0];
+      auto dim0s   = std::vector<long>(comm.size());
+      auto long_tp = mpi::mpi_type<long>::get();
+      if (all)
+        MPI_Allgather(&dim0, 1, long_tp, dim0s.data(), 1, long_tp, comm.get());
+      else
+        MPI_Gather(&dim0, 1, long_tp, dim0s.data(), 1, long_tp, root, comm.get());
+
+      // compute receive counts and memory displacements and allocate the result
+      if (all or comm.rank() == root) {
+        long inner = 1;
+        for (int i = 1; i < get_rank<A>; ++i) inner *= dims[i];
+        counts.resize(comm.size());
+        displs.resize(comm.size());
+        dims[0] = 0;
+        for (int r = 0; r < comm.size(); ++r) {
+          counts[r] = static_cast<int>(dim0s[r] * inner);
+          displs[r] = (r == 0 ? 0 : displs[r - 1] + counts[r - 1]);
+          dims[0] += dim0s[r];
+        }
+        res.resize(dims);
+      }
+    }
+
+    return mpi_future<buffer_t>{std::move(res), std::move(send), std::move(counts), std::move(displs),
+                                [&](auto &r, auto &cnts, auto &dspls, MPI_Request *req) {
+                                  int count = static_cast<int>(src.size());
+                                  auto type = mpi::mpi_type<value_type>::get();
+                                  if (all)
+                                    MPI_Iallgatherv((void *)src.data(), count, type, r.data(), cnts.data(), dspls.data(), type, comm.get(), req);
+                                  else
+                                    MPI_Igatherv((void *)src.data(), count, type, r.data(), cnts.data(), dspls.data(), type, root, comm.get(), req);
+                                }};
+  }
+
+  /**
+   * @ingroup av_mpi
+   * @brief Non-blocking MPI scatter for nda::basic_array or nda::basic_array_view types.
+   *
+   * @details Like nda::mpi_scatter, the array on the root process is chunked along its first dimension using
+   * `mpi::chunk_length`. The extent of the first dimension is broadcasted with a (small) blocking call, since it
+   * determines the shape of the result. The data is then scattered with `MPI_Iscatterv`.
+   *
+   * It is assumed that all other extents of the input arrays are the same on all processes. If the input is passed as
+   * an rvalue, it is kept alive by the returned future.
+   *
+   * @tparam A nda::basic_array or nda::basic_array_view type with a contiguous layout.
+   * @param a Array or view to be scattered.
+   * @param comm `mpi::communicator` object.
+   * @param root Rank of the root process.
+   * @return nda::mpi_future holding the result.
+   */
+  template <typename A>
+  auto mpi_iscatter(A &&a, mpi::communicator comm = {}, int root = 0)
+    requires(is_regular_or_view_v<A>)
+  {
+    detail::mpi_check_nonblocking(a, "mpi_iscatter");
+    using buffer_t   = detail::mpi_buffer_t<A>;
+    using value_type = get_value_t<A>;
+    auto send        = detail::mpi_keep_alive<A>(a);
+    auto const &src  = (send ? *send : a);
+    auto res         = buffer_t{};
+    auto counts      = std::vector<int>{};
+    auto displs      = std::vector<int>{};
+
+    if (not mpi::has_env) {
+      res = src;
+    } else {
+      // broadcast the extent of the first dimension and allocate the result
+      auto dims = src.shape();
+      long dim0 = dims[0];
+      MPI_Bcast(&dim0, 1, mpi::mpi_type<long>::get(), root, comm.get());
+      dims[0] = mpi::chunk_length(dim0, comm.size(), comm.rank());
+      res.resize(dims);
+
+      // compute send counts and memory displacements
+      long inner = 1;
+      for (int i = 1; i < get_rank<A>; ++i) inner *= dims[i];
+      counts.resize(comm.size());
+      displs.resize(comm.size());
+      for (int r = 0; r < comm.size(); ++r) {
+        counts[r] = static_cast<int>(mpi::chunk_length(dim0, comm.size(), r) * inner);
+        displs[r] = (r == 0 ? 0 : displs[r - 1] + counts[r - 1]);
+      }
+    }
+
+    return mpi_future<buffer_t>{std::move(res), std::move(send), std::move(counts), std::move(displs),
+                                [&](auto &r, auto &cnts, auto &dspls, MPI_Request *req) {
+                                  auto type = mpi::mpi_type<value_type>::get();
+                                  MPI_Iscatterv((void *)src.data(), cnts.data(), dspls.data(), type, r.data(), static_cast<int>(r.size()), type,
+                                                root, comm.get(), req);
+                                }};
+  }
+
+  /**
+   * @ingroup av_mpi
+   * @brief Non-blocking MPI broadcast for nda::basic_array or nda::basic_array_view types.
+   *
+   * @details The shape of the array on the root process is broadcasted with a (small) blocking call and the array/view
+   * is resized/checked on all other processes. The data is then broadcasted with `MPI_Ibcast`.
+   *
+   * The array/view must neither be accessed nor destroyed before the returned future has completed.
+   *
+   * @tparam A nda::basic_array or nda::basic_array_view type with a contiguous layout.
+   * @param a Array or view to be broadcasted from/into.
+   * @param comm `mpi::communicator` object.
+   * @param root Rank of the root process.
+   * @return nda::mpi_future holding a view of the given array.
+   */
+  template <typename A>
+  auto mpi_ibroadcast(A &a, mpi::communicator comm = {}, int root = 0)
+    requires(is_regular_or_view_v<A>)
+  {
+    static_assert(has_contiguous_layout<A>, "Error in nda::mpi_ibroadcast: Array needs to be contiguous");
+    detail::mpi_check_nonblocking(a, "mpi_ibroadcast");
+    using value_type = get_value_t<A>;
+    using view_t     = std::decay_t<decltype(a())>;
+    if (mpi::has_env) {
+      auto dims = a.shape();
+      MPI_Bcast(dims.data(), dims.size(), mpi::mpi_type<long>::get(), root, comm.get());
+      if (comm.rank() != root) resize_or_check_if_view(a, dims);
+    }
+    return mpi_future<view_t>{a(), nullptr, {}, {}, [&](auto &r, auto &, auto &, MPI_Request *req) {
+                                MPI_Ibcast(r.data(), static_cast<int>(r.size()), mpi::mpi_type<value_type>::get(), root, comm.get(), req);
+                              }};
+  }
+
+  /**
+   * @ingroup av_mpi
+   * @brief Persistent MPI reduction of arrays with a fixed shape.
+   *
+   * @details For repeated reductions of arrays with the same shape, the MPI request is set up once in the constructor
+   * (with `MPI_Reduce_init` or `MPI_Allreduce_init`, if the MPI library implements the MPI 4.0 standard) and every
+   * reduction only has to be started. The reduction is performed in-place in an array owned by the object:
+   *
+   * @code{.cpp}
+   * auto r = nda::mpi_persistent_reduce<nda::array<double, 2>>{{n, m}, comm, 0, true};
+   * for (int i = 0; i < n_iter; ++i) {
+   *   r.buffer() = compute(i);
+   *   r.start();
+   *   // ... do something else ...
+   *   res += r.wait();
+   * }
+   * @endcode
+   *
+   * To overlap the reduction of one block with the computation of the next, two objects can be used alternately. For
+   * MPI libraries without persistent collectives, every call to nda::mpi_persistent_reduce::start starts a new
+   * non-blocking reduction on the same buffer instead.
+   *
+   * @tparam A nda::basic_array type with a contiguous layout on host memory.
+   */
+  template <typename A>
+    requires(is_regular_v<A> and mem::on_host<A> and has_contiguous_layout<A>)
+  class mpi_persistent_reduce {
+    // Buffer in which the reduction is performed.
+    A buf_;
+
+    // MPI communicator.
+    mpi::communicator comm_;
+
+    // Rank of the root process.
+    int root_ = 0;
+
+    // Should all processes receive the result.
+    bool all_ = false;
+
+    // MPI reduction operation.
+    MPI_Op op_ = MPI_SUM;
+
+    // MPI request handle.
+    MPI_Request req_ = MPI_REQUEST_NULL;
+
+    // Is there a pending reduction.
+    bool active_ = false;
+
+    // Start a non-blocking or initialize a persistent reduction.
+    template <typename F, typename G>
+    void call(F all_fn, G root_fn) {
+      int count = static_cast<int>(buf_.size());
+      auto type = mpi::mpi_type<get_value_t<A>>::get();
+      if (all_)
+        all_fn(MPI_IN_PLACE, buf_.data(), count, type, op_, comm_.get());
+      else
+        root_fn((comm_.rank() == root_ ? MPI_IN_PLACE : buf_.data()), buf_.data(), count, type, op_, root_, comm_.get());
+    }
+
+    public:
+    /**
+     * @brief Construct the object and initialize the persistent request.
+     *
+     * @param shape Shape of the arrays to be reduced.
+     * @param comm `mpi::communicator` object.
+     * @param root Rank of the root process.
+     * @param all Should all processes receive the result of the reduction.
+     * @param op MPI reduction operation.
+     */
+    explicit mpi_persistent_reduce(std::array<long, A::rank> const &shape, mpi::communicator comm = {}, int root = 0, bool all = false,
+                                   MPI_Op op = MPI_SUM)
+       : buf_(A::zeros(shape)), comm_(comm), root_(root), all_(all), op_(op) {
+      static_assert(mpi::has_mpi_type<get_value_t<A>>, "Error in nda::mpi_persistent_reduce: Value type has no MPI type");
+#if MPI_VERSION >= 4
+      if (mpi::has_env) {
+        call([this](auto... args) { MPI_Allreduce_init(args..., MPI_INFO_NULL, &req_); },
+             [this](auto... args) { MPI_Reduce_init(args..., MPI_INFO_NULL, &req_); });
+      }
+#endif
+    }
+
+    /// Deleted copy constructor (the persistent request is bound to the buffer).
+    mpi_persistent_reduce(mpi_persistent_reduce const &) = delete;
+
+    /// Deleted copy assignment operator.
+    mpi_persistent_reduce &operator=(mpi_persistent_reduce const &) = delete;
+
+    /// Destructor waits for a pending reduction and frees the persistent request.
+    ~mpi_persistent_reduce() {
+      wait();
+#if MPI_VERSION >= 4
+      if (req_ != MPI_REQUEST_NULL) MPI_Request_free(&req_);
+#endif
+    }
+
+    /**
+     * @brief Get a view of the buffer.
+     * @details Before a reduction is started, the input has to be written into it. After it has completed, it contains
+     * the result on the receiving processes.
+     * @return View of the buffer.
+     */
+    [[nodiscard]] auto buffer() {
+      if (active_) NDA_RUNTIME_ERROR << "Error in nda::mpi_persistent_reduce::buffer: Reduction is in progress";
+      return buf_();
+    }
+
+    /// Start the reduction of the current content of the buffer.
+    void start() {
+      if (active_) NDA_RUNTIME_ERROR << "Error in nda::mpi_persistent_reduce::start: Reduction is already in progress";
+      if (not mpi::has_env) return;
+#if MPI_VERSION >= 4
+      MPI_Start(&req_);
+#else
+      call([this](auto... args) { MPI_Iallreduce(args..., &req_); }, [this](auto... args) { MPI_Ireduce(args..., &req_); });
+#endif
+      active_ = true;
+    }
+
+    /**
+     * @brief Check if the reduction has completed without blocking.
+     * @return True if there is no pending reduction.
+     */
+    [[nodiscard]] bool test() {
+      if (not active_) return true;
+      int flag = 0;
+      MPI_Test(&req_, &flag, MPI_STATUS_IGNORE);
+      active_ = (flag == 0);
+      return not active_;
+    }
+
+    /**
+     * @brief Block until the reduction has completed.
+     * @return Const view of the buffer containing the result.
+     */
+    auto wait() {
+      if (active_) MPI_Wait(&req_, MPI_STATUS_IGNORE);
+      active_ = false;
+      return make_const_view(buf_);
+    }
+  };
+
+} // namespace nda
@@ -53,6 +53,7 @@
 #include "./matrix_functions.hpp"
 #include "./mem.hpp"
 #include "./print.hpp"
+#include "./sparse.hpp"
 #include "./stdutil.hpp"
 #include "./traits.hpp"
 
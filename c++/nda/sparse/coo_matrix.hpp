@@ -0,0 +1,178 @@
+// Copyright (c) 2024 Simons Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+/**
+ * @file
+ * @brief Provides a sparse matrix in coordinate (COO) format for the assembly of sparse matrices.
+ */
+
+#pragma once
+
+#include "../basic_array.hpp"
+#include "../concepts.hpp"
+#include "../declarations.hpp"
+#include "../exceptions.hpp"
+#include "../layout/range.hpp"
+#include "../macros.hpp"
+
+#include <algorithm>
+#include <array>
+#include <utility>
+
+namespace nda::sparse {
+
+  /**
+   * @addtogroup linalg_sparse
+   * @{
+   */
+
+  /**
+   * @brief Sparse m-by-n matrix in coordinate (COO) format.
+   *
+   * @details It stores a list of (row, column, value) triplets in three nda arrays and is meant for the assembly of a
+   * sparse matrix, e.g. term by term from a Hamiltonian, which is then converted to an nda::sparse::csr_matrix for
+   * computations. The triplets can be added in any order and duplicate entries are summed up during the conversion.
+   *
+   * The storage grows geometrically, i.e. adding an element costs amortized O(1) operations.
+   *
+   * @tparam T Value type of the matrix.
+   */
+  template <typename T>
+  class coo_matrix {
+    // Number of rows and columns.
+    long nrows_ = 0, ncols_ = 0;
+
+    // Number of stored triplets.
+    long nnz_ = 0;
+
+    // Row indices, column indices and values of the triplets (only the first nnz_ elements are used).
+    array<long, 1> rows_, cols_;
+    array<T, 1> values_;
+
+    // Copy the first nnz_ elements of an array into a new array of the given size.
+    template <typename A>
+    static A grown(A const &a, long nnz, long cap) {
+      auto res = A(cap);
+      std::copy(a.data(), a.data() + nnz, res.data());
+      return res;
+    }
+
+    public:
+    /// Value type of the matrix.
+    using value_type = T;
+
+    /// Default constructor creates an empty 0-by-0 matrix.
+    coo_matrix() = default;
+
+    /**
+     * @brief Construct an m-by-n matrix without any elements.
+     * @param nrows Number of rows.
+     * @param ncols Number of columns.
+     * @param capacity Number of triplets for which storage is reserved.
+     */
+    coo_matrix(long nrows, long ncols, long capacity = 0) : nrows_(nrows), ncols_(ncols) {
+      EXPECTS(nrows >= 0 and ncols >= 0);
+      reserve(capacity);
+    }
+
+    /**
+     * @brief Reserve storage for the given number of triplets.
+     * @param cap Requested capacity.
+     */
+    void reserve(long cap) {
+      if (cap <= capacity()) return;
+      rows_   = grown(rows_, nnz_, cap);
+      cols_   = grown(cols_, nnz_, cap);
+      values_ = grown(values_, nnz_, cap);
+    }
+
+    /**
+     * @brief Get the number of triplets that can be stored without reallocation.
+     * @return Capacity of the storage.
+     */
+    [[nodiscard]] long capacity() const { return values_.size(); }
+
+    /**
+     * @brief Get the extent of the matrix in a given dimension.
+     * @param i Dimension (0: rows, 1: columns).
+     * @return Number of rows or columns.
+     */
+    [[nodiscard]] long extent(int i) const { return (i == 0 ? nrows_ : ncols_); }
+
+    /**
+     * @brief Get the shape of the matrix.
+     * @return std::array containing the number of rows and columns.
+     */
+    [[nodiscard]] std::array<long, 2> shape() const { return {nrows_, ncols_}; }
+
+    /**
+     * @brief Get the number of stored triplets (including duplicates and explicit zeros).
+     * @return Number of triplets.
+     */
+    [[nodiscard]] long nnz() const { return nnz_; }
+
+    /**
+     * @brief Add a triplet.
+     *
+     * @details If the element (i, j) has already been added, the values are summed up during the conversion to an
+     * nda::sparse::csr_matrix.
+     *
+     * @param i Row index.
+     * @param j Column index.
+     * @param v Value.
+     */
+    void insert(long i, long j, T const &v) {
+      EXPECTS(0 <= i and i < nrows_ and 0 <= j and j < ncols_);
+      if (nnz_ == capacity()) reserve(std::max(2 * capacity(), 16l));
+      rows_(nnz_)   = i;
+      cols_(nnz_)   = j;
+      values_(nnz_) = v;
+      ++nnz_;
+    }
+
+    /// Remove all triplets (the storage is kept).
+    void clear() { nnz_ = 0; }
+
+    /**
+     * @brief Get the row indices of the triplets.
+     * @return Const view of the row indices.
+     */
+    [[nodiscard]] auto rows() const { return rows_(range(nnz_)); }
+
+    /**
+     * @brief Get the column indices of the triplets.
+     * @return Const view of the column indices.
+     */
+    [[nodiscard]] auto cols() const { return cols_(range(nnz_)); }
+
+    /**
+     * @brief Get the values of the triplets.
+     * @return Const view of the values.
+     */
+    [[nodiscard]] auto values() const { return values_(range(nnz_)); }
+
+    /**
+     * @brief Convert the matrix to a dense matrix.
+     * @details Duplicate entries are summed up.
+     * @return nda::matrix containing the same elements.
+     */
+    [[nodiscard]] matrix<T> to_dense() const {
+      auto res = matrix<T>::zeros(nrows_, ncols_);
+      for (long k = 0; k < nnz_; ++k) res(rows_(k), cols_(k)) += values_(k);
+      return res;
+    }
+  };
+
+  /** @} */
+
+} // namespace nda::sparse
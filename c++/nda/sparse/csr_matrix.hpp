@@ -0,0 +1,377 @@
+// Copyright (c) 2024 Simons Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+/**
+ * @file
+ * @brief Provides a sparse matrix in compressed sparse row (CSR) format and sparse matrix-vector and matrix-matrix
+ * products.
+ */
+
+#pragma once
+
+#include "./coo_matrix.hpp"
+#include "../basic_array.hpp"
+#include "../concepts.hpp"
+#include "../declarations.hpp"
+#include "../exceptions.hpp"
+#include "../layout/range.hpp"
+#include "../macros.hpp"
+#include "../mem/address_space.hpp"
+#include "../traits.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <numeric>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace nda::sparse {
+
+  /**
+   * @addtogroup linalg_sparse
+   * @{
+   */
+
+  /**
+   * @brief Sparse m-by-n matrix in compressed sparse row (CSR) format.
+   *
+   * @details The nonzero elements of row i are stored in the positions `row_ptr(i), ..., row_ptr(i + 1) - 1` of the
+   * arrays `values` and `col_idx`, with strictly increasing column indices within each row. All three arrays are
+   * ordinary nda arrays, i.e. they can be accessed, modified (e.g. to update the values of a matrix with a fixed
+   * sparsity pattern) and stored like any other nda array.
+   *
+   * A CSR matrix is usually assembled as an nda::sparse::coo_matrix or converted from a dense matrix. Products with
+   * dense vectors and matrices are computed with nda::sparse::spmv and nda::sparse::spmm.
+   *
+   * @tparam T Value type of the matrix.
+   */
+  template <typename T>
+  class csr_matrix {
+    // Number of rows and columns.
+    long nrows_ = 0, ncols_ = 0;
+
+    // Nonzero values, their column indices and the start of each row in values_/col_idx_ (size nrows_ + 1).
+    array<T, 1> values_;
+    array<long, 1> col_idx_;
+    array<long, 1> row_ptr_ = array<long, 1>::zeros(1);
+
+    public:
+    /// Value type of the matrix.
+    using value_type = T;
+
+    /// Default constructor creates an empty 0-by-0 matrix.
+    csr_matrix() = default;
+
+    /**
+     * @brief Construct an m-by-n matrix without any nonzero elements.
+     * @param nrows Number of rows.
+     * @param ncols Number of columns.
+     */
+    csr_matrix(long nrows, long ncols) : nrows_(nrows), ncols_(ncols), row_ptr_(array<long, 1>::zeros(nrows + 1)) { EXPECTS(ncols >= 0); }
+
+    /**
+     * @brief Construct a matrix from its CSR arrays.
+     *
+     * @details The arrays are taken over as they are. Their consistency (sizes, monotonic row pointers, strictly
+     * increasing column indices within each row) is checked with `EXPECTS`.
+     *
+     * @param nrows Number of rows.
+     * @param ncols Number of columns.
+     * @param values Nonzero values.
+     * @param col_idx Column indices of the nonzero values.
+     * @param row_ptr Start of each row in `values` and `col_idx` (size `nrows + 1`).
+     */
+    csr_matrix(long nrows, long ncols, array<T, 1> values, array<long, 1> col_idx, array<long, 1> row_ptr)
+       : nrows_(nrows), ncols_(ncols), values_(std::move(values)), col_idx_(std::move(col_idx)), row_ptr_(std::move(row_ptr)) {
+      EXPECTS(row_ptr_.size() == nrows_ + 1 and row_ptr_(0) == 0 and row_ptr_(nrows_) == values_.size());
+      EXPECTS(col_idx_.size() == values_.size());
+      for (long i = 0; i < nrows_; ++i) {
+        EXPECTS(row_ptr_(i) <= row_ptr_(i + 1));
+        for (long p = row_ptr_(i); p < row_ptr_(i + 1); ++p) {
+          EXPECTS(0 <= col_idx_(p) and col_idx_(p) < ncols_);
+          EXPECTS(p == row_ptr_(i) or col_idx_(p - 1) < col_idx_(p));
+        }
+      }
+    }
+
+    /**
+     * @brief Construct a matrix from a matrix in COO format.
+     * @details The triplets are sorted and duplicate entries are summed up.
+     * @param coo nda::sparse::coo_matrix object.
+     */
+    explicit csr_matrix(coo_matrix<T> const &coo) : nrows_(coo.extent(0)), ncols_(coo.extent(1)) {
+      auto rows = coo.rows();
+      auto cols = coo.cols();
+      auto vals = coo.values();
+
+      // sort the triplets by (row, column)
+      auto perm = std::vector<long>(coo.nnz());
+      std::iota(perm.begin(), perm.end(), 0);
+      std::sort(perm.begin(), perm.end(), [&](long a, long b) { return std::pair{rows(a), cols(a)} < std::pair{rows(b), cols(b)}; });
+
+      // count the unique elements and fill the arrays
+      long nnz = 0;
+      for (long k = 0; k < std::ssize(perm); ++k)
+        if (k == 0 or rows(perm[k]) != rows(perm[k - 1]) or cols(perm[k]) != cols(perm[k - 1])) ++nnz;
+      values_  = array<T, 1>(nnz);
+      col_idx_ = array<long, 1>(nnz);
+      row_ptr_ = array<long, 1>::zeros(nrows_ + 1);
+      long p   = -1;
+      for (long k = 0; k < std::ssize(perm); ++k) {
+        long i = rows(perm[k]), j = cols(perm[k]);
+        if (p < 0 or i != rows(perm[k - 1]) or j != col_idx_(p)) {
+          ++p;
+          col_idx_(p) = j;
+          values_(p)  = vals(perm[k]);
+          ++row_ptr_(i + 1);
+        } else {
+          values_(p) += vals(perm[k]);
+        }
+      }
+      std::partial_sum(row_ptr_.begin(), row_ptr_.end(), row_ptr_.begin());
+    }
+
+    /**
+     * @brief Construct a matrix from a dense matrix.
+     *
+     * @tparam M nda::Matrix type.
+     * @param m Dense matrix.
+     * @param tol Elements with an absolute value smaller than or equal to `tol` are not stored.
+     */
+    template <Matrix M>
+      requires(std::is_convertible_v<get_value_t<M>, T>)
+    explicit csr_matrix(M const &m, double tol = 0.0) : nrows_(m.extent(0)), ncols_(m.extent(1)) {
+      row_ptr_ = array<long, 1>::zeros(nrows_ + 1);
+      for (long i = 0; i < nrows_; ++i)
+        for (long j = 0; j < ncols_; ++j)
+          if (std::abs(m(i, j)) > tol) ++row_ptr_(i + 1);
+      std::partial_sum(row_ptr_.begin(), row_ptr_.end(), row_ptr_.begin());
+      values_  = array<T, 1>(row_ptr_(nrows_));
+      col_idx_ = array<long, 1>(row_ptr_(nrows_));
+      for (long i = 0, p = 0; i < nrows_; ++i) {
+        for (long j = 0; j < ncols_; ++j) {
+          if (std::abs(m(i, j)) > tol) {
+            values_(p)    = m(i, j);
+            col_idx_(p++) = j;
+          }
+        }
+      }
+    }
+
+    /**
+     * @brief Get the extent of the matrix in a given dimension.
+     * @param i Dimension (0: rows, 1: columns).
+     * @return Number of rows or columns.
+     */
+    [[nodiscard]] long extent(int i) const { return (i == 0 ? nrows_ : ncols_); }
+
+    /**
+     * @brief Get the shape of the matrix.
+     * @return std::array containing the number of rows and columns.
+     */
+    [[nodiscard]] std::array<long, 2> shape() const { return {nrows_, ncols_}; }
+
+    /**
+     * @brief Get the number of stored elements.
+     * @return Number of nonzero elements (including explicitly stored zeros).
+     */
+    [[nodiscard]] long nnz() const { return values_.size(); }
+
+    /**
+     * @brief Get the nonzero values.
+     * @return Const reference to the array of values.
+     */
+    [[nodiscard]] array<T, 1> const &values() const { return values_; }
+
+    /**
+     * @brief Get the nonzero values.
+     * @details The values can be modified, the sparsity pattern is fixed.
+     * @return View of the array of values.
+     */
+    [[nodiscard]] auto values() { return values_(); }
+
+    /**
+     * @brief Get the column indices of the nonzero values.
+     * @return Const reference to the array of column indices.
+     */
+    [[nodiscard]] array<long, 1> const &col_idx() const { return col_idx_; }
+
+    /**
+     * @brief Get the row pointers.
+     * @return Const reference to the array of row pointers.
+     */
+    [[nodiscard]] array<long, 1> const &row_ptr() const { return row_ptr_; }
+
+    /**
+     * @brief Access an element of the matrix.
+     * @details The column index is found with a binary search in the given row.
+     * @param i Row index.
+     * @param j Column index.
+     * @return Value of the element (zero if it is not stored).
+     */
+    [[nodiscard]] T operator()(long i, long j) const {
+      EXPECTS(0 <= i and i < nrows_ and 0 <= j and j < ncols_);
+      auto const *first = col_idx_.data() + row_ptr_(i);
+      auto const *last  = col_idx_.data() + row_ptr_(i + 1);
+      auto const *it    = std::lower_bound(first, last, j);
+      return (it != last and *it == j ? values_(it - col_idx_.data()) : T{0});
+    }
+
+    /**
+     * @brief Convert the matrix to a dense matrix.
+     * @return nda::matrix containing the same elements.
+     */
+    [[nodiscard]] matrix<T> to_dense() const {
+      auto res = matrix<T>::zeros(nrows_, ncols_);
+      for (long i = 0; i < nrows_; ++i)
+        for (long p = row_ptr_(i); p < row_ptr_(i + 1); ++p) res(i, col_idx_(p)) = values_(p);
+      return res;
+    }
+
+    /**
+     * @brief Get the transpose of the matrix.
+     * @return nda::sparse::csr_matrix containing the transpose.
+     */
+    [[nodiscard]] csr_matrix transpose() const {
+      auto rp = array<long, 1>::zeros(ncols_ + 1);
+      for (long p = 0; p < nnz(); ++p) ++rp(col_idx_(p) + 1);
+      std::partial_sum(rp.begin(), rp.end(), rp.begin());
+      auto vals = array<T, 1>(nnz());
+      auto cols = array<long, 1>(nnz());
+      auto pos  = array<long, 1>{rp(range(ncols_))};
+      for (long i = 0; i < nrows_; ++i) {
+        for (long p = row_ptr_(i); p < row_ptr_(i + 1); ++p) {
+          long q  = pos(col_idx_(p))++;
+          vals(q) = values_(p);
+          cols(q) = i;
+        }
+      }
+      return {ncols_, nrows_, std::move(vals), std::move(cols), std::move(rp)};
+    }
+  };
+
+  namespace detail {
+
+    // Minimum number of nonzero elements for which the sparse products are parallelized with OpenMP.
+    inline constexpr long omp_min_nnz = 20000;
+
+  } // namespace detail
+
+  /**
+   * @brief Sparse matrix-vector product \f$ \mathbf{y} \leftarrow \alpha \mathbf{A x} + \beta \mathbf{y} \f$.
+   *
+   * @details The vectors can have arbitrary strides. The rows are distributed over the OpenMP threads if the matrix has
+   * enough nonzero elements. If `beta == 0`, the input values of `y` are not read.
+   *
+   * The value type of the vectors can differ from the one of the matrix, e.g. a real matrix can be applied to complex
+   * vectors.
+   *
+   * @tparam T Value type of the matrix.
+   * @tparam X nda::MemoryVector type.
+   * @tparam Y nda::MemoryVector type.
+   * @param alpha Input scalar.
+   * @param a Sparse m-by-n matrix.
+   * @param x Input vector of size n.
+   * @param beta Input scalar.
+   * @param y Input/output vector of size m.
+   */
+  template <typename T, MemoryVector X, MemoryVector Y>
+    requires(mem::on_host<X, Y> and std::is_convertible_v<decltype(T{} * get_value_t<X>{}), get_value_t<Y>>)
+  void spmv(get_value_t<Y> alpha, csr_matrix<T> const &a, X const &x, get_value_t<Y> beta, Y &&y) { // NOLINT (temporary views are allowed here)
+    using U = get_value_t<Y>;
+    EXPECTS(x.size() == a.extent(1) and y.size() == a.extent(0));
+    auto const *rp = a.row_ptr().data();
+    auto const *ci = a.col_idx().data();
+    auto const *v  = a.values().data();
+    auto const *xp = x.data();
+    auto *yp       = y.data();
+    long incx      = x.indexmap().strides()[0];
+    long incy      = y.indexmap().strides()[0];
+    long m         = a.extent(0);
+#pragma omp parallel for schedule(static) if (a.nnz() >= detail::omp_min_nnz)
+    for (long i = 0; i < m; ++i) {
+      U sum{0};
+      for (long p = rp[i]; p < rp[i + 1]; ++p) sum += v[p] * xp[ci[p] * incx];
+      yp[i * incy] = (beta == U{0} ? alpha * sum : alpha * sum + beta * yp[i * incy]);
+    }
+  }
+
+  /**
+   * @brief Sparse matrix-matrix product \f$ \mathbf{C} \leftarrow \alpha \mathbf{A B} + \beta \mathbf{C} \f$.
+   *
+   * @details The dense matrices can have any layout. The rows of \f$ \mathbf{C} \f$ are distributed over the OpenMP
+   * threads if the sparse matrix has enough nonzero elements. If `beta == 0`, the input values of `c` are not read.
+   *
+   * @tparam T Value type of the sparse matrix.
+   * @tparam B nda::MemoryMatrix type.
+   * @tparam C nda::MemoryMatrix type.
+   * @param alpha Input scalar.
+   * @param a Sparse m-by-n matrix.
+   * @param b Input dense n-by-k matrix.
+   * @param beta Input scalar.
+   * @param c Input/output dense m-by-k matrix.
+   */
+  template <typename T, MemoryMatrix B, MemoryMatrix C>
+    requires(mem::on_host<B, C> and std::is_convertible_v<decltype(T{} * get_value_t<B>{}), get_value_t<C>>)
+  void spmm(get_value_t<C> alpha, csr_matrix<T> const &a, B const &b, get_value_t<C> beta, C &&c) { // NOLINT (temporary views are allowed here)
+    using U = get_value_t<C>;
+    EXPECTS(b.extent(0) == a.extent(1) and c.extent(0) == a.extent(0) and c.extent(1) == b.extent(1));
+    auto const *rp   = a.row_ptr().data();
+    auto const *ci   = a.col_idx().data();
+    auto const *v    = a.values().data();
+    auto const *bp   = b.data();
+    auto *cp         = c.data();
+    auto [sb0, sb1]  = b.indexmap().strides();
+    auto [sc0, sc1]  = c.indexmap().strides();
+    long m = a.extent(0), k = b.extent(1);
+#pragma omp parallel for schedule(static) if (a.nnz() * k >= detail::omp_min_nnz)
+    for (long i = 0; i < m; ++i) {
+      auto *crow = cp + i * sc0;
+      for (long l = 0; l < k; ++l) crow[l * sc1] = (beta == U{0} ? U{0} : beta * crow[l * sc1]);
+      for (long p = rp[i]; p < rp[i + 1]; ++p) {
+        auto av    = alpha * v[p];
+        auto *brow = bp + ci[p] * sb0;
+        for (long l = 0; l < k; ++l) crow[l * sc1] += av * brow[l * sb1];
+      }
+    }
+  }
+
+  /**
+   * @brief Multiply a sparse matrix with a dense vector or matrix.
+   *
+   * @tparam T Value type of the sparse matrix.
+   * @tparam A nda::MemoryVector or nda::MemoryMatrix type.
+   * @param a Sparse matrix.
+   * @param x Dense vector or matrix.
+   * @return nda::vector or nda::matrix containing the product.
+   */
+  template <typename T, MemoryArray A>
+    requires((MemoryVector<A> or MemoryMatrix<A>) and mem::on_host<A>)
+  auto operator*(csr_matrix<T> const &a, A const &x) {
+    using U = decltype(T{} * get_value_t<A>{});
+    if constexpr (MemoryVector<A>) {
+      auto y = vector<U>(a.extent(0));
+      spmv(U{1}, a, x, U{0}, y);
+      return y;
+    } else {
+      auto y = matrix<U>(a.extent(0), x.extent(1));
+      spmm(U{1}, a, x, U{0}, y);
+      return y;
+    }
+  }
+
+  /** @} */
+
+} // namespace nda::sparse
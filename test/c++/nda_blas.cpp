@@ -79,6 +79,26 @@ TEST(BLAS, gemmF_vbatch) { test_gemm_vbatch<double, F_layout>(); }    //NOLINT
 TEST(BLAS, zgemm_vbatch) { test_gemm_vbatch<dcomplex, C_layout>(); }  //NOLINT
 TEST(BLAS, zgemmF_vbatch) { test_gemm_vbatch<dcomplex, F_layout>(); } //NOLINT
 
+template <typename value_t, typename Layout>
+void test_gemm_small() {
+  nda::matrix<value_t, Layout> M1{{0, 1}, {1, 2}}, M2{{1, 1}, {1, 1}}, M3{{1, 0}, {0, 1}};
+  nda::blas::gemm_small(1.0, M1, M2, 1.0, M3);
+  EXPECT_ARRAY_NEAR(M3, nda::matrix<value_t>{{2, 1}, {3, 4}});
+
+  nda::stack_matrix<value_t, 2, 2> S1{M1}, S2{M2}, S3{nda::eye<value_t>(2)};
+  nda::blas::gemm_small(2.0, S1, S2, -1.0, S3);
+  EXPECT_ARRAY_NEAR(S3, nda::matrix<value_t>{{1, 2}, {6, 5}});
+
+  nda::vector<value_t> x{1, 2}, y{1, 1};
+  nda::blas::gemv_small(1.0, M1, x, 1.0, y);
+  EXPECT_ARRAY_NEAR(y, nda::vector<value_t>{3, 6});
+}
+
+TEST(BLAS, gemm_small) { test_gemm_small<double, C_layout>(); }     //NOLINT
+TEST(BLAS, gemmF_small) { test_gemm_small<double, F_layout>(); }    //NOLINT
+TEST(BLAS, zgemm_small) { test_gemm_small<dcomplex, C_layout>(); }  //NOLINT
+TEST(BLAS, zgemmF_small) { test_gemm_small<dcomplex, F_layout>(); } //NOLINT
+
 template <typename value_t, typename Layout>
 void test_gemv() {
 
@@ -110,6 +130,125 @@ TEST(BLAS, zgemvF) { test_gemv<dcomplex, F_layout>(); } //NOLINT
 
 //----------------------------
 
+template <typename value_t, typename Layout>
+void test_gemv_batch() {
+  int batch_count = 10;
+  long M = 6, N = 5;
+
+  std::vector<nda::matrix<value_t, Layout>> vA;
+  std::vector<nda::vector<value_t>> vX, vY;
+  for (int i = 0; i < batch_count; ++i) {
+    vA.emplace_back(nda::matrix<value_t, Layout>::rand({M, N}));
+    vX.emplace_back(nda::vector<value_t>::rand({N}));
+    vY.emplace_back(nda::vector<value_t>::rand({M}));
+  }
+  auto vY_exp = vY;
+  for (int i = 0; i < batch_count; ++i) vY_exp[i] = make_regular(2.0 * vA[i] * vX[i] - vY[i]);
+  nda::blas::gemv_batch(2.0, vA, vX, -1.0, vY);
+
+  for (auto i : range(batch_count)) EXPECT_ARRAY_NEAR(vY[i], vY_exp[i]);
+}
+
+TEST(BLAS, gemv_batch) { test_gemv_batch<double, C_layout>(); }     //NOLINT
+TEST(BLAS, gemvF_batch) { test_gemv_batch<double, F_layout>(); }    //NOLINT
+TEST(BLAS, zgemv_batch) { test_gemv_batch<dcomplex, C_layout>(); }  //NOLINT
+TEST(BLAS, zgemvF_batch) { test_gemv_batch<dcomplex, F_layout>(); } //NOLINT
+
+//----------------------------
+
+template <typename value_t>
+void test_gemv_batch_strided() {
+  auto _          = nda::range::all;
+  int batch_count = 10;
+  long M = 6, N = 5;
+
+  // matrices in C layout and (via a transposed view) in Fortran layout
+  auto A  = nda::array<value_t, 3>::rand({batch_count, M, N});
+  auto AT = nda::array<value_t, 3>::rand({batch_count, N, M});
+  auto AF = nda::transposed_view<1, 2>(AT);
+
+  // vectors with non-unit strides
+  auto X  = nda::array<value_t, 2>::rand({batch_count, 2 * N});
+  auto Y  = nda::array<value_t, 2>::rand({batch_count, M});
+  auto x  = X(_, nda::range(0, 2 * N, 2));
+  auto Z  = nda::array<value_t, 2>::zeros({M, batch_count});
+  auto yt = transpose(Z);
+
+  auto check = [&](auto const &a, auto const &res, auto const &res_init, value_t alpha, value_t beta) {
+    for (int i = 0; i < batch_count; ++i) {
+      auto ai = nda::matrix<value_t>{a(i, _, _)};
+      auto xi = nda::vector<value_t>{x(i, _)};
+      auto yi = nda::vector<value_t>{res_init(i, _)};
+      EXPECT_ARRAY_NEAR(nda::vector<value_t>{res(i, _)}, nda::make_regular(alpha * ai * xi + beta * yi));
+    }
+  };
+
+  auto Y_init = Y;
+  nda::blas::gemv_batch_strided(2.0, A, x, 0.5, Y);
+  check(A, Y, Y_init, 2.0, 0.5);
+
+  Y = Y_init;
+  nda::blas::gemv_batch_strided(1.0, AF, x, 0.0, Y);
+  check(AF, Y, Y_init, 1.0, 0.0);
+
+  nda::blas::gemv_batch_strided(1.0, A, x, 0.0, yt);
+  check(A, yt, Y_init, 1.0, 0.0);
+
+  if constexpr (nda::is_complex_v<value_t>) {
+    nda::blas::gemv_batch_strided(1.0, conj(A), x, 0.0, Y);
+    check(nda::make_regular(conj(A)), Y, Y_init, 1.0, 0.0);
+  }
+}
+
+TEST(BLAS, gemv_batch_strided) { test_gemv_batch_strided<double>(); }   //NOLINT
+TEST(BLAS, zgemv_batch_strided) { test_gemv_batch_strided<dcomplex>(); } //NOLINT
+
+//----------------------------
+
+template <typename value_t>
+void test_dot_batch_strided() {
+  auto _          = nda::range::all;
+  int batch_count = 10;
+  long N          = 7;
+
+  auto X   = nda::array<value_t, 2>::rand({batch_count, 2 * N});
+  auto x   = X(_, nda::range(0, 2 * N, 2));
+  auto YT  = nda::array<value_t, 2>::rand({N, batch_count});
+  auto y   = transpose(YT);
+  auto res = nda::vector<value_t>(2 * batch_count);
+  auto r   = res(nda::range(0, 2 * batch_count, 2));
+
+  nda::blas::dot_batch_strided(x, y, r);
+  for (int i = 0; i < batch_count; ++i) EXPECT_COMPLEX_NEAR(r(i), (nda::blas::dot_generic(x(i, _), y(i, _))), 1.e-14);
+
+  nda::blas::dot_batch_strided(conj(x), y, r);
+  for (int i = 0; i < batch_count; ++i) EXPECT_COMPLEX_NEAR(r(i), (nda::blas::dotc_generic(x(i, _), y(i, _))), 1.e-14);
+}
+
+TEST(BLAS, ddot_batch_strided) { test_dot_batch_strided<double>(); }   //NOLINT
+TEST(BLAS, zdot_batch_strided) { test_dot_batch_strided<dcomplex>(); } //NOLINT
+
+//----------------------------
+
+TEST(BLAS, scoped_num_threads) { //NOLINT
+  int n0 = nda::blas::get_num_threads();
+  EXPECT_GE(n0, 1);
+  {
+    auto guard = nda::blas::scoped_num_threads{1};
+    EXPECT_EQ(nda::blas::get_num_threads(), 1);
+
+    // batched fallbacks run with a single-threaded backend and leave the setting untouched
+    auto A = nda::array<double, 3>::rand({4, 3, 3});
+    auto x = nda::array<double, 2>::rand({4, 3});
+    auto y = nda::array<double, 2>::zeros({4, 3});
+    nda::blas::gemv_batch_strided(1.0, A, x, 0.0, y);
+    EXPECT_EQ(nda::blas::get_num_threads(), 1);
+  }
+  EXPECT_EQ(nda::blas::get_num_threads(), n0);
+}
+
+//----------------------------
+
 template <typename value_t, typename Layout>
 void test_ger() {
 
@@ -176,3 +315,336 @@ void test_dotc() { //NOLINT
 
 TEST(BLAS, ddotc) { test_dotc<double>(); }   //NOLINT
 TEST(BLAS, zdotc) { test_dotc<dcomplex>(); } //NOLINT
+
+//----------------------------
+
+template <typename value_t>
+void test_axpy() { //NOLINT
+
+  nda::vector<value_t> x{1, 2, 3, 4, 5};
+  nda::vector<value_t> y{10, 20, 30, 40, 50};
+  if constexpr (nda::is_complex_v<value_t>) {
+    x *= 1 + 1i;
+    y *= 1 + 2i;
+  }
+  auto const a = value_t{2}, b = value_t{-3};
+
+  auto z = y;
+  nda::blas::axpy(a, x, z);
+  EXPECT_ARRAY_NEAR(z, make_regular(a * x + y));
+
+  z = y;
+  nda::blas::axpby(a, x, b, z);
+  EXPECT_ARRAY_NEAR(z, make_regular(a * x + b * y));
+
+  nda::blas::copy(x, z);
+  EXPECT_ARRAY_NEAR(z, x);
+
+  // strided views
+  nda::vector<value_t> w(10, 0);
+  nda::blas::copy(x, w(nda::range(0, 10, 2)));
+  nda::blas::axpy(a, x, w(nda::range(1, 10, 2)));
+  for (long i = 0; i < 5; ++i) {
+    EXPECT_COMPLEX_NEAR(w(2 * i), x(i), 1.e-14);
+    EXPECT_COMPLEX_NEAR(w(2 * i + 1), a * x(i), 1.e-14);
+  }
+}
+
+TEST(BLAS, daxpy) { test_axpy<double>(); }   //NOLINT
+TEST(BLAS, zaxpy) { test_axpy<dcomplex>(); } //NOLINT
+
+//----------------------------
+
+template <typename value_t>
+void test_level1_dispatch() { //NOLINT
+
+  // large enough to be dispatched to BLAS
+  long const n = nda::blas::level1_dispatch_min_size + 3;
+  static_assert(nda::blas::detail::has_level1_pattern<nda::vector<value_t>, decltype(nda::vector<value_t>{} + 2 * nda::vector<value_t>{})>);
+
+  auto x       = nda::vector<value_t>(nda::rand<double>(n));
+  auto y       = nda::vector<value_t>(nda::rand<double>(n));
+  auto const a = value_t{2}, b = value_t{-0.5};
+
+  // compute the expected result with an explicit loop
+  auto check = [&](auto const &res, auto f) {
+    auto exp = y;
+    for (long i = 0; i < n; ++i) exp(i) = f(exp(i), x(i));
+    EXPECT_ARRAY_NEAR(res, exp, 1.e-14);
+  };
+
+  // axpy
+  auto z = y;
+  z += a * x;
+  check(z, [&](auto yi, auto xi) { return yi + a * xi; });
+  z = y;
+  z -= x;
+  check(z, [&](auto yi, auto xi) { return yi - xi; });
+  z = y;
+  z = x * a + z;
+  check(z, [&](auto yi, auto xi) { return a * xi + yi; });
+
+  // axpby
+  z = y;
+  z = b * z - a * x;
+  check(z, [&](auto yi, auto xi) { return b * yi - a * xi; });
+
+  // scal
+  z = y;
+  z *= b;
+  check(z, [&](auto yi, auto) { return b * yi; });
+  z = y;
+  z = -z;
+  check(z, [&](auto yi, auto) { return -yi; });
+
+  // copy and axpy with strided views
+  auto w = nda::vector<value_t>(2 * n, 0);
+  w(nda::range(0, 2 * n, 2)) = y;
+  w(nda::range(0, 2 * n, 2)) += a * x;
+  check(w(nda::range(0, 2 * n, 2)), [&](auto yi, auto xi) { return yi + a * xi; });
+
+  // overlapping operands fallback to the elementwise assignment
+  z = y;
+  z(nda::range(0, n - 1)) += z(nda::range(1, n));
+  for (long i = 0; i < n - 1; ++i) EXPECT_COMPLEX_NEAR(z(i), y(i) + y(i + 1), 1.e-14);
+
+  // matrices with the same layout are strided in 1d
+  auto A = nda::matrix<value_t>(nda::rand<double>(200, 200));
+  auto B = nda::matrix<value_t>(nda::rand<double>(200, 200));
+  auto C = A;
+  C += a * B;
+  EXPECT_ARRAY_NEAR(C, make_regular(A + a * B), 1.e-14);
+}
+
+TEST(BLAS, level1_dispatch) { test_level1_dispatch<double>(); }   //NOLINT
+TEST(BLAS, zlevel1_dispatch) { test_level1_dispatch<dcomplex>(); } //NOLINT
+
+//----------------------------
+
+// Get the upper ('U') or lower ('L') triangular part of a matrix.
+template <typename M>
+auto get_triangle(M const &m, char uplo) {
+  auto res = nda::matrix<nda::get_value_t<M>>::zeros(m.shape());
+  for (auto [i, j] : m.indices())
+    if ((uplo == 'U' and i <= j) or (uplo == 'L' and i >= j)) res(i, j) = m(i, j);
+  return res;
+}
+
+// The other memory layout.
+template <typename Layout>
+using other_layout_t = std::conditional_t<std::is_same_v<Layout, C_layout>, F_layout, C_layout>;
+
+template <typename value_t, typename LayoutA, typename LayoutC>
+void test_syrk_herk() {
+  auto A  = nda::matrix<value_t, LayoutA>::rand({5, 3});
+  auto B  = nda::matrix<value_t, LayoutA>::rand({5, 3});
+  auto C0 = nda::matrix<value_t, LayoutC>::rand({5, 5});
+  C0      = C0 + dagger(C0);
+
+  for (char uplo : {'U', 'L'}) {
+    // syrk
+    auto C = C0;
+    nda::blas::syrk(2.0, A, 0.5, C, uplo);
+    EXPECT_ARRAY_NEAR(get_triangle(C, uplo), get_triangle(make_regular(2.0 * A * transpose(A) + 0.5 * C0), uplo));
+
+    // syr2k
+    C = C0;
+    nda::blas::syr2k(2.0, A, B, 0.5, C, uplo);
+    EXPECT_ARRAY_NEAR(get_triangle(C, uplo), get_triangle(make_regular(2.0 * A * transpose(B) + 2.0 * B * transpose(A) + 0.5 * C0), uplo));
+
+    // herk and her2k with a matrix in the same layout as C or a conjugated matrix in the other layout
+    auto A_same    = nda::matrix<value_t, LayoutC>{A};
+    auto B_same    = nda::matrix<value_t, LayoutC>{B};
+    auto A_conj    = nda::matrix<value_t, other_layout_t<LayoutC>>{conj(A)};
+    auto B_conj    = nda::matrix<value_t, other_layout_t<LayoutC>>{conj(B)};
+    auto herk_exp  = get_triangle(make_regular(2.0 * A * dagger(A) + 0.5 * C0), uplo);
+    auto her2k_exp = get_triangle(make_regular(value_t{2.0} * A * dagger(B) + nda::conj(value_t{2.0}) * B * dagger(A) + 0.5 * C0), uplo);
+
+    C = C0;
+    nda::blas::herk(2.0, A_same, 0.5, C, uplo);
+    EXPECT_ARRAY_NEAR(get_triangle(C, uplo), herk_exp);
+
+    C = C0;
+    nda::blas::herk(2.0, conj(A_conj), 0.5, C, uplo);
+    EXPECT_ARRAY_NEAR(get_triangle(C, uplo), herk_exp);
+
+    C = C0;
+    nda::blas::her2k(2.0, A_same, B_same, 0.5, C, uplo);
+    EXPECT_ARRAY_NEAR(get_triangle(C, uplo), her2k_exp);
+
+    C = C0;
+    nda::blas::her2k(2.0, conj(A_conj), conj(B_conj), 0.5, C, uplo);
+    EXPECT_ARRAY_NEAR(get_triangle(C, uplo), her2k_exp);
+  }
+}
+
+TEST(BLAS, syrk) { test_syrk_herk<double, C_layout, C_layout>(); }      //NOLINT
+TEST(BLAS, syrkF) { test_syrk_herk<double, F_layout, C_layout>(); }     //NOLINT
+TEST(BLAS, syrkFF) { test_syrk_herk<double, F_layout, F_layout>(); }    //NOLINT
+TEST(BLAS, zherk) { test_syrk_herk<dcomplex, C_layout, C_layout>(); }   //NOLINT
+TEST(BLAS, zherkF) { test_syrk_herk<dcomplex, C_layout, F_layout>(); }  //NOLINT
+TEST(BLAS, zherkFF) { test_syrk_herk<dcomplex, F_layout, F_layout>(); } //NOLINT
+
+//----------------------------
+
+template <typename value_t, typename LayoutA, typename LayoutC>
+void test_symm_hemm() {
+  auto A = nda::matrix<value_t, LayoutA>::rand({4, 4});
+  auto B = nda::matrix<value_t, LayoutC>::rand({4, 3});
+  auto D = nda::matrix<value_t, LayoutC>::rand({3, 4});
+
+  for (char uplo : {'U', 'L'}) {
+    // symmetric/hermitian matrices defined by the given triangle of A
+    auto T     = get_triangle(A, uplo);
+    auto A_sym = make_regular(T + transpose(T) - nda::diag(nda::diagonal(T)));
+    auto A_her = make_regular(T + dagger(T) - nda::diag(nda::diagonal(T)));
+    for (auto i : range(4)) A_her(i, i) = std::real(A_her(i, i));
+
+    auto C = nda::matrix<value_t, LayoutC>::zeros({4, 3});
+    nda::blas::symm(1.0, A, B, 0.0, C, 'L', uplo);
+    EXPECT_ARRAY_NEAR(C, make_regular(A_sym * B));
+
+    auto E = nda::matrix<value_t, LayoutC>::ones({3, 4});
+    nda::blas::symm(2.0, A, D, 1.0, E, 'R', uplo);
+    EXPECT_ARRAY_NEAR(E, make_regular(2.0 * D * A_sym + 1.0));
+
+    if constexpr (std::is_same_v<LayoutA, LayoutC>) {
+      for (auto i : range(4)) A(i, i) = std::real(A(i, i));
+      nda::blas::hemm(1.0, A, B, 0.0, C, 'L', uplo);
+      EXPECT_ARRAY_NEAR(C, make_regular(A_her * B));
+
+      nda::blas::hemm(1.0, A, D, 0.0, E, 'R', uplo);
+      EXPECT_ARRAY_NEAR(E, make_regular(D * A_her));
+    }
+  }
+}
+
+TEST(BLAS, symm) { test_symm_hemm<double, C_layout, C_layout>(); }      //NOLINT
+TEST(BLAS, symmF) { test_symm_hemm<double, C_layout, F_layout>(); }     //NOLINT
+TEST(BLAS, zhemm) { test_symm_hemm<dcomplex, C_layout, C_layout>(); }   //NOLINT
+TEST(BLAS, zhemmF) { test_symm_hemm<dcomplex, F_layout, F_layout>(); }  //NOLINT
+TEST(BLAS, zsymmFC) { test_symm_hemm<dcomplex, F_layout, C_layout>(); } //NOLINT
+
+//----------------------------
+
+template <typename value_t, typename LayoutA, typename LayoutB>
+void test_trmm_trsm() {
+  auto A = nda::matrix<value_t, LayoutA>::rand({4, 4});
+  for (auto i : range(4)) A(i, i) += 4.0;
+  auto B = nda::matrix<value_t, LayoutB>::rand({4, 3});
+  auto D = nda::matrix<value_t, LayoutB>::rand({3, 4});
+
+  for (char uplo : {'U', 'L'}) {
+    for (char diag : {'N', 'U'}) {
+      auto T = get_triangle(A, uplo);
+      if (diag == 'U') nda::diagonal(T) = 1;
+
+      // left side with op(A) = A, A^T, A^H
+      auto X = B;
+      nda::blas::trmm(2.0, A, X, 'L', uplo, diag);
+      EXPECT_ARRAY_NEAR(X, make_regular(2.0 * T * B));
+      nda::blas::trsm(0.5, A, X, 'L', uplo, diag);
+      EXPECT_ARRAY_NEAR(X, B);
+
+      X = B;
+      nda::blas::trmm(1.0, transpose(A), X, 'L', nda::blas::flip_uplo(uplo), diag);
+      EXPECT_ARRAY_NEAR(X, make_regular(transpose(T) * B));
+      nda::blas::trsm(1.0, transpose(A), X, 'L', nda::blas::flip_uplo(uplo), diag);
+      EXPECT_ARRAY_NEAR(X, B);
+
+      if constexpr (std::is_same_v<LayoutA, LayoutB>) {
+        X = B;
+        nda::blas::trmm(1.0, dagger(A), X, 'L', nda::blas::flip_uplo(uplo), diag);
+        EXPECT_ARRAY_NEAR(X, make_regular(dagger(T) * B));
+        nda::blas::trsm(1.0, dagger(A), X, 'L', nda::blas::flip_uplo(uplo), diag);
+        EXPECT_ARRAY_NEAR(X, B);
+      }
+
+      // right side
+      auto Y = D;
+      nda::blas::trmm(1.0, A, Y, 'R', uplo, diag);
+      EXPECT_ARRAY_NEAR(Y, make_regular(D * T));
+      nda::blas::trsm(1.0, A, Y, 'R', uplo, diag);
+      EXPECT_ARRAY_NEAR(Y, D);
+    }
+  }
+}
+
+TEST(BLAS, trmm) { test_trmm_trsm<double, C_layout, C_layout>(); }      //NOLINT
+TEST(BLAS, trmmF) { test_trmm_trsm<double, F_layout, C_layout>(); }     //NOLINT
+TEST(BLAS, trmmFF) { test_trmm_trsm<double, F_layout, F_layout>(); }    //NOLINT
+TEST(BLAS, ztrmm) { test_trmm_trsm<dcomplex, C_layout, C_layout>(); }   //NOLINT
+TEST(BLAS, ztrmmCF) { test_trmm_trsm<dcomplex, C_layout, F_layout>(); } //NOLINT
+TEST(BLAS, ztrmmFF) { test_trmm_trsm<dcomplex, F_layout, F_layout>(); } //NOLINT
+
+// Pack the upper ('U') or lower ('L') triangle of a square matrix column by column.
+template <typename M>
+auto pack_triangle(M const &m, char uplo) {
+  long n   = m.extent(0);
+  auto res = nda::vector<nda::get_value_t<M>>(n * (n + 1) / 2);
+  long k   = 0;
+  for (long j = 0; j < n; ++j)
+    for (long i = (uplo == 'U' ? 0 : j); i < (uplo == 'U' ? j + 1 : n); ++i) res(k++) = m(i, j);
+  return res;
+}
+
+template <typename value_t>
+void test_spmv_spr() {
+  using matrix_t = nda::matrix<value_t>;
+  long N         = 7;
+  auto R         = matrix_t::rand({N, N});
+  auto A         = matrix_t{R + dagger(R)};
+  auto X         = nda::vector<value_t>::rand(2 * N);
+  auto x         = X(range(0, 2 * N, 2));
+  auto y0        = nda::vector<value_t>::rand(N);
+
+  for (char uplo : {'U', 'L'}) {
+    // matrix-vector product with a strided vector
+    auto ap = pack_triangle(A, uplo);
+    auto y  = y0;
+    nda::blas::spmv(value_t{2.0}, ap, x, value_t{0.5}, y, uplo);
+    EXPECT_ARRAY_NEAR(y, make_regular(2.0 * A * x + 0.5 * y0));
+
+    // hermitian rank-1 update
+    nda::blas::hpr(0.5, x, ap, uplo);
+    auto x_reg = make_regular(x);
+    auto B     = matrix_t{A};
+    nda::blas::ger(value_t{0.5}, x_reg, nda::vector<value_t>{conj(x_reg)}, B);
+    EXPECT_ARRAY_NEAR(ap, pack_triangle(B, uplo));
+  }
+}
+TEST(BLAS, spmv) { test_spmv_spr<double>(); }    //NOLINT
+TEST(BLAS, zhpmv) { test_spmv_spr<dcomplex>(); } //NOLINT
+
+template <typename value_t>
+void test_gbmv() {
+  using matrix_t = nda::matrix<value_t>;
+  long M = 9, N = 7, kl = 2, ku = 1;
+
+  // random m-by-n band matrix and its band storage (with an extra row to test the leading dimension)
+  auto R  = matrix_t::rand({M, N});
+  auto A  = matrix_t::zeros({M, N});
+  auto AB = nda::matrix<value_t, F_layout>::zeros({kl + ku + 2, N});
+  for (long j = 0; j < N; ++j) {
+    for (long i = std::max(0l, j - ku); i <= std::min(M - 1, j + kl); ++i) {
+      A(i, j)           = R(i, j);
+      AB(ku + i - j, j) = R(i, j);
+    }
+  }
+
+  auto xn = nda::vector<value_t>::rand(N);
+  auto xm = nda::vector<value_t>::rand(M);
+  auto yn = nda::vector<value_t>::rand(N);
+  auto ym = nda::vector<value_t>::rand(M);
+  auto y  = ym;
+  nda::blas::gbmv(value_t{2.0}, AB, kl, ku, xn, value_t{0.5}, y);
+  EXPECT_ARRAY_NEAR(y, make_regular(2.0 * A * xn + 0.5 * ym));
+  y = yn;
+  nda::blas::gbmv(value_t{2.0}, AB, kl, ku, xm, value_t{0.5}, y, 'T');
+  EXPECT_ARRAY_NEAR(y, make_regular(2.0 * transpose(A) * xm + 0.5 * yn));
+  y = yn;
+  nda::blas::gbmv(value_t{2.0}, AB, kl, ku, xm, value_t{0.5}, y, 'C');
+  EXPECT_ARRAY_NEAR(y, make_regular(2.0 * dagger(A) * xm + 0.5 * yn));
+}
+TEST(BLAS, gbmv) { test_gbmv<double>(); }    //NOLINT
+TEST(BLAS, zgbmv) { test_gbmv<dcomplex>(); } //NOLINT
@@ -117,6 +117,86 @@ TEST(lapack, cgtsv) { //NOLINT
   }
 }
 
+//---------------------------------------------------------
+
+template <typename value_t>
+void test_gtsv_batch() {
+  long batch = 6, n = 5;
+  auto DL    = array<value_t, 2>::rand(batch, n - 1);
+  auto D     = array<value_t, 2>{array<value_t, 2>::rand(batch, n) + 4.0};
+  auto DU    = array<value_t, 2>::rand(batch, n - 1);
+  auto B     = array<value_t, 2>::rand(batch, n);
+
+  // make the last system singular
+  DL(batch - 1, _) = 0;
+  D(batch - 1, 0)  = 0;
+
+  auto dl = DL, d = D, du = DU, b = B;
+  auto info = lapack::gtsv_batch(dl, d, du, b);
+  EXPECT_EQ(info(batch - 1), 1);
+  for (long i = 0; i < batch - 1; ++i) {
+    auto dl_i = vector<value_t>{DL(i, _)}, d_i = vector<value_t>{D(i, _)}, du_i = vector<value_t>{DU(i, _)};
+    auto b_i  = vector<value_t>{B(i, _)};
+    EXPECT_EQ(info(i), 0);
+    EXPECT_EQ(lapack::gtsv(dl_i, d_i, du_i, b_i), 0);
+    EXPECT_ARRAY_NEAR(b(i, _), b_i, 1e-14);
+  }
+
+  // rows that are not contiguous in memory are rejected
+  auto b_f = array<value_t, 2, F_layout>{B};
+  EXPECT_THROW(lapack::gtsv_batch(dl, d, du, b_f), nda::runtime_error);
+}
+TEST(lapack, gtsv_batch) { test_gtsv_batch<double>(); }    // NOLINT
+TEST(lapack, zgtsv_batch) { test_gtsv_batch<dcomplex>(); } // NOLINT
+
+// ==================================== gbsv/gbtrf/gbtrs =========================================
+
+template <typename value_t>
+void test_gbsv() {
+  using matrix_t = matrix<value_t, F_layout>;
+  long n = 8, kl = 2, ku = 1;
+
+  // diagonally dominant band matrix and its band storage with kl extra rows
+  auto R  = matrix_t::rand({n, n});
+  auto A  = matrix_t::zeros({n, n});
+  auto AB = matrix_t::zeros({2 * kl + ku + 1, n});
+  for (long j = 0; j < n; ++j) {
+    for (long i = std::max(0l, j - ku); i <= std::min(n - 1, j + kl); ++i) {
+      A(i, j)                = R(i, j) + (i == j ? 4.0 : 0.0);
+      AB(kl + ku + i - j, j) = A(i, j);
+    }
+  }
+  auto B    = matrix_t::rand({n, 3});
+  auto ipiv = vector<int>(n);
+
+  // solve with a matrix and a vector right hand side
+  auto ab = AB;
+  auto X  = B;
+  EXPECT_EQ(lapack::gbsv(ab, kl, ku, ipiv, X), 0);
+  EXPECT_ARRAY_NEAR(A * X, B, 1e-13);
+  ab     = AB;
+  auto x = vector<value_t>{B(_, 0)};
+  EXPECT_EQ(lapack::gbsv(ab, kl, ku, ipiv, x), 0);
+  EXPECT_ARRAY_NEAR(x, X(_, 0), 1e-13);
+
+  // factorize once and solve with different operations
+  ab = AB;
+  EXPECT_EQ(lapack::gbtrf(ab, kl, ku, ipiv), 0);
+  for (char op : {'N', 'T', 'C'}) {
+    X = B;
+    EXPECT_EQ(lapack::gbtrs(ab, kl, ku, ipiv, X, op), 0);
+    auto opA = matrix_t{op == 'N' ? A : (op == 'T' ? matrix_t{transpose(A)} : matrix_t{dagger(A)})};
+    EXPECT_ARRAY_NEAR(opA * X, B, 1e-13);
+  }
+
+  // singular matrix (last column is zero)
+  ab           = AB;
+  ab(_, n - 1) = 0;
+  EXPECT_GT(lapack::gbtrf(ab, kl, ku, ipiv), 0);
+}
+TEST(lapack, gbsv) { test_gbsv<double>(); }    // NOLINT
+TEST(lapack, zgbsv) { test_gbsv<dcomplex>(); } // NOLINT
+
 // ==================================== gesvd ============================================
 
 template <typename value_t>
@@ -140,6 +220,84 @@ void test_gesvd() { //NOLINT
 TEST(lapack, gesvd) { test_gesvd<double>(); }    //NOLINT
 TEST(lapack, zgesvd) { test_gesvd<dcomplex>(); } //NOLINT
 
+//---------------------------------------------------------
+
+template <typename value_t>
+void test_gesvd_workspace() { //NOLINT
+  using matrix_t = matrix<value_t, F_layout>;
+  long M = 5, N = 3;
+  auto U  = matrix_t(M, M);
+  auto VT = matrix_t(N, N);
+  auto S  = vector<double>(N);
+
+  // the workspace only grows during the first call
+  auto ws = lapack::workspace<value_t>{};
+  for (int k = 0; k < 3; ++k) {
+    auto A     = matrix_t{matrix<value_t>::rand({M, N})};
+    auto Acopy = matrix_t{A};
+    lapack::gesvd(Acopy, S, U, VT, ws);
+    auto work_ptr = ws.work(1);
+    auto size     = ws.work_size();
+
+    auto Sigma = matrix_t::zeros(A.shape());
+    for (auto i : range(N)) Sigma(i, i) = S(i);
+    EXPECT_ARRAY_NEAR(A, U * Sigma * VT, 1e-14);
+
+    Acopy = A;
+    lapack::gesvd(Acopy, S, U, VT, ws);
+    EXPECT_EQ(ws.work(1), work_ptr);
+    EXPECT_EQ(ws.work_size(), size);
+  }
+}
+TEST(lapack, gesvd_workspace) { test_gesvd_workspace<double>(); }    //NOLINT
+TEST(lapack, zgesvd_workspace) { test_gesvd_workspace<dcomplex>(); } //NOLINT
+
+//---------------------------------------------------------
+
+template <typename value_t>
+void test_svd_modes(auto svd) { //NOLINT
+  using matrix_t = matrix<value_t, F_layout>;
+  long M = 7, N = 4;
+  auto A = matrix_t{matrix<value_t>::rand({M, N})};
+
+  // full SVD
+  auto U     = matrix_t(M, M);
+  auto VT    = matrix_t(N, N);
+  auto S     = vector<double>(N);
+  auto Acopy = matrix_t{A};
+  svd(Acopy, S, U, VT, 'A');
+  auto Sigma = matrix_t::zeros(A.shape());
+  for (auto i : range(N)) Sigma(i, i) = S(i);
+  EXPECT_ARRAY_NEAR(A, U * Sigma * VT, 1e-13);
+
+  // economy size SVD
+  auto U_thin  = matrix_t(M, N);
+  auto VT_thin = matrix_t(N, N);
+  auto S_thin  = vector<double>(N);
+  Acopy        = A;
+  svd(Acopy, S_thin, U_thin, VT_thin, 'S');
+  auto Sigma_thin = matrix_t::zeros(N, N);
+  for (auto i : range(N)) Sigma_thin(i, i) = S_thin(i);
+  EXPECT_ARRAY_NEAR(A, U_thin * Sigma_thin * VT_thin, 1e-13);
+  EXPECT_ARRAY_NEAR(dagger(U_thin) * U_thin, eye<value_t>(N), 1e-13);
+  EXPECT_ARRAY_NEAR(S_thin, S, 1e-13);
+
+  // singular values only
+  auto S_vals = vector<double>(N);
+  auto empty  = matrix_t{};
+  Acopy       = A;
+  svd(Acopy, S_vals, empty, empty, 'N');
+  EXPECT_ARRAY_NEAR(S_vals, S, 1e-13);
+}
+
+auto gesvd_fn = [](auto &&...args) { return lapack::gesvd(args...); };
+auto gesdd_fn = [](auto &&...args) { return lapack::gesdd(args...); };
+
+TEST(lapack, gesvd_modes) { test_svd_modes<double>(gesvd_fn); }    //NOLINT
+TEST(lapack, zgesvd_modes) { test_svd_modes<dcomplex>(gesvd_fn); } //NOLINT
+TEST(lapack, gesdd) { test_svd_modes<double>(gesdd_fn); }          //NOLINT
+TEST(lapack, zgesdd) { test_svd_modes<dcomplex>(gesdd_fn); }       //NOLINT
+
 // ==================================== geqp3 & orgqr/ungqr ====================================
 
 template <typename value_t, bool wide = false>
@@ -212,6 +370,52 @@ void test_gelss() {
 TEST(lapack, gelss) { test_gelss<double>(); }    //NOLINT
 TEST(lapack, zgelss) { test_gelss<dcomplex>(); } //NOLINT
 
+//---------------------------------------------------------
+
+template <typename value_t>
+void test_gelss_worker_multi_rhs() { //NOLINT
+  long M = 40, N = 6, K = 25;
+  auto A      = matrix<value_t>::rand({M, N});
+  auto worker = lapack::gelss_worker<value_t>{A};
+
+  // reference: column by column via the normal equations
+  auto B     = matrix<value_t>::rand({M, K});
+  auto AhA   = matrix<value_t>{dagger(A) * A};
+  auto X_ref = matrix<value_t>{inverse(AhA) * dagger(A) * B};
+  auto R     = matrix<value_t>{B - A * X_ref};
+  auto errs  = vector<double>(K);
+  for (long j = 0; j < K; ++j) errs(j) = norm(vector<value_t>{R(_, j)}) / std::sqrt(double(M));
+  auto err_max = max_element(errs);
+
+  auto [X, err] = worker(B);
+  EXPECT_ARRAY_NEAR(X, X_ref, 1e-12);
+  EXPECT_NEAR(err, err_max, 1e-12);
+
+  // caller-provided buffers
+  auto X_buf   = matrix<value_t>(N, K);
+  auto err_buf = vector<double>(K);
+  EXPECT_NEAR(worker(B, X_buf, err_buf), err_max, 1e-12);
+  EXPECT_ARRAY_NEAR(X_buf, X_ref, 1e-12);
+  EXPECT_ARRAY_NEAR(err_buf, errs, 1e-12);
+
+  // vector right hand side
+  auto [x, err_x] = worker(vector<value_t>{B(_, 3)});
+  EXPECT_ARRAY_NEAR(x, X_ref(_, 3), 1e-12);
+  EXPECT_NEAR(err_x, errs(3), 1e-12);
+
+  // batch of right hand sides
+  auto Bs  = std::vector<matrix<value_t>>{B, matrix<value_t>{B(_, range(3))}, matrix<value_t>{2 * B}};
+  auto res = worker.solve_batch(Bs);
+  ASSERT_EQ(res.size(), 3);
+  EXPECT_ARRAY_NEAR(res[0].first, X_ref, 1e-12);
+  EXPECT_ARRAY_NEAR(res[1].first, X_ref(_, range(3)), 1e-12);
+  EXPECT_ARRAY_NEAR(res[2].first, 2 * X_ref, 1e-12);
+  EXPECT_NEAR(res[0].second, err_max, 1e-12);
+  EXPECT_NEAR(res[2].second, 2 * err_max, 1e-12);
+}
+TEST(lapack, gelss_worker_multi_rhs) { test_gelss_worker_multi_rhs<double>(); }    //NOLINT
+TEST(lapack, zgelss_worker_multi_rhs) { test_gelss_worker_multi_rhs<dcomplex>(); } //NOLINT
+
 // =================================== getrs =======================================
 
 template <typename value_t>
@@ -238,3 +442,323 @@ void test_getrs() {
 }
 TEST(lapack, getrs) { test_getrs<double>(); }    //NOLINT
 TEST(lapack, zgetrs) { test_getrs<dcomplex>(); } //NOLINT
+
+// =============================== syevd/heevd ===================================
+
+template <typename value_t>
+void test_heevd() {
+  using matrix_t = matrix<value_t, F_layout>;
+  long N         = 8;
+  auto R         = matrix_t::rand({N, N});
+  auto A         = matrix_t{R + dagger(R)};
+  auto ev_ref    = nda::linalg::eigenvalues(A);
+
+  // eigenvalues only
+  auto w     = vector<double>(N);
+  auto Acopy = matrix_t{A};
+  lapack::heevd(Acopy, w, 'N');
+  EXPECT_ARRAY_NEAR(w, ev_ref, 1e-12);
+
+  // eigenvalues and eigenvectors with a reusable workspace
+  auto ws = lapack::workspace<value_t>{};
+  for (char uplo : {'U', 'L'}) {
+    Acopy = A;
+    lapack::heevd(Acopy, w, ws, 'V', uplo);
+    EXPECT_ARRAY_NEAR(w, ev_ref, 1e-12);
+    EXPECT_ARRAY_NEAR(matrix_t{A * Acopy}, matrix_t{Acopy * diag(w)}, 1e-12);
+    EXPECT_ARRAY_NEAR(matrix_t{dagger(Acopy) * Acopy}, eye<value_t>(N), 1e-12);
+  }
+}
+TEST(lapack, syevd) { test_heevd<double>(); }   //NOLINT
+TEST(lapack, zheevd) { test_heevd<dcomplex>(); } //NOLINT
+
+// =============================== syevr/heevr ===================================
+
+template <typename value_t>
+void test_heevr() {
+  using matrix_t = matrix<value_t, F_layout>;
+  long N         = 10;
+  auto R         = matrix_t::rand({N, N});
+  auto A         = matrix_t{R + dagger(R)};
+  auto ev_ref    = nda::linalg::eigenvalues(A);
+
+  auto w     = vector<double>(N);
+  auto Z     = matrix_t(N, N);
+  auto Acopy = matrix_t{A};
+  int m      = 0;
+
+  // full spectrum
+  lapack::syevr(Acopy, w, Z, m);
+  EXPECT_EQ(m, N);
+  EXPECT_ARRAY_NEAR(w, ev_ref, 1e-12);
+  EXPECT_ARRAY_NEAR(matrix_t{A * Z}, matrix_t{Z * diag(w)}, 1e-12);
+
+  // lowest 3 eigenpairs into a smaller output matrix
+  auto ws = lapack::workspace<value_t>{};
+  auto Z3 = matrix_t(N, 3);
+  Acopy   = A;
+  lapack::heevr(Acopy, w, Z3, m, ws, 'V', 'I', 0.0, 0.0, 0, 2);
+  EXPECT_EQ(m, 3);
+  EXPECT_ARRAY_NEAR(w(range(3)), ev_ref(range(3)), 1e-12);
+  EXPECT_ARRAY_NEAR(matrix_t{A * Z3}, matrix_t{Z3 * diag(w(range(3)))}, 1e-12);
+
+  // eigenvalues in an interval
+  double vl = 0.5 * (ev_ref(3) + ev_ref(4)), vu = 0.5 * (ev_ref(6) + ev_ref(7));
+  Acopy = A;
+  lapack::syevr(Acopy, w, Z, m, ws, 'N', 'V', vl, vu);
+  EXPECT_EQ(m, 3);
+  EXPECT_ARRAY_NEAR(w(range(3)), ev_ref(range(4, 7)), 1e-12);
+}
+TEST(lapack, syevr) { test_heevr<double>(); }   //NOLINT
+TEST(lapack, zheevr) { test_heevr<dcomplex>(); } //NOLINT
+
+// ============================= geev/ggev/sygvd/hegvd ============================
+
+// Convert the eigenvectors returned by geev/ggev to a complex matrix (unpack the compact format for real matrices).
+template <typename M, typename W>
+matrix<dcomplex, F_layout> unpack_eigenvectors(M const &v, W const &w) {
+  long N = v.extent(0);
+  auto z = matrix<dcomplex, F_layout>(v);
+  if constexpr (std::is_same_v<get_value_t<M>, double>) {
+    for (long j = 0; j < N; ++j) {
+      if (w(j).imag() > 0) {
+        z(_, j)     = v(_, j) + 1i * v(_, j + 1);
+        z(_, j + 1) = v(_, j) - 1i * v(_, j + 1);
+        ++j;
+      }
+    }
+  }
+  return z;
+}
+
+template <typename value_t>
+void test_geev() {
+  using matrix_t = matrix<value_t, F_layout>;
+  long N         = 7;
+  auto A         = matrix_t::rand({N, N});
+  auto Ac        = matrix<dcomplex, F_layout>{A};
+
+  auto w  = vector<dcomplex>(N);
+  auto VL = matrix_t(N, N);
+  auto VR = matrix_t(N, N);
+  auto ws = lapack::workspace<value_t>{};
+  for (int k = 0; k < 2; ++k) {
+    auto Acopy = matrix_t{A};
+    lapack::geev(Acopy, w, VL, VR, ws, 'V', 'V');
+    auto vr = unpack_eigenvectors(VR, w);
+    auto vl = unpack_eigenvectors(VL, w);
+    EXPECT_ARRAY_NEAR(matrix<dcomplex, F_layout>{Ac * vr}, matrix<dcomplex, F_layout>{vr * diag(w)}, 1e-12);
+    EXPECT_ARRAY_NEAR(matrix<dcomplex, F_layout>{dagger(vl) * Ac}, matrix<dcomplex, F_layout>{diag(w) * dagger(vl)}, 1e-12);
+  }
+
+  // eigenvalues only (the trace is the sum of the eigenvalues)
+  auto w2    = vector<dcomplex>(N);
+  auto empty = matrix_t{};
+  auto Acopy = matrix_t{A};
+  lapack::geev(Acopy, w2, empty, empty, 'N', 'N');
+  EXPECT_ARRAY_NEAR(w2, w, 1e-12);
+  EXPECT_COMPLEX_NEAR(sum(w2), trace(A), 1e-12);
+}
+TEST(lapack, geev) { test_geev<double>(); }    //NOLINT
+TEST(lapack, zgeev) { test_geev<dcomplex>(); } //NOLINT
+
+//---------------------------------------------------------
+
+template <typename value_t>
+void test_ggev() {
+  using matrix_t = matrix<value_t, F_layout>;
+  long N         = 6;
+  auto A         = matrix_t::rand({N, N});
+  auto B         = matrix_t::rand({N, N});
+  auto Ac        = matrix<dcomplex, F_layout>{A};
+  auto Bc        = matrix<dcomplex, F_layout>{B};
+
+  auto alpha = vector<dcomplex>(N);
+  auto beta  = vector<value_t>(N);
+  auto VL    = matrix_t(N, N);
+  auto VR    = matrix_t(N, N);
+  auto Acopy = matrix_t{A};
+  auto Bcopy = matrix_t{B};
+  lapack::ggev(Acopy, Bcopy, alpha, beta, VL, VR, 'V', 'V');
+
+  // A v beta = B v alpha and beta u^H A = alpha u^H B
+  auto vr = unpack_eigenvectors(VR, alpha);
+  auto vl = unpack_eigenvectors(VL, alpha);
+  auto bd = diag(vector<dcomplex>{beta});
+  EXPECT_ARRAY_NEAR(matrix<dcomplex, F_layout>{Ac * vr * bd}, matrix<dcomplex, F_layout>{Bc * vr * diag(alpha)}, 1e-12);
+  EXPECT_ARRAY_NEAR(matrix<dcomplex, F_layout>{bd * dagger(vl) * Ac}, matrix<dcomplex, F_layout>{diag(alpha) * dagger(vl) * Bc}, 1e-12);
+
+  // B = 1 reduces to the standard eigenproblem
+  auto w     = vector<dcomplex>(N);
+  auto empty = matrix_t{};
+  Acopy      = A;
+  lapack::geev(Acopy, w, empty, empty, 'N', 'N');
+  Acopy = A;
+  Bcopy = eye<value_t>(N);
+  lapack::ggev(Acopy, Bcopy, alpha, beta, empty, empty, 'N', 'N');
+
+  // the eigenvalues are not necessarily returned in the same order, i.e. match each one to the closest of geev
+  auto used = std::vector<bool>(N, false);
+  for (long j = 0; j < N; ++j) {
+    auto lambda = dcomplex{alpha(j) / beta(j)};
+    long k_min  = -1;
+    for (long k = 0; k < N; ++k)
+      if (not used[k] and (k_min < 0 or std::abs(lambda - w(k)) < std::abs(lambda - w(k_min)))) k_min = k;
+    used[k_min] = true;
+    EXPECT_COMPLEX_NEAR(lambda, w(k_min), 1e-12);
+  }
+}
+TEST(lapack, ggev) { test_ggev<double>(); }    //NOLINT
+TEST(lapack, zggev) { test_ggev<dcomplex>(); } //NOLINT
+
+//---------------------------------------------------------
+
+template <typename value_t>
+void test_hegvd() {
+  using matrix_t = matrix<value_t, F_layout>;
+  long N         = 8;
+  auto R         = matrix_t::rand({N, N});
+  auto A         = matrix_t{R + dagger(R)};
+  auto S         = matrix_t::rand({N, N});
+  auto B         = matrix_t{S * dagger(S) + N * eye<value_t>(N)};
+
+  auto w  = vector<double>(N);
+  auto ws = lapack::workspace<value_t>{};
+  for (char uplo : {'U', 'L'}) {
+    auto X     = matrix_t{A};
+    auto Bcopy = matrix_t{B};
+    lapack::hegvd(X, Bcopy, w, ws, 'V', uplo);
+    EXPECT_ARRAY_NEAR(matrix_t{A * X}, matrix_t{B * X * diag(w)}, 1e-12);
+    EXPECT_ARRAY_NEAR(matrix_t{dagger(X) * B * X}, eye<value_t>(N), 1e-12);
+  }
+
+  // eigenvalues only for A B x = lambda x (the eigenvalues of the non-hermitian matrix A B are real)
+  auto X     = matrix_t{A};
+  auto Bcopy = matrix_t{B};
+  auto w2    = vector<double>(N);
+  lapack::hegvd(X, Bcopy, w2, 'N', 'U', 2);
+  auto AB    = matrix_t{A * B};
+  auto ev    = vector<dcomplex>(N);
+  auto empty = matrix_t{};
+  lapack::geev(AB, ev, empty, empty, 'N', 'N');
+  auto ev_re = vector<double>{real(ev)};
+  std::sort(ev_re.begin(), ev_re.end());
+  EXPECT_ARRAY_NEAR(w2, ev_re, 1e-10);
+
+  // B not positive definite
+  X     = A;
+  Bcopy = -B;
+  EXPECT_THROW(lapack::hegvd(X, Bcopy, w), nda::runtime_error);
+}
+TEST(lapack, sygvd) { test_hegvd<double>(); }   //NOLINT
+TEST(lapack, zhegvd) { test_hegvd<dcomplex>(); } //NOLINT
+
+// ============================ potrf/potrs/potri ================================
+
+template <typename value_t, typename layout_t>
+void test_potrf() {
+  using matrix_t = matrix<value_t, layout_t>;
+  long N         = 6;
+  auto R         = matrix_t::rand({N, N});
+  auto A         = matrix_t{R * dagger(R) + N * eye<value_t>(N)};
+  auto B         = matrix<value_t, F_layout>::rand({N, 2});
+
+  for (char uplo : {'U', 'L'}) {
+    // solve A * X = B
+    auto Af = matrix_t{A};
+    auto X  = matrix<value_t, F_layout>{B};
+    EXPECT_EQ(lapack::potrf(Af, uplo), 0);
+    EXPECT_EQ(lapack::potrs(Af, X, uplo), 0);
+    EXPECT_ARRAY_NEAR(matrix<value_t, F_layout>{A * X}, B, 1e-12);
+
+    // single right hand side
+    auto x = vector<value_t>{B(range::all, 0)};
+    EXPECT_EQ(lapack::potrs(Af, x, uplo), 0);
+    EXPECT_ARRAY_NEAR(x, X(range::all, 0), 1e-12);
+
+    // inverse (only the referenced triangle is valid)
+    auto Ainv_ref = inverse(A);
+    EXPECT_EQ(lapack::potri(Af, uplo), 0);
+    for (long i = 0; i < N; ++i)
+      for (long j = 0; j < N; ++j)
+        if ((uplo == 'U' and i <= j) or (uplo == 'L' and i >= j)) { EXPECT_COMPLEX_NEAR(Af(i, j), Ainv_ref(i, j), 1e-12); }
+  }
+
+  // not positive definite
+  auto Aneg = matrix_t{-A};
+  EXPECT_GT(lapack::potrf(Aneg), 0);
+}
+TEST(lapack, potrf) { test_potrf<double, F_layout>(); }     //NOLINT
+TEST(lapack, zpotrf) { test_potrf<dcomplex, F_layout>(); }  //NOLINT
+TEST(lapack, potrf_C) { test_potrf<double, C_layout>(); }   //NOLINT
+TEST(lapack, zpotrf_C) { test_potrf<dcomplex, C_layout>(); } //NOLINT
+
+// ============================ pptrf/pptrs/spev/hpev ============================
+
+template <typename value_t>
+void test_packed() {
+  using matrix_t = matrix<value_t, F_layout>;
+  long N         = 6;
+  auto R         = matrix_t::rand({N, N});
+  auto A         = matrix_t{R * dagger(R) + N * eye<value_t>(N)};
+  auto B         = matrix_t::rand({N, 2});
+  auto ev_ref    = nda::linalg::eigenvalues(A);
+
+  auto ws = lapack::workspace<value_t>{};
+  for (char uplo : {'U', 'L'}) {
+    // pack the triangle column by column
+    auto ap = vector<value_t>(N * (N + 1) / 2);
+    long k  = 0;
+    for (long j = 0; j < N; ++j)
+      for (long i = (uplo == 'U' ? 0 : j); i < (uplo == 'U' ? j + 1 : N); ++i) ap(k++) = A(i, j);
+
+    // eigenvalues and eigenvectors
+    auto ap_copy = ap;
+    auto w       = vector<double>(N);
+    auto Z       = matrix_t(N, N);
+    EXPECT_EQ(lapack::hpev(ap_copy, w, Z, ws, 'V', uplo), 0);
+    EXPECT_ARRAY_NEAR(w, ev_ref, 1e-12);
+    EXPECT_ARRAY_NEAR(matrix_t{A * Z}, matrix_t{Z * diag(w)}, 1e-12);
+
+    // Cholesky factorization and linear system
+    auto X = matrix_t{B};
+    EXPECT_EQ(lapack::pptrf(ap, uplo), 0);
+    EXPECT_EQ(lapack::pptrs(ap, X, uplo), 0);
+    EXPECT_ARRAY_NEAR(matrix_t{A * X}, B, 1e-12);
+  }
+  EXPECT_EQ(lapack::get_packed_dim(21), 6);
+}
+TEST(lapack, pptrf) { test_packed<double>(); }    //NOLINT
+TEST(lapack, zpptrf) { test_packed<dcomplex>(); } //NOLINT
+
+// ============================= sytrf/sytrs/hetrf/hetrs ===========================
+
+template <typename value_t, typename layout_t, bool hermitian>
+void test_sytrf() {
+  using matrix_t = matrix<value_t, layout_t>;
+  long N         = 6;
+  auto R         = matrix_t::rand({N, N});
+  auto A         = (hermitian ? matrix_t{R + dagger(R)} : matrix_t{R + transpose(R)});
+  auto B         = matrix<value_t, F_layout>::rand({N, 3});
+
+  auto ws = lapack::workspace<value_t>{};
+  for (char uplo : {'U', 'L'}) {
+    auto Af   = matrix_t{A};
+    auto X    = matrix<value_t, F_layout>{B};
+    auto ipiv = vector<int>(N);
+    if constexpr (hermitian) {
+      EXPECT_EQ(lapack::hetrf(Af, ipiv, ws, uplo), 0);
+      EXPECT_EQ(lapack::hetrs(Af, X, ipiv, uplo), 0);
+    } else {
+      EXPECT_EQ(lapack::sytrf(Af, ipiv, ws, uplo), 0);
+      EXPECT_EQ(lapack::sytrs(Af, X, ipiv, uplo), 0);
+    }
+    EXPECT_ARRAY_NEAR(matrix<value_t, F_layout>{A * X}, B, 1e-10);
+  }
+}
+TEST(lapack, sytrf) { test_sytrf<double, F_layout, false>(); }      //NOLINT
+TEST(lapack, zsytrf) { test_sytrf<dcomplex, F_layout, false>(); }   //NOLINT
+TEST(lapack, zsytrf_C) { test_sytrf<dcomplex, C_layout, false>(); } //NOLINT
+TEST(lapack, hetrf_C) { test_sytrf<double, C_layout, true>(); }     //NOLINT
+TEST(lapack, zhetrf) { test_sytrf<dcomplex, F_layout, true>(); }    //NOLINT
+TEST(lapack, zhetrf_C) { test_sytrf<dcomplex, C_layout, true>(); }  //NOLINT
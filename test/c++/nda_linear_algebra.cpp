@@ -19,8 +19,12 @@
 #include "nda/linalg/dot.hpp"
 #include <nda/lapack.hpp>
 
+#include <nda/linalg/batched.hpp>
 #include <nda/linalg/det_and_inverse.hpp>
 #include <nda/linalg/eigenelements.hpp>
+#include <nda/linalg/interleaved.hpp>
+#include <nda/linalg/cholesky.hpp>
+#include <nda/linalg/lu.hpp>
 
 using nda::C_layout;
 using nda::F_layout;
@@ -114,6 +118,91 @@ TEST(Matmul, Int) { // NOLINT
 
 //-------------------------------------------------------------
 
+TEST(Matmul, StackMatrix) { //NOLINT
+  nda::stack_matrix<double, 3, 4> A;
+  nda::stack_matrix<double, 4, 2> B;
+  nda::stack_vector<double, 4> x;
+  for (int i = 0; i < 3; ++i)
+    for (int j = 0; j < 4; ++j) A(i, j) = i + 0.5 * j;
+  for (int i = 0; i < 4; ++i) {
+    x(i) = 1 - i;
+    for (int j = 0; j < 2; ++j) B(i, j) = 1 + i - 2.0 * j;
+  }
+
+  // results of products of stack matrices/vectors are stack matrices/vectors
+  auto C = A * B;
+  auto y = A * x;
+  static_assert(std::is_same_v<decltype(C), nda::stack_matrix<double, 3, 2>>);
+  static_assert(std::is_same_v<decltype(y), nda::stack_vector<double, 3>>);
+
+  matrix<double> C_ref = matrix<double>::zeros(3, 2);
+  nda::vector<double> y_ref = nda::zeros<double>(3);
+  for (int i = 0; i < 3; ++i)
+    for (int k = 0; k < 4; ++k) {
+      y_ref(i) += A(i, k) * x(k);
+      for (int j = 0; j < 2; ++j) C_ref(i, j) += A(i, k) * B(k, j);
+    }
+  EXPECT_ARRAY_NEAR(C, C_ref, 1.e-14);
+  EXPECT_ARRAY_NEAR(y, y_ref, 1.e-14);
+}
+
+//-------------------------------------------------------------
+
+template <typename T, typename L1, typename L2>
+void test_matmul_small_vs_blas(long n) {
+  auto A = matrix<T, L1>{nda::rand(n, n + 1)};
+  auto B = matrix<T, L2>{nda::rand(n + 1, n)};
+  auto x = nda::vector<T>{nda::rand(n + 1)};
+
+  // compare with gemm/gemv called directly
+  auto C = matrix<T, F_layout>(n, n);
+  auto y = nda::vector<T>(n);
+  blas::gemm(1, A, B, 0, C);
+  blas::gemv(1, A, x, 0, y);
+  EXPECT_ARRAY_NEAR(A * B, C, 1.e-13);
+  EXPECT_ARRAY_NEAR(A * x, y, 1.e-13);
+}
+
+TEST(Matmul, SmallVsBlas) { //NOLINT
+  for (long n : {1, 2, 5, 7, 8, 9, 16}) {
+    test_matmul_small_vs_blas<double, C_layout, C_layout>(n);
+    test_matmul_small_vs_blas<double, F_layout, C_layout>(n);
+    test_matmul_small_vs_blas<dcomplex, C_layout, F_layout>(n);
+    test_matmul_small_vs_blas<dcomplex, F_layout, F_layout>(n);
+  }
+}
+
+//-------------------------------------------------------------
+
+template <typename T, typename L>
+void test_matmul_rank_k() {
+  auto A = matrix<T, L>{matrix<T>::rand({12, 10})};
+  auto B = matrix<T, L>{A};
+
+  // results computed with syrk/herk are exactly symmetric/hermitian
+  auto check = [](auto const &C, auto const &C_exp, bool hermitian) {
+    EXPECT_ARRAY_NEAR(C, C_exp, 1.e-13);
+    if (hermitian) {
+      EXPECT_EQ_ARRAY(C, make_regular(dagger(C)));
+    } else {
+      EXPECT_EQ_ARRAY(C, make_regular(transpose(C)));
+    }
+  };
+  check(make_regular(A * transpose(A)), make_regular(B * make_regular(transpose(B))), false);
+  check(make_regular(transpose(A) * A), make_regular(make_regular(transpose(B)) * B), false);
+  check(make_regular(A * dagger(A)), make_regular(B * make_regular(dagger(B))), true);
+  check(make_regular(dagger(A) * A), make_regular(make_regular(dagger(B)) * B), true);
+}
+
+TEST(Matmul, RankK) { //NOLINT
+  test_matmul_rank_k<double, C_layout>();
+  test_matmul_rank_k<double, F_layout>();
+  test_matmul_rank_k<dcomplex, C_layout>();
+  test_matmul_rank_k<dcomplex, F_layout>();
+}
+
+//-------------------------------------------------------------
+
 TEST(Matmul, Promotion) { //NOLINT
   matrix<double> C, D, A = {{1.0, 2.3}, {3.1, 4.3}};
   matrix<int> B     = {{1, 2}, {3, 4}};
@@ -325,8 +414,217 @@ TEST(Inverse, Small) { //NOLINT
   }
 }
 
+//-------------------------------------------------------------
+
+TEST(Inverse, Worker) { //NOLINT
+
+  for (auto N : {2, 5}) {
+    auto worker = nda::inverse_worker<dcomplex>(N);
+    for (int k = 0; k < 3; ++k) {
+      matrix<dcomplex> W(N, N);
+      for (int i = 0; i < N; ++i)
+        for (int j = 0; j < N; ++j) W(i, j) = (i > j ? 0.5 + i + 2.5 * j + k : i * 0.8 - j - 0.5) + 1i * (i == j ? k : 0);
+
+      auto Wi = W;
+      worker(Wi);
+      EXPECT_ARRAY_NEAR(Wi, inverse(W), 1.e-12);
+
+      // F layout
+      auto WFi = matrix<dcomplex, F_layout>{W};
+      worker(WFi);
+      EXPECT_ARRAY_NEAR(WFi, inverse(W), 1.e-12);
+    }
+  }
+}
+
+//-------------------------------------------------------------
+
+TEST(Inverse, SPD) { //NOLINT
+
+  for (auto N : {1, 4, 7}) {
+    auto R  = matrix<dcomplex>::rand({N, N});
+    auto A  = matrix<dcomplex>{R * dagger(R) + N * nda::eye<dcomplex>(N)};
+    auto Ai = inverse_spd(A);
+    EXPECT_ARRAY_NEAR(Ai, inverse(A), 1.e-12);
+
+    auto AF = matrix<double, F_layout>{real(A + transpose(A))};
+    inverse_spd_in_place(AF);
+    EXPECT_ARRAY_NEAR(AF, inverse(matrix<double>{real(A + transpose(A))}), 1.e-12);
+  }
+
+  auto A = matrix<double>{{1, 2}, {2, 1}};
+  EXPECT_THROW(inverse_spd(A), nda::runtime_error); //NOLINT
+}
+
 // ==============================================================
 
+template <typename T>
+void test_lu() {
+  long N = 6;
+  auto A = matrix<T>::rand({N, N});
+  auto B = matrix<T>::rand({N, 3});
+
+  auto f = nda::linalg::lu{A};
+  EXPECT_EQ(f.size(), N);
+  EXPECT_FALSE(f.is_singular());
+
+  // determinant
+  EXPECT_COMPLEX_NEAR(f.det(), determinant(A), 1.e-12);
+  EXPECT_COMPLEX_NEAR(f.sign() * std::exp(f.log_det()), determinant(A), 1.e-12);
+
+  // solve with C and F layout matrices and with a vector
+  auto X = B;
+  f.solve(X);
+  EXPECT_ARRAY_NEAR(matrix<T>{A * X}, B, 1.e-10);
+  auto XF = matrix<T, F_layout>{B};
+  f.solve(XF);
+  EXPECT_ARRAY_NEAR(XF, X, 1.e-12);
+  auto x = nda::vector<T>{B(range::all, 1)};
+  f.solve(x);
+  EXPECT_ARRAY_NEAR(x, X(range::all, 1), 1.e-12);
+
+  // inverse
+  EXPECT_ARRAY_NEAR(f.inverse(), inverse(A), 1.e-10);
+
+  // refactorizing a matrix of the same size reuses the storage
+  auto const *lu_ptr = f.factors().data();
+  f.factorize(matrix<T, F_layout>{A});
+  EXPECT_EQ(f.factors().data(), lu_ptr);
+  EXPECT_COMPLEX_NEAR(f.det(), determinant(A), 1.e-12);
+
+  // refactorize and singular matrix
+  f.factorize(matrix<T>{{1, 2}, {2, 4}});
+  EXPECT_TRUE(f.is_singular());
+  EXPECT_COMPLEX_NEAR(f.det(), T{0}, 1.e-14);
+  EXPECT_THROW(std::ignore = f.inverse(), nda::runtime_error); //NOLINT
+}
+TEST(LU, Factorization) { test_lu<double>(); }    //NOLINT
+TEST(LU, ZFactorization) { test_lu<dcomplex>(); } //NOLINT
+
+template <typename T>
+void test_cholesky() {
+  long N = 6;
+  auto R = matrix<T>::rand({N, N});
+  auto A = matrix<T>{R * dagger(R) + N * nda::eye<T>(N)};
+  auto B = matrix<T>::rand({N, 2});
+
+  auto f = nda::linalg::cholesky{A};
+  auto L = f.factor();
+  EXPECT_ARRAY_NEAR(matrix<T>{L * dagger(L)}, A, 1.e-12);
+  EXPECT_NEAR(f.det(), std::real(determinant(A)), 1.e-10 * f.det());
+  EXPECT_NEAR(f.log_det(), std::log(f.det()), 1.e-12);
+
+  auto X = B;
+  f.solve(X);
+  EXPECT_ARRAY_NEAR(matrix<T>{A * X}, B, 1.e-10);
+  auto x = nda::vector<T>{B(range::all, 0)};
+  f.solve(x);
+  EXPECT_ARRAY_NEAR(x, X(range::all, 0), 1.e-12);
+
+  EXPECT_ARRAY_NEAR(f.inverse(), inverse(A), 1.e-12);
+
+  // refactorizing a matrix of the same size reuses the storage
+  auto const *l_ptr = f.factor().data();
+  f.factorize(matrix<T, F_layout>{A});
+  EXPECT_EQ(f.factor().data(), l_ptr);
+  EXPECT_ARRAY_NEAR(matrix<T>{f.factor() * dagger(f.factor())}, A, 1.e-12);
+  EXPECT_THROW(f.factorize(matrix<T>{-A}), nda::runtime_error); //NOLINT
+}
+TEST(Cholesky, Factorization) { test_cholesky<double>(); }    //NOLINT
+TEST(Cholesky, ZFactorization) { test_cholesky<dcomplex>(); } //NOLINT
+
+template <typename T>
+void test_batch() {
+  auto _     = range::all;
+  long batch = 5;
+  for (long n : {1, 2, 3, 6}) {
+    auto A = nda::array<T, 3>::rand({batch, n, n});
+    for (long i = 0; i < batch; ++i) A(i, _, _) += n * nda::eye<T>(n);
+
+    // inverse and determinant
+    auto Ainv = nda::inverse_batch(A);
+    auto dets = nda::determinant_batch(A);
+    for (long i = 0; i < batch; ++i) {
+      auto Ai = matrix<T>{make_matrix_view(A(i, _, _))};
+      EXPECT_ARRAY_NEAR(make_matrix_view(Ainv(i, _, _)), inverse(Ai), 1.e-12);
+      EXPECT_COMPLEX_NEAR(dets(i), determinant(Ai), 1.e-10);
+    }
+
+    // eigenvalues and eigenvectors of hermitian matrices
+    auto H = nda::array<T, 3>(batch, n, n);
+    for (long i = 0; i < batch; ++i) H(i, _, _) = matrix<T>{make_matrix_view(A(i, _, _))} + dagger(matrix<T>{make_matrix_view(A(i, _, _))});
+    auto [ev, vecs] = nda::linalg::eigenelements_batch(H);
+    EXPECT_ARRAY_NEAR(nda::linalg::eigenvalues_batch(H), ev, 1.e-12);
+    for (long i = 0; i < batch; ++i) {
+      auto Hi = matrix<T>{make_matrix_view(H(i, _, _))};
+      auto Vi = matrix<T>{make_matrix_view(vecs(i, _, _))};
+      EXPECT_ARRAY_NEAR(ev(i, _), nda::linalg::eigenvalues(Hi), 1.e-12);
+      EXPECT_ARRAY_NEAR(matrix<T>{Hi * Vi}, matrix<T>{Vi * nda::diag(ev(i, _))}, 1.e-12);
+    }
+  }
+
+  // singular matrix in the stack
+  auto S = nda::array<T, 3>(2, 4, 4);
+  S(0, _, _) = nda::eye<T>(4);
+  S(1, _, _) = T{1};
+  EXPECT_COMPLEX_NEAR(nda::determinant_batch(S)(1), T{0}, 1.e-14);
+  EXPECT_THROW(nda::inverse_batch_in_place(S), nda::runtime_error); //NOLINT
+}
+TEST(Batch, InverseDeterminantEigen) { test_batch<double>(); }    //NOLINT
+TEST(Batch, ZInverseDeterminantEigen) { test_batch<dcomplex>(); } //NOLINT
+
+template <typename T>
+void test_interleaved() {
+  auto _     = range::all;
+  long batch = 13;
+  for (long n : {1, 2, 3, 5, 8}) {
+    // well-conditioned matrices
+    auto A = nda::array<T, 3>::rand({batch, n, n});
+    for (long b = 0; b < batch; ++b) A(b, _, _) += n * nda::eye<T>(n);
+    auto X = nda::linalg::interleaved_matrices<T>{A};
+    EXPECT_EQ(X.dim(), n);
+    EXPECT_EQ(X.size(), batch);
+    EXPECT_ARRAY_EQ(X.to_stack(), A);
+
+    // determinant, solve and inverse
+    auto dets = nda::determinant_batch(A);
+    EXPECT_ARRAY_NEAR(X.determinant(), dets, 1.e-12 * max_element(abs(dets)));
+    auto y = nda::array<T, 2>::rand({batch, n});
+    auto x = X.solve(y);
+    for (long b = 0; b < batch; ++b) {
+      auto Ab = matrix<T>{make_matrix_view(A(b, _, _))};
+      EXPECT_ARRAY_NEAR(nda::vector<T>{Ab * nda::vector<T>{x(b, _)}}, y(b, _), 1.e-10);
+    }
+    X.invert();
+    EXPECT_ARRAY_NEAR(X.to_stack(), nda::inverse_batch(A), 1.e-10);
+
+    // eigenvalues and eigenvectors of symmetric matrices
+    if constexpr (not nda::is_complex_v<T>) {
+      auto H = nda::array<T, 3>(batch, n, n);
+      for (long b = 0; b < batch; ++b) H(b, _, _) = A(b, _, _) + transpose(A(b, _, _));
+      auto [ev, vecs]         = nda::linalg::interleaved_matrices<T>{H}.eigenelements();
+      auto [ev_ref, vecs_ref] = nda::linalg::eigenelements_batch(H);
+      EXPECT_ARRAY_NEAR(ev, ev_ref, 1.e-12);
+      for (long b = 0; b < batch; ++b) {
+        auto Hb = matrix<T>{make_matrix_view(H(b, _, _))};
+        auto Vb = matrix<T>{make_matrix_view(vecs(b, _, _))};
+        EXPECT_ARRAY_NEAR(matrix<T>{Hb * Vb}, matrix<T>{Vb * nda::diag(ev(b, _))}, 1.e-12);
+        EXPECT_ARRAY_NEAR(matrix<T>{transpose(Vb) * Vb}, nda::eye<T>(n), 1.e-12);
+      }
+    }
+  }
+
+  // singular matrix in the batch
+  auto S     = nda::array<T, 3>(2, 3, 3);
+  S(0, _, _) = nda::eye<T>(3);
+  S(1, _, _) = T{1};
+  auto XS    = nda::linalg::interleaved_matrices<T>{S};
+  EXPECT_COMPLEX_NEAR(XS.determinant()(1), T{0}, 1.e-14);
+  EXPECT_THROW(XS.invert(), nda::runtime_error); //NOLINT
+}
+TEST(Interleaved, Kernels) { test_interleaved<double>(); }    //NOLINT
+TEST(Interleaved, ZKernels) { test_interleaved<dcomplex>(); } //NOLINT
+
 TEST(Matvecmul, Promotion) { //NOLINT
 
   matrix<int> Ai   = {{1, 2}, {3, 4}};
@@ -419,3 +717,668 @@ TEST(eigenelements, test1) { //NOLINT
     test(C);
   }
 }
+
+//----------------------------------
+
+TEST(eigenelements, worker) { //NOLINT
+  long N      = 6;
+  auto worker = nda::linalg::eigen_worker<dcomplex>(N);
+  EXPECT_EQ(worker.size(), N);
+
+  // the buffers of the worker are reused for C and Fortran layout inputs
+  auto const *vecs_ptr = worker.eigenelements(nda::matrix<dcomplex>{nda::eye<dcomplex>(N)}).second.data();
+  for (int k = 0; k < 3; ++k) {
+    auto R  = nda::matrix<dcomplex>::rand({N, N});
+    auto A  = nda::matrix<dcomplex>{R + dagger(R)};
+    auto AF = nda::matrix<dcomplex, nda::F_layout>{A};
+
+    auto ev_ref = nda::linalg::eigenvalues(A);
+    EXPECT_ARRAY_NEAR(worker.eigenvalues(A), ev_ref, 1.e-12);
+
+    auto [ev, vecs] = worker.eigenelements(A);
+    EXPECT_ARRAY_NEAR(ev, ev_ref, 1.e-12);
+    check_eig(A, vecs, ev);
+    EXPECT_EQ(vecs.data(), vecs_ptr);
+
+    auto [ev_f, vecs_f] = worker.eigenelements(AF);
+    EXPECT_ARRAY_NEAR(ev_f, ev_ref, 1.e-12);
+    check_eig(A, vecs_f, ev_f);
+    EXPECT_EQ(vecs_f.data(), vecs_ptr);
+  }
+}
+
+//----------------------------------
+
+template <typename value_t>
+void test_randomized_svd() { //NOLINT
+  using matrix_t = nda::matrix<value_t, nda::F_layout>;
+  long M = 120, N = 80, rank = 8, k = 5;
+
+  // low-rank matrix with known singular values
+  auto [Q1, S1, VH1] = [&]() {
+    auto A = matrix_t{nda::matrix<value_t>::rand({M, N})};
+    auto S = nda::vector<double>(N);
+    auto U = matrix_t(M, N);
+    auto V = matrix_t(N, N);
+    nda::lapack::gesvd(A, S, U, V, 'S');
+    return std::make_tuple(matrix_t{U(_, range(rank))}, S, matrix_t{V(range(rank), _)});
+  }();
+  auto sv = nda::vector<double>(rank);
+  for (long i = 0; i < rank; ++i) sv(i) = std::pow(0.5, i);
+  auto A = matrix_t{Q1 * nda::diag(sv) * VH1};
+
+  auto check = [&](auto const &U, auto const &S, auto const &VH) {
+    EXPECT_EQ(U.shape(), (std::array{M, k}));
+    EXPECT_EQ(VH.shape(), (std::array{k, N}));
+    EXPECT_ARRAY_NEAR(S, sv(range(k)), 1e-12);
+    EXPECT_ARRAY_NEAR(dagger(U) * U, nda::eye<value_t>(k), 1e-12);
+    EXPECT_ARRAY_NEAR(VH * dagger(VH), nda::eye<value_t>(k), 1e-12);
+    // the truncation error is given by the first neglected singular value
+    auto R     = matrix_t{A - U * nda::diag(S) * VH};
+    auto S_res = nda::vector<double>(N);
+    auto empty = matrix_t{};
+    nda::lapack::gesvd(R, S_res, empty, empty, 'N');
+    EXPECT_NEAR(S_res(0), sv(k), 1e-12);
+  };
+
+  // matrix input (also in C layout)
+  auto [U, S, VH] = nda::linalg::randomized_svd(A, k);
+  check(U, S, VH);
+  auto [U_c, S_c, VH_c] = nda::linalg::randomized_svd(nda::matrix<value_t>{A}, k, 5, 1, 42);
+  check(U_c, S_c, VH_c);
+
+  // matrix-free input
+  auto apply         = [&](matrix_t const &X) { return matrix_t{A * X}; };
+  auto apply_adjoint = [&](matrix_t const &Y) { return matrix_t{dagger(A) * Y}; };
+
+  auto [U_op, S_op, VH_op] = nda::linalg::randomized_svd<value_t>(M, N, apply, apply_adjoint, k);
+  check(U_op, S_op, VH_op);
+
+  EXPECT_THROW(std::ignore = nda::linalg::randomized_svd(A, N + 1), nda::runtime_error);
+}
+
+TEST(RandomizedSVD, LowRank) { test_randomized_svd<double>(); }    //NOLINT
+TEST(RandomizedSVD, ZLowRank) { test_randomized_svd<dcomplex>(); } //NOLINT
+
+//----------------------------------
+
+template <typename value_t>
+void test_matrix_functions() { //NOLINT
+  using matrix_t = nda::matrix<value_t>;
+  long N         = 6;
+
+  // nilpotent and rotation generators (the latter requires scaling and squaring)
+  auto J = matrix_t::zeros(N, N);
+  for (long i = 0; i + 1 < N; ++i) J(i, i + 1) = 1;
+  auto expJ = matrix_t{nda::eye<value_t>(N)};
+  auto Jk   = matrix_t{nda::eye<value_t>(N)};
+  for (long k = 1; k < N; ++k) {
+    Jk   = Jk * J / double(k);
+    expJ = expJ + Jk;
+  }
+  EXPECT_ARRAY_NEAR(nda::linalg::expm(J), expJ, 1e-14);
+  double t = 20.0;
+  auto G   = matrix_t{{0, -t}, {t, 0}};
+  auto R   = matrix_t{{std::cos(t), -std::sin(t)}, {std::sin(t), std::cos(t)}};
+  EXPECT_ARRAY_NEAR(nda::linalg::expm(G), R, 1e-12);
+
+  // exp(2A) = exp(A)^2 for norms covering all Pade degrees
+  for (double scale : {0.001, 0.05, 0.2, 0.5, 1.0, 4.0}) {
+    auto A  = matrix_t{scale * (matrix_t::rand({N, N}) - 0.5)};
+    auto eA = nda::linalg::expm(A);
+    EXPECT_ARRAY_NEAR(nda::linalg::expm(matrix_t{2 * A}), eA * eA, 1e-12 * nda::max_element(abs(eA * eA)));
+  }
+
+  // logm and sqrtm
+  auto B = matrix_t{matrix_t::rand({N, N}) + N * nda::eye<value_t>(N)};
+  auto S = nda::linalg::sqrtm(B);
+  EXPECT_ARRAY_NEAR(S * S, B, 1e-12);
+  auto L = nda::linalg::logm(B);
+  EXPECT_ARRAY_NEAR(nda::linalg::expm(L), B, 1e-12);
+  auto A = matrix_t{0.5 * (matrix_t::rand({N, N}) - 0.5)};
+  EXPECT_ARRAY_NEAR(nda::linalg::logm(nda::linalg::expm(A)), A, 1e-12);
+
+  // preallocated output with a different layout and a reusable worker (the result is written into its memory)
+  auto out      = nda::matrix<value_t, nda::F_layout>(N, N);
+  auto out_v    = out();
+  auto worker   = nda::linalg::expm_worker<value_t>{};
+  auto out_data = out.data();
+  for (int k = 0; k < 2; ++k) {
+    worker(A, out);
+    EXPECT_EQ(out.data(), out_data);
+    EXPECT_ARRAY_NEAR(out_v, nda::linalg::expm(A), 1e-14);
+  }
+  nda::linalg::sqrtm(B, out);
+  EXPECT_EQ(out.data(), out_data);
+  EXPECT_ARRAY_NEAR(out_v, S, 1e-14);
+
+  // singular matrix and non-square matrix
+  EXPECT_THROW(std::ignore = nda::linalg::sqrtm(matrix_t::zeros(N, N)), nda::runtime_error);
+  EXPECT_THROW(std::ignore = nda::linalg::expm(matrix_t::zeros(N, N + 1)), nda::runtime_error);
+
+  // functions of hermitian matrices
+  auto X = matrix_t::rand({N, N});
+  auto H = matrix_t{X + dagger(X)};
+  EXPECT_ARRAY_NEAR(nda::linalg::apply_hermitian([](double x) { return std::exp(x); }, H), nda::linalg::expm(H), 1e-10);
+  auto P = matrix_t{H * H + nda::eye<value_t>(N)};
+  EXPECT_ARRAY_NEAR(nda::linalg::apply_hermitian([](double x) { return std::log(x); }, P), nda::linalg::logm(P), 1e-10);
+  auto U = nda::linalg::apply_hermitian([](double x) { return std::exp(dcomplex{0, -0.3 * x}); }, H);
+  static_assert(std::is_same_v<nda::get_value_t<decltype(U)>, dcomplex>);
+  EXPECT_ARRAY_NEAR(U, nda::linalg::expm(nda::matrix<dcomplex>{dcomplex{0, -0.3} * H}), 1e-12);
+  EXPECT_ARRAY_NEAR(U * dagger(U), nda::eye<dcomplex>(N), 1e-12);
+  auto h_worker = nda::linalg::apply_hermitian_worker<value_t>(N);
+  for (int k = 0; k < 2; ++k) {
+    h_worker([](double x) { return std::exp(x); }, H, out);
+    EXPECT_EQ(out.data(), out_data);
+    EXPECT_ARRAY_NEAR(out_v, nda::linalg::expm(H), 1e-10);
+  }
+
+  // batched versions
+  long batch = 5;
+  auto As    = nda::array<value_t, 3>(batch, N, N);
+  auto Hs    = nda::array<value_t, 3>(batch, N, N);
+  for (long b = 0; b < batch; ++b) {
+    auto Y      = matrix_t::rand({N, N});
+    As(b, _, _) = (b + 1) * Y;
+    Hs(b, _, _) = Y + dagger(Y);
+  }
+  auto eAs = nda::linalg::expm_batch(As);
+  auto Us  = nda::linalg::apply_hermitian_batch([](double x) { return std::exp(dcomplex{0, -x}); }, Hs);
+  auto Bs  = nda::array<value_t, 3>(batch, N, N);
+  auto Rs  = nda::array<value_t, 3>(batch, N, N);
+  for (long b = 0; b < batch; ++b) Bs(b, _, _) = nda::make_matrix_view(As(b, _, _)) + 2 * N * nda::eye<value_t>(N);
+  nda::linalg::sqrtm_batch(Bs, Rs);
+  for (long b = 0; b < batch; ++b) {
+    auto A_b = matrix_t{nda::make_matrix_view(As(b, _, _))};
+    auto H_b = nda::matrix<dcomplex>{nda::make_matrix_view(Hs(b, _, _))};
+    auto S_b = matrix_t{nda::make_matrix_view(Rs(b, _, _))};
+    auto U_b = nda::matrix<dcomplex>{nda::make_matrix_view(Us(b, _, _))};
+    EXPECT_ARRAY_NEAR(matrix_t{nda::make_matrix_view(eAs(b, _, _))}, nda::linalg::expm(A_b), 1e-14);
+    EXPECT_ARRAY_NEAR(U_b, nda::linalg::expm(nda::matrix<dcomplex>{dcomplex{0, -1} * H_b}), 1e-12);
+    EXPECT_ARRAY_NEAR(S_b * S_b, matrix_t{nda::make_matrix_view(Bs(b, _, _))}, 1e-12);
+  }
+  nda::linalg::logm_batch(Bs, Rs);
+  EXPECT_ARRAY_NEAR(matrix_t{nda::make_matrix_view(Rs(1, _, _))}, nda::linalg::logm(nda::make_matrix_view(Bs(1, _, _))), 1e-14);
+}
+
+TEST(MatrixFunctions, Real) { test_matrix_functions<double>(); }      //NOLINT
+TEST(MatrixFunctions, Complex) { test_matrix_functions<dcomplex>(); } //NOLINT
+
+template <typename value_t>
+void test_det_manip() { //NOLINT
+  using matrix_t = nda::matrix<value_t>;
+  using vector_t = nda::vector<value_t>;
+
+  // reference matrix with rows i and columns j of m replaced by/inserted from the rows of r, the columns of c and d
+  auto build = [](matrix_t const &m, std::vector<long> const &i, std::vector<long> const &j, matrix_t const &r, matrix_t const &c,
+                  matrix_t const &d) {
+    long n   = m.extent(0) + std::ssize(i);
+    auto res = matrix_t(n, n);
+    auto pos = [](std::vector<long> const &p, long size) {
+      auto old = std::vector<long>(size, -1);
+      for (long k = 0, l = 0; k < size; ++k)
+        if (std::find(p.begin(), p.end(), k) == p.end()) old[k] = l++;
+      return old;
+    };
+    auto oi = pos(i, n), oj = pos(j, n);
+    for (long a = 0; a < n; ++a) {
+      for (long b = 0; b < n; ++b) {
+        long ia = std::find(i.begin(), i.end(), a) - i.begin(), jb = std::find(j.begin(), j.end(), b) - j.begin();
+        if (oi[a] >= 0 and oj[b] >= 0) res(a, b) = m(oi[a], oj[b]);
+        if (oi[a] < 0 and oj[b] >= 0) res(a, b) = r(ia, oj[b]);
+        if (oi[a] >= 0 and oj[b] < 0) res(a, b) = c(oi[a], jb);
+        if (oi[a] < 0 and oj[b] < 0) res(a, b) = d(ia, jb);
+      }
+    }
+    return res;
+  };
+  auto remove = [](matrix_t const &m, std::vector<long> const &i, std::vector<long> const &j) {
+    long n   = m.extent(0) - std::ssize(i);
+    auto res = matrix_t(n, n);
+    for (long a = 0, ra = 0; a < m.extent(0); ++a) {
+      if (std::find(i.begin(), i.end(), a) != i.end()) continue;
+      for (long b = 0, rb = 0; b < m.extent(1); ++b)
+        if (std::find(j.begin(), j.end(), b) == j.end()) res(ra, rb++) = m(a, b);
+      ++ra;
+    }
+    return res;
+  };
+
+  // check the state of the object against the reference matrix
+  auto ref   = matrix_t(0, 0);
+  auto check = [&](auto const &dm) {
+    ASSERT_EQ(dm.size(), ref.extent(0));
+    EXPECT_ARRAY_NEAR(dm.mat(), ref, 1e-14);
+    if (ref.empty()) return;
+    EXPECT_ARRAY_NEAR(dm.inverse(), nda::inverse(ref), 1e-10);
+    EXPECT_COMPLEX_NEAR(dm.determinant(), nda::determinant(ref), 1e-10 * std::abs(nda::determinant(ref)));
+  };
+  // all matrices are kept well-conditioned: they have one large element in each row and column and small random
+  // elements otherwise (i.e. they are diagonally dominant up to a permutation)
+  auto rand_mat = [](long m, long n) { return matrix_t{0.1 * (matrix_t::rand({m, n}) - 0.5)}; };
+  auto argmax   = [](auto const &v) {
+    long res = 0;
+    for (long k = 1; k < v.size(); ++k)
+      if (std::abs(v(k)) > std::abs(v(res))) res = k;
+    return res;
+  };
+  auto diag     = [](value_t x) { return matrix_t{{x}}; };
+
+  // build the matrix row by row from an empty object
+  auto dm = nda::linalg::det_manip<value_t>{};
+  dm.set_recompute_period(0);
+  for (long n = 0; n < 6; ++n) {
+    long i = n / 2, j = (n + 1) / 2;
+    auto r       = rand_mat(1, n), c = rand_mat(n, 1);
+    auto d       = value_t(2.0 + n);
+    auto new_ref = build(ref, {i}, {j}, r, c, diag(d));
+    auto ratio   = dm.try_insert(i, j, r(0, _), c(_, 0), d);
+    EXPECT_COMPLEX_NEAR(ratio, (ref.empty() ? value_t{1} : value_t{1} / nda::determinant(ref)) * nda::determinant(new_ref), 1e-10);
+    dm.complete_operation();
+    ref = new_ref;
+    check(dm);
+  }
+
+  // rejected removal leaves the object unchanged
+  auto ratio = dm.try_remove(2, 3);
+  dm.reject_last_try();
+  check(dm);
+  auto new_ref = remove(ref, {2}, {3});
+  EXPECT_COMPLEX_NEAR(ratio, nda::determinant(new_ref) / nda::determinant(ref), 1e-10);
+  EXPECT_COMPLEX_NEAR(dm.try_remove(2, 3), ratio, 1e-14);
+  dm.complete_operation();
+  ref = new_ref;
+  check(dm);
+
+  // replace a column, a row and a row and a column
+  auto col = vector_t{rand_mat(5, 1)(_, 0)};
+  col(argmax(ref(_, 3))) += 3.0;
+  new_ref       = ref;
+  new_ref(_, 3) = col;
+  EXPECT_COMPLEX_NEAR(dm.try_change_col(3, col), nda::determinant(new_ref) / nda::determinant(ref), 1e-10);
+  dm.complete_operation();
+  ref = new_ref;
+  check(dm);
+  auto row = vector_t{rand_mat(1, 5)(0, _)};
+  row(argmax(ref(0, _))) += 3.0;
+  new_ref       = ref;
+  new_ref(0, _) = row;
+  EXPECT_COMPLEX_NEAR(dm.try_change_row(0, row), nda::determinant(new_ref) / nda::determinant(ref), 1e-10);
+  dm.complete_operation();
+  ref = new_ref;
+  check(dm);
+  auto r = rand_mat(1, 4), c = rand_mat(4, 1);
+  r(0, 3) += 3.0; // the large elements of row 1 and column 4 are at (1, 3) and (0, 4)
+  c(0, 0) += 3.0;
+  new_ref = build(remove(ref, {1}, {4}), {1}, {4}, r, c, diag(0.5));
+  EXPECT_COMPLEX_NEAR(dm.try_change_row_col(1, 4, r(0, _), c(_, 0), 0.5), nda::determinant(new_ref) / nda::determinant(ref), 1e-10);
+  dm.complete_operation();
+  ref = new_ref;
+  check(dm);
+
+  // rank-k insertion and removal
+  auto R  = rand_mat(3, 5), C = rand_mat(5, 3);
+  auto D  = matrix_t{rand_mat(3, 3) + 3 * nda::eye<value_t>(3)};
+  new_ref = build(ref, {0, 4, 7}, {1, 2, 6}, R, C, D);
+  EXPECT_COMPLEX_NEAR(dm.try_insert_k({0, 4, 7}, {1, 2, 6}, R, C, D), nda::determinant(new_ref) / nda::determinant(ref), 1e-10);
+  dm.complete_operation();
+  ref = new_ref;
+  check(dm);
+  new_ref = remove(ref, {2, 3}, {4, 5});
+  EXPECT_COMPLEX_NEAR(dm.try_remove_k({2, 3}, {4, 5}), nda::determinant(new_ref) / nda::determinant(ref), 1e-10);
+  dm.complete_operation();
+  ref = new_ref;
+  check(dm);
+
+  // periodic recomputation and construction from a matrix
+  auto dm2 = nda::linalg::det_manip{ref, 2};
+  check(dm2);
+  for (long k = 0; k < 5; ++k) {
+    auto v = vector_t{rand_mat(6, 1)(_, 0)};
+    v(argmax(ref(_, k))) += 3.0;
+    dm2.try_change_col(k, v);
+    dm2.complete_operation();
+    ref(_, k) = v;
+    check(dm2);
+  }
+
+  // singular moves cannot be completed and invalid positions throw
+  EXPECT_COMPLEX_NEAR(dm2.try_change_col(0, vector_t::zeros(6)), 0.0, 1e-14);
+  EXPECT_THROW(dm2.complete_operation(), nda::runtime_error);
+  EXPECT_THROW(std::ignore = dm2.try_remove_k({1, 1}, {0, 1}), nda::runtime_error);
+}
+
+TEST(DetManip, Real) { test_det_manip<double>(); }      //NOLINT
+TEST(DetManip, Complex) { test_det_manip<dcomplex>(); } //NOLINT
+
+template <typename value_t>
+void test_krylov() { //NOLINT
+  using matrix_t = nda::matrix<value_t>;
+  using vector_t = nda::vector<value_t>;
+  long N         = 40;
+
+  // dense hermitian positive definite, hermitian indefinite and general matrices
+  auto X   = matrix_t{matrix_t::rand({N, N}) - 0.5};
+  auto Apd = matrix_t{X * dagger(X) + nda::eye<value_t>(N)};
+  auto Ain = matrix_t{X + dagger(X)};
+  for (long i = 0; i < N; ++i) Ain(i, i) += (i % 2 == 0 ? 3.0 : -3.0);
+  auto Age = matrix_t{X + 4 * nda::eye<value_t>(N)};
+  auto b   = vector_t{vector_t::rand(N) - 0.5};
+
+  // operators in place and by value, Jacobi preconditioner
+  auto op     = [](matrix_t const &A) { return [&A](auto const &v, auto &y) { nda::blas::gemv(value_t{1}, A, v, value_t{0}, y); }; };
+  auto jacobi = [](matrix_t const &A) {
+    return [&A](auto const &r, auto &z) {
+      for (long i = 0; i < r.size(); ++i) z(i) = r(i) / A(i, i);
+    };
+  };
+  auto check = [&](nda::linalg::krylov_info const &info, matrix_t const &A, vector_t const &x) {
+    EXPECT_TRUE(info.converged);
+    EXPECT_LE(info.residual, 1e-10);
+    EXPECT_ARRAY_NEAR(x, nda::linalg::lu{A}.inverse() * b, 1e-8);
+  };
+
+  auto x = vector_t::zeros(N);
+  check(nda::linalg::cg(op(Apd), b, x), Apd, x);
+  x = 0;
+  check(nda::linalg::cg([&](auto const &v) { return Apd * v; }, b, x, 1e-12, 1000, jacobi(Apd)), Apd, x);
+  x = 0;
+  check(nda::linalg::minres(op(Ain), b, x, 1e-12), Ain, x);
+  x = 0;
+  check(nda::linalg::minres(op(Apd), b, x, 1e-12, 1000, jacobi(Apd)), Apd, x);
+  x = 0;
+  check(nda::linalg::gmres(op(Age), b, x, 1e-12), Age, x);
+  x = 0;
+  auto info = nda::linalg::gmres(op(Age), b, x, 1e-12, 1000, 5, jacobi(Age));
+  check(info, Age, x);
+  EXPECT_GT(info.iterations, 5);
+
+  // the initial guess is used and zero right hand sides give zero solutions
+  auto worker = nda::linalg::gmres_worker<value_t>{10};
+  auto it0    = worker(op(Age), b, x).iterations;
+  EXPECT_EQ(it0, 0);
+  EXPECT_TRUE(worker(op(Age), vector_t::zeros(N), x).converged);
+  EXPECT_ARRAY_NEAR(x, vector_t::zeros(N), 1e-14);
+
+  // matrix-free 1D Laplacian acting on a view and too few iterations
+  long M   = 200;
+  auto lap = [M](auto const &v, auto &y) {
+    for (long i = 0; i < M; ++i) y(i) = 2.0 * v(i) - (i > 0 ? v(i - 1) : 0.0) - (i < M - 1 ? v(i + 1) : 0.0);
+  };
+  auto c  = vector_t::ones(M);
+  auto xc = nda::vector<value_t>(2 * M);
+  xc      = 0;
+  auto cg = nda::linalg::cg_worker<value_t>{};
+  EXPECT_FALSE(cg(lap, c, xc(nda::range(M)), 1e-12, 10).converged);
+  EXPECT_TRUE(cg(lap, c, xc(nda::range(M)), 1e-12, 1000).converged);
+  for (long i = 0; i < M; ++i) EXPECT_NEAR(std::real(xc(i)), 0.5 * (i + 1) * (M - i), 1e-6 * M * M);
+}
+
+TEST(Krylov, Real) { test_krylov<double>(); }      //NOLINT
+TEST(Krylov, Complex) { test_krylov<dcomplex>(); } //NOLINT
+
+template <typename value_t>
+void test_eigensolvers() { //NOLINT
+  using matrix_t = nda::matrix<value_t>;
+  long N         = 150;
+  long k         = 4;
+
+  // diagonally dominant and general hermitian matrices
+  auto X  = matrix_t{matrix_t::rand({N, N}) - 0.5};
+  auto Hd = matrix_t{0.05 * (X + dagger(X))};
+  for (long i = 0; i < N; ++i) Hd(i, i) += double((7 * i) % N);
+  auto Hg             = matrix_t{X + dagger(X)};
+  auto [ev_d, evec_d] = nda::linalg::eigenelements(Hd);
+  auto [ev_g, evec_g] = nda::linalg::eigenelements(Hg);
+  auto check          = [&](auto const &res, auto const &ev_ref, matrix_t const &H) {
+    auto const &[ev, evec, info] = res;
+    EXPECT_TRUE(info.converged);
+    EXPECT_LE(info.residual, 1e-10);
+    EXPECT_ARRAY_NEAR(ev, ev_ref(nda::range(k)), 1e-9);
+    EXPECT_ARRAY_NEAR(dagger(evec) * evec, nda::eye<value_t>(k), 1e-12);
+    EXPECT_ARRAY_NEAR(H * evec, evec * nda::diag(ev), 1e-8);
+  };
+
+  // Lanczos with a matrix and with an operator returning its result, small Krylov subspace to force restarts
+  check(nda::linalg::lanczos(Hg, k), ev_g, Hg);
+  auto op  = [&Hg](auto const &x) { return Hg * x; };
+  auto res = nda::linalg::lanczos<value_t>(N, op, k, 1e-12, 10000, 12);
+  check(res, ev_g, Hg);
+  EXPECT_GT(std::get<2>(res).iterations, 12);
+
+  // Davidson with a matrix and with an operator acting in place
+  check(nda::linalg::davidson(Hd, k), ev_d, Hd);
+  auto diag = nda::vector<double>(N);
+  for (long i = 0; i < N; ++i) diag(i) = std::real(Hd(i, i));
+  auto op_d = [&Hd](auto const &x, auto &y) { nda::blas::gemv(value_t{1}, Hd, x, value_t{0}, y); };
+  check(nda::linalg::davidson<value_t>(N, op_d, diag, k, 1e-12, 10000, 2 * k), ev_d, Hd);
+
+  // the full spectrum of a small matrix, too few iterations and invalid k
+  auto S   = matrix_t{Hg(nda::range(5), nda::range(5))};
+  auto evS = nda::linalg::eigenvalues(S);
+  EXPECT_ARRAY_NEAR(std::get<0>(nda::linalg::lanczos(S, 5)), evS, 1e-12);
+  EXPECT_ARRAY_NEAR(std::get<0>(nda::linalg::davidson(S, 5)), evS, 1e-12);
+  EXPECT_FALSE(std::get<2>(nda::linalg::lanczos(Hg, k, 1e-12, 20, 20)).converged);
+  EXPECT_THROW(std::ignore = nda::linalg::lanczos(Hg, 0), nda::runtime_error);
+}
+
+TEST(Eigensolvers, Real) { test_eigensolvers<double>(); }      //NOLINT
+TEST(Eigensolvers, Complex) { test_eigensolvers<dcomplex>(); } //NOLINT
+
+template <typename value_t>
+void test_block_diagonal() { //NOLINT
+  using matrix_t = nda::matrix<value_t>;
+  auto sizes     = std::vector<long>{3, 1, 0, 6, 2};
+  long N         = 12;
+
+  // block-diagonal matrix from the blocks of a dense matrix
+  auto X   = matrix_t{matrix_t::rand({N, N}) - 0.5};
+  auto A   = nda::linalg::block_diagonal_matrix<value_t>{X, sizes};
+  auto Ad  = matrix_t{A.to_dense()};
+  auto ref = matrix_t::zeros(N, N);
+  for (long b = 0; b < A.n_blocks(); ++b) ref(A.block_range(b), A.block_range(b)) = X(A.block_range(b), A.block_range(b));
+  EXPECT_EQ(A.n_blocks(), 5);
+  EXPECT_EQ(A.storage().size(), 50);
+  EXPECT_ARRAY_NEAR(Ad, ref, 1e-14);
+  EXPECT_COMPLEX_NEAR(A(4, 6), X(4, 6), 1e-14);
+  EXPECT_COMPLEX_NEAR(A(4, 0), value_t{0}, 1e-14);
+
+  // blocks are views into the storage
+  A.block(1)(0, 0) = 3.0;
+  EXPECT_COMPLEX_NEAR(A(3, 3), value_t{3.0}, 1e-14);
+  Ad(3, 3) = 3.0;
+
+  // products with block-diagonal and dense matrices
+  auto B  = nda::linalg::block_diagonal_matrix<value_t>{matrix_t{matrix_t::rand({N, N})}, sizes};
+  auto C  = matrix_t{matrix_t::rand({N, 4})};
+  auto Cf = nda::matrix<value_t, nda::F_layout>{C};
+  EXPECT_ARRAY_NEAR((A * B).to_dense(), Ad * B.to_dense(), 1e-13);
+  EXPECT_ARRAY_NEAR(A * C, Ad * C, 1e-13);
+  EXPECT_ARRAY_NEAR(A * Cf, Ad * C, 1e-13);
+  auto D = nda::linalg::block_diagonal_matrix<value_t>{std::vector<long>{N}};
+  EXPECT_THROW(std::ignore = A * D, nda::runtime_error);
+
+  // inverse and determinant
+  for (long b = 0; b < A.n_blocks(); ++b) A.block(b) += 2.0 * nda::eye<value_t>(A.block_sizes()[b]);
+  Ad = A.to_dense();
+  EXPECT_ARRAY_NEAR(nda::linalg::inverse(A).to_dense(), nda::inverse(Ad), 1e-12);
+  EXPECT_COMPLEX_NEAR(nda::linalg::determinant(A) / nda::determinant(Ad), value_t{1}, 1e-12);
+
+  // eigenvalues and eigenvectors of a hermitian block-diagonal matrix
+  auto H          = nda::linalg::block_diagonal_matrix<value_t>{matrix_t{X + dagger(X)}, sizes};
+  auto Hd         = matrix_t{H.to_dense()};
+  auto [ev, vecs] = nda::linalg::eigenelements(H);
+  auto ev_sorted  = ev;
+  std::sort(ev_sorted.begin(), ev_sorted.end());
+  EXPECT_ARRAY_NEAR(nda::linalg::eigenvalues(H), ev, 1e-12);
+  EXPECT_ARRAY_NEAR(ev_sorted, nda::linalg::eigenvalues(Hd), 1e-12);
+  EXPECT_ARRAY_NEAR(Hd * vecs.to_dense(), vecs.to_dense() * nda::diag(ev), 1e-12);
+
+  // singular block
+  auto S     = nda::linalg::block_diagonal_matrix<value_t>::zeros({2, 2});
+  S.block(0) = nda::eye<value_t>(2);
+  EXPECT_COMPLEX_NEAR(nda::linalg::determinant(S), value_t{0}, 1e-14);
+  EXPECT_THROW(nda::linalg::inverse_in_place(S), nda::runtime_error);
+}
+
+TEST(BlockDiagonal, Real) { test_block_diagonal<double>(); }      //NOLINT
+TEST(BlockDiagonal, Complex) { test_block_diagonal<dcomplex>(); } //NOLINT
+
+template <typename value_t, char uplo>
+void test_packed_matrix() {
+  using matrix_t = nda::matrix<value_t>;
+  long N         = 9;
+  auto R         = matrix_t{matrix_t::rand({N, N}) - 0.5};
+  auto A         = matrix_t{R + dagger(R)};
+  auto P         = nda::linalg::packed_matrix<value_t, uplo>{A};
+
+  // element access and storage
+  EXPECT_EQ(P.storage().size(), N * (N + 1) / 2);
+  EXPECT_ARRAY_NEAR(P.to_dense(), A, 1e-14);
+  EXPECT_COMPLEX_NEAR(P(2, 5), A(2, 5), 1e-14);
+  EXPECT_COMPLEX_NEAR(P(5, 2), A(5, 2), 1e-14);
+  EXPECT_EQ(P.indexmap()(N - 1, N - 1), P.storage().size() - 1);
+
+  // products, rank-1 update and eigenelements
+  auto x = nda::vector<value_t>{nda::vector<value_t>::rand(N) - 0.5};
+  EXPECT_ARRAY_NEAR(P * x, A * x, 1e-13);
+  P.rank1_update(2.0, x);
+  A += 2.0 * nda::blas::outer_product(x, nda::vector<value_t>{conj(x)});
+  EXPECT_ARRAY_NEAR(P.to_dense(), A, 1e-13);
+  auto [ev, vecs] = nda::linalg::eigenelements(P);
+  EXPECT_ARRAY_NEAR(nda::linalg::eigenvalues(P), ev, 1e-12);
+  EXPECT_ARRAY_NEAR(ev, nda::linalg::eigenvalues(A), 1e-12);
+  EXPECT_ARRAY_NEAR(A * vecs, vecs * nda::diag(ev), 1e-12);
+}
+
+TEST(PackedMatrix, Real) { test_packed_matrix<double, 'U'>(); }           //NOLINT
+TEST(PackedMatrix, ComplexUpper) { test_packed_matrix<dcomplex, 'U'>(); } //NOLINT
+TEST(PackedMatrix, ComplexLower) { test_packed_matrix<dcomplex, 'L'>(); } //NOLINT
+
+template <typename value_t>
+void test_banded_matrix() {
+  using matrix_t = nda::matrix<value_t>;
+  long N = 10, kl = 1, ku = 2;
+
+  // diagonally dominant band matrix
+  auto R = matrix_t::rand({N, N});
+  auto A = matrix_t::zeros({N, N});
+  for (long i = 0; i < N; ++i)
+    for (long j = std::max(0l, i - kl); j <= std::min(N - 1, i + ku); ++j) A(i, j) = R(i, j) + (i == j ? 3.0 : 0.0);
+  auto B = nda::linalg::banded_matrix<value_t>{A, kl, ku};
+
+  // element access, diagonals and storage
+  EXPECT_EQ(B.storage().shape(), (std::array<long, 2>{kl + ku + 1, N}));
+  EXPECT_ARRAY_NEAR(B.to_dense(), A, 1e-14);
+  EXPECT_COMPLEX_NEAR(B(3, 4), A(3, 4), 1e-14);
+  EXPECT_COMPLEX_NEAR(B(5, 4), A(5, 4), 1e-14);
+  EXPECT_COMPLEX_NEAR(B(7, 2), value_t{0}, 1e-14);
+  EXPECT_ARRAY_NEAR(B.diagonal(0), nda::diagonal(A), 1e-14);
+  EXPECT_EQ(B.diagonal(-1).size(), N - 1);
+  EXPECT_EQ(B.diagonal(2).size(), N - 2);
+  for (long i = 0; i < N - 1; ++i) EXPECT_COMPLEX_NEAR(B.diagonal(-1)(i), A(i + 1, i), 1e-14);
+  for (long i = 0; i < N - 2; ++i) EXPECT_COMPLEX_NEAR(B.diagonal(2)(i), A(i, i + 2), 1e-14);
+
+  // tridiagonal matrix from its diagonals
+  auto T         = nda::linalg::banded_matrix<value_t>::zeros(N, 1, 1);
+  T.diagonal(-1) = -1.0;
+  T.diagonal(0)  = 2.0;
+  T.diagonal(1)  = -1.0;
+  EXPECT_COMPLEX_NEAR(T(4, 3), value_t{-1.0}, 1e-14);
+  EXPECT_COMPLEX_NEAR(T(4, 6), value_t{0.0}, 1e-14);
+
+  // products
+  auto x = nda::vector<value_t>{nda::vector<value_t>::rand(N) - 0.5};
+  EXPECT_ARRAY_NEAR(B * x, A * x, 1e-13);
+  auto y = nda::vector<value_t>(N);
+  nda::linalg::gemv(value_t{1.0}, B, x, value_t{0.0}, y, 'C');
+  EXPECT_ARRAY_NEAR(y, matrix_t{dagger(A)} * x, 1e-13);
+
+  // LU factorization, linear solves and determinant
+  auto f = nda::linalg::banded_lu{B};
+  EXPECT_FALSE(f.is_singular());
+  auto X = matrix_t::rand({N, 3});
+  auto Y = X;
+  f.solve(Y);
+  EXPECT_ARRAY_NEAR(A * Y, X, 1e-13);
+  y = x;
+  f.solve(y, 'T');
+  EXPECT_ARRAY_NEAR(matrix_t{transpose(A)} * y, x, 1e-13);
+  EXPECT_NEAR(std::abs(f.det() / nda::determinant(A) - 1.0), 0.0, 1e-12);
+
+  // refactorize a singular matrix
+  auto S                 = nda::linalg::banded_matrix<value_t>::zeros(N, kl, ku);
+  S.diagonal(0)          = 1.0;
+  S.stored(N - 1, N - 1) = 0.0;
+  f.factorize(S);
+  EXPECT_TRUE(f.is_singular());
+  EXPECT_THROW(f.solve(y), nda::runtime_error);
+}
+
+TEST(BandedMatrix, Real) { test_banded_matrix<double>(); }      //NOLINT
+TEST(BandedMatrix, Complex) { test_banded_matrix<dcomplex>(); } //NOLINT
+
+template <typename value_t>
+void test_einsum() {
+  auto A = nda::array<value_t, 3>::rand(3, 4, 5);
+  auto B = nda::array<value_t, 3>::rand(5, 4, 2);
+
+  // contraction of two rank-3 arrays (requires a permutation of B)
+  auto C = nda::array<value_t, 2>::zeros(3, 2);
+  for (long i = 0; i < 3; ++i)
+    for (long j = 0; j < 4; ++j)
+      for (long k = 0; k < 5; ++k)
+        for (long l = 0; l < 2; ++l) C(i, l) += A(i, j, k) * B(k, j, l);
+  EXPECT_ARRAY_NEAR(nda::einsum<"ijk,kjl->il">(A, B), C, 1e-13);
+  EXPECT_ARRAY_NEAR(nda::einsum<"ijk,kjl->li">(A, B), transpose(C), 1e-13);
+  EXPECT_ARRAY_NEAR(nda::einsum<"ijk,kjl->il">(A, nda::array<value_t, 3, F_layout>{B}), C, 1e-13);
+
+  // batched matrix products with the batch index in different positions
+  auto D = nda::array<value_t, 3>::zeros(4, 3, 2);
+  for (long j = 0; j < 4; ++j)
+    for (long i = 0; i < 3; ++i)
+      for (long k = 0; k < 5; ++k)
+        for (long l = 0; l < 2; ++l) D(j, i, l) += A(i, j, k) * B(k, j, l);
+  EXPECT_ARRAY_NEAR(nda::einsum<"ijk,kjl->jil">(A, B), D, 1e-13);
+  auto X = nda::array<value_t, 3>::rand(6, 3, 4);
+  auto Y = nda::array<value_t, 3>::rand(6, 4, 5);
+  auto Z = nda::einsum<"bij,bjk->bik">(X, Y);
+  for (long b = 0; b < 6; ++b) EXPECT_ARRAY_NEAR(Z(b, _, _), nda::matrix<value_t>{X(b, _, _)} * nda::matrix<value_t>{Y(b, _, _)}, 1e-13);
+
+  // matrix products with strided views and a chain of three matrices
+  auto M = nda::matrix<value_t>::rand(8, 6);
+  auto N = nda::matrix<value_t, F_layout>::rand(6, 7);
+  auto P = nda::matrix<value_t>::rand(7, 3);
+  auto Mv = M(range(0, 8, 2), _);
+  EXPECT_ARRAY_NEAR(nda::einsum<"ij,jk->ik">(Mv, N), nda::matrix<value_t>{Mv} * N, 1e-13);
+  EXPECT_ARRAY_NEAR(nda::einsum<"ij,jk">(M, N), M * N, 1e-13);
+  EXPECT_ARRAY_NEAR(nda::einsum<"ij,jk,kl->il">(M, N, P), M * N * P, 1e-12);
+  EXPECT_ARRAY_NEAR(nda::einsum<"kl,ij,jk->il">(P, M, N), M * N * P, 1e-12);
+
+  // outer and inner products and a lazy expression
+  auto u = nda::vector<value_t>::rand(4);
+  auto v = nda::vector<value_t>::rand(5);
+  EXPECT_ARRAY_NEAR(nda::einsum<"i,j->ij">(u, v), nda::blas::outer_product(u, v), 1e-14);
+  auto ua = nda::array<value_t, 1>{u};
+  EXPECT_COMPLEX_NEAR(nda::einsum<"i,i->">(u, u), nda::sum(ua * ua), 1e-13);
+  EXPECT_ARRAY_NEAR(nda::einsum<"ij,j->i">(2.0 * M, N(_, 0)), 2.0 * M * nda::vector<value_t>{N(_, 0)}, 1e-13);
+
+  // single operand: transpose, trace, diagonal and partial sums
+  auto S = nda::matrix<value_t>::rand(5, 5);
+  EXPECT_ARRAY_NEAR(nda::einsum<"ij->ji">(M), transpose(M), 1e-14);
+  EXPECT_COMPLEX_NEAR(nda::einsum<"ii">(S), nda::trace(S), 1e-13);
+  EXPECT_ARRAY_NEAR(nda::einsum<"ii->i">(S), nda::diagonal(S), 1e-14);
+  auto s = nda::array<value_t, 1>::zeros(5);
+  for (long i = 0; i < 3; ++i)
+    for (long j = 0; j < 4; ++j) s += A(i, j, _);
+  EXPECT_ARRAY_NEAR(nda::einsum<"ijk->k">(A), s, 1e-13);
+  auto w = nda::array<value_t, 1>::zeros(3);
+  for (long k = 0; k < 5; ++k) w += s(k) * P(k, _);
+  EXPECT_ARRAY_NEAR(nda::einsum<"ijk,kl->l">(A, P(range(0, 5), _)), w, 1e-13);
+
+  // inconsistent extents
+  EXPECT_THROW(nda::einsum<"ij,jk->ik">(M, P), nda::runtime_error);
+}
+
+TEST(Einsum, Real) { test_einsum<double>(); }      //NOLINT
+TEST(Einsum, Complex) { test_einsum<dcomplex>(); } //NOLINT
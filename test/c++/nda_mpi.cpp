@@ -172,4 +172,83 @@ TEST(Arrays, array_transpose_bcast) { //NOLINT
   EXPECT_ARRAY_EQ(At, B);
 }
 
+// --------------------------------------
+
+// test non-blocking reduce, gather, scatter and broadcast
+TEST(Arrays, MPINonBlocking) { //NOLINT
+
+  mpi::communicator world;
+  using arr_t = nda::array<std::complex<double>, 2>;
+
+  arr_t A(7, 3);
+  for (int i = 0; i < A.extent(0); ++i)
+    for (int j = 0; j < A.extent(1); ++j) A(i, j) = i + 10 * j;
+
+  // reduce out-of-place and in-place (rvalue)
+  auto f1 = nda::mpi_ireduce(A, world);
+  auto f2 = nda::mpi_ireduce(arr_t{A}, world, 0, true);
+  auto D  = nda::array<double, 2>{nda::real(A) - world.rank()};
+  auto f3 = nda::mpi_ireduce(D(range(1, 4), range::all), world, 0, true, MPI_MAX);
+  auto r1 = f1.get();
+  if (world.rank() == 0) { EXPECT_ARRAY_NEAR(r1, world.size() * A); }
+  EXPECT_ARRAY_NEAR(f2.get(), world.size() * A);
+  EXPECT_ARRAY_NEAR(f3.get(), nda::real(A)(range(1, 4), range::all));
+
+  // scatter and gather
+  auto se = itertools::chunk_range(0, 7, world.size(), world.rank());
+  auto B  = nda::mpi_iscatter(A, world).get();
+  EXPECT_ARRAY_EQ(B, A(range(se.first, se.second), range::all));
+
+  auto f4 = nda::mpi_igather(B, world);
+  auto f5 = nda::mpi_igather(arr_t{-B}, world, 0, true);
+  auto AA = f4.get();
+  if (world.rank() == 0) { EXPECT_ARRAY_NEAR(AA, A); }
+  EXPECT_ARRAY_NEAR(f5.get(), -A);
+
+  // broadcast
+  arr_t C;
+  if (world.rank() == 0) C = A;
+  auto f6 = nda::mpi_ibroadcast(C, world);
+  f6.wait();
+  EXPECT_TRUE(f6.test());
+  EXPECT_ARRAY_NEAR(C, A);
+
+  // reassigning a broadcast future rebinds its view (the previous target is not modified)
+  arr_t E;
+  if (world.rank() == 0) E = 2 * A(range(0, 4), range::all);
+  f6       = nda::mpi_ibroadcast(E, world);
+  auto E_v = f6.get();
+  EXPECT_EQ(E_v.data(), E.data());
+  EXPECT_ARRAY_NEAR(E, 2 * A(range(0, 4), range::all));
+  EXPECT_ARRAY_NEAR(C, A);
+
+  // assigning to a default constructed future
+  auto f7 = decltype(f6){};
+  f7      = nda::mpi_ibroadcast(C, world);
+  EXPECT_EQ(f7.get().data(), C.data());
+}
+
+// --------------------------------------
+
+// test persistent reduce
+TEST(Arrays, MPIPersistentReduce) { //NOLINT
+
+  mpi::communicator world;
+  using arr_t = nda::array<double, 2>;
+
+  auto r1 = nda::mpi_persistent_reduce<arr_t>{{4, 5}, world, 0, true};
+  auto r2 = nda::mpi_persistent_reduce<arr_t>{{4, 5}, world};
+  auto s  = world.size();
+  for (int it = 0; it < 3; ++it) {
+    r1.buffer() = it + world.rank();
+    r1.start();
+    r2.buffer() = it;
+    r2.start();
+    EXPECT_THROW(r1.start(), nda::runtime_error);
+    EXPECT_ARRAY_NEAR(r1.wait(), arr_t(4, 5) = it * s + s * (s - 1) / 2.0);
+    auto res = r2.wait();
+    if (world.rank() == 0) { EXPECT_ARRAY_NEAR(res, arr_t(4, 5) = it * s); }
+  }
+}
+
 MAKE_MAIN_MPI
@@ -0,0 +1,125 @@
+// Copyright (c) 2024 Simons Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "./test_common.hpp"
+
+#include <nda/sparse.hpp>
+
+// random sparse matrix with roughly the given fraction of nonzero elements
+template <typename T>
+nda::matrix<T> sparse_dense(long m, long n, double fill) {
+  auto res = nda::matrix<T>::zeros(m, n);
+  auto r   = nda::rand<double>(m, n);
+  auto v   = nda::matrix<T>{nda::matrix<T>::rand({m, n}) - 0.5};
+  for (long i = 0; i < m; ++i)
+    for (long j = 0; j < n; ++j)
+      if (r(i, j) < fill) res(i, j) = v(i, j);
+  return res;
+}
+
+// ==============================================================
+
+TEST(Sparse, COOToCSR) { //NOLINT
+  auto coo = nda::sparse::coo_matrix<double>(3, 4);
+  coo.insert(2, 1, 1.0);
+  coo.insert(0, 3, 2.0);
+  coo.insert(2, 1, 0.5);
+  coo.insert(0, 0, -1.0);
+  coo.insert(1, 2, 3.0);
+  EXPECT_EQ(coo.nnz(), 5);
+
+  auto csr = nda::sparse::csr_matrix{coo};
+  EXPECT_EQ(csr.nnz(), 4);
+  EXPECT_EQ(csr.shape(), (std::array<long, 2>{3, 4}));
+  EXPECT_EQ(csr.row_ptr(), (nda::array<long, 1>{0, 2, 3, 4}));
+  EXPECT_EQ(csr.col_idx(), (nda::array<long, 1>{0, 3, 2, 1}));
+  EXPECT_EQ(csr(2, 1), 1.5);
+  EXPECT_EQ(csr(2, 2), 0.0);
+  EXPECT_ARRAY_NEAR(csr.to_dense(), coo.to_dense());
+  EXPECT_ARRAY_NEAR(csr.transpose().to_dense(), nda::matrix<double>{transpose(coo.to_dense())});
+
+  // values can be updated in place
+  csr.values() *= 2.0;
+  EXPECT_EQ(csr(0, 3), 4.0);
+
+  // empty matrices and rows
+  auto empty = nda::sparse::csr_matrix{nda::sparse::coo_matrix<double>(2, 2)};
+  EXPECT_EQ(empty.nnz(), 0);
+  EXPECT_ARRAY_NEAR(empty.to_dense(), nda::matrix<double>::zeros(2, 2));
+}
+
+// ==============================================================
+
+template <typename T>
+void test_sparse_products() {
+  long m = 50, n = 40, k = 6;
+  auto d = sparse_dense<T>(m, n, 0.1);
+  auto a = nda::sparse::csr_matrix<T>{d};
+  EXPECT_ARRAY_NEAR(a.to_dense(), d);
+
+  // SpMV with strided vectors and beta != 0
+  auto x  = nda::vector<T>{nda::vector<T>::rand(2 * n) - 0.5};
+  auto xs = x(nda::range(0, 2 * n, 2));
+  auto y0 = nda::vector<T>{nda::vector<T>::rand(m)};
+  auto y  = y0;
+  nda::sparse::spmv(T{2}, a, xs, T{-1}, y);
+  EXPECT_ARRAY_NEAR(y, nda::vector<T>{2 * d * xs - y0}, 1e-13);
+  EXPECT_ARRAY_NEAR(a * xs, nda::vector<T>{d * xs}, 1e-13);
+
+  // SpMM with C and Fortran layouts
+  auto b  = nda::matrix<T>{nda::matrix<T>::rand({n, k}) - 0.5};
+  auto bf = nda::matrix<T, nda::F_layout>{b};
+  auto c  = nda::matrix<T, nda::F_layout>(m, k);
+  nda::sparse::spmm(T{1}, a, b, T{0}, c);
+  EXPECT_ARRAY_NEAR(c, nda::matrix<T>{d * b}, 1e-13);
+  nda::sparse::spmm(T{1}, a, bf(nda::range::all, nda::range(2)), T{1}, c(nda::range::all, nda::range(2)));
+  EXPECT_ARRAY_NEAR(c(nda::range::all, nda::range(2)), nda::matrix<T>{2 * d * b(nda::range::all, nda::range(2))}, 1e-13);
+  EXPECT_ARRAY_NEAR(a * bf, nda::matrix<T>{d * b}, 1e-13);
+
+  // large matrix (parallel products), the reference is computed from the triplets
+  long N   = 6000;
+  long K   = 3;
+  auto coo = nda::sparse::coo_matrix<T>(N, N);
+  for (long i = 0; i < N; ++i) {
+    coo.insert(i, i, 2.0);
+    if (i > 0) coo.insert(i, i - 1, -1.0);
+    if (i + 1 < N) coo.insert(i, i + 1, -1.0);
+    coo.insert(i, (7 * i) % N, 0.5);
+  }
+  auto big = nda::sparse::csr_matrix{coo};
+  EXPECT_GE(big.nnz(), nda::sparse::detail::omp_min_nnz);
+  auto v     = nda::vector<T>{nda::vector<T>::rand(N)};
+  auto w     = nda::matrix<T>{nda::matrix<T>::rand({N, K})};
+  auto v_ref = nda::vector<T>::zeros({N});
+  auto w_ref = nda::matrix<T>::zeros({N, K});
+  for (long p = 0; p < coo.nnz(); ++p) {
+    long row = coo.rows()(p), col = coo.cols()(p);
+    v_ref(row) += coo.values()(p) * v(col);
+    for (long l = 0; l < K; ++l) w_ref(row, l) += coo.values()(p) * w(col, l);
+  }
+  EXPECT_ARRAY_NEAR(big * v, v_ref, 1e-12);
+  EXPECT_ARRAY_NEAR(big * w, w_ref, 1e-12);
+}
+
+TEST(Sparse, ProductsReal) { test_sparse_products<double>(); }      //NOLINT
+TEST(Sparse, ProductsComplex) { test_sparse_products<dcomplex>(); } //NOLINT
+
+TEST(Sparse, RealMatrixComplexVector) { //NOLINT
+  auto d = sparse_dense<double>(20, 20, 0.2);
+  auto a = nda::sparse::csr_matrix<double>{d};
+  auto x = nda::vector<dcomplex>{nda::vector<dcomplex>::rand(20)};
+  auto y = a * x;
+  static_assert(std::is_same_v<nda::get_value_t<decltype(y)>, dcomplex>);
+  EXPECT_ARRAY_NEAR(y, nda::vector<dcomplex>{nda::matrix<dcomplex>{d} * x}, 1e-13);
+}